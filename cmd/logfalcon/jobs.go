@@ -0,0 +1,272 @@
+package main
+
+import (
+	"context"
+	"errors"
+	"log/slog"
+	"os"
+	"path/filepath"
+	"runtime"
+	"strings"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/config"
+	"github.com/proeugene/logfalcon/internal/jobs"
+	"github.com/proeugene/logfalcon/internal/offload"
+	"github.com/proeugene/logfalcon/internal/storage"
+	lfsync "github.com/proeugene/logfalcon/internal/sync"
+	"github.com/proeugene/logfalcon/internal/util"
+	"github.com/proeugene/logfalcon/internal/web"
+)
+
+// jobsStateName is the persisted job queue in the storage root, so queued
+// work survives a reboot.
+const jobsStateName = ".jobs.json"
+
+// startJobs creates the background job scheduler for the web process,
+// registers post-sync work and starts it. Jobs are queued at boot and every
+// time a sync ends.
+func startJobs(ctx context.Context, cfg *config.Config) *jobs.Scheduler {
+	budget := jobs.Budget{
+		MaxLoadPerCPU:   cfg.JobsMaxLoadPerCPU,
+		MaxTempC:        cfg.JobsMaxTempC,
+		MaxIOPressure:   cfg.JobsMaxIOPressure,
+		PauseOnThrottle: true,
+	}
+	window := func() jobs.Window {
+		if !lfsync.SyncActive(cfg.StoragePath) {
+			return jobs.Open
+		}
+		if lfsync.GetStatus().State == "erasing" {
+			return jobs.LightOnly // the FC erases on its own; the Pi is idle
+		}
+		return jobs.Closed
+	}
+	sched := jobs.New(filepath.Join(cfg.StoragePath, jobsStateName), budget, window)
+
+	store, err := storage.OpenStore(cfg.StorageLayout, cfg.StoragePath)
+	if err != nil {
+		slog.Error("background jobs disabled: cannot open session store", "error", err)
+		return sched
+	}
+	sched.Register(jobs.Spec{Kind: "offload", Class: jobs.Heavy, Priority: 30,
+		Run: func(ctx context.Context, _ string) error {
+			return offloadOnce(cfg, store, func() bool { return ctx.Err() != nil })
+		}})
+	sched.Register(jobs.Spec{Kind: "index", Class: jobs.Heavy, Priority: 40,
+		Run: func(ctx context.Context, _ string) error { return indexOnce(ctx, store) }})
+	sched.Register(jobs.Spec{Kind: "reclaim", Class: jobs.Light, Priority: 20,
+		Run: func(context.Context, string) error { return reclaimOnce(cfg, store) }})
+	compactor, canCompact := store.(interface{ Compact() error })
+	if canCompact {
+		sched.Register(jobs.Spec{Kind: "compact", Class: jobs.Heavy, Priority: 10,
+			Run: func(context.Context, string) error {
+				if err := compactor.Compact(); err != nil && !errors.Is(err, storage.ErrStoreBusy) {
+					return err
+				}
+				return nil
+			}})
+	}
+
+	sched.Register(jobs.Spec{Kind: "card_probe", Class: jobs.Light, Priority: 5,
+		Run: func(ctx context.Context, _ string) error { return probeCardOnce(ctx, cfg) }})
+	sched.Register(jobs.Spec{Kind: web.CardCheckJob, Class: jobs.Heavy, Priority: 1,
+		Run: func(ctx context.Context, _ string) error { return checkCardOnce(ctx, cfg) }})
+	_ = sched.Enqueue("card_probe", "")
+
+	postSync := func() {
+		_ = sched.Enqueue("index", "")
+		if cfg.OffloadPath != "" {
+			_ = sched.Enqueue("offload", "")
+		}
+		if cfg.StoragePressureCleanup {
+			_ = sched.Enqueue("reclaim", "")
+		}
+		if canCompact {
+			_ = sched.Enqueue("compact", "")
+		}
+	}
+	sched.OnSyncEnd(postSync)
+	postSync()
+
+	go onIdleIOThread(func() { sched.Run(ctx) })
+	return sched
+}
+
+// onIdleIOThread runs fn on an OS thread in the idle I/O class so background
+// disk work never competes with a flash copy for the SD card. I/O priority
+// is per thread, so jobs must do their SD reads on the goroutine they were
+// called on (offload keeps its reads there and hands only the USB writes to
+// a helper goroutine). The thread is never unlocked so it exits with fn
+// instead of returning to the pool.
+func onIdleIOThread(fn func()) {
+	done := make(chan struct{})
+	go func() {
+		runtime.LockOSThread()
+		if err := util.SetIdleIOPriority(); err != nil {
+			slog.Warn("could not set idle I/O priority", "error", err)
+		}
+		fn()
+		close(done)
+	}()
+	<-done
+}
+
+// runReclaim is the --reclaim mode: one reclaim pass, then exit.
+func runReclaim(cfg *config.Config) error {
+	store, err := storage.OpenStore(cfg.StorageLayout, cfg.StoragePath)
+	if err != nil {
+		return err
+	}
+	onIdleIOThread(func() { err = reclaimOnce(cfg, store) })
+	return err
+}
+
+// runOffload is the --offload mode: one offload pass, then exit.
+func runOffload(cfg *config.Config) error {
+	store, err := storage.OpenStore(cfg.StorageLayout, cfg.StoragePath)
+	if err != nil {
+		return err
+	}
+	onIdleIOThread(func() {
+		err = offloadOnce(cfg, store, func() bool { return lfsync.SyncActive(cfg.StoragePath) })
+	})
+	return err
+}
+
+// reclaimOnce keeps room for the next sync off the sync critical path.
+func reclaimOnce(cfg *config.Config, store storage.Store) error {
+	if !cfg.StoragePressureCleanup {
+		slog.Info("storage_pressure_cleanup=false — skipping reclaim")
+		return nil
+	}
+	// Space other writers have reserved but not yet written is not free.
+	reserve := int64(cfg.MinFreeSpaceMB) * 1024 * 1024
+	if reserved, err := storage.OpenLedger(cfg.RuntimeDir, cfg.StoragePath).Reserved(); err == nil {
+		reserve += reserved
+	}
+	res, err := storage.Reclaim(store, reserve, lfsync.RetentionPolicy(cfg))
+	if res != nil {
+		slog.Info("reclaim finished",
+			"targetFreeMB", res.TargetFreeBytes/(1024*1024),
+			"freeBeforeMB", res.FreeBefore/(1024*1024),
+			"plannedMB", res.PlannedBytes/(1024*1024),
+			"freeAfterMB", res.FreeAfter/(1024*1024),
+			"deleted_sessions", len(res.Deleted))
+	}
+	return err
+}
+
+// indexOnce finds the flights in sessions that have not been indexed yet and
+// renders their sparklines for the session list.
+func indexOnce(ctx context.Context, store storage.Store) error {
+	sessions, err := store.ListSessions()
+	if err != nil {
+		return err
+	}
+	for _, s := range sessions {
+		if err := ctx.Err(); err != nil {
+			return err // paused for a sync; the job is resumed later
+		}
+		if s.Manifest == nil || s.Manifest.IndexedUTC != "" {
+			continue
+		}
+		n, err := storage.IndexFlights(store, s.SessionID)
+		if err != nil {
+			slog.Warn("could not index session", "session", s.SessionID, "error", err)
+			continue
+		}
+		slog.Info("indexed session", "session", s.SessionID, "flights", n)
+	}
+	return nil
+}
+
+// offloadOnce copies new sessions to the USB drive. A missing drive is not an
+// error: there is simply nothing to do. busy stops the copy early.
+func offloadOnce(cfg *config.Config, store storage.Store, busy func() bool) error {
+	if cfg.OffloadPath == "" {
+		slog.Info("offload_path not set — skipping offload")
+		return nil
+	}
+	res, err := offload.Run(store, offload.Options{
+		Dest:        cfg.OffloadPath,
+		DeleteLocal: cfg.OffloadDeleteLocal,
+		SyncActive:  busy,
+	})
+	switch {
+	case errors.Is(err, offload.ErrNotMounted), errors.Is(err, os.ErrNotExist):
+		slog.Info("no USB drive mounted — skipping offload", "path", cfg.OffloadPath)
+		return nil
+	case errors.Is(err, offload.ErrSyncActive):
+		slog.Info("offload paused for a sync; it resumes afterwards")
+		err = nil
+	}
+	if res != nil {
+		slog.Info("offload finished",
+			"offloaded", len(res.Offloaded),
+			"already_present", res.AlreadyPresent,
+			"MB", res.Bytes/(1024*1024),
+			"deleted_local", len(res.DeletedLocal))
+	}
+	return err
+}
+
+// bootIDPath identifies the current boot, so the card probe runs once per
+// boot and not on every socket-activated start of the web server.
+const bootIDPath = "/proc/sys/kernel/random/boot_id"
+
+// probeCardOnce runs the calibrated SD card probe unless it already ran this
+// boot, and records the result in the card history.
+func probeCardOnce(ctx context.Context, cfg *config.Config) error {
+	bootID := ""
+	if data, err := os.ReadFile(bootIDPath); err == nil {
+		bootID = strings.TrimSpace(string(data))
+	}
+	if h, err := storage.LoadCardHealth(cfg.StoragePath); err == nil && bootID != "" && h.ProbeBootID == bootID {
+		return nil
+	}
+	scratch, err := reserveScratch(cfg, storage.ProbeBytes, "card_probe")
+	if err != nil {
+		slog.Info("skipping SD card probe", "reason", err)
+		return nil
+	}
+	sample, err := storage.ProbeCard(ctx, cfg.StoragePath)
+	_ = scratch.Release()
+	if err != nil {
+		return err
+	}
+	slog.Info("SD card probe", "MBps", sample.MBps, "flush_p99_ms", sample.FsyncP99MS, "flush_max_ms", sample.FsyncMaxMS)
+	return storage.UpdateCardHealth(cfg.StoragePath, func(h *storage.CardHealth) {
+		h.Probe = sample
+		h.ProbeBootID = bootID
+		h.BytesWritten += sample.Bytes
+	})
+}
+
+// checkCardOnce runs the fake-capacity check and records the result. A check
+// that cannot run is recorded too, so the settings page can say why.
+func checkCardOnce(ctx context.Context, cfg *config.Config) error {
+	var res *storage.CapacityCheck
+	scratch, err := reserveScratch(cfg, storage.CapacityCheckBytes, "card_check")
+	var short *storage.SpaceError
+	if errors.As(err, &short) {
+		err = storage.ErrNotEnoughSpace
+	} else if err == nil {
+		res, err = storage.CheckCapacity(ctx, cfg.StoragePath)
+		_ = scratch.Release()
+	}
+	if ctx.Err() != nil {
+		return err // paused for a sync; the job is resumed later
+	}
+	if err != nil {
+		res = &storage.CapacityCheck{AtUTC: time.Now().UTC().Format(time.RFC3339), Error: err.Error()}
+	}
+	slog.Info("SD card capacity check", "blocks", res.Blocks, "bad", res.Bad, "error", res.Error)
+	return storage.UpdateCardHealth(cfg.StoragePath, func(h *storage.CardHealth) { h.Capacity = res })
+}
+
+// reserveScratch claims n bytes for a job's scratch file in the space ledger,
+// leaving the sync's headroom untouched.
+func reserveScratch(cfg *config.Config, n int64, purpose string) (*storage.Reservation, error) {
+	return storage.OpenLedger(cfg.RuntimeDir, cfg.StoragePath).Reserve(n, int64(cfg.MinFreeSpaceMB)*1024*1024, purpose)
+}
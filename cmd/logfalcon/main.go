@@ -1,14 +1,22 @@
 package main
 
 import (
+	"context"
 	"flag"
 	"fmt"
 	"log/slog"
 	"os"
+	"os/signal"
+	"path/filepath"
+	"runtime"
+	"runtime/debug"
+	"syscall"
 
 	"github.com/proeugene/logfalcon/internal/config"
 	"github.com/proeugene/logfalcon/internal/led"
+	"github.com/proeugene/logfalcon/internal/power"
 	lfsync "github.com/proeugene/logfalcon/internal/sync"
+	"github.com/proeugene/logfalcon/internal/util"
 	"github.com/proeugene/logfalcon/internal/web"
 )
 
@@ -19,19 +27,30 @@ var (
 )
 
 func main() {
+	timeline := lfsync.NewTimeline()
 	var (
 		webMode     bool
 		serialPort  string
 		configPath  string
 		showVersion bool
 		dryRun      bool
+		reclaim     bool
+		offloadRun  bool
+		traceStart  bool
+		lastFlight  bool
+		restoreCPU  bool
 	)
 
 	flag.BoolVar(&webMode, "web", false, "Run in web server mode")
-	flag.StringVar(&serialPort, "port", "", "Serial port path for sync mode (e.g. /dev/ttyACM0)")
+	flag.StringVar(&serialPort, "port", "", "Serial port path for sync mode (e.g. /dev/ttyACM0), or an MSP bridge as tcp://host:port or udp://host:port")
 	flag.StringVar(&configPath, "config", "", "Path to config file (default: /etc/logfalcon/logfalcon.toml)")
 	flag.BoolVar(&showVersion, "version", false, "Print version and exit")
 	flag.BoolVar(&dryRun, "dry-run", false, "Sync without erasing FC flash")
+	flag.BoolVar(&lastFlight, "last-flight", false, "Copy only the newest log and keep the FC flash (overrides last_flight_only)")
+	flag.BoolVar(&reclaim, "reclaim", false, "Free space for the next sync by deleting old sessions, then exit")
+	flag.BoolVar(&offloadRun, "offload", false, "Copy new sessions to the USB drive at offload_path, then exit")
+	flag.BoolVar(&restoreCPU, "restore-cpu", false, "Undo the CPU clock boost of a sync that was killed, then exit")
+	flag.BoolVar(&traceStart, "startup-trace", false, "Print time from exec to the first MSP byte, stage by stage")
 	flag.Parse()
 
 	if showVersion {
@@ -39,8 +58,8 @@ func main() {
 		os.Exit(0)
 	}
 
-	if !webMode && serialPort == "" {
-		fmt.Fprintln(os.Stderr, "error: specify --web or --port <path>")
+	if !webMode && !reclaim && !offloadRun && !restoreCPU && serialPort == "" {
+		fmt.Fprintln(os.Stderr, "error: specify --web, --reclaim, --offload, --restore-cpu or --port <path>")
 		flag.Usage()
 		os.Exit(1)
 	}
@@ -50,6 +69,34 @@ func main() {
 		slog.Warn("config load failed, using defaults", "error", err)
 		cfg = config.Default()
 	}
+	timeline.Mark(lfsync.StageConfigLoaded)
+	if lastFlight {
+		cfg.LastFlightOnly = true
+	}
+
+	if restoreCPU {
+		if err := power.RestoreSaved(lfsync.BoostStatePath(cfg)); err != nil {
+			slog.Error("could not restore the CPU clock policy", "error", err)
+			os.Exit(1)
+		}
+		return
+	}
+
+	if reclaim {
+		if err := runReclaim(cfg); err != nil {
+			slog.Error("reclaim failed", "error", err)
+			os.Exit(1)
+		}
+		return
+	}
+
+	if offloadRun {
+		if err := runOffload(cfg); err != nil {
+			slog.Error("offload failed", "error", err)
+			os.Exit(1)
+		}
+		return
+	}
 
 	ledCtrl := led.New(cfg.LEDBackend, cfg.LEDGPIOPin)
 	ledCtrl.Start()
@@ -57,7 +104,16 @@ func main() {
 
 	if webMode {
 		slog.Info("starting web server", "port", cfg.WebPort, "version", Version)
+		if ncpu := runtime.NumCPU(); cfg.SerialCPU >= 0 && cfg.SerialCPU < ncpu && ncpu > 1 {
+			// Leave the serial loop's core to the sync process.
+			if err := util.AvoidCPU(cfg.SerialCPU, ncpu); err != nil {
+				slog.Warn("could not move the web server off the serial core", "cpu", cfg.SerialCPU, "error", err)
+			}
+		}
+		lfsync.FollowStatus(filepath.Join(cfg.RuntimeDir, lfsync.StatusFileName),
+			func() bool { return lfsync.SyncActive(cfg.StoragePath) })
 		srv := web.NewServer(cfg.StoragePath, cfg)
+		srv.SetJobs(startJobs(context.Background(), cfg))
 		addr := fmt.Sprintf("0.0.0.0:%d", cfg.WebPort)
 		if err := srv.ListenAndServe(addr); err != nil {
 			slog.Error("web server failed", "error", err)
@@ -67,13 +123,23 @@ func main() {
 	}
 
 	slog.Info("starting sync", "port", serialPort, "version", Version)
+	tuneSyncGC()
+	lfsync.PublishStatus(filepath.Join(cfg.RuntimeDir, lfsync.StatusFileName))
 	ledCtrl.SetState(led.Busy)
+	timeline.Mark(lfsync.StageLEDOn)
+	timeline.DeviceAdded(serialPort)
 	orch := &lfsync.Orchestrator{
-		Config: cfg,
-		LED:    ledCtrl,
-		DryRun: dryRun,
+		Config:       cfg,
+		LED:          ledCtrl,
+		DryRun:       dryRun,
+		Timeline:     timeline,
+		StartupTrace: traceStart,
 	}
-	result := orch.Run(serialPort)
+	// systemd stops the unit with SIGTERM when the FC is unplugged; cancel
+	// the sync so its cleanup runs instead of the process dying mid-copy.
+	ctx, stop := signal.NotifyContext(context.Background(), syscall.SIGTERM, os.Interrupt)
+	defer stop()
+	result := orch.Run(ctx, serialPort)
 	switch result {
 	case lfsync.ResultSuccess:
 		slog.Info("sync complete")
@@ -86,3 +152,21 @@ func main() {
 		os.Exit(1)
 	}
 }
+
+// Sync-mode GC settings for the 512 MB Pi Zero. The flash read loop does not
+// allocate once warmed up, so a lazy collector costs nothing there and keeps
+// GC work off the serial core during handshake and verify; the soft limit
+// keeps the heap bounded regardless. GOGC / GOMEMLIMIT still override them.
+const (
+	syncGCPercent   = 400
+	syncMemoryLimit = 64 << 20
+)
+
+func tuneSyncGC() {
+	if os.Getenv("GOGC") == "" {
+		debug.SetGCPercent(syncGCPercent)
+	}
+	if os.Getenv("GOMEMLIMIT") == "" {
+		debug.SetMemoryLimit(syncMemoryLimit)
+	}
+}
@@ -0,0 +1,36 @@
+package main
+
+import (
+	"os"
+	"os/exec"
+	"testing"
+)
+
+// startupProbeEnv makes a re-executed test binary exit as soon as every
+// package is initialised, so BenchmarkStartup measures exec plus init cost.
+const startupProbeEnv = "LOGFALCON_STARTUP_PROBE"
+
+func TestMain(m *testing.M) {
+	if os.Getenv(startupProbeEnv) == "1" {
+		os.Exit(0)
+	}
+	os.Exit(m.Run())
+}
+
+// BenchmarkStartup runs the binary (with everything main links in) up to
+// the point where main would start. On a Pi Zero, compare it against
+// `logfalcon --startup-trace` to see how much of the wait is process start.
+func BenchmarkStartup(b *testing.B) {
+	exe, err := os.Executable()
+	if err != nil {
+		b.Fatal(err)
+	}
+	env := append(os.Environ(), startupProbeEnv+"=1")
+	for i := 0; i < b.N; i++ {
+		cmd := exec.Command(exe, "-test.run=^$")
+		cmd.Env = env
+		if err := cmd.Run(); err != nil {
+			b.Fatal(err)
+		}
+	}
+}
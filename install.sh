@@ -182,9 +182,14 @@ ip link set wlan0 up 2>/dev/null || true
 echo "[6/8] Installing systemd units..."
 cp "$SCRIPT_DIR/system/logfalcon@.service" /etc/systemd/system/
 cp "$SCRIPT_DIR/system/logfalcon-web.service" /etc/systemd/system/
+cp "$SCRIPT_DIR/system/logfalcon-web.socket" /etc/systemd/system/
 cp "$SCRIPT_DIR/system/logfalcon-boot-led.service" /etc/systemd/system/
 cp "$SCRIPT_DIR/system/logfalcon-ready-led.service" /etc/systemd/system/
 
+# cpufreq access for the sync service (sync_cpu_governor)
+install -m 644 "$SCRIPT_DIR/system/logfalcon.tmpfiles" /etc/tmpfiles.d/logfalcon.conf
+systemd-tmpfiles --create /etc/tmpfiles.d/logfalcon.conf 2>/dev/null || true
+
 # Boot LED heartbeat script
 install -m 755 "$SCRIPT_DIR/system/logfalcon-boot-led.sh" "$INSTALL_DIR/boot-led.sh"
 
@@ -197,7 +202,7 @@ chmod +x "$INSTALL_DIR/firstboot.sh"
 cp "$SCRIPT_DIR/system/logfalcon-firstboot.service" /etc/systemd/system/
 systemctl daemon-reload
 systemctl enable logfalcon-firstboot.service
-systemctl enable logfalcon-web.service
+systemctl enable logfalcon-web.socket
 systemctl enable logfalcon-boot-led.service
 systemctl enable logfalcon-ready-led.service
 systemctl enable hostapd
@@ -221,7 +226,7 @@ echo "[8/8] Starting services..."
 systemctl restart hostapd || true
 systemctl restart dnsmasq || true
 systemctl restart avahi-daemon || true
-systemctl start logfalcon-web.service || true
+systemctl start logfalcon-web.socket || true
 
 echo ""
 echo "=== Install complete! ==="
@@ -0,0 +1,519 @@
+// Package blackbox reads just enough of Betaflight and iNav blackbox logs to
+// summarise each flight in a raw flash dump: where it is, how long it ran and
+// a throttle/gyro trace sampled from its intra frames.
+//
+// Inter (P) and slow frames are walked by their field encodings only; their
+// values are never reconstructed, which needs the full predictor state.
+// Corrupt data is skipped up to the next intra frame that parses cleanly.
+package blackbox
+
+import (
+	"bytes"
+	"errors"
+	"math"
+	"strconv"
+	"strings"
+	"time"
+)
+
+// Preamble opens every Betaflight and iNav blackbox log.
+var Preamble = []byte("H Product:Blackbox flight data recorder by Nicholas Sherlock")
+
+// Field encodings, as numbered in "H Field X encoding" headers.
+const (
+	encSignedVB   = 0
+	encUnsignedVB = 1
+	encNeg14Bit   = 3
+	encTag8_8SVB  = 6
+	encTag2_3S32  = 7
+	encTag8_4S16  = 8
+	encNull       = 9
+)
+
+// I-frame predictors applied to the fields a Flight samples.
+const (
+	predZero        = 0
+	predMinThrottle = 4
+	predMotor0      = 5
+	predVBatRef     = 9
+	predMinMotor    = 11
+)
+
+// logEndMessage follows the log-end event.
+const logEndMessage = "End of log\x00"
+
+// Sample is one intra frame's worth of the fields a sparkline needs.
+type Sample struct {
+	TimeUS   int64
+	Throttle int32   // rcCommand[3], 1000-2000 when the header is complete
+	GyroDPS  float64 // largest absolute gyro rate of the three axes
+}
+
+// Flight is one log found in a flash dump.
+type Flight struct {
+	Offset  int64 // of the log's first header byte
+	Bytes   int64
+	Samples []Sample
+	// Corrupt counts the times the frame walk lost sync and skipped ahead.
+	Corrupt int
+}
+
+// Duration is the time between the first and last sampled frame.
+func (f *Flight) Duration() time.Duration {
+	if len(f.Samples) < 2 {
+		return 0
+	}
+	return time.Duration(f.Samples[len(f.Samples)-1].TimeUS-f.Samples[0].TimeUS) * time.Microsecond
+}
+
+// MaxGyroDPS is the largest gyro rate seen, which is where a crash shows.
+func (f *Flight) MaxGyroDPS() float64 {
+	peak := 0.0
+	for _, s := range f.Samples {
+		peak = max(peak, s.GyroDPS)
+	}
+	return peak
+}
+
+// Index splits a flash dump into its logs and samples each one. Logs whose
+// header cannot be used are still listed, without samples.
+func Index(data []byte) []Flight {
+	var flights []Flight
+	for off := bytes.Index(data, Preamble); off >= 0; {
+		next := bytes.Index(data[off+len(Preamble):], Preamble)
+		end := len(data)
+		if next >= 0 {
+			next += off + len(Preamble)
+			end = next
+		}
+		f := Flight{Offset: int64(off), Bytes: int64(end - off)}
+		if h, body, err := parseHeader(data[off:end]); err == nil {
+			f.Samples, f.Corrupt = h.walk(body)
+		}
+		flights = append(flights, f)
+		off = next
+	}
+	return flights
+}
+
+// header is what the frame walk needs from a log's text header.
+type header struct {
+	enc         map[byte][]int // field encodings per frame type
+	iPred       []int
+	timeField   int
+	throttle    int
+	gyro        [3]int
+	motor0      int
+	minThrottle int32
+	minMotor    int32
+	vbatRef     int32
+	gyroScale   float64 // deg/s per gyro unit
+}
+
+var errNoFields = errors.New("log header has no intra frame fields")
+
+// parseHeader reads the "H name:value" lines at the start of log and returns
+// the frame data after them.
+func parseHeader(log []byte) (*header, []byte, error) {
+	h := &header{enc: make(map[byte][]int), timeField: -1, throttle: -1, gyro: [3]int{-1, -1, -1}, motor0: -1, gyroScale: 1}
+	var names []string
+	pos := 0
+	for pos < len(log) && bytes.HasPrefix(log[pos:], []byte("H ")) {
+		eol := bytes.IndexByte(log[pos:], '\n')
+		if eol < 0 {
+			eol = len(log) - pos
+		}
+		line := string(log[pos+2 : pos+eol])
+		pos += eol + 1
+		name, value, ok := strings.Cut(line, ":")
+		if !ok {
+			continue
+		}
+		switch {
+		case name == "Field I name":
+			names = strings.Split(value, ",")
+		case name == "Field I predictor":
+			h.iPred = parseInts(value)
+		case strings.HasPrefix(name, "Field ") && strings.HasSuffix(name, " encoding") && len(name) == len("Field X encoding"):
+			h.enc[name[6]] = parseInts(value)
+		case name == "minthrottle":
+			h.minThrottle = int32(atoi(value))
+		case name == "motorOutput":
+			first, _, _ := strings.Cut(value, ",")
+			h.minMotor = int32(atoi(first))
+		case name == "vbatref":
+			h.vbatRef = int32(atoi(value))
+		case name == "gyro_scale" || name == "gyro.scale":
+			if bits, err := strconv.ParseUint(strings.TrimPrefix(value, "0x"), 16, 32); err == nil {
+				if scale := math.Float32frombits(uint32(bits)); scale > 0 {
+					h.gyroScale = float64(scale)
+				}
+			}
+		}
+	}
+	if len(names) == 0 || len(h.enc['I']) != len(names) {
+		return nil, nil, errNoFields
+	}
+	for i, n := range names {
+		switch n {
+		case "time":
+			h.timeField = i
+		case "rcCommand[3]":
+			h.throttle = i
+		case "gyroADC[0]", "gyroADC[1]", "gyroADC[2]":
+			h.gyro[n[8]-'0'] = i
+		case "motor[0]":
+			h.motor0 = i
+		}
+	}
+	// P frames carry the same fields as I frames.
+	if p := h.enc['P']; len(p) != len(names) {
+		delete(h.enc, 'P')
+	}
+	return h, log[pos:], nil
+}
+
+// walk steps through the frames in body and samples every intra frame. A
+// frame only counts once the byte after it starts another frame.
+func (h *header) walk(body []byte) ([]Sample, int) {
+	var (
+		samples []Sample
+		corrupt int
+		synced  = true
+	)
+	size := 0
+	for _, enc := range h.enc {
+		size = max(size, len(enc))
+	}
+	values := make([]int64, size)
+	for pos := 0; pos < len(body); {
+		marker := body[pos]
+		if !synced && marker != 'I' {
+			pos++
+			continue
+		}
+		r := &frameReader{buf: body, pos: pos + 1}
+		end := false
+		var err error
+		switch {
+		case marker == 'E':
+			end, err = r.event()
+		case h.enc[marker] != nil:
+			err = r.fields(h.enc[marker], values)
+		default:
+			err = errCorrupt
+		}
+		if err == nil && !end && r.pos < len(body) && !h.isMarker(body[r.pos]) {
+			err = errCorrupt
+		}
+		if err != nil {
+			if synced {
+				corrupt++
+			}
+			synced = false
+			pos++
+			continue
+		}
+		synced = true
+		if marker == 'I' {
+			samples = append(samples, h.sample(values))
+		}
+		if end {
+			break
+		}
+		pos = r.pos
+	}
+	return samples, corrupt
+}
+
+func (h *header) isMarker(b byte) bool {
+	return b == 'E' || h.enc[b] != nil
+}
+
+// sample applies the intra frame predictors to the sampled fields.
+func (h *header) sample(raw []int64) Sample {
+	value := func(i int) int64 {
+		if i < 0 {
+			return 0
+		}
+		v := raw[i]
+		pred := predZero
+		if i < len(h.iPred) {
+			pred = h.iPred[i]
+		}
+		switch pred {
+		case predMinThrottle:
+			v += int64(h.minThrottle)
+		case predMinMotor:
+			v += int64(h.minMotor)
+		case predVBatRef:
+			v += int64(h.vbatRef)
+		case predMotor0:
+			if h.motor0 >= 0 && h.motor0 != i {
+				v += raw[h.motor0]
+			}
+		}
+		return v
+	}
+	s := Sample{TimeUS: value(h.timeField), Throttle: int32(value(h.throttle))}
+	for _, g := range h.gyro {
+		s.GyroDPS = max(s.GyroDPS, math.Abs(float64(value(g)))*h.gyroScale)
+	}
+	return s
+}
+
+var errCorrupt = errors.New("corrupt frame")
+
+// frameReader decodes the variable-length encodings of frame fields.
+type frameReader struct {
+	buf []byte
+	pos int
+}
+
+func (r *frameReader) byte() (byte, error) {
+	if r.pos >= len(r.buf) {
+		return 0, errCorrupt
+	}
+	b := r.buf[r.pos]
+	r.pos++
+	return b, nil
+}
+
+func (r *frameReader) unsignedVB() (uint32, error) {
+	var v uint32
+	for shift := 0; shift < 35; shift += 7 {
+		b, err := r.byte()
+		if err != nil {
+			return 0, err
+		}
+		v |= uint32(b&0x7f) << shift
+		if b < 0x80 {
+			return v, nil
+		}
+	}
+	return 0, errCorrupt
+}
+
+func (r *frameReader) signedVB() (int64, error) {
+	u, err := r.unsignedVB()
+	return int64(int32(u>>1) ^ -int32(u&1)), err
+}
+
+// fields decodes one frame with the given per-field encodings into values.
+func (r *frameReader) fields(enc []int, values []int64) error {
+	for i := 0; i < len(enc); {
+		var err error
+		switch enc[i] {
+		case encSignedVB:
+			values[i], err = r.signedVB()
+			i++
+		case encUnsignedVB:
+			var u uint32
+			u, err = r.unsignedVB()
+			values[i] = int64(int32(u))
+			i++
+		case encNeg14Bit:
+			var u uint32
+			u, err = r.unsignedVB()
+			values[i] = -signExtend(u, 14)
+			i++
+		case encNull:
+			values[i] = 0
+			i++
+		case encTag8_8SVB:
+			n := 1
+			for i+n < len(enc) && n < 8 && enc[i+n] == encTag8_8SVB {
+				n++
+			}
+			err = r.tag8_8SVB(values[i : i+n])
+			i += n
+		case encTag2_3S32:
+			err = r.tag2_3S32(values[i:min(i+3, len(values))])
+			i += 3
+		case encTag8_4S16:
+			err = r.tag8_4S16(values[i:min(i+4, len(values))])
+			i += 4
+		default:
+			return errCorrupt
+		}
+		if err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+func (r *frameReader) tag8_8SVB(out []int64) error {
+	if len(out) == 1 {
+		v, err := r.signedVB()
+		out[0] = v
+		return err
+	}
+	tags, err := r.byte()
+	if err != nil {
+		return err
+	}
+	for i := range out {
+		out[i] = 0
+		if tags&(1<<i) != 0 {
+			if out[i], err = r.signedVB(); err != nil {
+				return err
+			}
+		}
+	}
+	return nil
+}
+
+func (r *frameReader) tag2_3S32(out []int64) error {
+	var v [3]int64
+	lead, err := r.byte()
+	if err != nil {
+		return err
+	}
+	switch lead >> 6 {
+	case 0:
+		v = [3]int64{signExtend(uint32(lead>>4), 2), signExtend(uint32(lead>>2), 2), signExtend(uint32(lead), 2)}
+	case 1:
+		b, err := r.byte()
+		if err != nil {
+			return err
+		}
+		v = [3]int64{signExtend(uint32(lead), 4), signExtend(uint32(b>>4), 4), signExtend(uint32(b), 4)}
+	case 2:
+		v[0] = signExtend(uint32(lead), 6)
+		for i := 1; i < 3; i++ {
+			b, err := r.byte()
+			if err != nil {
+				return err
+			}
+			v[i] = signExtend(uint32(b), 6)
+		}
+	case 3:
+		sel := lead
+		for i := range v {
+			size := 1 + int(sel&3)
+			var u uint32
+			for k := 0; k < size; k++ {
+				b, err := r.byte()
+				if err != nil {
+					return err
+				}
+				u |= uint32(b) << (8 * k)
+			}
+			v[i] = signExtend(u, 8*size)
+			sel >>= 2
+		}
+	}
+	copy(out, v[:])
+	return nil
+}
+
+func (r *frameReader) tag8_4S16(out []int64) error {
+	var v [4]int64
+	sel, err := r.byte()
+	if err != nil {
+		return err
+	}
+	var nibble byte
+	half := false // the low nibble of `nibble` is still unread
+	for i := range v {
+		switch sel & 3 {
+		case 1:
+			if !half {
+				if nibble, err = r.byte(); err != nil {
+					return err
+				}
+				v[i] = signExtend(uint32(nibble>>4), 4)
+			} else {
+				v[i] = signExtend(uint32(nibble), 4)
+			}
+			half = !half
+		case 2:
+			b, err := r.byte()
+			if err != nil {
+				return err
+			}
+			if half {
+				v[i] = signExtend(uint32(nibble)<<4|uint32(b>>4), 8)
+				nibble = b
+			} else {
+				v[i] = signExtend(uint32(b), 8)
+			}
+		case 3:
+			b1, err := r.byte()
+			if err != nil {
+				return err
+			}
+			b2, err := r.byte()
+			if err != nil {
+				return err
+			}
+			if half {
+				v[i] = signExtend(uint32(nibble)<<12|uint32(b1)<<4|uint32(b2>>4), 16)
+				nibble = b2
+			} else {
+				v[i] = signExtend(uint32(b1)<<8|uint32(b2), 16)
+			}
+		}
+		sel >>= 2
+	}
+	copy(out, v[:])
+	return nil
+}
+
+// event skips an event frame and reports whether it ended the log.
+func (r *frameReader) event() (end bool, err error) {
+	kind, err := r.byte()
+	if err != nil {
+		return false, err
+	}
+	switch kind {
+	case 0, 15: // sync beep, disarm
+		_, err = r.unsignedVB()
+	case 13: // in-flight adjustment
+		var fn byte
+		if fn, err = r.byte(); err == nil {
+			if fn < 128 {
+				_, err = r.signedVB()
+			} else {
+				r.pos += 4
+				if r.pos > len(r.buf) {
+					err = errCorrupt
+				}
+			}
+		}
+	case 14, 30: // logging resumed, flight mode change
+		if _, err = r.unsignedVB(); err == nil {
+			_, err = r.unsignedVB()
+		}
+	case 255:
+		if !bytes.HasPrefix(r.buf[r.pos:], []byte(logEndMessage)) {
+			return false, errCorrupt
+		}
+		r.pos += len(logEndMessage)
+		return true, nil
+	default:
+		return false, errCorrupt
+	}
+	return false, err
+}
+
+// signExtend interprets the low bits of u as a two's complement number.
+func signExtend(u uint32, bits int) int64 {
+	shift := 32 - bits
+	return int64(int32(u<<shift) >> shift)
+}
+
+func parseInts(s string) []int {
+	parts := strings.Split(s, ",")
+	out := make([]int, len(parts))
+	for i, p := range parts {
+		out[i] = atoi(p)
+	}
+	return out
+}
+
+func atoi(s string) int {
+	n, _ := strconv.Atoi(strings.TrimSpace(s))
+	return n
+}
@@ -0,0 +1,192 @@
+package blackbox
+
+import (
+	"bytes"
+	"fmt"
+	"testing"
+	"time"
+)
+
+// logWriter builds a small Betaflight-style log: loopIteration, time,
+// throttle and gyro in intra frames, with inter frames between them.
+type logWriter struct{ bytes.Buffer }
+
+func newLog() *logWriter {
+	w := &logWriter{}
+	w.Write(Preamble)
+	w.WriteString("\nH Data version:2\n")
+	w.WriteString("H Field I name:loopIteration,time,rcCommand[3],gyroADC[0],gyroADC[1],gyroADC[2],motor[0]\n")
+	w.WriteString("H Field I signed:0,0,0,1,1,1,0\n")
+	w.WriteString("H Field I predictor:0,0,4,0,0,0,11\n")
+	w.WriteString("H Field I encoding:1,1,1,0,0,0,1\n")
+	w.WriteString("H Field P predictor:6,2,1,1,1,1,1\n")
+	w.WriteString("H Field P encoding:9,0,8,8,8,8,0\n")
+	w.WriteString("H Field S name:flightModeFlags\n")
+	w.WriteString("H Field S encoding:1\n")
+	w.WriteString("H minthrottle:1000\n")
+	w.WriteString("H motorOutput:48,2047\n")
+	w.WriteString("H gyro_scale:0x3f800000\n")
+	return w
+}
+
+func (w *logWriter) uvb(v uint32) {
+	for v >= 0x80 {
+		w.WriteByte(byte(v) | 0x80)
+		v >>= 7
+	}
+	w.WriteByte(byte(v))
+}
+
+func (w *logWriter) svb(v int32) { w.uvb(uint32(v<<1) ^ uint32(v>>31)) }
+
+func (w *logWriter) iframe(iter, timeUS uint32, throttle int32, gyro [3]int32) {
+	w.WriteByte('I')
+	w.uvb(iter)
+	w.uvb(timeUS)
+	w.uvb(uint32(throttle - 1000))
+	for _, g := range gyro {
+		w.svb(g)
+	}
+	w.uvb(100)
+}
+
+// pframe writes a time delta and zero deltas for everything else.
+func (w *logWriter) pframe(dt int32) {
+	w.WriteByte('P')
+	w.svb(dt)
+	w.WriteByte(0) // tag8_4s16: four zero fields
+	w.svb(0)
+}
+
+func (w *logWriter) end() {
+	w.Write([]byte{'E', 255})
+	w.WriteString(logEndMessage)
+}
+
+// flight writes n intra frames 32 loops apart, each followed by inter frames,
+// with gyro(i) as the roll rate.
+func (w *logWriter) flight(n int, gyro func(i int) int32) {
+	w.Write([]byte{'E', 0})
+	w.uvb(123456) // sync beep
+	for i := 0; i < n; i++ {
+		w.iframe(uint32(i*32), uint32(i*32*125), 1500, [3]int32{gyro(i), -20, 5})
+		for k := 0; k < 3; k++ {
+			w.pframe(125)
+		}
+		if i == n/2 {
+			w.WriteByte('S')
+			w.uvb(1)
+		}
+	}
+}
+
+func TestIndexSplitsAndSamplesLogs(t *testing.T) {
+	calm := newLog()
+	calm.flight(100, func(int) int32 { return 150 })
+	calm.end()
+	crash := newLog()
+	crash.flight(50, func(i int) int32 {
+		if i == 40 {
+			return -1990
+		}
+		return 200
+	})
+	crash.end()
+	data := append(append([]byte{}, calm.Bytes()...), crash.Bytes()...)
+
+	flights := Index(data)
+	if len(flights) != 2 {
+		t.Fatalf("got %d flights, want 2", len(flights))
+	}
+	if flights[0].Offset != 0 || flights[1].Offset != int64(calm.Len()) || flights[1].Bytes != int64(crash.Len()) {
+		t.Errorf("offsets %+v, want the two logs' boundaries", []int64{flights[0].Offset, flights[1].Offset, flights[1].Bytes})
+	}
+	for i, want := range []int{100, 50} {
+		f := flights[i]
+		if len(f.Samples) != want || f.Corrupt != 0 {
+			t.Fatalf("flight %d: %d samples, %d corrupt; want %d clean", i, len(f.Samples), f.Corrupt, want)
+		}
+		if s := f.Samples[1]; s.Throttle != 1500 || s.TimeUS != 32*125 {
+			t.Errorf("flight %d sample = %+v, want throttle 1500 at 4000 us", i, s)
+		}
+	}
+	if d := flights[0].Duration(); d != 99*32*125*time.Microsecond {
+		t.Errorf("duration = %v", d)
+	}
+	if peak := flights[0].MaxGyroDPS(); peak != 150 {
+		t.Errorf("calm peak gyro = %v, want 150", peak)
+	}
+	if peak := flights[1].MaxGyroDPS(); peak != 1990 {
+		t.Errorf("crash peak gyro = %v, want 1990", peak)
+	}
+}
+
+func TestIndexResyncsAfterCorruption(t *testing.T) {
+	w := newLog()
+	w.flight(20, func(int) int32 { return 100 })
+	w.Write([]byte{0xff, 'P', 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 'Q'}) // torn write
+	w.flight(20, func(int) int32 { return 100 })
+	w.end()
+	w.Write(bytes.Repeat([]byte{0xff}, 64)) // erased flash after the log
+
+	flights := Index(w.Bytes())
+	if len(flights) != 1 {
+		t.Fatalf("got %d flights, want 1", len(flights))
+	}
+	f := flights[0]
+	if f.Corrupt != 1 {
+		t.Errorf("Corrupt = %d, want 1", f.Corrupt)
+	}
+	if len(f.Samples) != 40 {
+		t.Errorf("%d samples, want both halves' 40", len(f.Samples))
+	}
+}
+
+func TestIndexWithoutUsableHeader(t *testing.T) {
+	data := append(append([]byte{}, Preamble...), "\nH Firmware type:Cleanflight\n\x00\x01\x02"...)
+	flights := Index(data)
+	if len(flights) != 1 || len(flights[0].Samples) != 0 || flights[0].Sparkline() != "" {
+		t.Fatalf("flights = %+v, want one log without samples", flights)
+	}
+	if got := Index([]byte("no logs here")); len(got) != 0 {
+		t.Fatalf("got %d flights from non-log data", len(got))
+	}
+}
+
+func TestGroupEncodings(t *testing.T) {
+	tests := []struct {
+		enc  []int
+		data []byte
+		want []int64
+	}{
+		// Two nibbles then a byte.
+		{[]int{8, 8, 8, 8}, []byte{0x94, 0x3e, 0x64}, []int64{0, 3, -2, 100}},
+		// A nibble, then a byte straddling the nibble boundary.
+		{[]int{8, 8, 8, 8}, []byte{0x09, 0x59, 0xc0}, []int64{5, -100, 0, 0}},
+		// A nibble, then 16 bits straddling it.
+		{[]int{8, 8, 8, 8}, []byte{0x0d, 0x1f, 0xc1, 0x80}, []int64{1, -1000, 0, 0}},
+		{[]int{7, 7, 7}, []byte{0x1c}, []int64{1, -1, 0}},
+		{[]int{7, 7, 7}, []byte{0x4f, 0x27}, []int64{-1, 2, 7}},
+		{[]int{7, 7, 7}, []byte{0xbf, 0x01, 0x20}, []int64{-1, 1, -32}},
+		{[]int{7, 7, 7}, []byte{0xc4, 0xfb, 0xe8, 0x03, 0x00}, []int64{-5, 1000, 0}},
+		{[]int{6, 6, 6}, []byte{0x05, 0x03, 0x04}, []int64{-2, 0, 2}},
+		{[]int{6}, []byte{0x03}, []int64{-2}},
+		{[]int{3, 9}, []byte{0x05}, []int64{-5, 0}},
+	}
+	for _, tt := range tests {
+		t.Run(fmt.Sprintf("%v/% x", tt.enc, tt.data), func(t *testing.T) {
+			r := &frameReader{buf: tt.data}
+			got := make([]int64, len(tt.enc))
+			if err := r.fields(tt.enc, got); err != nil {
+				t.Fatal(err)
+			}
+			if fmt.Sprint(got) != fmt.Sprint(tt.want) || r.pos != len(tt.data) {
+				t.Errorf("got %v after %d bytes, want %v after %d", got, r.pos, tt.want, len(tt.data))
+			}
+		})
+	}
+	r := &frameReader{buf: []byte{0x80, 0x80}}
+	if err := r.fields([]int{1}, make([]int64, 1)); err == nil {
+		t.Error("truncated varint decoded")
+	}
+}
@@ -0,0 +1,71 @@
+package blackbox
+
+import (
+	"fmt"
+	"math"
+	"regexp"
+	"strings"
+)
+
+// Sparkline geometry: sparkPoints columns spaced sparkStep apart, drawn in a
+// sparkHeight-unit box. Points are integers so a thumbnail stays a few
+// hundred bytes.
+const (
+	sparkPoints = 32
+	sparkStep   = 2
+	sparkHeight = 20
+	// gyroFullScale is the top of the gyro trace; crashes and flips hit it.
+	gyroFullScale = 2000.0
+)
+
+// Sparkline renders the flight's throttle (blue) and peak gyro rate (orange)
+// as a small inline SVG, or "" if the flight has no samples.
+func (f *Flight) Sparkline() string {
+	if len(f.Samples) == 0 {
+		return ""
+	}
+	throttle := make([]float64, sparkPoints)
+	gyro := make([]float64, sparkPoints)
+	counts := make([]int, sparkPoints)
+	for i, s := range f.Samples {
+		col := i * sparkPoints / len(f.Samples)
+		throttle[col] += float64(s.Throttle-1000) / 1000
+		gyro[col] = max(gyro[col], s.GyroDPS/gyroFullScale)
+		counts[col]++
+	}
+	for col := range throttle {
+		if counts[col] > 0 {
+			throttle[col] /= float64(counts[col])
+		} else if col > 0 { // fewer samples than columns
+			throttle[col], gyro[col] = throttle[col-1], gyro[col-1]
+		}
+	}
+	width := (sparkPoints - 1) * sparkStep
+	return fmt.Sprintf(`<svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 %d %d" width="%d" height="%d">`+
+		`<polyline points="%s" fill="none" stroke="#80a8ff"/>`+
+		`<polyline points="%s" fill="none" stroke="#e08030"/></svg>`,
+		width, sparkHeight, width*2, sparkHeight*2, polyline(throttle), polyline(gyro))
+}
+
+// polyline maps values in [0, 1] to polyline points, 0 at the bottom.
+func polyline(values []float64) string {
+	var b strings.Builder
+	for i, v := range values {
+		if i > 0 {
+			b.WriteByte(' ')
+		}
+		v = math.Max(0, math.Min(1, v))
+		fmt.Fprintf(&b, "%d,%d", i*sparkStep, sparkHeight-int(math.Round(v*sparkHeight)))
+	}
+	return b.String()
+}
+
+var sparklineRE = regexp.MustCompile(`^<svg xmlns="http://www\.w3\.org/2000/svg" viewBox="0 0 \d+ \d+" width="\d+" height="\d+">` +
+	`(<polyline points="[\d, ]*" fill="none" stroke="#[0-9a-f]{6}"/>)*</svg>$`)
+
+// ValidSparkline reports whether s has exactly the shape Sparkline produces,
+// so a sparkline read back from a manifest can be inlined into a page
+// without escaping.
+func ValidSparkline(s string) bool {
+	return sparklineRE.MatchString(s)
+}
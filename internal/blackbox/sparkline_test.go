@@ -0,0 +1,46 @@
+package blackbox
+
+import (
+	"strings"
+	"testing"
+)
+
+func TestSparkline(t *testing.T) {
+	f := &Flight{}
+	for i := 0; i < 1000; i++ {
+		s := Sample{TimeUS: int64(i) * 4000, Throttle: 1000 + int32(i%500), GyroDPS: 300}
+		if i == 900 {
+			s.GyroDPS = 2000 // the crash
+		}
+		f.Samples = append(f.Samples, s)
+	}
+	svg := f.Sparkline()
+	if !ValidSparkline(svg) {
+		t.Fatalf("Sparkline output not accepted by ValidSparkline: %s", svg)
+	}
+	if len(svg) > 800 {
+		t.Errorf("sparkline is %d bytes, want a few hundred", len(svg))
+	}
+	gyro := svg[strings.LastIndex(svg, `points="`):]
+	if !strings.Contains(gyro, "56,0") || !strings.Contains(gyro, "0,17") {
+		t.Errorf("gyro trace %q should peak at the crash and idle at 300 deg/s", gyro)
+	}
+
+	few := &Flight{Samples: f.Samples[:3]}
+	if svg := few.Sparkline(); !ValidSparkline(svg) || strings.Count(svg, ",") != 2*sparkPoints {
+		t.Errorf("short flight sparkline = %s", svg)
+	}
+}
+
+func TestValidSparklineRejectsMarkup(t *testing.T) {
+	for _, s := range []string{
+		"",
+		`<svg onload="alert(1)"></svg>`,
+		`<svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 62 20" width="124" height="40"><script>alert(1)</script></svg>`,
+		`<svg xmlns="http://www.w3.org/2000/svg" viewBox="0 0 62 20" width="124" height="40"><polyline points="0,0" fill="none" stroke="#80a8ff" onclick="x"/></svg>`,
+	} {
+		if ValidSparkline(s) {
+			t.Errorf("ValidSparkline(%q) = true", s)
+		}
+	}
+}
@@ -18,58 +18,101 @@ const (
 // Config holds all runtime configuration for LogFalcon.
 type Config struct {
 	// Serial
-	SerialBaud    int     `toml:"serial_baud"`
-	SerialPort    string  `toml:"serial_port"`
-	SerialTimeout float64 `toml:"serial_timeout"`
+	SerialBaud       int     `toml:"serial_baud"`
+	SerialPort       string  `toml:"serial_port"`
+	SerialTimeout    float64 `toml:"serial_timeout"`
+	SerialRTPriority int     `toml:"serial_rt_priority"`
+	SerialCPU        int     `toml:"serial_cpu"`
+	FCReadyTimeout   float64 `toml:"fc_ready_timeout"`
 
 	// Storage
 	StoragePath            string `toml:"storage_path"`
+	StorageLayout          string `toml:"storage_layout"`
 	MinFreeSpaceMB         int    `toml:"min_free_space_mb"`
 	StoragePressureCleanup bool   `toml:"storage_pressure_cleanup"`
 
+	// Retention
+	RetentionKeepLastPerFC    int  `toml:"retention_keep_last_per_fc"`
+	RetentionFCQuotaMB        int  `toml:"retention_fc_quota_mb"`
+	RetentionPreferDownloaded bool `toml:"retention_prefer_downloaded"`
+
+	// USB offload
+	OffloadPath        string `toml:"offload_path"`
+	OffloadDeleteLocal bool   `toml:"offload_delete_local"`
+
 	// Sync behaviour
-	EraseAfterSync       bool `toml:"erase_after_sync"`
-	FlashChunkSize       int  `toml:"flash_chunk_size"`
-	EraseTimeoutSec      int  `toml:"erase_timeout_sec"`
-	FlashReadCompression bool `toml:"flash_read_compression"`
+	EraseAfterSync       bool   `toml:"erase_after_sync"`
+	FlashChunkSize       int    `toml:"flash_chunk_size"`
+	EraseTimeoutSec      int    `toml:"erase_timeout_sec"`
+	FlashReadCompression bool   `toml:"flash_read_compression"`
+	LastFlightOnly       bool   `toml:"last_flight_only"`
+	ReadOrder            string `toml:"read_order"`
 
 	// LED
 	LEDBackend string `toml:"led_backend"`
 	LEDGPIOPin int    `toml:"led_gpio_pin"`
 
 	// Web server
-	WebPort         int    `toml:"web_port"`
-	HotspotSSID     string `toml:"hotspot_ssid"`
-	HotspotPassword string `toml:"hotspot_password"`
+	WebPort            int    `toml:"web_port"`
+	WebIdleExitMinutes int    `toml:"web_idle_exit_minutes"`
+	HotspotSSID        string `toml:"hotspot_ssid"`
+	HotspotPassword    string `toml:"hotspot_password"`
 
 	// Power management
-	IdleShutdownMinutes int `toml:"idle_shutdown_minutes"`
+	IdleShutdownMinutes int    `toml:"idle_shutdown_minutes"`
+	SyncCPUGovernor     string `toml:"sync_cpu_governor"`
+
+	// Background jobs
+	RuntimeDir        string  `toml:"runtime_dir"`
+	JobsMaxLoadPerCPU float64 `toml:"jobs_max_load_per_cpu"`
+	JobsMaxTempC      float64 `toml:"jobs_max_temp_c"`
+	JobsMaxIOPressure float64 `toml:"jobs_max_io_pressure"`
 }
 
 // Default returns a Config populated with all default values.
 func Default() *Config {
 	return &Config{
-		SerialBaud:    921600,
-		SerialPort:    "",
-		SerialTimeout: 5.0,
+		SerialBaud:       921600,
+		SerialPort:       "",
+		SerialTimeout:    5.0,
+		SerialRTPriority: 0,
+		SerialCPU:        -1,
+		FCReadyTimeout:   10.0,
 
 		StoragePath:            "/mnt/logfalcon-logs",
+		StorageLayout:          "directory",
 		MinFreeSpaceMB:         200,
 		StoragePressureCleanup: true,
 
+		RetentionKeepLastPerFC:    0,
+		RetentionFCQuotaMB:        0,
+		RetentionPreferDownloaded: true,
+
+		OffloadPath:        "",
+		OffloadDeleteLocal: false,
+
 		EraseAfterSync:       true,
 		FlashChunkSize:       4096,
 		EraseTimeoutSec:      120,
 		FlashReadCompression: false,
+		LastFlightOnly:       false,
+		ReadOrder:            "linear",
 
 		LEDBackend: "sysfs",
 		LEDGPIOPin: 17,
 
-		WebPort:         80,
-		HotspotSSID:     "LogFalcon",
-		HotspotPassword: "fpvpilot",
+		WebPort:            80,
+		WebIdleExitMinutes: 30,
+		HotspotSSID:        "LogFalcon",
+		HotspotPassword:    "fpvpilot",
 
 		IdleShutdownMinutes: 0,
+		SyncCPUGovernor:     "performance",
+
+		RuntimeDir:        "/run/logfalcon",
+		JobsMaxLoadPerCPU: 0.75,
+		JobsMaxTempC:      70,
+		JobsMaxIOPressure: 20,
 	}
 }
 
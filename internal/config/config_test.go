@@ -13,17 +13,32 @@ func TestDefault(t *testing.T) {
 	assertEqual(t, "SerialBaud", cfg.SerialBaud, 921600)
 	assertEqual(t, "SerialPort", cfg.SerialPort, "")
 	assertEqualFloat(t, "SerialTimeout", cfg.SerialTimeout, 5.0)
+	assertEqual(t, "SerialRTPriority", cfg.SerialRTPriority, 0)
+	assertEqual(t, "SerialCPU", cfg.SerialCPU, -1)
+	assertEqualFloat(t, "FCReadyTimeout", cfg.FCReadyTimeout, 10.0)
 
 	// Storage
 	assertEqual(t, "StoragePath", cfg.StoragePath, "/mnt/logfalcon-logs")
+	assertEqual(t, "StorageLayout", cfg.StorageLayout, "directory")
 	assertEqual(t, "MinFreeSpaceMB", cfg.MinFreeSpaceMB, 200)
 	assertEqualBool(t, "StoragePressureCleanup", cfg.StoragePressureCleanup, true)
 
+	// Retention
+	assertEqual(t, "RetentionKeepLastPerFC", cfg.RetentionKeepLastPerFC, 0)
+	assertEqual(t, "RetentionFCQuotaMB", cfg.RetentionFCQuotaMB, 0)
+	assertEqualBool(t, "RetentionPreferDownloaded", cfg.RetentionPreferDownloaded, true)
+
+	// USB offload
+	assertEqual(t, "OffloadPath", cfg.OffloadPath, "")
+	assertEqualBool(t, "OffloadDeleteLocal", cfg.OffloadDeleteLocal, false)
+
 	// Sync behaviour
 	assertEqualBool(t, "EraseAfterSync", cfg.EraseAfterSync, true)
 	assertEqual(t, "FlashChunkSize", cfg.FlashChunkSize, 4096)
 	assertEqual(t, "EraseTimeoutSec", cfg.EraseTimeoutSec, 120)
 	assertEqualBool(t, "FlashReadCompression", cfg.FlashReadCompression, false)
+	assertEqualBool(t, "LastFlightOnly", cfg.LastFlightOnly, false)
+	assertEqual(t, "ReadOrder", cfg.ReadOrder, "linear")
 
 	// LED
 	assertEqual(t, "LEDBackend", cfg.LEDBackend, "sysfs")
@@ -31,11 +46,19 @@ func TestDefault(t *testing.T) {
 
 	// Web server
 	assertEqual(t, "WebPort", cfg.WebPort, 80)
+	assertEqual(t, "WebIdleExitMinutes", cfg.WebIdleExitMinutes, 30)
 	assertEqual(t, "HotspotSSID", cfg.HotspotSSID, "LogFalcon")
 	assertEqual(t, "HotspotPassword", cfg.HotspotPassword, "fpvpilot")
 
 	// Power management
 	assertEqual(t, "IdleShutdownMinutes", cfg.IdleShutdownMinutes, 0)
+	assertEqual(t, "SyncCPUGovernor", cfg.SyncCPUGovernor, "performance")
+
+	// Background jobs
+	assertEqual(t, "RuntimeDir", cfg.RuntimeDir, "/run/logfalcon")
+	assertEqualFloat(t, "JobsMaxLoadPerCPU", cfg.JobsMaxLoadPerCPU, 0.75)
+	assertEqualFloat(t, "JobsMaxTempC", cfg.JobsMaxTempC, 70)
+	assertEqualFloat(t, "JobsMaxIOPressure", cfg.JobsMaxIOPressure, 20)
 }
 
 func TestLoadFromFile(t *testing.T) {
@@ -43,19 +66,31 @@ func TestLoadFromFile(t *testing.T) {
 serial_baud = 921600
 serial_port = "/dev/ttyUSB0"
 serial_timeout = 10.0
+serial_rt_priority = 50
+serial_cpu = 3
+fc_ready_timeout = 4.5
 storage_path = "/tmp/logs"
 min_free_space_mb = 500
 storage_pressure_cleanup = false
+retention_keep_last_per_fc = 3
+retention_fc_quota_mb = 2048
+retention_prefer_downloaded = false
+offload_path = "/media/usb"
+offload_delete_local = true
 erase_after_sync = false
 flash_chunk_size = 8192
 erase_timeout_sec = 60
 flash_read_compression = true
+last_flight_only = true
+read_order = "tail_first"
 led_backend = "gpio"
 led_gpio_pin = 22
 web_port = 8080
+web_idle_exit_minutes = 0
 hotspot_ssid = "MyDrone"
 hotspot_password = "secret123"
 idle_shutdown_minutes = 15
+sync_cpu_governor = ""
 `
 	path := writeTempTOML(t, content)
 	cfg, err := Load(path)
@@ -66,19 +101,31 @@ idle_shutdown_minutes = 15
 	assertEqual(t, "SerialBaud", cfg.SerialBaud, 921600)
 	assertEqual(t, "SerialPort", cfg.SerialPort, "/dev/ttyUSB0")
 	assertEqualFloat(t, "SerialTimeout", cfg.SerialTimeout, 10.0)
+	assertEqual(t, "SerialRTPriority", cfg.SerialRTPriority, 50)
+	assertEqual(t, "SerialCPU", cfg.SerialCPU, 3)
+	assertEqualFloat(t, "FCReadyTimeout", cfg.FCReadyTimeout, 4.5)
 	assertEqual(t, "StoragePath", cfg.StoragePath, "/tmp/logs")
 	assertEqual(t, "MinFreeSpaceMB", cfg.MinFreeSpaceMB, 500)
 	assertEqualBool(t, "StoragePressureCleanup", cfg.StoragePressureCleanup, false)
+	assertEqual(t, "RetentionKeepLastPerFC", cfg.RetentionKeepLastPerFC, 3)
+	assertEqual(t, "RetentionFCQuotaMB", cfg.RetentionFCQuotaMB, 2048)
+	assertEqualBool(t, "RetentionPreferDownloaded", cfg.RetentionPreferDownloaded, false)
+	assertEqual(t, "OffloadPath", cfg.OffloadPath, "/media/usb")
+	assertEqualBool(t, "OffloadDeleteLocal", cfg.OffloadDeleteLocal, true)
 	assertEqualBool(t, "EraseAfterSync", cfg.EraseAfterSync, false)
 	assertEqual(t, "FlashChunkSize", cfg.FlashChunkSize, 8192)
 	assertEqual(t, "EraseTimeoutSec", cfg.EraseTimeoutSec, 60)
 	assertEqualBool(t, "FlashReadCompression", cfg.FlashReadCompression, true)
+	assertEqualBool(t, "LastFlightOnly", cfg.LastFlightOnly, true)
+	assertEqual(t, "ReadOrder", cfg.ReadOrder, "tail_first")
 	assertEqual(t, "LEDBackend", cfg.LEDBackend, "gpio")
 	assertEqual(t, "LEDGPIOPin", cfg.LEDGPIOPin, 22)
 	assertEqual(t, "WebPort", cfg.WebPort, 8080)
+	assertEqual(t, "WebIdleExitMinutes", cfg.WebIdleExitMinutes, 0)
 	assertEqual(t, "HotspotSSID", cfg.HotspotSSID, "MyDrone")
 	assertEqual(t, "HotspotPassword", cfg.HotspotPassword, "secret123")
 	assertEqual(t, "IdleShutdownMinutes", cfg.IdleShutdownMinutes, 15)
+	assertEqual(t, "SyncCPUGovernor", cfg.SyncCPUGovernor, "")
 }
 
 func TestLoadMissing(t *testing.T) {
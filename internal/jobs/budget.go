@@ -0,0 +1,92 @@
+package jobs
+
+import (
+	"bufio"
+	"os"
+	"runtime"
+	"strconv"
+	"strings"
+
+	"github.com/proeugene/logfalcon/internal/power"
+)
+
+// Budget limits when heavy jobs may run. A zero limit disables that check,
+// and so does a probe the kernel does not provide.
+type Budget struct {
+	// MaxLoadPerCPU is the highest 1-minute load average per CPU.
+	MaxLoadPerCPU float64
+	// MaxTempC is the highest SoC temperature in °C.
+	MaxTempC float64
+	// MaxIOPressure is the highest share of time (percent, 10 s average) in
+	// which some task was stalled on I/O, from /proc/pressure/io.
+	MaxIOPressure float64
+	// PauseOnThrottle holds heavy jobs while the firmware reports
+	// undervoltage or throttling.
+	PauseOnThrottle bool
+}
+
+// DefaultBudget leaves headroom for the web UI and keeps the SoC clear of
+// the Pi's 80 °C soft throttle.
+var DefaultBudget = Budget{MaxLoadPerCPU: 0.75, MaxTempC: 70, MaxIOPressure: 20, PauseOnThrottle: true}
+
+// Probe sources, replaceable in tests.
+var (
+	loadAvgPath    = "/proc/loadavg"
+	ioPressurePath = "/proc/pressure/io"
+	readHealth     = power.ReadHealth
+)
+
+// Allows reports whether every budget currently has room.
+func (b Budget) Allows() bool {
+	if b.MaxLoadPerCPU > 0 {
+		if load, ok := readLoadAvg(); ok && load/float64(runtime.NumCPU()) > b.MaxLoadPerCPU {
+			return false
+		}
+	}
+	health := readHealth()
+	if b.MaxTempC > 0 && health.TempC > b.MaxTempC { // 0 when unknown
+		return false
+	}
+	if b.MaxIOPressure > 0 {
+		if p, ok := readIOPressure(); ok && p > b.MaxIOPressure {
+			return false
+		}
+	}
+	if b.PauseOnThrottle && health.Flags != 0 {
+		return false
+	}
+	return true
+}
+
+func readLoadAvg() (float64, bool) {
+	data, err := os.ReadFile(loadAvgPath)
+	if err != nil {
+		return 0, false
+	}
+	fields := strings.Fields(string(data))
+	if len(fields) == 0 {
+		return 0, false
+	}
+	v, err := strconv.ParseFloat(fields[0], 64)
+	return v, err == nil
+}
+
+// readIOPressure returns avg10 of the "some" line, e.g.
+// "some avg10=1.23 avg60=0.50 avg300=0.10 total=12345".
+func readIOPressure() (float64, bool) {
+	f, err := os.Open(ioPressurePath)
+	if err != nil {
+		return 0, false
+	}
+	defer f.Close()
+	sc := bufio.NewScanner(f)
+	for sc.Scan() {
+		fields := strings.Fields(sc.Text())
+		if len(fields) < 2 || fields[0] != "some" {
+			continue
+		}
+		v, err := strconv.ParseFloat(strings.TrimPrefix(fields[1], "avg10="), 64)
+		return v, err == nil
+	}
+	return 0, false
+}
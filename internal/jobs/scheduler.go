@@ -0,0 +1,384 @@
+// Package jobs runs post-sync background work (offload, space reclaim,
+// compaction, ...) inside the long-running web process.
+//
+// Jobs run one at a time, highest priority first, and only while the Pi has
+// time to spare: nothing runs while a sync is copying flash, light jobs may
+// use the step 9 erase wait, and heavy jobs also need the CPU, thermal and
+// I/O budgets to allow them. A job that loses its window is cancelled and
+// resumed later. The queue is persisted, so pending work survives a reboot.
+package jobs
+
+import (
+	"context"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"log/slog"
+	"os"
+	"sort"
+	"sync"
+	"time"
+)
+
+// Class tells the scheduler how much a job costs.
+type Class int
+
+const (
+	// Light jobs are short and mostly metadata work; they may run during the
+	// FC erase wait.
+	Light Class = iota
+	// Heavy jobs stream data or burn CPU; they need a fully idle Pi and the
+	// resource budgets.
+	Heavy
+)
+
+// Window is how much background work the sync state currently allows.
+type Window int
+
+const (
+	// Closed: a sync is copying or verifying flash; nothing runs.
+	Closed Window = iota
+	// LightOnly: the sync is waiting for the FC to erase its flash.
+	LightOnly
+	// Open: no sync is running.
+	Open
+)
+
+// Spec describes a kind of job.
+type Spec struct {
+	Kind     string
+	Class    Class
+	Priority int // higher runs first
+	// Run does the work. It must return promptly once ctx is cancelled; the
+	// job is then requeued and resumed in the next window.
+	Run func(ctx context.Context, arg string) error
+}
+
+// Job is one queued unit of work.
+type Job struct {
+	ID        string    `json:"id"`
+	Kind      string    `json:"kind"`
+	Arg       string    `json:"arg,omitempty"`
+	Priority  int       `json:"priority"`
+	Enqueued  time.Time `json:"enqueued"`
+	Attempts  int       `json:"attempts"`
+	LastError string    `json:"last_error,omitempty"`
+	NotBefore time.Time `json:"not_before,omitempty"`
+}
+
+const (
+	pollInterval = time.Second
+	maxAttempts  = 5
+	retryBackoff = time.Minute
+)
+
+// Scheduler owns the job queue.
+type Scheduler struct {
+	path   string
+	window func() Window
+	budget Budget
+
+	mu        sync.Mutex
+	specs     map[string]Spec
+	queue     []*Job
+	running   *Job
+	seq       int
+	onSyncEnd []func()
+	wake      chan struct{}
+}
+
+// New returns a scheduler persisting its queue at statePath. window reports
+// the current sync state; it is polled while jobs wait and while they run.
+func New(statePath string, budget Budget, window func() Window) *Scheduler {
+	s := &Scheduler{
+		path:   statePath,
+		window: window,
+		budget: budget,
+		specs:  make(map[string]Spec),
+		wake:   make(chan struct{}, 1),
+	}
+	if err := s.load(); err != nil && !errors.Is(err, os.ErrNotExist) {
+		slog.Warn("job queue state unreadable, starting empty", "path", statePath, "error", err)
+	}
+	return s
+}
+
+// Register adds a job kind. Queued jobs of unknown kinds are kept until their
+// kind is registered.
+func (s *Scheduler) Register(spec Spec) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	s.specs[spec.Kind] = spec
+}
+
+// OnSyncEnd registers fn to run each time the window reopens after a sync,
+// typically to enqueue post-sync jobs.
+func (s *Scheduler) OnSyncEnd(fn func()) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	s.onSyncEnd = append(s.onSyncEnd, fn)
+}
+
+// Enqueue queues a job unless an identical one (same kind and arg) is
+// already waiting.
+func (s *Scheduler) Enqueue(kind, arg string) error {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	spec, ok := s.specs[kind]
+	if !ok {
+		return fmt.Errorf("unknown job kind %q", kind)
+	}
+	for _, j := range s.queue {
+		if j.Kind == kind && j.Arg == arg && j != s.running {
+			return nil
+		}
+	}
+	s.seq++
+	s.queue = append(s.queue, &Job{
+		ID:       fmt.Sprintf("%d-%d", time.Now().Unix(), s.seq),
+		Kind:     kind,
+		Arg:      arg,
+		Priority: spec.Priority,
+		Enqueued: time.Now().UTC(),
+	})
+	s.saveLocked()
+	select {
+	case s.wake <- struct{}{}:
+	default:
+	}
+	return nil
+}
+
+// Snapshot returns the queued jobs in run order (including the running one) and
+// the running job, if any.
+func (s *Scheduler) Snapshot() ([]Job, *Job) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	out := make([]Job, 0, len(s.queue))
+	for _, j := range s.queue {
+		out = append(out, *j)
+	}
+	sort.SliceStable(out, func(a, b int) bool { return out[a].Priority > out[b].Priority })
+	if s.running == nil {
+		return out, nil
+	}
+	r := *s.running
+	return out, &r
+}
+
+// Busy reports whether a job is running.
+func (s *Scheduler) Busy() bool {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	return s.running != nil
+}
+
+// Idle reports whether nothing is running and no job of a registered kind is
+// waiting. Jobs of unknown kinds never run in this process, so they do not
+// count.
+func (s *Scheduler) Idle() bool {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if s.running != nil {
+		return false
+	}
+	for _, j := range s.queue {
+		if _, ok := s.specs[j.Kind]; ok {
+			return false
+		}
+	}
+	return true
+}
+
+// Run executes jobs until ctx is cancelled.
+func (s *Scheduler) Run(ctx context.Context) {
+	ticker := time.NewTicker(pollInterval)
+	defer ticker.Stop()
+	last := s.window()
+	for {
+		w := s.window()
+		if w == Open && last != Open {
+			s.syncEnded()
+		}
+		last = w
+
+		if job, spec, ok := s.next(w); ok {
+			s.runJob(ctx, job, spec)
+			continue
+		}
+		select {
+		case <-ctx.Done():
+			return
+		case <-s.wake:
+		case <-ticker.C:
+		}
+	}
+}
+
+func (s *Scheduler) syncEnded() {
+	s.mu.Lock()
+	hooks := append([]func(){}, s.onSyncEnd...)
+	s.mu.Unlock()
+	for _, fn := range hooks {
+		fn()
+	}
+}
+
+// stillAllowed reports whether a running job of class c may continue in
+// window w. I/O pressure is not rechecked: a running heavy job causes most of
+// it and would otherwise keep pausing itself.
+func (s *Scheduler) stillAllowed(c Class, w Window) bool {
+	switch w {
+	case Open:
+		b := s.budget
+		b.MaxIOPressure = 0
+		return c == Light || b.Allows()
+	case LightOnly:
+		return c == Light
+	default:
+		return false
+	}
+}
+
+// next picks the highest-priority runnable job, oldest first on ties.
+func (s *Scheduler) next(w Window) (*Job, Spec, bool) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if w == Closed {
+		return nil, Spec{}, false
+	}
+	now := time.Now()
+	var (
+		best     *Job
+		bestSpec Spec
+	)
+	heavyOK := w == Open && s.budget.Allows()
+	for _, j := range s.queue {
+		spec, ok := s.specs[j.Kind]
+		if !ok || now.Before(j.NotBefore) {
+			continue
+		}
+		if spec.Class == Heavy && !heavyOK {
+			continue
+		}
+		if best == nil || j.Priority > best.Priority {
+			best, bestSpec = j, spec
+		}
+	}
+	if best == nil {
+		return nil, Spec{}, false
+	}
+	s.running = best
+	return best, bestSpec, true
+}
+
+// runJob runs one job, cancelling it if its window closes or, for heavy jobs,
+// its budget runs out.
+func (s *Scheduler) runJob(ctx context.Context, job *Job, spec Spec) {
+	jctx, cancel := context.WithCancel(ctx)
+	paused := make(chan struct{})
+	go func() {
+		t := time.NewTicker(pollInterval)
+		defer t.Stop()
+		for {
+			select {
+			case <-jctx.Done():
+				return
+			case <-t.C:
+				if !s.stillAllowed(spec.Class, s.window()) {
+					close(paused)
+					cancel()
+					return
+				}
+			}
+		}
+	}()
+
+	started := time.Now()
+	slog.Info("job started", "kind", job.Kind, "arg", job.Arg, "id", job.ID)
+	err := spec.Run(jctx, job.Arg)
+	cancel()
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	s.running = nil
+	select {
+	case <-paused:
+		slog.Info("job paused", "kind", job.Kind, "id", job.ID, "ran_sec", time.Since(started).Seconds())
+		return // stays queued as is
+	default:
+	}
+	if ctx.Err() != nil {
+		return // shutting down; resume after restart
+	}
+	if err != nil {
+		job.Attempts++
+		job.LastError = err.Error()
+		if job.Attempts < maxAttempts {
+			job.NotBefore = time.Now().Add(time.Duration(job.Attempts) * retryBackoff)
+			slog.Warn("job failed, will retry", "kind", job.Kind, "id", job.ID, "attempt", job.Attempts, "error", err)
+			s.saveLocked()
+			return
+		}
+		slog.Error("job failed, giving up", "kind", job.Kind, "id", job.ID, "error", err)
+	} else {
+		slog.Info("job done", "kind", job.Kind, "id", job.ID, "sec", time.Since(started).Seconds())
+	}
+	s.removeLocked(job)
+	s.saveLocked()
+}
+
+func (s *Scheduler) removeLocked(job *Job) {
+	for i, j := range s.queue {
+		if j == job {
+			s.queue = append(s.queue[:i], s.queue[i+1:]...)
+			return
+		}
+	}
+}
+
+type state struct {
+	Seq  int    `json:"seq"`
+	Jobs []*Job `json:"jobs"`
+}
+
+func (s *Scheduler) load() error {
+	data, err := os.ReadFile(s.path)
+	if err != nil {
+		return err
+	}
+	var st state
+	if err := json.Unmarshal(data, &st); err != nil {
+		return err
+	}
+	s.queue, s.seq = st.Jobs, st.Seq
+	return nil
+}
+
+// saveLocked persists the queue with write, fsync and rename so a power cut
+// leaves either the old or the new queue.
+func (s *Scheduler) saveLocked() {
+	data, err := json.Marshal(state{Seq: s.seq, Jobs: s.queue})
+	if err != nil {
+		return
+	}
+	tmp := s.path + ".tmp"
+	f, err := os.OpenFile(tmp, os.O_WRONLY|os.O_CREATE|os.O_TRUNC, 0o644)
+	if err != nil {
+		slog.Warn("saving job queue", "error", err)
+		return
+	}
+	_, err = f.Write(data)
+	if err == nil {
+		err = f.Sync()
+	}
+	if cerr := f.Close(); err == nil {
+		err = cerr
+	}
+	if err == nil {
+		err = os.Rename(tmp, s.path)
+	}
+	if err != nil {
+		slog.Warn("saving job queue", "error", err)
+	}
+}
@@ -0,0 +1,207 @@
+package jobs
+
+import (
+	"context"
+	"os"
+	"path/filepath"
+	gosync "sync"
+	"sync/atomic"
+	"testing"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/power"
+)
+
+// runUntil runs s until cond holds or the deadline passes.
+func runUntil(t *testing.T, s *Scheduler, cond func() bool) {
+	t.Helper()
+	ctx, cancel := context.WithCancel(context.Background())
+	done := make(chan struct{})
+	go func() { s.Run(ctx); close(done) }()
+	deadline := time.Now().Add(5 * time.Second)
+	for !cond() {
+		if time.Now().After(deadline) {
+			cancel()
+			<-done
+			t.Fatal("timed out waiting for scheduler")
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	cancel()
+	<-done
+}
+
+func open() Window { return Open }
+
+func TestPriorityOrder(t *testing.T) {
+	s := New(filepath.Join(t.TempDir(), "jobs.json"), Budget{}, open)
+	var (
+		mu    gosync.Mutex
+		order []string
+	)
+	for kind, prio := range map[string]int{"low": 1, "high": 30, "mid": 10} {
+		kind := kind
+		s.Register(Spec{Kind: kind, Class: Light, Priority: prio, Run: func(context.Context, string) error {
+			mu.Lock()
+			order = append(order, kind)
+			mu.Unlock()
+			return nil
+		}})
+	}
+	for _, k := range []string{"low", "mid", "high"} {
+		if err := s.Enqueue(k, ""); err != nil {
+			t.Fatal(err)
+		}
+	}
+	runUntil(t, s, func() bool { mu.Lock(); defer mu.Unlock(); return len(order) == 3 })
+	if order[0] != "high" || order[1] != "mid" || order[2] != "low" {
+		t.Fatalf("run order = %v, want high, mid, low", order)
+	}
+}
+
+func TestQueueSurvivesRestart(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "jobs.json")
+	s := New(path, Budget{}, open)
+	s.Register(Spec{Kind: "offload", Priority: 5})
+	if err := s.Enqueue("offload", "sess-1"); err != nil {
+		t.Fatal(err)
+	}
+	if err := s.Enqueue("offload", "sess-1"); err != nil {
+		t.Fatal(err)
+	}
+
+	s2 := New(path, Budget{}, open)
+	queued, _ := s2.Snapshot()
+	if len(queued) != 1 || queued[0].Kind != "offload" || queued[0].Arg != "sess-1" {
+		t.Fatalf("queue after restart = %+v, want one deduplicated offload job", queued)
+	}
+}
+
+func TestPausesWhenSyncStarts(t *testing.T) {
+	var window atomic.Int32
+	window.Store(int32(Open))
+	s := New(filepath.Join(t.TempDir(), "jobs.json"), Budget{}, func() Window { return Window(window.Load()) })
+
+	var runs atomic.Int32
+	s.Register(Spec{Kind: "copy", Class: Heavy, Priority: 1, Run: func(ctx context.Context, _ string) error {
+		if runs.Add(1) == 1 {
+			window.Store(int32(Closed)) // a sync starts mid-job
+			<-ctx.Done()
+			return ctx.Err()
+		}
+		return nil
+	}})
+	var ended atomic.Int32
+	s.OnSyncEnd(func() { ended.Add(1) })
+	if err := s.Enqueue("copy", ""); err != nil {
+		t.Fatal(err)
+	}
+
+	pausedAttempts := -1
+	runUntil(t, s, func() bool {
+		queued, running := s.Snapshot()
+		if pausedAttempts < 0 && runs.Load() == 1 && running == nil && len(queued) == 1 {
+			pausedAttempts = queued[0].Attempts
+			window.Store(int32(Open)) // the sync ends
+		}
+		return len(queued) == 0
+	})
+	if pausedAttempts != 0 {
+		t.Errorf("a paused job is not a failure, attempts = %d", pausedAttempts)
+	}
+	if runs.Load() != 2 {
+		t.Errorf("job ran %d times, want resumed once", runs.Load())
+	}
+	if ended.Load() == 0 {
+		t.Error("OnSyncEnd hooks should run when the window reopens")
+	}
+}
+
+func TestEraseWaitRunsOnlyLightJobs(t *testing.T) {
+	s := New(filepath.Join(t.TempDir(), "jobs.json"), Budget{}, func() Window { return LightOnly })
+	var light, heavy atomic.Bool
+	s.Register(Spec{Kind: "index", Class: Light, Run: func(context.Context, string) error { light.Store(true); return nil }})
+	s.Register(Spec{Kind: "offload", Class: Heavy, Priority: 10, Run: func(context.Context, string) error { heavy.Store(true); return nil }})
+	_ = s.Enqueue("offload", "")
+	_ = s.Enqueue("index", "")
+
+	runUntil(t, s, func() bool { return light.Load() })
+	if heavy.Load() {
+		t.Error("heavy job ran during the erase wait")
+	}
+}
+
+func TestFailedJobRetriesLater(t *testing.T) {
+	s := New(filepath.Join(t.TempDir(), "jobs.json"), Budget{}, open)
+	var runs atomic.Int32
+	s.Register(Spec{Kind: "scrub", Run: func(context.Context, string) error {
+		runs.Add(1)
+		return os.ErrPermission
+	}})
+	_ = s.Enqueue("scrub", "")
+
+	runUntil(t, s, func() bool { return runs.Load() == 1 && !s.Busy() })
+	queued, _ := s.Snapshot()
+	if len(queued) != 1 || queued[0].Attempts != 1 || queued[0].LastError == "" {
+		t.Fatalf("queue after failure = %+v, want one job with a recorded error", queued)
+	}
+	if !queued[0].NotBefore.After(time.Now()) {
+		t.Error("failed job should back off before retrying")
+	}
+}
+
+func TestBudgetProbes(t *testing.T) {
+	dir := t.TempDir()
+	write := func(name, data string) string {
+		p := filepath.Join(dir, name)
+		if err := os.WriteFile(p, []byte(data), 0o644); err != nil {
+			t.Fatal(err)
+		}
+		return p
+	}
+	defer func(l, io string, h func() power.Health) {
+		loadAvgPath, ioPressurePath, readHealth = l, io, h
+	}(loadAvgPath, ioPressurePath, readHealth)
+	health := power.Health{TempC: 45, HasFlags: true}
+	readHealth = func() power.Health { return health }
+	loadAvgPath = write("loadavg", "0.10 0.20 0.30 1/100 1234\n")
+	ioPressurePath = write("io", "some avg10=1.50 avg60=0.50 avg300=0.10 total=1\nfull avg10=0.00 avg60=0.00 avg300=0.00 total=0\n")
+
+	if !DefaultBudget.Allows() {
+		t.Fatal("quiet system should be within budget")
+	}
+	health.TempC = 75.5
+	if DefaultBudget.Allows() {
+		t.Error("75.5 °C should exceed the thermal budget")
+	}
+	health.TempC = 45
+	health.Flags = power.UnderVoltage
+	if DefaultBudget.Allows() {
+		t.Error("undervoltage should hold heavy jobs")
+	}
+	health.Flags = 0
+	ioPressurePath = write("io", "some avg10=42.00 avg60=10.00 avg300=1.00 total=1\n")
+	if DefaultBudget.Allows() {
+		t.Error("42% I/O stall should exceed the I/O budget")
+	}
+	ioPressurePath = filepath.Join(dir, "missing")
+	if !DefaultBudget.Allows() {
+		t.Error("a missing probe should not block jobs")
+	}
+}
+
+func TestIdleIgnoresUnknownKinds(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "jobs.json")
+	s := New(path, Budget{}, open)
+	s.Register(Spec{Kind: "compact"})
+	_ = s.Enqueue("compact", "")
+	if s.Idle() {
+		t.Fatal("scheduler with a queued job reported idle")
+	}
+
+	// A process without the compact job (e.g. a directory store) never runs it.
+	s2 := New(path, Budget{}, open)
+	if !s2.Idle() {
+		t.Error("a job of an unregistered kind should not keep the scheduler busy")
+	}
+}
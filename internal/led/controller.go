@@ -1,8 +1,11 @@
 package led
 
 import (
-	"log/slog"
+	"fmt"
 	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
 	"sync"
 	"time"
 )
@@ -36,6 +39,23 @@ type pattern struct {
 	repeat bool
 }
 
+// duration is the length of one pass through the pattern.
+func (p pattern) duration() time.Duration {
+	var ms int
+	for _, s := range p.steps {
+		ms += s.onMs + s.offMs
+	}
+	return time.Duration(ms) * time.Millisecond
+}
+
+// hardwareBlinker is implemented by backends that can hand a blink pattern to
+// the kernel, so no userspace timer runs while it plays. Blink returns false
+// if the pattern cannot be offloaded; the controller then toggles the LED
+// itself. A later Set takes the LED back from the kernel.
+type hardwareBlinker interface {
+	Blink(steps []step, repeat bool) bool
+}
+
 var patterns = map[State]pattern{
 	Off:     {steps: nil, repeat: false},
 	Booting: {steps: []step{{1000, 1000}}, repeat: true},
@@ -82,9 +102,9 @@ func New(backend string, gpioPin int) *Controller {
 	}
 	switch backend {
 	case "gpio":
-		c.backend = &gpioBackend{pin: gpioPin}
+		c.backend = &gpioBackend{chip: gpioChipPath, pin: gpioPin}
 	default:
-		c.backend = &sysfsBackend{}
+		c.backend = &sysfsBackend{dir: sysfsLEDDir}
 	}
 	return c
 }
@@ -168,6 +188,7 @@ func (c *Controller) WaitUntilIdle(timeout time.Duration) bool {
 func (c *Controller) run() {
 	defer close(c.done)
 
+	hw, _ := c.backend.(hardwareBlinker)
 	for {
 		c.mu.Lock()
 		st := c.state
@@ -189,32 +210,23 @@ func (c *Controller) run() {
 			continue
 		}
 
-		interrupted := false
-		for _, s := range pat.steps {
-			c.backend.Set(true)
-			if c.interruptibleSleep(time.Duration(s.onMs) * time.Millisecond) {
-				return
-			}
-			if c.stateChanged() {
-				interrupted = true
-				break
+		if hw != nil && hw.Blink(pat.steps, pat.repeat) {
+			// The kernel plays the pattern; just wait for it to end.
+			if pat.repeat {
+				if c.waitForChangeOrStop() {
+					return
+				}
+				continue
 			}
-
-			c.backend.Set(false)
-			if c.interruptibleSleep(time.Duration(s.offMs) * time.Millisecond) {
+			if c.interruptibleSleep(pat.duration()) {
 				return
 			}
 			if c.stateChanged() {
-				interrupted = true
-				break
+				continue
 			}
-		}
-
-		if interrupted {
-			continue
-		}
-
-		if pat.repeat {
+		} else if done, stop := c.playSteps(pat.steps); stop {
+			return
+		} else if !done || pat.repeat {
 			continue
 		}
 
@@ -230,6 +242,29 @@ func (c *Controller) run() {
 	}
 }
 
+// playSteps toggles the LED through steps once from this goroutine. It
+// reports whether all steps played and whether stop was signaled.
+func (c *Controller) playSteps(steps []step) (done, stop bool) {
+	for _, s := range steps {
+		c.backend.Set(true)
+		if c.interruptibleSleep(time.Duration(s.onMs) * time.Millisecond) {
+			return false, true
+		}
+		if c.stateChanged() {
+			return false, false
+		}
+
+		c.backend.Set(false)
+		if c.interruptibleSleep(time.Duration(s.offMs) * time.Millisecond) {
+			return false, true
+		}
+		if c.stateChanged() {
+			return false, false
+		}
+	}
+	return true, false
+}
+
 // interruptibleSleep waits for duration, but returns early if stop or changed signals.
 // Returns true if stop was signaled (goroutine should exit).
 func (c *Controller) interruptibleSleep(d time.Duration) bool {
@@ -271,43 +306,131 @@ func (c *Controller) waitForChangeOrStop() bool {
 
 // --- sysfs backend ---
 
-const (
-	sysfsLEDBrightness = "/sys/class/leds/led0/brightness"
-	sysfsLEDTrigger    = "/sys/class/leds/led0/trigger"
-)
-
-type sysfsBackend struct{}
+const sysfsLEDDir = "/sys/class/leds/led0"
+
+// gpioChipPath is the GPIO character device holding the header pins on the
+// Pi Zero through Pi 4.
+const gpioChipPath = "/dev/gpiochip0"
+
+// sysfsBackend drives the ACT LED through /sys/class/leds. Blink patterns are
+// offloaded to the kernel timer and pattern triggers when available; manual
+// toggles write through file descriptors kept open for the process lifetime
+// instead of an open/write/close per toggle.
+type sysfsBackend struct {
+	dir        string
+	brightness *os.File
+	trigger    *os.File
+	triggers   map[string]bool // available triggers, read once
+	max        string          // max_brightness, used for pattern levels
+	blinking   bool            // a kernel trigger owns the LED
+}
 
 func (b *sysfsBackend) Set(on bool) {
+	if b.blinking {
+		b.setTrigger("none")
+		b.blinking = false
+	}
 	val := "0"
 	if on {
 		val = "1"
 	}
-	_ = os.WriteFile(sysfsLEDBrightness, []byte(val), 0644)
+	if b.brightness == nil {
+		f, err := os.OpenFile(filepath.Join(b.dir, "brightness"), os.O_WRONLY, 0)
+		if err != nil {
+			return
+		}
+		b.brightness = f
+	}
+	_, _ = b.brightness.WriteAt([]byte(val), 0)
 }
 
 func (b *sysfsBackend) DisableTrigger() {
-	_ = os.WriteFile(sysfsLEDTrigger, []byte("none"), 0644)
+	b.setTrigger("none")
+	b.blinking = false
 }
 
 func (b *sysfsBackend) RestoreTrigger() {
-	_ = os.WriteFile(sysfsLEDTrigger, []byte("mmc0"), 0644)
+	b.setTrigger("mmc0")
+	b.blinking = false
+	for _, f := range []*os.File{b.brightness, b.trigger} {
+		if f != nil {
+			_ = f.Close()
+		}
+	}
+	b.brightness, b.trigger = nil, nil
 }
 
-// --- gpio backend (placeholder) ---
+// Blink maps a single repeating on/off step onto the timer trigger and any
+// other pattern onto the pattern trigger.
+func (b *sysfsBackend) Blink(steps []step, repeat bool) bool {
+	b.loadTriggers()
+	var ok bool
+	switch {
+	case len(steps) == 1 && repeat && b.triggers["timer"]:
+		ok = b.setTrigger("timer") &&
+			b.writeAttr("delay_on", strconv.Itoa(steps[0].onMs)) &&
+			b.writeAttr("delay_off", strconv.Itoa(steps[0].offMs))
+	case b.triggers["pattern"]:
+		count := "1"
+		if repeat {
+			count = "-1"
+		}
+		ok = b.setTrigger("pattern") &&
+			b.writeAttr("repeat", count) &&
+			b.writeAttr("pattern", b.patternSpec(steps))
+	default:
+		return false
+	}
+	b.blinking = true
+	if !ok {
+		b.Set(false)
+	}
+	return ok
+}
 
-type gpioBackend struct {
-	pin int
+// patternSpec renders steps as "level ms level 0 0 ms 0 0 ..." — each level
+// is held for its duration and the zero-length entries make the edges square.
+func (b *sysfsBackend) patternSpec(steps []step) string {
+	var sb strings.Builder
+	for _, s := range steps {
+		fmt.Fprintf(&sb, "%s %d %s 0 0 %d 0 0 ", b.max, s.onMs, b.max, s.offMs)
+	}
+	return strings.TrimSpace(sb.String())
 }
 
-func (b *gpioBackend) Set(on bool) {
-	slog.Debug("gpio: set pin", "pin", b.pin, "on", on)
+// loadTriggers reads the trigger list, e.g. "none [mmc0] timer pattern".
+func (b *sysfsBackend) loadTriggers() {
+	if b.triggers != nil {
+		return
+	}
+	b.triggers = make(map[string]bool)
+	if data, err := os.ReadFile(filepath.Join(b.dir, "trigger")); err == nil {
+		for _, t := range strings.Fields(string(data)) {
+			b.triggers[strings.Trim(t, "[]")] = true
+		}
+	}
+	b.max = "1"
+	if data, err := os.ReadFile(filepath.Join(b.dir, "max_brightness")); err == nil {
+		if v := strings.TrimSpace(string(data)); v != "" && v != "0" {
+			b.max = v
+		}
+	}
 }
 
-func (b *gpioBackend) DisableTrigger() {
-	slog.Debug("gpio: disable trigger")
+func (b *sysfsBackend) setTrigger(name string) bool {
+	if b.trigger == nil {
+		f, err := os.OpenFile(filepath.Join(b.dir, "trigger"), os.O_WRONLY, 0)
+		if err != nil {
+			return false
+		}
+		b.trigger = f
+	}
+	_, err := b.trigger.WriteAt([]byte(name), 0)
+	return err == nil
 }
 
-func (b *gpioBackend) RestoreTrigger() {
-	slog.Debug("gpio: restore trigger")
+// writeAttr writes a trigger attribute. These files only exist while their
+// trigger is active and are written once per state change.
+func (b *sysfsBackend) writeAttr(name, val string) bool {
+	return os.WriteFile(filepath.Join(b.dir, name), []byte(val), 0o644) == nil
 }
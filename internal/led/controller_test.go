@@ -1,6 +1,9 @@
 package led
 
 import (
+	"os"
+	"path/filepath"
+	"strings"
 	"sync"
 	"sync/atomic"
 	"testing"
@@ -204,3 +207,99 @@ func TestNewGPIOBackend(t *testing.T) {
 		t.Fatal("expected gpio backend for 'gpio' argument")
 	}
 }
+
+// blinkerBackend is a mockBackend that accepts kernel blink offload.
+type blinkerBackend struct {
+	mockBackend
+	blinks int64 // atomic
+}
+
+func (b *blinkerBackend) Blink(steps []step, repeat bool) bool {
+	atomic.AddInt64(&b.blinks, 1)
+	return true
+}
+
+func TestHardwareBlinkSkipsToggling(t *testing.T) {
+	hb := &blinkerBackend{}
+	c := NewWithBackend(hb)
+
+	c.Start()
+	defer c.Stop()
+	time.Sleep(50 * time.Millisecond)
+
+	c.SetState(Busy)
+	time.Sleep(500 * time.Millisecond)
+	if got := atomic.LoadInt64(&hb.blinks); got != 1 {
+		t.Fatalf("Blink called %d times, want 1", got)
+	}
+	// Only the initial Off write; Busy must not toggle from userspace.
+	if got := atomic.LoadInt64(&hb.setCount); got > 1 {
+		t.Fatalf("Set called %d times during offloaded Busy", got)
+	}
+
+	c.SetState(Done)
+	if !c.WaitUntilIdle(6 * time.Second) {
+		t.Fatal("expected offloaded Done pattern to signal idle")
+	}
+}
+
+func newFakeLED(t *testing.T, triggers string) *sysfsBackend {
+	t.Helper()
+	dir := t.TempDir()
+	for name, val := range map[string]string{
+		"trigger":        triggers,
+		"brightness":     "0",
+		"max_brightness": "255",
+	} {
+		if err := os.WriteFile(filepath.Join(dir, name), []byte(val), 0o644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	return &sysfsBackend{dir: dir}
+}
+
+// assertWrote checks the last value written to a fake attribute. Unlike
+// sysfs, a regular file keeps the tail of an earlier, longer write, so only
+// the prefix is compared.
+func assertWrote(t *testing.T, b *sysfsBackend, name, want string) {
+	t.Helper()
+	data, err := os.ReadFile(filepath.Join(b.dir, name))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !strings.HasPrefix(string(data), want) {
+		t.Errorf("%s = %q, want %q", name, data, want)
+	}
+}
+
+func TestSysfsTimerTrigger(t *testing.T) {
+	b := newFakeLED(t, "none [mmc0] timer pattern")
+	if !b.Blink(patterns[Busy].steps, true) {
+		t.Fatal("Blink should offload Busy to the timer trigger")
+	}
+	assertWrote(t, b, "trigger", "timer")
+	assertWrote(t, b, "delay_on", "150")
+	assertWrote(t, b, "delay_off", "150")
+
+	// A manual toggle takes the LED back from the kernel.
+	b.Set(true)
+	assertWrote(t, b, "trigger", "none")
+	assertWrote(t, b, "brightness", "1")
+}
+
+func TestSysfsPatternTrigger(t *testing.T) {
+	b := newFakeLED(t, "none [mmc0] timer pattern")
+	if !b.Blink(patterns[Done].steps[4:], false) {
+		t.Fatal("Blink should offload Done to the pattern trigger")
+	}
+	assertWrote(t, b, "trigger", "pattern")
+	assertWrote(t, b, "repeat", "1")
+	assertWrote(t, b, "pattern", "255 50 255 0 0 50 0 0 255 3000 255 0 0 1 0 0")
+}
+
+func TestSysfsNoTriggerFallsBack(t *testing.T) {
+	b := newFakeLED(t, "none [mmc0]")
+	if b.Blink(patterns[Error].steps, true) {
+		t.Fatal("Blink should refuse when no timer or pattern trigger exists")
+	}
+}
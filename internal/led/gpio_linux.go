@@ -0,0 +1,105 @@
+package led
+
+import (
+	"log/slog"
+	"os"
+	"syscall"
+	"unsafe"
+)
+
+// GPIO character device uAPI v2 (linux/gpio.h).
+const (
+	gpioV2LinesMax        = 64
+	gpioMaxNameSize       = 32
+	gpioV2LineNumAttrsMax = 10
+	gpioV2LineFlagOutput  = 1 << 3
+
+	gpioV2GetLineIoctl       = 0xC250B407 // _IOWR(0xB4, 0x07, struct gpio_v2_line_request)
+	gpioV2LineSetValuesIoctl = 0xC010B40F // _IOWR(0xB4, 0x0F, struct gpio_v2_line_values)
+)
+
+type gpioV2LineConfigAttribute struct {
+	id      uint32
+	padding uint32
+	value   uint64
+	mask    uint64
+}
+
+type gpioV2LineConfig struct {
+	flags    uint64
+	numAttrs uint32
+	padding  [5]uint32
+	attrs    [gpioV2LineNumAttrsMax]gpioV2LineConfigAttribute
+}
+
+type gpioV2LineRequest struct {
+	offsets         [gpioV2LinesMax]uint32
+	consumer        [gpioMaxNameSize]byte
+	config          gpioV2LineConfig
+	numLines        uint32
+	eventBufferSize uint32
+	padding         [5]uint32
+	fd              int32
+}
+
+type gpioV2LineValues struct {
+	bits uint64
+	mask uint64
+}
+
+// gpioBackend drives an external LED on one line of a GPIO chip through the
+// character device. The line is requested as an output on first use and the
+// line fd is kept open, so each toggle is a single ioctl.
+type gpioBackend struct {
+	chip string
+	pin  int
+	line *os.File
+}
+
+func (b *gpioBackend) Set(on bool) {
+	if b.line == nil && !b.request() {
+		return
+	}
+	vals := gpioV2LineValues{mask: 1}
+	if on {
+		vals.bits = 1
+	}
+	if _, _, errno := syscall.Syscall(syscall.SYS_IOCTL, b.line.Fd(),
+		gpioV2LineSetValuesIoctl, uintptr(unsafe.Pointer(&vals))); errno != 0 {
+		slog.Debug("gpio: set line", "pin", b.pin, "error", errno)
+	}
+}
+
+// request claims the line as an output, initially off.
+func (b *gpioBackend) request() bool {
+	chip, err := os.OpenFile(b.chip, os.O_RDWR, 0)
+	if err != nil {
+		slog.Warn("gpio: cannot open chip", "chip", b.chip, "error", err)
+		return false
+	}
+	defer chip.Close()
+
+	var req gpioV2LineRequest
+	req.offsets[0] = uint32(b.pin)
+	copy(req.consumer[:], "logfalcon")
+	req.config.flags = gpioV2LineFlagOutput
+	req.numLines = 1
+	if _, _, errno := syscall.Syscall(syscall.SYS_IOCTL, chip.Fd(),
+		gpioV2GetLineIoctl, uintptr(unsafe.Pointer(&req))); errno != 0 {
+		slog.Warn("gpio: cannot request line", "chip", b.chip, "pin", b.pin, "error", errno)
+		return false
+	}
+	b.line = os.NewFile(uintptr(req.fd), "gpio-line")
+	return true
+}
+
+// DisableTrigger is a no-op: GPIO lines have no kernel trigger.
+func (b *gpioBackend) DisableTrigger() {}
+
+// RestoreTrigger releases the line so other tools can use it.
+func (b *gpioBackend) RestoreTrigger() {
+	if b.line != nil {
+		_ = b.line.Close()
+		b.line = nil
+	}
+}
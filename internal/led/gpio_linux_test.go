@@ -0,0 +1,16 @@
+package led
+
+import (
+	"testing"
+	"unsafe"
+)
+
+// The ioctl numbers encode the kernel struct sizes; the Go mirrors must match.
+func TestGPIOUAPILayout(t *testing.T) {
+	if got := unsafe.Sizeof(gpioV2LineRequest{}); got != 592 {
+		t.Errorf("sizeof(gpio_v2_line_request) = %d, want 592", got)
+	}
+	if got := unsafe.Sizeof(gpioV2LineValues{}); got != 16 {
+		t.Errorf("sizeof(gpio_v2_line_values) = %d, want 16", got)
+	}
+}
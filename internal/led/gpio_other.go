@@ -0,0 +1,19 @@
+//go:build !linux
+
+package led
+
+import "log/slog"
+
+// gpioBackend only logs outside Linux, which has no GPIO character device.
+type gpioBackend struct {
+	chip string
+	pin  int
+}
+
+func (b *gpioBackend) Set(on bool) {
+	slog.Debug("gpio: set pin", "pin", b.pin, "on", on)
+}
+
+func (b *gpioBackend) DisableTrigger() {}
+
+func (b *gpioBackend) RestoreTrigger() {}
@@ -39,23 +39,41 @@ type DataflashSummary struct {
 	Ready     bool
 }
 
+// readBufSize is the size of the client's serial read buffer.
+const readBufSize = 4096
+
+// flashReadPayloadSize is the MSP_DATAFLASH_READ request payload:
+// address(4) + size(2) + compression flag(1).
+const flashReadPayloadSize = 7
+
 // Client is a synchronous MSP client wrapping a serial port.
+//
+// The flash read path (SendFlashReadRequest / ReceiveFlashReadResponse) reuses
+// the client's buffers and does not allocate once warmed up.
 type Client struct {
 	port      SerialPort
 	decoder   *FrameDecoder
-	pending   map[uint16]*Frame
+	pending   map[uint16]Frame
 	timeout   time.Duration
 	FCVariant string // "BTFL" or "INAV", set after detection
+
+	readBuf   []byte
+	flashReq  [MSPV2Overhead + flashReadPayloadSize]byte // encoded request template
+	held      []byte                                     // payload behind the last flash chunk
+	decodeBuf []byte                                     // Huffman output
 }
 
 // NewClient creates a Client with the given serial port and response timeout.
 func NewClient(port SerialPort, timeout time.Duration) *Client {
-	return &Client{
+	c := &Client{
 		port:    port,
 		decoder: NewFrameDecoder(),
-		pending: make(map[uint16]*Frame),
+		pending: make(map[uint16]Frame),
 		timeout: timeout,
+		readBuf: make([]byte, readBufSize),
 	}
+	copy(c.flashReq[:], EncodeV2(MSPDataflashRead, make([]byte, flashReadPayloadSize)))
+	return c
 }
 
 // Send encodes and writes an MSP v1 request frame to the serial port.
@@ -76,6 +94,14 @@ func (c *Client) SendV2(code uint16, payload []byte) error {
 // Receive blocks until a response frame with the given code arrives or the
 // timeout expires. Decoded frames for other codes are buffered in pending.
 func (c *Client) Receive(code uint16) (*Frame, error) {
+	f, err := c.receive(code)
+	if err != nil {
+		return nil, err
+	}
+	return &f, nil
+}
+
+func (c *Client) receive(code uint16) (Frame, error) {
 	// Check pending buffer first.
 	if f, ok := c.pending[code]; ok {
 		delete(c.pending, code)
@@ -83,24 +109,29 @@ func (c *Client) Receive(code uint16) (*Frame, error) {
 	}
 
 	deadline := time.Now().Add(c.timeout)
-	buf := make([]byte, 4096)
 
 	for time.Now().Before(deadline) {
-		n, err := c.port.Read(buf)
+		n, err := c.port.Read(c.readBuf)
 		if err != nil && err != io.EOF {
-			return nil, &Error{Message: fmt.Sprintf("read error: %v", err)}
+			return Frame{}, &Error{Message: fmt.Sprintf("read error: %v", err)}
 		}
 		if n > 0 {
-			c.decoder.Feed(buf[:n])
+			c.decoder.Feed(c.readBuf[:n])
 		}
 
-		// Drain decoded frames into the pending map.
+		// Drain decoded frames into the pending map. A newer frame replaces
+		// an unclaimed older one with the same code.
 		for _, f := range c.decoder.Frames {
-			if f.Direction == MSPDirectionFromFC {
-				fc := f // copy
-				c.pending[f.Code] = &fc
+			if f.Direction != MSPDirectionFromFC {
+				c.decoder.Recycle(f.Payload)
+				continue
 			}
+			if old, ok := c.pending[f.Code]; ok {
+				c.decoder.Recycle(old.Payload)
+			}
+			c.pending[f.Code] = f
 		}
+		clear(c.decoder.Frames)
 		c.decoder.Frames = c.decoder.Frames[:0]
 
 		// Check if our target arrived.
@@ -110,7 +141,7 @@ func (c *Client) Receive(code uint16) (*Frame, error) {
 		}
 	}
 
-	return nil, &TimeoutError{Message: fmt.Sprintf("timeout waiting for MSP code %d", code)}
+	return Frame{}, &TimeoutError{Message: fmt.Sprintf("timeout waiting for MSP code %d", code)}
 }
 
 // Request sends a command and waits for the matching response.
@@ -122,6 +153,17 @@ func (c *Client) Request(code byte, payload []byte) (*Frame, error) {
 	return c.Receive(uint16(code))
 }
 
+// TakeFrame returns a frame for code that has already been received, without
+// reading the port. The caller owns the returned payload.
+func (c *Client) TakeFrame(code uint16) (*Frame, bool) {
+	f, ok := c.pending[code]
+	if !ok {
+		return nil, false
+	}
+	delete(c.pending, code)
+	return &f, true
+}
+
 // FlushFrames removes any buffered frames for the given code.
 func (c *Client) FlushFrames(code uint16) {
 	delete(c.pending, code)
@@ -221,21 +263,34 @@ func (c *Client) SendFlashReadRequest(address uint32, size uint16, compression b
 	if compression {
 		comprFlag = 1
 	}
-	payload := make([]byte, 7)
+	// Patch the pre-encoded request in place: the header (8 bytes) never
+	// changes, only the payload and its CRC do.
+	req := c.flashReq[:]
+	payload := req[8 : 8+flashReadPayloadSize]
 	binary.LittleEndian.PutUint32(payload[0:4], address)
 	binary.LittleEndian.PutUint16(payload[4:6], size)
 	payload[6] = comprFlag
-	return c.SendV2(MSPDataflashRead, payload)
+	req[len(req)-1] = CRC8DVBS2(req[3:len(req)-1], 0)
+	_, err := c.port.Write(req)
+	return err
 }
 
 // ReceiveFlashReadResponse reads and parses the next MSP_DATAFLASH_READ response.
 // Parsing is variant-aware: Betaflight includes length/compression headers,
 // while iNav sends raw data after the address.
+//
+// data points into the client's buffers and is only valid until the next
+// ReceiveFlashReadResponse call; callers hand it to a writer that copies it.
 func (c *Client) ReceiveFlashReadResponse() (address uint32, data []byte, err error) {
-	f, err := c.Receive(MSPDataflashRead)
+	if c.held != nil {
+		c.decoder.Recycle(c.held)
+		c.held = nil
+	}
+	f, err := c.receive(MSPDataflashRead)
 	if err != nil {
 		return 0, nil, err
 	}
+	c.held = f.Payload
 	p := f.Payload
 	if len(p) < 4 {
 		return 0, nil, &Error{Message: "MSP_DATAFLASH_READ payload too short"}
@@ -260,10 +315,11 @@ func (c *Client) ReceiveFlashReadResponse() (address uint32, data []byte, err er
 				return address, nil, &Error{Message: "huffman data too short for char count"}
 			}
 			charCount := int(binary.LittleEndian.Uint16(raw[0:2]))
-			decoded, decErr := HuffmanDecode(raw[2:], charCount)
+			decoded, decErr := huffmanDecodeInto(c.decodeBuf[:0], raw[2:], charCount)
 			if decErr != nil {
 				return address, nil, &Error{Message: fmt.Sprintf("huffman decode: %v", decErr)}
 			}
+			c.decodeBuf = decoded
 			data = decoded
 		} else {
 			data = raw
@@ -286,5 +342,20 @@ func (c *Client) ReadFlashChunk(address uint32, size uint16, compression bool) (
 
 // EraseFlash sends MSP_DATAFLASH_ERASE (fire-and-forget, no response expected).
 func (c *Client) EraseFlash() error {
-	return c.Send(MSPDataflashErase, nil)
+	if err := c.Send(MSPDataflashErase, nil); err != nil {
+		return err
+	}
+	// Nothing is read right after an erase; push it out of a batching port.
+	return c.Flush()
+}
+
+// Flush pushes requests held back by a batching port (see Flusher) onto the
+// wire. Callers that send a request and then do other work before reading
+// its answer call it so the FC starts on the request at once. It is a no-op
+// on ports that write immediately.
+func (c *Client) Flush() error {
+	if f, ok := c.port.(Flusher); ok {
+		return f.Flush()
+	}
+	return nil
 }
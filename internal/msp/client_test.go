@@ -178,3 +178,83 @@ func TestTimeout(t *testing.T) {
 		t.Fatalf("expected *TimeoutError, got %T: %v", err, err)
 	}
 }
+
+// flashFC answers every MSP_DATAFLASH_READ request with a prebuilt V2 frame,
+// without allocating, so allocation tests measure only the client.
+type flashFC struct {
+	resp []byte
+	pos  int
+}
+
+func (f *flashFC) Write(data []byte) (int, error) { f.pos = 0; return len(data), nil }
+func (f *flashFC) Read(buf []byte) (int, error) {
+	n := copy(buf, f.resp[f.pos:])
+	f.pos += n
+	return n, nil
+}
+func (f *flashFC) Close() error { return nil }
+
+func btflFlashResponse(compression byte, data []byte) []byte {
+	payload := make([]byte, 7+len(data))
+	binary.LittleEndian.PutUint16(payload[4:6], uint16(len(data)))
+	payload[6] = compression
+	copy(payload[7:], data)
+	resp := EncodeV2(MSPDataflashRead, payload)
+	resp[2] = '>'
+	return resp
+}
+
+func TestSendFlashReadRequestMatchesEncodeV2(t *testing.T) {
+	c, ms := newTestClient(nil)
+	c.FCVariant = BTFLVariant
+	for _, tc := range []struct {
+		addr  uint32
+		size  uint16
+		compr bool
+	}{{0, 4096, true}, {0x12345678, 17, false}, {0xfffffff0, 1, true}} {
+		ms.writeBuf.Reset()
+		if err := c.SendFlashReadRequest(tc.addr, tc.size, tc.compr); err != nil {
+			t.Fatal(err)
+		}
+		payload := make([]byte, 7)
+		binary.LittleEndian.PutUint32(payload[0:4], tc.addr)
+		binary.LittleEndian.PutUint16(payload[4:6], tc.size)
+		if tc.compr {
+			payload[6] = 1
+		}
+		if want := EncodeV2(MSPDataflashRead, payload); !bytes.Equal(ms.writeBuf.Bytes(), want) {
+			t.Errorf("request % x, want % x", ms.writeBuf.Bytes(), want)
+		}
+	}
+}
+
+func TestFlashReadLoopAllocs(t *testing.T) {
+	chunk := bytes.Repeat([]byte("blackbox"), 512) // 4 KB, like a real chunk
+	for _, tc := range []struct {
+		name string
+		resp []byte
+		want int
+	}{
+		{"raw", btflFlashResponse(DataflashCompressionNone, chunk), len(chunk)},
+		{"huffman", btflFlashResponse(DataflashCompressionHuffman,
+			append([]byte{byte(len(chunk)), byte(len(chunk) >> 8)}, encodeHuffman(chunk)...)), len(chunk)},
+	} {
+		t.Run(tc.name, func(t *testing.T) {
+			c := NewClient(&flashFC{resp: tc.resp}, time.Second)
+			c.FCVariant = BTFLVariant
+			cycle := func() {
+				if err := c.SendFlashReadRequest(0, 4096, true); err != nil {
+					t.Fatal(err)
+				}
+				_, data, err := c.ReceiveFlashReadResponse()
+				if err != nil || len(data) != tc.want {
+					t.Fatalf("got %d bytes, err %v", len(data), err)
+				}
+			}
+			cycle() // warm up the buffer pool
+			if allocs := testing.AllocsPerRun(100, cycle); allocs != 0 {
+				t.Errorf("flash read cycle allocates %.1f times, want 0", allocs)
+			}
+		})
+	}
+}
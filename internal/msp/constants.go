@@ -26,6 +26,9 @@ const (
 	MSPFCVersion        = 3
 	MSPBoardInfo        = 4
 	MSPBuildInfo        = 5
+	MSPName             = 10
+	MSPStatus           = 101
+	MSPAnalog           = 110
 	MSPUID              = 160
 	MSPBlackboxConfig   = 80
 	MSPDataflashSummary = 70
@@ -54,7 +54,14 @@ const (
 	stateV2Checksum
 )
 
+// maxFreePayloads bounds the decoder's pool of recycled payload buffers.
+const maxFreePayloads = 8
+
 // FrameDecoder is a streaming MSP frame decoder implementing a 14-state machine.
+//
+// Payloads are decoded straight into buffers from a small pool and handed
+// over with the frame. Consumers that are done with a payload may give it
+// back with Recycle, which makes a steady stream of frames allocation-free.
 type FrameDecoder struct {
 	Frames     []Frame
 	state      int
@@ -64,8 +71,8 @@ type FrameDecoder struct {
 	size       int
 	payload    []byte
 	payloadIdx int
-	checksum   byte   // running XOR for v1
-	v2Header   []byte // accumulated V2 header bytes for batch CRC
+	checksum   byte // running XOR for v1, running CRC8-DVB-S2 for v2
+	free       [][]byte
 }
 
 // NewFrameDecoder returns a FrameDecoder in the idle state.
@@ -80,7 +87,41 @@ func (d *FrameDecoder) Feed(data []byte) {
 	}
 }
 
+// Recycle returns a frame payload to the decoder for reuse. The caller must
+// not touch p afterwards.
+func (d *FrameDecoder) Recycle(p []byte) {
+	if cap(p) > 0 && len(d.free) < maxFreePayloads {
+		d.free = append(d.free, p[:0])
+	}
+}
+
+// takePayload returns a pooled buffer of length n.
+func (d *FrameDecoder) takePayload(n int) []byte {
+	for i := len(d.free) - 1; i >= 0; i-- {
+		if b := d.free[i]; cap(b) >= n {
+			d.free[i] = d.free[len(d.free)-1]
+			d.free = d.free[:len(d.free)-1]
+			return b[:n]
+		}
+	}
+	return make([]byte, n)
+}
+
+// emit hands the current payload over with a completed frame.
+func (d *FrameDecoder) emit() {
+	d.Frames = append(d.Frames, Frame{
+		Version:   d.version,
+		Direction: d.direction,
+		Code:      d.code,
+		Payload:   d.payload,
+	})
+	d.payload = nil
+}
+
 func (d *FrameDecoder) reset() {
+	if d.payload != nil {
+		d.Recycle(d.payload)
+	}
 	d.state = stateIdle
 	d.version = 0
 	d.direction = 0
@@ -89,7 +130,6 @@ func (d *FrameDecoder) reset() {
 	d.payload = nil
 	d.payloadIdx = 0
 	d.checksum = 0
-	d.v2Header = nil
 }
 
 func (d *FrameDecoder) process(b byte) {
@@ -135,7 +175,7 @@ func (d *FrameDecoder) process(b byte) {
 		if d.size == 0 {
 			d.state = stateV1Checksum
 		} else {
-			d.payload = make([]byte, d.size)
+			d.payload = d.takePayload(d.size)
 			d.payloadIdx = 0
 			d.state = stateV1Payload
 		}
@@ -150,44 +190,37 @@ func (d *FrameDecoder) process(b byte) {
 
 	case stateV1Checksum:
 		if b == d.checksum {
-			pl := make([]byte, len(d.payload))
-			copy(pl, d.payload)
-			d.Frames = append(d.Frames, Frame{
-				Version:   1,
-				Direction: d.direction,
-				Code:      d.code,
-				Payload:   pl,
-			})
+			d.emit()
 		}
 		d.reset()
 
 	// --- V2 path ---
 	case stateV2Flag:
-		d.v2Header = []byte{b}
+		d.checksum = crc8Table[b]
 		d.state = stateV2CodeLo
 
 	case stateV2CodeLo:
 		d.code = uint16(b)
-		d.v2Header = append(d.v2Header, b)
+		d.checksum = crc8Table[d.checksum^b]
 		d.state = stateV2CodeHi
 
 	case stateV2CodeHi:
 		d.code |= uint16(b) << 8
-		d.v2Header = append(d.v2Header, b)
+		d.checksum = crc8Table[d.checksum^b]
 		d.state = stateV2LenLo
 
 	case stateV2LenLo:
 		d.size = int(b)
-		d.v2Header = append(d.v2Header, b)
+		d.checksum = crc8Table[d.checksum^b]
 		d.state = stateV2LenHi
 
 	case stateV2LenHi:
 		d.size |= int(b) << 8
-		d.v2Header = append(d.v2Header, b)
+		d.checksum = crc8Table[d.checksum^b]
 		if d.size == 0 {
 			d.state = stateV2Checksum
 		} else {
-			d.payload = make([]byte, d.size)
+			d.payload = d.takePayload(d.size)
 			d.payloadIdx = 0
 			d.state = stateV2Payload
 		}
@@ -195,21 +228,14 @@ func (d *FrameDecoder) process(b byte) {
 	case stateV2Payload:
 		d.payload[d.payloadIdx] = b
 		d.payloadIdx++
+		d.checksum = crc8Table[d.checksum^b]
 		if d.payloadIdx == d.size {
 			d.state = stateV2Checksum
 		}
 
 	case stateV2Checksum:
-		expected := CRC8DVBS2(d.payload, CRC8DVBS2(d.v2Header, 0))
-		if b == expected {
-			pl := make([]byte, len(d.payload))
-			copy(pl, d.payload)
-			d.Frames = append(d.Frames, Frame{
-				Version:   2,
-				Direction: d.direction,
-				Code:      d.code,
-				Payload:   pl,
-			})
+		if b == d.checksum {
+			d.emit()
 		}
 		d.reset()
 	}
@@ -173,3 +173,33 @@ func TestDecodeFragmented(t *testing.T) {
 		t.Fatalf("unexpected payload: %v", dec.Frames[0].Payload)
 	}
 }
+
+func TestFrameDecoderRecyclesPayloads(t *testing.T) {
+	frame := EncodeV2(MSPDataflashRead, bytes.Repeat([]byte{0xab}, 300))
+	dec := NewFrameDecoder()
+	dec.Feed(frame)
+	if len(dec.Frames) != 1 {
+		t.Fatalf("got %d frames, want 1", len(dec.Frames))
+	}
+	first := dec.Frames[0].Payload
+	dec.Recycle(first)
+	dec.Frames = dec.Frames[:0]
+
+	dec.Feed(frame)
+	if len(dec.Frames) != 1 || &dec.Frames[0].Payload[0] != &first[0] {
+		t.Fatal("recycled payload buffer was not reused")
+	}
+	if !bytes.Equal(dec.Frames[0].Payload, bytes.Repeat([]byte{0xab}, 300)) {
+		t.Fatal("payload corrupted")
+	}
+
+	// A frame failing its checksum gives its buffer back.
+	bad := append([]byte(nil), frame...)
+	bad[len(bad)-1] ^= 0xff
+	dec.Recycle(dec.Frames[0].Payload)
+	dec.Frames = dec.Frames[:0]
+	dec.Feed(bad)
+	if len(dec.Frames) != 0 || len(dec.free) != 1 {
+		t.Fatalf("frames=%d free=%d after a bad frame, want 0 and 1", len(dec.Frames), len(dec.free))
+	}
+}
@@ -0,0 +1,395 @@
+//go:build ignore
+
+// gen_tables.go writes tables_gen.go: the MSP v2 CRC table and the
+// Huffman decode tables, computed here once instead of in init() on every
+// start of the binary. Run it with `go generate ./internal/msp`.
+package main
+
+import (
+	"bytes"
+	"fmt"
+	"go/format"
+	"log"
+	"os"
+	"sort"
+)
+
+const (
+	huffmanEOF = -1
+	maxCodeLen = 12
+	crcPoly    = 0xD5 // CRC8-DVB-S2
+)
+
+type huffmanEntry struct {
+	Value   int
+	CodeLen int
+	Code    int
+}
+
+// rawTree is the complete 257-entry Huffman tree from the Betaflight configurator.
+// Ported from betaflight-configurator/src/js/default_huffman_tree.js.
+// Each entry: {value, codeLen, code}. The code is the MSB-first bit pattern.
+var rawTree = []huffmanEntry{
+	{0x00, 2, 0x0003},        //  11
+	{0x01, 3, 0x0005},        //  101
+	{0x02, 4, 0x0009},        //  1001
+	{0x03, 5, 0x0011},        //  10001
+	{0x04, 5, 0x0010},        //  10000
+	{0x50, 5, 0x000f},        //  01111
+	{0x05, 6, 0x001d},        //  011101
+	{0x06, 6, 0x001c},        //  011100
+	{0x07, 6, 0x001b},        //  011011
+	{0x08, 6, 0x001a},        //  011010
+	{0x10, 6, 0x0019},        //  011001
+	{0x09, 7, 0x0031},        //  0110001
+	{0x0a, 7, 0x0030},        //  0110000
+	{0x0b, 7, 0x002f},        //  0101111
+	{0x0c, 7, 0x002e},        //  0101110
+	{0x0d, 7, 0x002d},        //  0101101
+	{0x0e, 7, 0x002c},        //  0101100
+	{0x0f, 7, 0x002b},        //  0101011
+	{0x11, 7, 0x002a},        //  0101010
+	{0x12, 7, 0x0029},        //  0101001
+	{0x13, 8, 0x0051},        //  01010001
+	{0x14, 8, 0x0050},        //  01010000
+	{0x15, 8, 0x004f},        //  01001111
+	{0x16, 8, 0x004e},        //  01001110
+	{0x17, 8, 0x004d},        //  01001101
+	{0x18, 8, 0x004c},        //  01001100
+	{0x19, 8, 0x004b},        //  01001011
+	{0x1a, 8, 0x004a},        //  01001010
+	{0x1b, 8, 0x0049},        //  01001001
+	{0x1c, 8, 0x0048},        //  01001000
+	{0x1d, 8, 0x0047},        //  01000111
+	{0x1e, 8, 0x0046},        //  01000110
+	{0x1f, 8, 0x0045},        //  01000101
+	{0x20, 8, 0x0044},        //  01000100
+	{0x21, 8, 0x0043},        //  01000011
+	{0x22, 8, 0x0042},        //  01000010
+	{0x23, 8, 0x0041},        //  01000001
+	{0x24, 8, 0x0040},        //  01000000
+	{0x30, 8, 0x003f},        //  00111111
+	{0x40, 8, 0x003e},        //  00111110
+	{0xf0, 8, 0x003d},        //  00111101
+	{0x25, 9, 0x0079},        //  001111001
+	{0x26, 9, 0x0078},        //  001111000
+	{0x27, 9, 0x0077},        //  001110111
+	{0x28, 9, 0x0076},        //  001110110
+	{0x29, 9, 0x0075},        //  001110101
+	{0x2a, 9, 0x0074},        //  001110100
+	{0x2b, 9, 0x0073},        //  001110011
+	{0x2c, 9, 0x0072},        //  001110010
+	{0x2d, 9, 0x0071},        //  001110001
+	{0x2e, 9, 0x0070},        //  001110000
+	{0x2f, 9, 0x006f},        //  001101111
+	{0x31, 9, 0x006e},        //  001101110
+	{0x32, 9, 0x006d},        //  001101101
+	{0x33, 9, 0x006c},        //  001101100
+	{0x34, 9, 0x006b},        //  001101011
+	{0x35, 9, 0x006a},        //  001101010
+	{0x36, 9, 0x0069},        //  001101001
+	{0x37, 9, 0x0068},        //  001101000
+	{0x38, 9, 0x0067},        //  001100111
+	{0x39, 9, 0x0066},        //  001100110
+	{0x3a, 9, 0x0065},        //  001100101
+	{0x3b, 9, 0x0064},        //  001100100
+	{0x3c, 9, 0x0063},        //  001100011
+	{0x3d, 9, 0x0062},        //  001100010
+	{0x3e, 9, 0x0061},        //  001100001
+	{0x3f, 9, 0x0060},        //  001100000
+	{0x41, 9, 0x005f},        //  001011111
+	{0x42, 9, 0x005e},        //  001011110
+	{0x43, 9, 0x005d},        //  001011101
+	{0x44, 9, 0x005c},        //  001011100
+	{0x45, 9, 0x005b},        //  001011011
+	{0x46, 9, 0x005a},        //  001011010
+	{0x47, 9, 0x0059},        //  001011001
+	{0x48, 9, 0x0058},        //  001011000
+	{0x49, 9, 0x0057},        //  001010111
+	{0x4c, 9, 0x0056},        //  001010110
+	{0x4f, 9, 0x0055},        //  001010101
+	{0x51, 9, 0x0054},        //  001010100
+	{0x80, 9, 0x0053},        //  001010011
+	{0xe0, 9, 0x0052},        //  001010010
+	{0xf1, 9, 0x0051},        //  001010001
+	{0xff, 9, 0x0050},        //  001010000
+	{0x4a, 10, 0x009f},       //  0010011111
+	{0x4b, 10, 0x009e},       //  0010011110
+	{0x4d, 10, 0x009d},       //  0010011101
+	{0x4e, 10, 0x009c},       //  0010011100
+	{0x52, 10, 0x009b},       //  0010011011
+	{0x53, 10, 0x009a},       //  0010011010
+	{0x54, 10, 0x0099},       //  0010011001
+	{0x55, 10, 0x0098},       //  0010011000
+	{0x56, 10, 0x0097},       //  0010010111
+	{0x57, 10, 0x0096},       //  0010010110
+	{0x58, 10, 0x0095},       //  0010010101
+	{0x59, 10, 0x0094},       //  0010010100
+	{0x5a, 10, 0x0093},       //  0010010011
+	{0x5b, 10, 0x0092},       //  0010010010
+	{0x5c, 10, 0x0091},       //  0010010001
+	{0x5d, 10, 0x0090},       //  0010010000
+	{0x5e, 10, 0x008f},       //  0010001111
+	{0x5f, 10, 0x008e},       //  0010001110
+	{0x60, 10, 0x008d},       //  0010001101
+	{0x61, 10, 0x008c},       //  0010001100
+	{0x62, 10, 0x008b},       //  0010001011
+	{0x63, 10, 0x008a},       //  0010001010
+	{0x64, 10, 0x0089},       //  0010001001
+	{0x65, 10, 0x0088},       //  0010001000
+	{0x66, 10, 0x0087},       //  0010000111
+	{0x67, 10, 0x0086},       //  0010000110
+	{0x68, 10, 0x0085},       //  0010000101
+	{0x69, 10, 0x0084},       //  0010000100
+	{0x6a, 10, 0x0083},       //  0010000011
+	{0x6b, 10, 0x0082},       //  0010000010
+	{0x6c, 10, 0x0081},       //  0010000001
+	{0x6d, 10, 0x0080},       //  0010000000
+	{0x6e, 10, 0x007f},       //  0001111111
+	{0x6f, 10, 0x007e},       //  0001111110
+	{0x70, 10, 0x007d},       //  0001111101
+	{0x71, 10, 0x007c},       //  0001111100
+	{0x72, 10, 0x007b},       //  0001111011
+	{0x73, 10, 0x007a},       //  0001111010
+	{0x74, 10, 0x0079},       //  0001111001
+	{0x75, 10, 0x0078},       //  0001111000
+	{0x76, 10, 0x0077},       //  0001110111
+	{0x77, 10, 0x0076},       //  0001110110
+	{0x78, 10, 0x0075},       //  0001110101
+	{0x79, 10, 0x0074},       //  0001110100
+	{0x7a, 10, 0x0073},       //  0001110011
+	{0x7b, 10, 0x0072},       //  0001110010
+	{0x7c, 10, 0x0071},       //  0001110001
+	{0x7d, 10, 0x0070},       //  0001110000
+	{0x7e, 10, 0x006f},       //  0001101111
+	{0x7f, 10, 0x006e},       //  0001101110
+	{0x81, 10, 0x006d},       //  0001101101
+	{0x82, 10, 0x006c},       //  0001101100
+	{0x83, 10, 0x006b},       //  0001101011
+	{0x84, 10, 0x006a},       //  0001101010
+	{0x85, 10, 0x0069},       //  0001101001
+	{0x86, 10, 0x0068},       //  0001101000
+	{0x87, 10, 0x0067},       //  0001100111
+	{0x88, 10, 0x0066},       //  0001100110
+	{0x89, 10, 0x0065},       //  0001100101
+	{0x8a, 10, 0x0064},       //  0001100100
+	{0x8b, 10, 0x0063},       //  0001100011
+	{0x8c, 10, 0x0062},       //  0001100010
+	{0x8d, 10, 0x0061},       //  0001100001
+	{0x8e, 10, 0x0060},       //  0001100000
+	{0x8f, 10, 0x005f},       //  0001011111
+	{0x90, 10, 0x005e},       //  0001011110
+	{0x91, 10, 0x005d},       //  0001011101
+	{0x92, 10, 0x005c},       //  0001011100
+	{0x93, 10, 0x005b},       //  0001011011
+	{0x94, 10, 0x005a},       //  0001011010
+	{0x95, 10, 0x0059},       //  0001011001
+	{0x96, 10, 0x0058},       //  0001011000
+	{0x97, 10, 0x0057},       //  0001010111
+	{0x98, 10, 0x0056},       //  0001010110
+	{0x99, 10, 0x0055},       //  0001010101
+	{0x9a, 10, 0x0054},       //  0001010100
+	{0x9b, 10, 0x0053},       //  0001010011
+	{0x9c, 10, 0x0052},       //  0001010010
+	{0x9d, 10, 0x0051},       //  0001010001
+	{0x9e, 10, 0x0050},       //  0001010000
+	{0x9f, 10, 0x004f},       //  0001001111
+	{0xa0, 10, 0x004e},       //  0001001110
+	{0xa1, 10, 0x004d},       //  0001001101
+	{0xa2, 10, 0x004c},       //  0001001100
+	{0xa3, 10, 0x004b},       //  0001001011
+	{0xa4, 10, 0x004a},       //  0001001010
+	{0xa5, 10, 0x0049},       //  0001001001
+	{0xa6, 10, 0x0048},       //  0001001000
+	{0xa7, 10, 0x0047},       //  0001000111
+	{0xa8, 10, 0x0046},       //  0001000110
+	{0xa9, 10, 0x0045},       //  0001000101
+	{0xaa, 10, 0x0044},       //  0001000100
+	{0xab, 10, 0x0043},       //  0001000011
+	{0xac, 10, 0x0042},       //  0001000010
+	{0xad, 10, 0x0041},       //  0001000001
+	{0xae, 10, 0x0040},       //  0001000000
+	{0xaf, 10, 0x003f},       //  0000111111
+	{0xb0, 10, 0x003e},       //  0000111110
+	{0xb1, 10, 0x003d},       //  0000111101
+	{0xb2, 10, 0x003c},       //  0000111100
+	{0xb3, 10, 0x003b},       //  0000111011
+	{0xb4, 10, 0x003a},       //  0000111010
+	{0xb5, 10, 0x0039},       //  0000111001
+	{0xb6, 10, 0x0038},       //  0000111000
+	{0xb7, 10, 0x0037},       //  0000110111
+	{0xb8, 10, 0x0036},       //  0000110110
+	{0xb9, 10, 0x0035},       //  0000110101
+	{0xba, 10, 0x0034},       //  0000110100
+	{0xbb, 10, 0x0033},       //  0000110011
+	{0xbc, 10, 0x0032},       //  0000110010
+	{0xbd, 10, 0x0031},       //  0000110001
+	{0xbe, 10, 0x0030},       //  0000110000
+	{0xbf, 10, 0x002f},       //  0000101111
+	{0xc0, 10, 0x002e},       //  0000101110
+	{0xc1, 10, 0x002d},       //  0000101101
+	{0xc2, 10, 0x002c},       //  0000101100
+	{0xc3, 10, 0x002b},       //  0000101011
+	{0xc4, 10, 0x002a},       //  0000101010
+	{0xc5, 10, 0x0029},       //  0000101001
+	{0xc6, 10, 0x0028},       //  0000101000
+	{0xc7, 10, 0x0027},       //  0000100111
+	{0xc8, 10, 0x0026},       //  0000100110
+	{0xc9, 10, 0x0025},       //  0000100101
+	{0xca, 10, 0x0024},       //  0000100100
+	{0xcb, 10, 0x0023},       //  0000100011
+	{0xcc, 10, 0x0022},       //  0000100010
+	{0xcd, 10, 0x0021},       //  0000100001
+	{0xce, 10, 0x0020},       //  0000100000
+	{0xcf, 10, 0x001f},       //  0000011111
+	{0xd0, 10, 0x001e},       //  0000011110
+	{0xd1, 10, 0x001d},       //  0000011101
+	{0xd2, 10, 0x001c},       //  0000011100
+	{0xd3, 10, 0x001b},       //  0000011011
+	{0xd4, 10, 0x001a},       //  0000011010
+	{0xd6, 10, 0x0019},       //  0000011001
+	{0xd7, 10, 0x0018},       //  0000011000
+	{0xd8, 10, 0x0017},       //  0000010111
+	{0xd9, 10, 0x0016},       //  0000010110
+	{0xda, 10, 0x0015},       //  0000010101
+	{0xdb, 10, 0x0014},       //  0000010100
+	{0xdc, 10, 0x0013},       //  0000010011
+	{0xde, 10, 0x0012},       //  0000010010
+	{0xdf, 10, 0x0011},       //  0000010001
+	{0xe1, 10, 0x0010},       //  0000010000
+	{0xe2, 10, 0x000f},       //  0000001111
+	{0xe4, 10, 0x000e},       //  0000001110
+	{0xef, 10, 0x000d},       //  0000001101
+	{0xd5, 11, 0x0019},       //  00000011001
+	{0xdd, 11, 0x0018},       //  00000011000
+	{0xe3, 11, 0x0017},       //  00000010111
+	{0xe5, 11, 0x0016},       //  00000010110
+	{0xe6, 11, 0x0015},       //  00000010101
+	{0xe7, 11, 0x0014},       //  00000010100
+	{0xe8, 11, 0x0013},       //  00000010011
+	{0xe9, 11, 0x0012},       //  00000010010
+	{0xea, 11, 0x0011},       //  00000010001
+	{0xeb, 11, 0x0010},       //  00000010000
+	{0xec, 11, 0x000f},       //  00000001111
+	{0xed, 11, 0x000e},       //  00000001110
+	{0xee, 11, 0x000d},       //  00000001101
+	{0xf2, 11, 0x000c},       //  00000001100
+	{0xf3, 11, 0x000b},       //  00000001011
+	{0xf4, 11, 0x000a},       //  00000001010
+	{0xf5, 11, 0x0009},       //  00000001001
+	{0xf6, 11, 0x0008},       //  00000001000
+	{0xf7, 11, 0x0007},       //  00000000111
+	{0xf8, 11, 0x0006},       //  00000000110
+	{0xfa, 11, 0x0005},       //  00000000101
+	{0xfb, 11, 0x0004},       //  00000000100
+	{0xfc, 11, 0x0003},       //  00000000011
+	{0xfd, 11, 0x0002},       //  00000000010
+	{0xfe, 11, 0x0001},       //  00000000001
+	{0xf9, 12, 0x0001},       //  000000000001
+	{huffmanEOF, 12, 0x0000}, //  000000000000
+}
+
+func main() {
+	var b bytes.Buffer
+	fmt.Fprintln(&b, "// Code generated by gen_tables.go; DO NOT EDIT.")
+	fmt.Fprintln(&b)
+	fmt.Fprintln(&b, "package msp")
+	fmt.Fprintln(&b)
+
+	// CRC8-DVB-S2, one entry per input byte.
+	fmt.Fprintf(&b, "// crc8Table is the CRC8-DVB-S2 lookup table (polynomial 0x%02X).\n", crcPoly)
+	fmt.Fprintln(&b, "var crc8Table = [256]byte{")
+	for i := 0; i < 256; i++ {
+		crc := byte(i)
+		for bit := 0; bit < 8; bit++ {
+			if crc&0x80 != 0 {
+				crc = crc<<1 ^ crcPoly
+			} else {
+				crc <<= 1
+			}
+		}
+		fmt.Fprintf(&b, "0x%02x,", crc)
+		if i%16 == 15 {
+			fmt.Fprintln(&b)
+		}
+	}
+	fmt.Fprintln(&b, "}")
+	fmt.Fprintln(&b)
+
+	// The tree sorted by (CodeLen, Code), and where each length starts.
+	tree := append([]huffmanEntry(nil), rawTree...)
+	sort.SliceStable(tree, func(i, j int) bool {
+		if tree[i].CodeLen != tree[j].CodeLen {
+			return tree[i].CodeLen < tree[j].CodeLen
+		}
+		return tree[i].Code < tree[j].Code
+	})
+	fmt.Fprintln(&b, "// defaultTree is the Betaflight configurator's Huffman tree sorted by")
+	fmt.Fprintln(&b, "// (CodeLen, Code).")
+	fmt.Fprintln(&b, "var defaultTree = [...]huffmanEntry{")
+	for _, e := range tree {
+		value := fmt.Sprintf("0x%02x", e.Value)
+		if e.Value == huffmanEOF {
+			value = "HuffmanEOF"
+		}
+		fmt.Fprintf(&b, "{%s, %d, 0x%04x},\n", value, e.CodeLen, e.Code)
+	}
+	fmt.Fprintln(&b, "}")
+	fmt.Fprintln(&b)
+
+	lenIndex := make([]int, maxCodeLen+1)
+	for i := range lenIndex {
+		lenIndex[i] = -1
+	}
+	for i, e := range tree {
+		if lenIndex[e.CodeLen] == -1 {
+			lenIndex[e.CodeLen] = i
+		}
+	}
+	fmt.Fprintln(&b, "// huffmanLenIndex[n] is the index in defaultTree of the first entry with")
+	fmt.Fprintln(&b, "// CodeLen == n, or -1 if no entry has that length. Index 0 is unused.")
+	fmt.Fprintf(&b, "var huffmanLenIndex = [maxCodeLen + 1]int{")
+	for i, idx := range lenIndex {
+		if i > 0 {
+			fmt.Fprint(&b, ", ")
+		}
+		fmt.Fprint(&b, idx)
+	}
+	fmt.Fprintln(&b, "}")
+	fmt.Fprintln(&b)
+
+	// Direct-index decode table: every maxCodeLen-bit window maps to the
+	// symbol whose code is its prefix.
+	var table [1 << maxCodeLen]struct {
+		value int
+		n     int
+	}
+	for _, e := range tree {
+		shift := maxCodeLen - e.CodeLen
+		first := e.Code << shift
+		for i := first; i < first+1<<shift; i++ {
+			if table[i].n != 0 {
+				log.Fatalf("code 0x%x/%d overlaps another code", e.Code, e.CodeLen)
+			}
+			table[i].value, table[i].n = e.Value, e.CodeLen
+		}
+	}
+	fmt.Fprintln(&b, "// huffmanDecodeTable maps the next maxCodeLen input bits to the symbol")
+	fmt.Fprintln(&b, "// they start with. A zero codeLen marks an invalid code.")
+	fmt.Fprintln(&b, "var huffmanDecodeTable = [1 << maxCodeLen]huffmanSymbol{")
+	for i, sym := range table {
+		fmt.Fprintf(&b, "{%d, %d},", sym.value, sym.n)
+		if i%8 == 7 {
+			fmt.Fprintln(&b)
+		}
+	}
+	fmt.Fprintln(&b, "}")
+
+	src, err := format.Source(b.Bytes())
+	if err != nil {
+		log.Fatal(err)
+	}
+	if err := os.WriteFile("tables_gen.go", src, 0o644); err != nil {
+		log.Fatal(err)
+	}
+}
@@ -86,14 +86,70 @@ t.Errorf("HuffmanDecode with EOF = %v, want %v", got, want)
 }
 
 func TestHuffmanRoundTrip(t *testing.T) {
-for _, e := range defaultTree {
-val, ok := huffmanLookup[huffmanKey{e.CodeLen, e.Code}]
-if !ok {
-t.Errorf("lookup missing for CodeLen=%d Code=0x%x", e.CodeLen, e.Code)
-continue
+	for _, e := range defaultTree {
+		// Every window that starts with the code decodes to its symbol.
+		shift := maxCodeLen - e.CodeLen
+		for _, i := range []int{e.Code << shift, e.Code<<shift | (1<<shift - 1)} {
+			sym := huffmanDecodeTable[i]
+			if int(sym.value) != e.Value || int(sym.codeLen) != e.CodeLen {
+				t.Errorf("decode table[0x%03x] = {%d, %d}, want {%d, %d}", i, sym.value, sym.codeLen, e.Value, e.CodeLen)
+			}
+		}
+	}
 }
-if val != e.Value {
-t.Errorf("lookup[%d,0x%x] = 0x%x, want 0x%x", e.CodeLen, e.Code, val, e.Value)
+
+// encodeHuffman is the reference encoder for the benchmarks.
+func encodeHuffman(data []byte) []byte {
+	var codes [256]huffmanEntry
+	for _, e := range defaultTree {
+		if e.Value != HuffmanEOF {
+			codes[e.Value] = e
+		}
+	}
+	var out []byte
+	var acc uint64
+	bits := 0
+	for _, b := range data {
+		e := codes[b]
+		acc = acc<<uint(e.CodeLen) | uint64(e.Code)
+		bits += e.CodeLen
+		for bits >= 8 {
+			out = append(out, byte(acc>>uint(bits-8)))
+			bits -= 8
+		}
+	}
+	if bits > 0 {
+		out = append(out, byte(acc<<uint(8-bits)))
+	}
+	return out
 }
+
+func TestHuffmanDecodeAllBytes(t *testing.T) {
+	data := make([]byte, 4096)
+	for i := range data {
+		data[i] = byte(i * 7)
+	}
+	got, err := HuffmanDecode(encodeHuffman(data), len(data))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got, data) {
+		t.Error("round trip through the reference encoder changed the data")
+	}
 }
+
+func BenchmarkHuffmanDecode(b *testing.B) {
+	data := make([]byte, 4096)
+	for i := range data {
+		data[i] = byte(i % 40) // skewed toward short codes, like blackbox data
+	}
+	input := encodeHuffman(data)
+	out := make([]byte, 0, len(data))
+	b.SetBytes(int64(len(data)))
+	b.ReportAllocs()
+	for i := 0; i < b.N; i++ {
+		if _, err := huffmanDecodeInto(out[:0], input, len(data)); err != nil {
+			b.Fatal(err)
+		}
+	}
 }
@@ -0,0 +1,185 @@
+package msp
+
+import (
+	"errors"
+	"fmt"
+	"net"
+	"net/url"
+	"strings"
+	"time"
+)
+
+// Flusher is implemented by ports that hold back writes to send them
+// together, such as the network transports.
+type Flusher interface {
+	Flush() error
+}
+
+const (
+	// netDialTimeout bounds one connection attempt to a network bridge.
+	netDialTimeout = 2 * time.Second
+	// netWriteTimeout bounds sending buffered requests.
+	netWriteTimeout = time.Second
+	// netMaxBuffered flushes held-back writes early. Pipelined requests are
+	// a few dozen bytes, so this is only reached by unusual callers.
+	netMaxBuffered = 1024
+	// udpMaxDatagram is the largest datagram a UDP bridge can send.
+	udpMaxDatagram = 65535
+)
+
+// IsNetworkPort reports whether path names a network MSP bridge
+// (tcp://host:port or udp://host:port) rather than a serial device.
+func IsNetworkPort(path string) bool {
+	return strings.HasPrefix(path, "tcp://") || strings.HasPrefix(path, "udp://")
+}
+
+// netPort is a SerialPort over a TCP or UDP bridge, such as ser2net, an ESP32
+// serial bridge or an ELRS backpack.
+//
+// Writes are held back until the next Read or Flush, so the requests a
+// pipelined caller sends together go out in one segment or datagram. Callers
+// that do other work between sending and reading must Flush first, or the
+// FC only sees the request once they read. Nagle is off, so a flushed
+// segment leaves at once. A broken connection fails the current
+// call; the next call dials again, and the client's retry resends the lost
+// request.
+type netPort struct {
+	network     string // "tcp" or "udp"
+	address     string
+	readTimeout time.Duration
+
+	conn    net.Conn
+	wbuf    []byte
+	dgram   []byte // UDP receive buffer
+	pending []byte // rest of the last datagram, not yet read
+	dials   int
+}
+
+// DialNetwork connects to the bridge at rawURL (tcp://host:port or
+// udp://host:port). Reads return no data after readTimeout, like a serial
+// port with a read timeout.
+func DialNetwork(rawURL string, readTimeout time.Duration) (SerialPort, error) {
+	u, err := url.Parse(rawURL)
+	if err != nil {
+		return nil, err
+	}
+	if (u.Scheme != "tcp" && u.Scheme != "udp") || u.Host == "" || u.Port() == "" {
+		return nil, fmt.Errorf("invalid MSP bridge address %q, want tcp://host:port or udp://host:port", rawURL)
+	}
+	p := &netPort{network: u.Scheme, address: u.Host, readTimeout: readTimeout}
+	if p.network == "udp" {
+		p.dgram = make([]byte, udpMaxDatagram)
+	}
+	if err := p.dial(); err != nil {
+		return nil, err
+	}
+	return p, nil
+}
+
+func (p *netPort) dial() error {
+	conn, err := net.DialTimeout(p.network, p.address, netDialTimeout)
+	if err != nil {
+		return err
+	}
+	if tcp, ok := conn.(*net.TCPConn); ok {
+		_ = tcp.SetNoDelay(true)
+		_ = tcp.SetKeepAlive(true)
+		_ = tcp.SetKeepAlivePeriod(5 * time.Second)
+	}
+	p.conn = conn
+	p.pending = nil
+	p.dials++
+	return nil
+}
+
+// drop closes a broken connection so the next call reconnects.
+func (p *netPort) drop(op string, err error) error {
+	p.conn.Close()
+	p.conn = nil
+	p.wbuf = p.wbuf[:0]
+	p.pending = nil
+	return fmt.Errorf("%s %s %s: %w", p.network, p.address, op, err)
+}
+
+// Write queues data until the next Read or Flush.
+func (p *netPort) Write(data []byte) (int, error) {
+	p.wbuf = append(p.wbuf, data...)
+	if len(p.wbuf) >= netMaxBuffered {
+		if err := p.Flush(); err != nil {
+			return 0, err
+		}
+	}
+	return len(data), nil
+}
+
+// Flush sends the queued writes as one segment or datagram.
+func (p *netPort) Flush() error {
+	if len(p.wbuf) == 0 {
+		return nil
+	}
+	if p.conn == nil {
+		if err := p.dial(); err != nil {
+			return err
+		}
+	}
+	_ = p.conn.SetWriteDeadline(time.Now().Add(netWriteTimeout))
+	if _, err := p.conn.Write(p.wbuf); err != nil {
+		return p.drop("write", err)
+	}
+	p.wbuf = p.wbuf[:0]
+	return nil
+}
+
+// Read flushes queued writes, then returns what the bridge sent, or no data
+// once the read timeout passes.
+func (p *netPort) Read(buf []byte) (int, error) {
+	if err := p.Flush(); err != nil {
+		return 0, err
+	}
+	if len(p.pending) > 0 {
+		n := copy(buf, p.pending)
+		p.pending = p.pending[n:]
+		return n, nil
+	}
+	if p.conn == nil {
+		if err := p.dial(); err != nil {
+			return 0, err
+		}
+	}
+	_ = p.conn.SetReadDeadline(time.Now().Add(p.readTimeout))
+	var (
+		n   int
+		err error
+	)
+	if p.dgram != nil {
+		// A datagram must be read whole; keep what does not fit in buf.
+		var got int
+		got, err = p.conn.Read(p.dgram)
+		n = copy(buf, p.dgram[:got])
+		p.pending = p.dgram[n:got]
+	} else {
+		n, err = p.conn.Read(buf)
+	}
+	if err != nil {
+		var ne net.Error
+		if errors.As(err, &ne) && ne.Timeout() {
+			return n, nil
+		}
+		return n, p.drop("read", err)
+	}
+	return n, nil
+}
+
+// Close sends anything still queued and closes the connection.
+func (p *netPort) Close() error {
+	if p.conn == nil {
+		return nil
+	}
+	_ = p.Flush()
+	if p.conn == nil {
+		return nil
+	}
+	err := p.conn.Close()
+	p.conn = nil
+	return err
+}
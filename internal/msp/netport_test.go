@@ -0,0 +1,233 @@
+package msp
+
+import (
+	"bytes"
+	"net"
+	"strings"
+	"sync"
+	"testing"
+	"time"
+)
+
+// ser2net stands in for a TCP serial bridge: bytes from the client go to
+// an emulated FC, its answers go back. It records what arrived in each
+// read, and can drop the first connection after a number of reads.
+type ser2net struct {
+	ln       net.Listener
+	fc       *answeringFC
+	mu       sync.Mutex
+	segments [][]byte
+	dropFrom int // close the first connection after this many reads (0: never)
+	conns    int
+}
+
+func startSer2net(t *testing.T) *ser2net {
+	t.Helper()
+	ln, err := net.Listen("tcp", "127.0.0.1:0")
+	if err != nil {
+		t.Fatal(err)
+	}
+	s := &ser2net{ln: ln, fc: &answeringFC{chunk: bytes.Repeat([]byte{0xa5}, 512), dec: NewFrameDecoder()}}
+	t.Cleanup(func() { ln.Close() })
+	go func() {
+		for {
+			conn, err := ln.Accept()
+			if err != nil {
+				return
+			}
+			s.mu.Lock()
+			s.conns++
+			first := s.conns == 1
+			s.mu.Unlock()
+			go s.serve(conn, first)
+		}
+	}()
+	return s
+}
+
+func (s *ser2net) serve(conn net.Conn, first bool) {
+	defer conn.Close()
+	buf := make([]byte, 4096)
+	for reads := 1; ; reads++ {
+		n, err := conn.Read(buf)
+		if err != nil {
+			return
+		}
+		s.mu.Lock()
+		s.segments = append(s.segments, append([]byte(nil), buf[:n]...))
+		if first && s.dropFrom > 0 && reads >= s.dropFrom {
+			s.mu.Unlock()
+			return
+		}
+		s.fc.Write(buf[:n])
+		out := append([]byte(nil), s.fc.out.Bytes()...)
+		s.fc.out.Reset()
+		s.mu.Unlock()
+		if _, err := conn.Write(out); err != nil {
+			return
+		}
+	}
+}
+
+func (s *ser2net) url() string { return "tcp://" + s.ln.Addr().String() }
+
+func TestNetworkPortPipelinedFlashReads(t *testing.T) {
+	bridge := startSer2net(t)
+	port, err := DialNetwork(bridge.url(), 50*time.Millisecond)
+	if err != nil {
+		t.Fatal(err)
+	}
+	c := NewClient(port, time.Second)
+	defer c.Close()
+	c.FCVariant = BTFLVariant
+
+	// Pipelined like the sync: next request out before the current answer
+	// is handled, with a query slotted in.
+	if err := c.SendFlashReadRequest(0, 512, false); err != nil {
+		t.Fatal(err)
+	}
+	for i := 0; i < 50; i++ {
+		_, data, err := c.ReceiveFlashReadResponse()
+		if err != nil || len(data) != 512 {
+			t.Fatalf("chunk %d: %d bytes, %v", i, len(data), err)
+		}
+		_ = c.SendFlashReadRequest(uint32(i+1)*512, 512, false)
+		if i == 10 {
+			_ = c.Send(byte(MSPAnalog), nil)
+		}
+		if err := c.Flush(); err != nil {
+			t.Fatal(err)
+		}
+	}
+	if _, data, err := c.ReceiveFlashReadResponse(); err != nil || len(data) != 512 {
+		t.Fatalf("last chunk: %d bytes, %v", len(data), err)
+	}
+	if f, err := c.Receive(MSPAnalog); err != nil || !bytes.Equal(f.Payload, []byte{MSPAnalog}) {
+		t.Fatalf("interleaved query: %v, %v", f, err)
+	}
+
+	// The flash request and the query sent between two reads left as one
+	// segment.
+	bridge.mu.Lock()
+	defer bridge.mu.Unlock()
+	flashReq := len(EncodeV2(MSPDataflashRead, make([]byte, flashReadPayloadSize)))
+	found := false
+	for _, seg := range bridge.segments {
+		if len(seg) == flashReq+len(EncodeV1(byte(MSPAnalog), nil)) {
+			found = true
+		}
+	}
+	if !found {
+		t.Error("pipelined flash request and query were not coalesced into one write")
+	}
+}
+
+func TestNetworkPortFlushSendsBeforeRead(t *testing.T) {
+	bridge := startSer2net(t)
+	port, err := DialNetwork(bridge.url(), 50*time.Millisecond)
+	if err != nil {
+		t.Fatal(err)
+	}
+	c := NewClient(port, time.Second)
+	defer c.Close()
+	c.FCVariant = BTFLVariant
+
+	// The sync sends the next request, then writes the current chunk to the
+	// SD card before it reads again. The FC must have the request by then.
+	if err := c.SendFlashReadRequest(0, 512, false); err != nil {
+		t.Fatal(err)
+	}
+	if err := c.Flush(); err != nil {
+		t.Fatal(err)
+	}
+	deadline := time.Now().Add(2 * time.Second)
+	for {
+		bridge.mu.Lock()
+		arrived := len(bridge.segments)
+		bridge.mu.Unlock()
+		if arrived > 0 {
+			break
+		}
+		if time.Now().After(deadline) {
+			t.Fatal("flushed flash request never reached the bridge")
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	if _, data, err := c.ReceiveFlashReadResponse(); err != nil || len(data) != 512 {
+		t.Fatalf("chunk: %d bytes, %v", len(data), err)
+	}
+}
+
+func TestNetworkPortReconnects(t *testing.T) {
+	bridge := startSer2net(t)
+	bridge.dropFrom = 2 // the bridge restarts after the first answer
+	port, err := DialNetwork(bridge.url(), 50*time.Millisecond)
+	if err != nil {
+		t.Fatal(err)
+	}
+	c := NewClient(port, 300*time.Millisecond)
+	defer c.Close()
+
+	if _, err := c.Request(MSPStatus, nil); err != nil {
+		t.Fatalf("first request: %v", err)
+	}
+	// This one is lost with the connection.
+	if _, err := c.Request(MSPStatus, nil); err == nil {
+		t.Fatal("request on a dropped connection should fail")
+	}
+	if _, err := c.Request(MSPStatus, nil); err != nil {
+		t.Fatalf("after reconnect: %v", err)
+	}
+	bridge.mu.Lock()
+	defer bridge.mu.Unlock()
+	if bridge.conns != 2 {
+		t.Errorf("bridge saw %d connections, want 2", bridge.conns)
+	}
+}
+
+func TestNetworkPortUDP(t *testing.T) {
+	pc, err := net.ListenPacket("udp", "127.0.0.1:0")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer pc.Close()
+	// 3 KB chunks: one datagram larger than the client's reads would be
+	// from a serial port, so it is handed out in pieces.
+	fc := &answeringFC{chunk: bytes.Repeat([]byte{0x3c}, 3000), dec: NewFrameDecoder()}
+	go func() {
+		buf := make([]byte, udpMaxDatagram)
+		for {
+			n, from, err := pc.ReadFrom(buf)
+			if err != nil {
+				return
+			}
+			fc.Write(buf[:n])
+			pc.WriteTo(fc.out.Bytes(), from)
+			fc.out.Reset()
+		}
+	}()
+
+	port, err := DialNetwork("udp://"+pc.LocalAddr().String(), 50*time.Millisecond)
+	if err != nil {
+		t.Fatal(err)
+	}
+	c := NewClient(port, time.Second)
+	defer c.Close()
+	c.FCVariant = BTFLVariant
+	for i := 0; i < 5; i++ {
+		if _, data, err := c.ReadFlashChunk(uint32(i)*3000, 3000, false); err != nil || len(data) != 3000 {
+			t.Fatalf("chunk %d: %d bytes, %v", i, len(data), err)
+		}
+	}
+}
+
+func TestDialNetworkRejectsBadAddresses(t *testing.T) {
+	for _, addr := range []string{"tcp://", "tcp://host", "serial:///dev/ttyACM0", "udp://:"} {
+		if _, err := DialNetwork(addr, time.Second); err == nil || !strings.Contains(err.Error(), "invalid MSP bridge") {
+			t.Errorf("DialNetwork(%q) = %v, want an invalid address error", addr, err)
+		}
+	}
+	if !IsNetworkPort("tcp://10.0.0.1:5761") || IsNetworkPort("/dev/ttyACM0") {
+		t.Error("IsNetworkPort misclassifies addresses")
+	}
+}
@@ -0,0 +1,229 @@
+package msp
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"sync"
+	"time"
+)
+
+// Priority is the class of a request queued on a Scheduler. Bulk flash
+// reads are not queued: they are the traffic of the goroutine that owns the
+// Client, and queued requests are slotted in between them.
+type Priority int
+
+const (
+	// PriorityInteractive is for queries someone is waiting on, such as the
+	// dashboard asking for the battery voltage. One is sent per pipeline
+	// slot.
+	PriorityInteractive Priority = iota
+	// PriorityBackground is for periodic polls. One is sent at most every
+	// backgroundEvery slots, and only when no interactive request waits.
+	PriorityBackground
+	numPriorities
+)
+
+// backgroundEvery spaces background requests out between bulk reads.
+const backgroundEvery = 8
+
+// ErrSchedulerClosed is returned for requests still queued when the owner
+// of the client is done with the FC.
+var ErrSchedulerClosed = errors.New("msp: FC connection closed")
+
+// ErrReservedCode is returned for codes the owner uses for bulk transfers;
+// interleaving them would confuse its response matching.
+var ErrReservedCode = errors.New("msp: code reserved for flash transfers")
+
+// Scheduler lets other goroutines share a Client with the goroutine that
+// owns it. Requests are queued by priority and sent by the owner at its next
+// Interleave call, one at a time, so each adds one small request and
+// response to the owner's pipeline.
+type Scheduler struct {
+	client  *Client
+	timeout time.Duration
+
+	mu       sync.Mutex
+	queue    [numPriorities][]*call
+	inflight *call
+	slots    int // Interleave calls since the last background request
+	closed   bool
+}
+
+type call struct {
+	code    uint16
+	payload []byte
+	sent    time.Time
+	done    chan callResult // buffered; the waiter may have given up
+}
+
+type callResult struct {
+	payload []byte
+	err     error
+}
+
+// NewScheduler returns a scheduler for client. A sent request fails if its
+// response has not arrived within timeout.
+func NewScheduler(client *Client, timeout time.Duration) *Scheduler {
+	return &Scheduler{client: client, timeout: timeout}
+}
+
+// Do queues a request and waits for the response payload.
+func (s *Scheduler) Do(ctx context.Context, pri Priority, code uint16, payload []byte) ([]byte, error) {
+	if code == MSPDataflashRead || code == MSPDataflashErase {
+		return nil, ErrReservedCode
+	}
+	if pri < 0 || pri >= numPriorities {
+		return nil, fmt.Errorf("msp: invalid priority %d", pri)
+	}
+	c := &call{code: code, payload: payload, done: make(chan callResult, 1)}
+	s.mu.Lock()
+	if s.closed {
+		s.mu.Unlock()
+		return nil, ErrSchedulerClosed
+	}
+	s.queue[pri] = append(s.queue[pri], c)
+	s.mu.Unlock()
+
+	select {
+	case r := <-c.done:
+		return r.payload, r.err
+	case <-ctx.Done():
+		s.mu.Lock()
+		for p, q := range s.queue {
+			for i, qc := range q {
+				if qc == c {
+					s.queue[p] = append(q[:i], q[i+1:]...)
+					break
+				}
+			}
+		}
+		s.mu.Unlock()
+		return nil, ctx.Err()
+	}
+}
+
+// Interleave must be called only by the goroutine that owns the client,
+// at points where one extra request fits: right after a bulk request has
+// been sent, or between polls. It delivers a response that has arrived,
+// expires an overdue request, and sends the next queued one. It is a no-op
+// on a nil Scheduler and does not allocate when nothing is queued.
+func (s *Scheduler) Interleave() {
+	if s == nil {
+		return
+	}
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	s.slots++
+
+	if c := s.inflight; c != nil {
+		if f, ok := s.client.TakeFrame(c.code); ok {
+			c.done <- callResult{payload: f.Payload}
+		} else if time.Since(c.sent) > s.timeout {
+			c.done <- callResult{err: &TimeoutError{Message: fmt.Sprintf("timeout waiting for MSP code %d", c.code)}}
+		} else {
+			return
+		}
+		s.inflight = nil
+	}
+	s.sendNextLocked()
+}
+
+// waitStep is how often Wait checks for newly queued requests.
+const waitStep = 20 * time.Millisecond
+
+// Wait services queued requests for about d. The owner calls it instead of
+// sleeping while it has no traffic of its own, e.g. between erase polls. On a
+// nil Scheduler it just sleeps.
+func (s *Scheduler) Wait(d time.Duration) {
+	if s == nil {
+		time.Sleep(d)
+		return
+	}
+	deadline := time.Now().Add(d)
+	for {
+		s.Interleave()
+		s.mu.Lock()
+		c := s.inflight
+		s.mu.Unlock()
+		if c != nil {
+			// Only the owner reads the port, so waiting here is safe.
+			f, err := s.client.Receive(c.code)
+			s.mu.Lock()
+			if s.inflight == c {
+				if err == nil {
+					c.done <- callResult{payload: f.Payload}
+				} else {
+					c.done <- callResult{err: err}
+				}
+				s.inflight = nil
+			}
+			s.mu.Unlock()
+		}
+		left := time.Until(deadline)
+		if left <= 0 {
+			return
+		}
+		if c == nil {
+			time.Sleep(min(left, waitStep))
+		}
+	}
+}
+
+// sendNextLocked sends the next queued request, if one is due. Callers hold
+// s.mu and have no request in flight.
+func (s *Scheduler) sendNextLocked() {
+	var c *call
+	switch {
+	case len(s.queue[PriorityInteractive]) > 0:
+		c = s.pop(PriorityInteractive)
+	case len(s.queue[PriorityBackground]) > 0 && s.slots >= backgroundEvery:
+		c = s.pop(PriorityBackground)
+		s.slots = 0
+	default:
+		return
+	}
+
+	// Drop a late answer to an earlier, expired request for the same code.
+	s.client.FlushFrames(c.code)
+	var err error
+	if c.code <= 0xff {
+		err = s.client.Send(byte(c.code), c.payload)
+	} else {
+		err = s.client.SendV2(c.code, c.payload)
+	}
+	if err != nil {
+		c.done <- callResult{err: err}
+		return
+	}
+	c.sent = time.Now()
+	s.inflight = c
+}
+
+func (s *Scheduler) pop(pri Priority) *call {
+	c := s.queue[pri][0]
+	s.queue[pri][0] = nil
+	s.queue[pri] = s.queue[pri][1:]
+	return c
+}
+
+// Close fails every queued and in-flight request; later ones fail at once.
+// Call it from the owner before it stops servicing the client.
+func (s *Scheduler) Close() {
+	if s == nil {
+		return
+	}
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	s.closed = true
+	if s.inflight != nil {
+		s.inflight.done <- callResult{err: ErrSchedulerClosed}
+		s.inflight = nil
+	}
+	for p, q := range s.queue {
+		for _, c := range q {
+			c.done <- callResult{err: ErrSchedulerClosed}
+		}
+		s.queue[p] = nil
+	}
+}
@@ -0,0 +1,172 @@
+package msp
+
+import (
+	"bytes"
+	"context"
+	"errors"
+	"testing"
+	"time"
+)
+
+// answeringFC replies to every request: flash reads with chunk, anything
+// else with a one-byte payload holding the code.
+type answeringFC struct {
+	chunk []byte
+	dec   *FrameDecoder
+	out   bytes.Buffer
+	codes []uint16 // non-flash requests seen, in order
+}
+
+func (f *answeringFC) Write(data []byte) (int, error) {
+	f.dec.Feed(data)
+	for _, req := range f.dec.Frames {
+		if req.Code == MSPDataflashRead {
+			f.out.Write(btflFlashResponse(DataflashCompressionNone, f.chunk))
+			continue
+		}
+		f.codes = append(f.codes, req.Code)
+		f.out.Write(makeV1Response(byte(req.Code), []byte{byte(req.Code)}))
+	}
+	f.dec.Frames = f.dec.Frames[:0]
+	return len(data), nil
+}
+
+func (f *answeringFC) Read(buf []byte) (int, error) { return f.out.Read(buf) }
+func (f *answeringFC) Close() error                 { return nil }
+
+func newSchedulerFixture() (*Client, *Scheduler, *answeringFC) {
+	fc := &answeringFC{chunk: bytes.Repeat([]byte{0x5a}, 512), dec: NewFrameDecoder()}
+	c := NewClient(fc, 50*time.Millisecond)
+	c.FCVariant = BTFLVariant
+	return c, NewScheduler(c, time.Second), fc
+}
+
+// bulkLoop runs pipelined flash reads like the sync does, interleaving
+// queued requests after each send, until stop is closed.
+func bulkLoop(t *testing.T, c *Client, s *Scheduler, stop <-chan struct{}) <-chan int {
+	chunks := make(chan int, 1)
+	go func() {
+		n := 0
+		defer func() { chunks <- n }()
+		if err := c.SendFlashReadRequest(0, 512, false); err != nil {
+			t.Error(err)
+			return
+		}
+		for {
+			_, data, err := c.ReceiveFlashReadResponse()
+			if err != nil || len(data) != 512 {
+				t.Errorf("flash chunk %d: %d bytes, err %v", n, len(data), err)
+				return
+			}
+			n++
+			select {
+			case <-stop:
+				s.Close()
+				return
+			default:
+			}
+			_ = c.SendFlashReadRequest(uint32(n*512), 512, false)
+			s.Interleave()
+		}
+	}()
+	return chunks
+}
+
+// pumpResponses reads whatever the FC sent into the client's pending frames,
+// as the owner's next flash receive would.
+func pumpResponses(c *Client) {
+	_, _ = c.receive(0xffff) // no such code; returns after the client timeout
+}
+
+func TestSchedulerInterleavesWithBulkReads(t *testing.T) {
+	c, s, _ := newSchedulerFixture()
+	stop := make(chan struct{})
+	chunks := bulkLoop(t, c, s, stop)
+
+	for _, code := range []uint16{MSPAnalog, MSPStatus, MSPName} {
+		ctx, cancel := context.WithTimeout(context.Background(), 2*time.Second)
+		payload, err := s.Do(ctx, PriorityInteractive, code, nil)
+		cancel()
+		if err != nil || !bytes.Equal(payload, []byte{byte(code)}) {
+			t.Fatalf("Do(%d) = %v, %v", code, payload, err)
+		}
+	}
+	close(stop)
+	if n := <-chunks; n == 0 {
+		t.Fatal("bulk reads stalled")
+	}
+	if _, err := s.Do(context.Background(), PriorityInteractive, MSPAnalog, nil); !errors.Is(err, ErrSchedulerClosed) {
+		t.Fatalf("Do after Close = %v, want ErrSchedulerClosed", err)
+	}
+}
+
+func TestSchedulerPriorities(t *testing.T) {
+	c, s, fc := newSchedulerFixture()
+	done := make(chan struct{}, 2)
+	go func() { s.Do(context.Background(), PriorityBackground, MSPStatus, nil); done <- struct{}{} }()
+	go func() { s.Do(context.Background(), PriorityInteractive, MSPAnalog, nil); done <- struct{}{} }()
+	for {
+		s.mu.Lock()
+		queued := len(s.queue[PriorityInteractive]) + len(s.queue[PriorityBackground])
+		s.mu.Unlock()
+		if queued == 2 {
+			break
+		}
+		time.Sleep(time.Millisecond)
+	}
+
+	// Interactive goes first; background waits for its slot spacing.
+	slots := 0
+	for len(fc.codes) < 2 && slots < 100 {
+		s.Interleave()
+		slots++
+		pumpResponses(c)
+	}
+	if len(fc.codes) != 2 || fc.codes[0] != MSPAnalog || fc.codes[1] != MSPStatus {
+		t.Fatalf("sent %v, want analog then status", fc.codes)
+	}
+	if slots < backgroundEvery {
+		t.Errorf("background request sent after %d slots, want at least %d", slots, backgroundEvery)
+	}
+	for i := 0; i < 4; i++ {
+		s.Interleave()
+		pumpResponses(c)
+	}
+	for i := 0; i < 2; i++ {
+		select {
+		case <-done:
+		case <-time.After(time.Second):
+			t.Fatal("request not answered")
+		}
+	}
+}
+
+func TestSchedulerRejectsFlashCodes(t *testing.T) {
+	_, s, _ := newSchedulerFixture()
+	for _, code := range []uint16{MSPDataflashRead, MSPDataflashErase} {
+		if _, err := s.Do(context.Background(), PriorityInteractive, code, nil); !errors.Is(err, ErrReservedCode) {
+			t.Errorf("Do(%d) = %v, want ErrReservedCode", code, err)
+		}
+	}
+}
+
+func TestSchedulerIdleInterleaveAllocs(t *testing.T) {
+	_, s, _ := newSchedulerFixture()
+	if allocs := testing.AllocsPerRun(100, s.Interleave); allocs != 0 {
+		t.Errorf("idle Interleave allocates %.1f times, want 0", allocs)
+	}
+}
+
+func TestSchedulerWaitAnswersWhileIdle(t *testing.T) {
+	_, s, _ := newSchedulerFixture()
+	go func() {
+		for i := 0; i < 20; i++ {
+			s.Wait(10 * time.Millisecond)
+		}
+		s.Close()
+	}()
+	payload, err := s.Do(context.Background(), PriorityBackground, MSPStatus, nil)
+	if err != nil || !bytes.Equal(payload, []byte{MSPStatus}) {
+		t.Fatalf("Do = %v, %v", payload, err)
+	}
+}
@@ -0,0 +1,806 @@
+// Code generated by gen_tables.go; DO NOT EDIT.
+
+package msp
+
+// crc8Table is the CRC8-DVB-S2 lookup table (polynomial 0xD5).
+var crc8Table = [256]byte{
+	0x00, 0xd5, 0x7f, 0xaa, 0xfe, 0x2b, 0x81, 0x54, 0x29, 0xfc, 0x56, 0x83, 0xd7, 0x02, 0xa8, 0x7d,
+	0x52, 0x87, 0x2d, 0xf8, 0xac, 0x79, 0xd3, 0x06, 0x7b, 0xae, 0x04, 0xd1, 0x85, 0x50, 0xfa, 0x2f,
+	0xa4, 0x71, 0xdb, 0x0e, 0x5a, 0x8f, 0x25, 0xf0, 0x8d, 0x58, 0xf2, 0x27, 0x73, 0xa6, 0x0c, 0xd9,
+	0xf6, 0x23, 0x89, 0x5c, 0x08, 0xdd, 0x77, 0xa2, 0xdf, 0x0a, 0xa0, 0x75, 0x21, 0xf4, 0x5e, 0x8b,
+	0x9d, 0x48, 0xe2, 0x37, 0x63, 0xb6, 0x1c, 0xc9, 0xb4, 0x61, 0xcb, 0x1e, 0x4a, 0x9f, 0x35, 0xe0,
+	0xcf, 0x1a, 0xb0, 0x65, 0x31, 0xe4, 0x4e, 0x9b, 0xe6, 0x33, 0x99, 0x4c, 0x18, 0xcd, 0x67, 0xb2,
+	0x39, 0xec, 0x46, 0x93, 0xc7, 0x12, 0xb8, 0x6d, 0x10, 0xc5, 0x6f, 0xba, 0xee, 0x3b, 0x91, 0x44,
+	0x6b, 0xbe, 0x14, 0xc1, 0x95, 0x40, 0xea, 0x3f, 0x42, 0x97, 0x3d, 0xe8, 0xbc, 0x69, 0xc3, 0x16,
+	0xef, 0x3a, 0x90, 0x45, 0x11, 0xc4, 0x6e, 0xbb, 0xc6, 0x13, 0xb9, 0x6c, 0x38, 0xed, 0x47, 0x92,
+	0xbd, 0x68, 0xc2, 0x17, 0x43, 0x96, 0x3c, 0xe9, 0x94, 0x41, 0xeb, 0x3e, 0x6a, 0xbf, 0x15, 0xc0,
+	0x4b, 0x9e, 0x34, 0xe1, 0xb5, 0x60, 0xca, 0x1f, 0x62, 0xb7, 0x1d, 0xc8, 0x9c, 0x49, 0xe3, 0x36,
+	0x19, 0xcc, 0x66, 0xb3, 0xe7, 0x32, 0x98, 0x4d, 0x30, 0xe5, 0x4f, 0x9a, 0xce, 0x1b, 0xb1, 0x64,
+	0x72, 0xa7, 0x0d, 0xd8, 0x8c, 0x59, 0xf3, 0x26, 0x5b, 0x8e, 0x24, 0xf1, 0xa5, 0x70, 0xda, 0x0f,
+	0x20, 0xf5, 0x5f, 0x8a, 0xde, 0x0b, 0xa1, 0x74, 0x09, 0xdc, 0x76, 0xa3, 0xf7, 0x22, 0x88, 0x5d,
+	0xd6, 0x03, 0xa9, 0x7c, 0x28, 0xfd, 0x57, 0x82, 0xff, 0x2a, 0x80, 0x55, 0x01, 0xd4, 0x7e, 0xab,
+	0x84, 0x51, 0xfb, 0x2e, 0x7a, 0xaf, 0x05, 0xd0, 0xad, 0x78, 0xd2, 0x07, 0x53, 0x86, 0x2c, 0xf9,
+}
+
+// defaultTree is the Betaflight configurator's Huffman tree sorted by
+// (CodeLen, Code).
+var defaultTree = [...]huffmanEntry{
+	{0x00, 2, 0x0003},
+	{0x01, 3, 0x0005},
+	{0x02, 4, 0x0009},
+	{0x50, 5, 0x000f},
+	{0x04, 5, 0x0010},
+	{0x03, 5, 0x0011},
+	{0x10, 6, 0x0019},
+	{0x08, 6, 0x001a},
+	{0x07, 6, 0x001b},
+	{0x06, 6, 0x001c},
+	{0x05, 6, 0x001d},
+	{0x12, 7, 0x0029},
+	{0x11, 7, 0x002a},
+	{0x0f, 7, 0x002b},
+	{0x0e, 7, 0x002c},
+	{0x0d, 7, 0x002d},
+	{0x0c, 7, 0x002e},
+	{0x0b, 7, 0x002f},
+	{0x0a, 7, 0x0030},
+	{0x09, 7, 0x0031},
+	{0xf0, 8, 0x003d},
+	{0x40, 8, 0x003e},
+	{0x30, 8, 0x003f},
+	{0x24, 8, 0x0040},
+	{0x23, 8, 0x0041},
+	{0x22, 8, 0x0042},
+	{0x21, 8, 0x0043},
+	{0x20, 8, 0x0044},
+	{0x1f, 8, 0x0045},
+	{0x1e, 8, 0x0046},
+	{0x1d, 8, 0x0047},
+	{0x1c, 8, 0x0048},
+	{0x1b, 8, 0x0049},
+	{0x1a, 8, 0x004a},
+	{0x19, 8, 0x004b},
+	{0x18, 8, 0x004c},
+	{0x17, 8, 0x004d},
+	{0x16, 8, 0x004e},
+	{0x15, 8, 0x004f},
+	{0x14, 8, 0x0050},
+	{0x13, 8, 0x0051},
+	{0xff, 9, 0x0050},
+	{0xf1, 9, 0x0051},
+	{0xe0, 9, 0x0052},
+	{0x80, 9, 0x0053},
+	{0x51, 9, 0x0054},
+	{0x4f, 9, 0x0055},
+	{0x4c, 9, 0x0056},
+	{0x49, 9, 0x0057},
+	{0x48, 9, 0x0058},
+	{0x47, 9, 0x0059},
+	{0x46, 9, 0x005a},
+	{0x45, 9, 0x005b},
+	{0x44, 9, 0x005c},
+	{0x43, 9, 0x005d},
+	{0x42, 9, 0x005e},
+	{0x41, 9, 0x005f},
+	{0x3f, 9, 0x0060},
+	{0x3e, 9, 0x0061},
+	{0x3d, 9, 0x0062},
+	{0x3c, 9, 0x0063},
+	{0x3b, 9, 0x0064},
+	{0x3a, 9, 0x0065},
+	{0x39, 9, 0x0066},
+	{0x38, 9, 0x0067},
+	{0x37, 9, 0x0068},
+	{0x36, 9, 0x0069},
+	{0x35, 9, 0x006a},
+	{0x34, 9, 0x006b},
+	{0x33, 9, 0x006c},
+	{0x32, 9, 0x006d},
+	{0x31, 9, 0x006e},
+	{0x2f, 9, 0x006f},
+	{0x2e, 9, 0x0070},
+	{0x2d, 9, 0x0071},
+	{0x2c, 9, 0x0072},
+	{0x2b, 9, 0x0073},
+	{0x2a, 9, 0x0074},
+	{0x29, 9, 0x0075},
+	{0x28, 9, 0x0076},
+	{0x27, 9, 0x0077},
+	{0x26, 9, 0x0078},
+	{0x25, 9, 0x0079},
+	{0xef, 10, 0x000d},
+	{0xe4, 10, 0x000e},
+	{0xe2, 10, 0x000f},
+	{0xe1, 10, 0x0010},
+	{0xdf, 10, 0x0011},
+	{0xde, 10, 0x0012},
+	{0xdc, 10, 0x0013},
+	{0xdb, 10, 0x0014},
+	{0xda, 10, 0x0015},
+	{0xd9, 10, 0x0016},
+	{0xd8, 10, 0x0017},
+	{0xd7, 10, 0x0018},
+	{0xd6, 10, 0x0019},
+	{0xd4, 10, 0x001a},
+	{0xd3, 10, 0x001b},
+	{0xd2, 10, 0x001c},
+	{0xd1, 10, 0x001d},
+	{0xd0, 10, 0x001e},
+	{0xcf, 10, 0x001f},
+	{0xce, 10, 0x0020},
+	{0xcd, 10, 0x0021},
+	{0xcc, 10, 0x0022},
+	{0xcb, 10, 0x0023},
+	{0xca, 10, 0x0024},
+	{0xc9, 10, 0x0025},
+	{0xc8, 10, 0x0026},
+	{0xc7, 10, 0x0027},
+	{0xc6, 10, 0x0028},
+	{0xc5, 10, 0x0029},
+	{0xc4, 10, 0x002a},
+	{0xc3, 10, 0x002b},
+	{0xc2, 10, 0x002c},
+	{0xc1, 10, 0x002d},
+	{0xc0, 10, 0x002e},
+	{0xbf, 10, 0x002f},
+	{0xbe, 10, 0x0030},
+	{0xbd, 10, 0x0031},
+	{0xbc, 10, 0x0032},
+	{0xbb, 10, 0x0033},
+	{0xba, 10, 0x0034},
+	{0xb9, 10, 0x0035},
+	{0xb8, 10, 0x0036},
+	{0xb7, 10, 0x0037},
+	{0xb6, 10, 0x0038},
+	{0xb5, 10, 0x0039},
+	{0xb4, 10, 0x003a},
+	{0xb3, 10, 0x003b},
+	{0xb2, 10, 0x003c},
+	{0xb1, 10, 0x003d},
+	{0xb0, 10, 0x003e},
+	{0xaf, 10, 0x003f},
+	{0xae, 10, 0x0040},
+	{0xad, 10, 0x0041},
+	{0xac, 10, 0x0042},
+	{0xab, 10, 0x0043},
+	{0xaa, 10, 0x0044},
+	{0xa9, 10, 0x0045},
+	{0xa8, 10, 0x0046},
+	{0xa7, 10, 0x0047},
+	{0xa6, 10, 0x0048},
+	{0xa5, 10, 0x0049},
+	{0xa4, 10, 0x004a},
+	{0xa3, 10, 0x004b},
+	{0xa2, 10, 0x004c},
+	{0xa1, 10, 0x004d},
+	{0xa0, 10, 0x004e},
+	{0x9f, 10, 0x004f},
+	{0x9e, 10, 0x0050},
+	{0x9d, 10, 0x0051},
+	{0x9c, 10, 0x0052},
+	{0x9b, 10, 0x0053},
+	{0x9a, 10, 0x0054},
+	{0x99, 10, 0x0055},
+	{0x98, 10, 0x0056},
+	{0x97, 10, 0x0057},
+	{0x96, 10, 0x0058},
+	{0x95, 10, 0x0059},
+	{0x94, 10, 0x005a},
+	{0x93, 10, 0x005b},
+	{0x92, 10, 0x005c},
+	{0x91, 10, 0x005d},
+	{0x90, 10, 0x005e},
+	{0x8f, 10, 0x005f},
+	{0x8e, 10, 0x0060},
+	{0x8d, 10, 0x0061},
+	{0x8c, 10, 0x0062},
+	{0x8b, 10, 0x0063},
+	{0x8a, 10, 0x0064},
+	{0x89, 10, 0x0065},
+	{0x88, 10, 0x0066},
+	{0x87, 10, 0x0067},
+	{0x86, 10, 0x0068},
+	{0x85, 10, 0x0069},
+	{0x84, 10, 0x006a},
+	{0x83, 10, 0x006b},
+	{0x82, 10, 0x006c},
+	{0x81, 10, 0x006d},
+	{0x7f, 10, 0x006e},
+	{0x7e, 10, 0x006f},
+	{0x7d, 10, 0x0070},
+	{0x7c, 10, 0x0071},
+	{0x7b, 10, 0x0072},
+	{0x7a, 10, 0x0073},
+	{0x79, 10, 0x0074},
+	{0x78, 10, 0x0075},
+	{0x77, 10, 0x0076},
+	{0x76, 10, 0x0077},
+	{0x75, 10, 0x0078},
+	{0x74, 10, 0x0079},
+	{0x73, 10, 0x007a},
+	{0x72, 10, 0x007b},
+	{0x71, 10, 0x007c},
+	{0x70, 10, 0x007d},
+	{0x6f, 10, 0x007e},
+	{0x6e, 10, 0x007f},
+	{0x6d, 10, 0x0080},
+	{0x6c, 10, 0x0081},
+	{0x6b, 10, 0x0082},
+	{0x6a, 10, 0x0083},
+	{0x69, 10, 0x0084},
+	{0x68, 10, 0x0085},
+	{0x67, 10, 0x0086},
+	{0x66, 10, 0x0087},
+	{0x65, 10, 0x0088},
+	{0x64, 10, 0x0089},
+	{0x63, 10, 0x008a},
+	{0x62, 10, 0x008b},
+	{0x61, 10, 0x008c},
+	{0x60, 10, 0x008d},
+	{0x5f, 10, 0x008e},
+	{0x5e, 10, 0x008f},
+	{0x5d, 10, 0x0090},
+	{0x5c, 10, 0x0091},
+	{0x5b, 10, 0x0092},
+	{0x5a, 10, 0x0093},
+	{0x59, 10, 0x0094},
+	{0x58, 10, 0x0095},
+	{0x57, 10, 0x0096},
+	{0x56, 10, 0x0097},
+	{0x55, 10, 0x0098},
+	{0x54, 10, 0x0099},
+	{0x53, 10, 0x009a},
+	{0x52, 10, 0x009b},
+	{0x4e, 10, 0x009c},
+	{0x4d, 10, 0x009d},
+	{0x4b, 10, 0x009e},
+	{0x4a, 10, 0x009f},
+	{0xfe, 11, 0x0001},
+	{0xfd, 11, 0x0002},
+	{0xfc, 11, 0x0003},
+	{0xfb, 11, 0x0004},
+	{0xfa, 11, 0x0005},
+	{0xf8, 11, 0x0006},
+	{0xf7, 11, 0x0007},
+	{0xf6, 11, 0x0008},
+	{0xf5, 11, 0x0009},
+	{0xf4, 11, 0x000a},
+	{0xf3, 11, 0x000b},
+	{0xf2, 11, 0x000c},
+	{0xee, 11, 0x000d},
+	{0xed, 11, 0x000e},
+	{0xec, 11, 0x000f},
+	{0xeb, 11, 0x0010},
+	{0xea, 11, 0x0011},
+	{0xe9, 11, 0x0012},
+	{0xe8, 11, 0x0013},
+	{0xe7, 11, 0x0014},
+	{0xe6, 11, 0x0015},
+	{0xe5, 11, 0x0016},
+	{0xe3, 11, 0x0017},
+	{0xdd, 11, 0x0018},
+	{0xd5, 11, 0x0019},
+	{HuffmanEOF, 12, 0x0000},
+	{0xf9, 12, 0x0001},
+}
+
+// huffmanLenIndex[n] is the index in defaultTree of the first entry with
+// CodeLen == n, or -1 if no entry has that length. Index 0 is unused.
+var huffmanLenIndex = [maxCodeLen + 1]int{-1, -1, 0, 1, 2, 3, 6, 11, 20, 41, 83, 230, 255}
+
+// huffmanDecodeTable maps the next maxCodeLen input bits to the symbol
+// they start with. A zero codeLen marks an invalid code.
+var huffmanDecodeTable = [1 << maxCodeLen]huffmanSymbol{
+	{-1, 12}, {249, 12}, {254, 11}, {254, 11}, {253, 11}, {253, 11}, {252, 11}, {252, 11},
+	{251, 11}, {251, 11}, {250, 11}, {250, 11}, {248, 11}, {248, 11}, {247, 11}, {247, 11},
+	{246, 11}, {246, 11}, {245, 11}, {245, 11}, {244, 11}, {244, 11}, {243, 11}, {243, 11},
+	{242, 11}, {242, 11}, {238, 11}, {238, 11}, {237, 11}, {237, 11}, {236, 11}, {236, 11},
+	{235, 11}, {235, 11}, {234, 11}, {234, 11}, {233, 11}, {233, 11}, {232, 11}, {232, 11},
+	{231, 11}, {231, 11}, {230, 11}, {230, 11}, {229, 11}, {229, 11}, {227, 11}, {227, 11},
+	{221, 11}, {221, 11}, {213, 11}, {213, 11}, {239, 10}, {239, 10}, {239, 10}, {239, 10},
+	{228, 10}, {228, 10}, {228, 10}, {228, 10}, {226, 10}, {226, 10}, {226, 10}, {226, 10},
+	{225, 10}, {225, 10}, {225, 10}, {225, 10}, {223, 10}, {223, 10}, {223, 10}, {223, 10},
+	{222, 10}, {222, 10}, {222, 10}, {222, 10}, {220, 10}, {220, 10}, {220, 10}, {220, 10},
+	{219, 10}, {219, 10}, {219, 10}, {219, 10}, {218, 10}, {218, 10}, {218, 10}, {218, 10},
+	{217, 10}, {217, 10}, {217, 10}, {217, 10}, {216, 10}, {216, 10}, {216, 10}, {216, 10},
+	{215, 10}, {215, 10}, {215, 10}, {215, 10}, {214, 10}, {214, 10}, {214, 10}, {214, 10},
+	{212, 10}, {212, 10}, {212, 10}, {212, 10}, {211, 10}, {211, 10}, {211, 10}, {211, 10},
+	{210, 10}, {210, 10}, {210, 10}, {210, 10}, {209, 10}, {209, 10}, {209, 10}, {209, 10},
+	{208, 10}, {208, 10}, {208, 10}, {208, 10}, {207, 10}, {207, 10}, {207, 10}, {207, 10},
+	{206, 10}, {206, 10}, {206, 10}, {206, 10}, {205, 10}, {205, 10}, {205, 10}, {205, 10},
+	{204, 10}, {204, 10}, {204, 10}, {204, 10}, {203, 10}, {203, 10}, {203, 10}, {203, 10},
+	{202, 10}, {202, 10}, {202, 10}, {202, 10}, {201, 10}, {201, 10}, {201, 10}, {201, 10},
+	{200, 10}, {200, 10}, {200, 10}, {200, 10}, {199, 10}, {199, 10}, {199, 10}, {199, 10},
+	{198, 10}, {198, 10}, {198, 10}, {198, 10}, {197, 10}, {197, 10}, {197, 10}, {197, 10},
+	{196, 10}, {196, 10}, {196, 10}, {196, 10}, {195, 10}, {195, 10}, {195, 10}, {195, 10},
+	{194, 10}, {194, 10}, {194, 10}, {194, 10}, {193, 10}, {193, 10}, {193, 10}, {193, 10},
+	{192, 10}, {192, 10}, {192, 10}, {192, 10}, {191, 10}, {191, 10}, {191, 10}, {191, 10},
+	{190, 10}, {190, 10}, {190, 10}, {190, 10}, {189, 10}, {189, 10}, {189, 10}, {189, 10},
+	{188, 10}, {188, 10}, {188, 10}, {188, 10}, {187, 10}, {187, 10}, {187, 10}, {187, 10},
+	{186, 10}, {186, 10}, {186, 10}, {186, 10}, {185, 10}, {185, 10}, {185, 10}, {185, 10},
+	{184, 10}, {184, 10}, {184, 10}, {184, 10}, {183, 10}, {183, 10}, {183, 10}, {183, 10},
+	{182, 10}, {182, 10}, {182, 10}, {182, 10}, {181, 10}, {181, 10}, {181, 10}, {181, 10},
+	{180, 10}, {180, 10}, {180, 10}, {180, 10}, {179, 10}, {179, 10}, {179, 10}, {179, 10},
+	{178, 10}, {178, 10}, {178, 10}, {178, 10}, {177, 10}, {177, 10}, {177, 10}, {177, 10},
+	{176, 10}, {176, 10}, {176, 10}, {176, 10}, {175, 10}, {175, 10}, {175, 10}, {175, 10},
+	{174, 10}, {174, 10}, {174, 10}, {174, 10}, {173, 10}, {173, 10}, {173, 10}, {173, 10},
+	{172, 10}, {172, 10}, {172, 10}, {172, 10}, {171, 10}, {171, 10}, {171, 10}, {171, 10},
+	{170, 10}, {170, 10}, {170, 10}, {170, 10}, {169, 10}, {169, 10}, {169, 10}, {169, 10},
+	{168, 10}, {168, 10}, {168, 10}, {168, 10}, {167, 10}, {167, 10}, {167, 10}, {167, 10},
+	{166, 10}, {166, 10}, {166, 10}, {166, 10}, {165, 10}, {165, 10}, {165, 10}, {165, 10},
+	{164, 10}, {164, 10}, {164, 10}, {164, 10}, {163, 10}, {163, 10}, {163, 10}, {163, 10},
+	{162, 10}, {162, 10}, {162, 10}, {162, 10}, {161, 10}, {161, 10}, {161, 10}, {161, 10},
+	{160, 10}, {160, 10}, {160, 10}, {160, 10}, {159, 10}, {159, 10}, {159, 10}, {159, 10},
+	{158, 10}, {158, 10}, {158, 10}, {158, 10}, {157, 10}, {157, 10}, {157, 10}, {157, 10},
+	{156, 10}, {156, 10}, {156, 10}, {156, 10}, {155, 10}, {155, 10}, {155, 10}, {155, 10},
+	{154, 10}, {154, 10}, {154, 10}, {154, 10}, {153, 10}, {153, 10}, {153, 10}, {153, 10},
+	{152, 10}, {152, 10}, {152, 10}, {152, 10}, {151, 10}, {151, 10}, {151, 10}, {151, 10},
+	{150, 10}, {150, 10}, {150, 10}, {150, 10}, {149, 10}, {149, 10}, {149, 10}, {149, 10},
+	{148, 10}, {148, 10}, {148, 10}, {148, 10}, {147, 10}, {147, 10}, {147, 10}, {147, 10},
+	{146, 10}, {146, 10}, {146, 10}, {146, 10}, {145, 10}, {145, 10}, {145, 10}, {145, 10},
+	{144, 10}, {144, 10}, {144, 10}, {144, 10}, {143, 10}, {143, 10}, {143, 10}, {143, 10},
+	{142, 10}, {142, 10}, {142, 10}, {142, 10}, {141, 10}, {141, 10}, {141, 10}, {141, 10},
+	{140, 10}, {140, 10}, {140, 10}, {140, 10}, {139, 10}, {139, 10}, {139, 10}, {139, 10},
+	{138, 10}, {138, 10}, {138, 10}, {138, 10}, {137, 10}, {137, 10}, {137, 10}, {137, 10},
+	{136, 10}, {136, 10}, {136, 10}, {136, 10}, {135, 10}, {135, 10}, {135, 10}, {135, 10},
+	{134, 10}, {134, 10}, {134, 10}, {134, 10}, {133, 10}, {133, 10}, {133, 10}, {133, 10},
+	{132, 10}, {132, 10}, {132, 10}, {132, 10}, {131, 10}, {131, 10}, {131, 10}, {131, 10},
+	{130, 10}, {130, 10}, {130, 10}, {130, 10}, {129, 10}, {129, 10}, {129, 10}, {129, 10},
+	{127, 10}, {127, 10}, {127, 10}, {127, 10}, {126, 10}, {126, 10}, {126, 10}, {126, 10},
+	{125, 10}, {125, 10}, {125, 10}, {125, 10}, {124, 10}, {124, 10}, {124, 10}, {124, 10},
+	{123, 10}, {123, 10}, {123, 10}, {123, 10}, {122, 10}, {122, 10}, {122, 10}, {122, 10},
+	{121, 10}, {121, 10}, {121, 10}, {121, 10}, {120, 10}, {120, 10}, {120, 10}, {120, 10},
+	{119, 10}, {119, 10}, {119, 10}, {119, 10}, {118, 10}, {118, 10}, {118, 10}, {118, 10},
+	{117, 10}, {117, 10}, {117, 10}, {117, 10}, {116, 10}, {116, 10}, {116, 10}, {116, 10},
+	{115, 10}, {115, 10}, {115, 10}, {115, 10}, {114, 10}, {114, 10}, {114, 10}, {114, 10},
+	{113, 10}, {113, 10}, {113, 10}, {113, 10}, {112, 10}, {112, 10}, {112, 10}, {112, 10},
+	{111, 10}, {111, 10}, {111, 10}, {111, 10}, {110, 10}, {110, 10}, {110, 10}, {110, 10},
+	{109, 10}, {109, 10}, {109, 10}, {109, 10}, {108, 10}, {108, 10}, {108, 10}, {108, 10},
+	{107, 10}, {107, 10}, {107, 10}, {107, 10}, {106, 10}, {106, 10}, {106, 10}, {106, 10},
+	{105, 10}, {105, 10}, {105, 10}, {105, 10}, {104, 10}, {104, 10}, {104, 10}, {104, 10},
+	{103, 10}, {103, 10}, {103, 10}, {103, 10}, {102, 10}, {102, 10}, {102, 10}, {102, 10},
+	{101, 10}, {101, 10}, {101, 10}, {101, 10}, {100, 10}, {100, 10}, {100, 10}, {100, 10},
+	{99, 10}, {99, 10}, {99, 10}, {99, 10}, {98, 10}, {98, 10}, {98, 10}, {98, 10},
+	{97, 10}, {97, 10}, {97, 10}, {97, 10}, {96, 10}, {96, 10}, {96, 10}, {96, 10},
+	{95, 10}, {95, 10}, {95, 10}, {95, 10}, {94, 10}, {94, 10}, {94, 10}, {94, 10},
+	{93, 10}, {93, 10}, {93, 10}, {93, 10}, {92, 10}, {92, 10}, {92, 10}, {92, 10},
+	{91, 10}, {91, 10}, {91, 10}, {91, 10}, {90, 10}, {90, 10}, {90, 10}, {90, 10},
+	{89, 10}, {89, 10}, {89, 10}, {89, 10}, {88, 10}, {88, 10}, {88, 10}, {88, 10},
+	{87, 10}, {87, 10}, {87, 10}, {87, 10}, {86, 10}, {86, 10}, {86, 10}, {86, 10},
+	{85, 10}, {85, 10}, {85, 10}, {85, 10}, {84, 10}, {84, 10}, {84, 10}, {84, 10},
+	{83, 10}, {83, 10}, {83, 10}, {83, 10}, {82, 10}, {82, 10}, {82, 10}, {82, 10},
+	{78, 10}, {78, 10}, {78, 10}, {78, 10}, {77, 10}, {77, 10}, {77, 10}, {77, 10},
+	{75, 10}, {75, 10}, {75, 10}, {75, 10}, {74, 10}, {74, 10}, {74, 10}, {74, 10},
+	{255, 9}, {255, 9}, {255, 9}, {255, 9}, {255, 9}, {255, 9}, {255, 9}, {255, 9},
+	{241, 9}, {241, 9}, {241, 9}, {241, 9}, {241, 9}, {241, 9}, {241, 9}, {241, 9},
+	{224, 9}, {224, 9}, {224, 9}, {224, 9}, {224, 9}, {224, 9}, {224, 9}, {224, 9},
+	{128, 9}, {128, 9}, {128, 9}, {128, 9}, {128, 9}, {128, 9}, {128, 9}, {128, 9},
+	{81, 9}, {81, 9}, {81, 9}, {81, 9}, {81, 9}, {81, 9}, {81, 9}, {81, 9},
+	{79, 9}, {79, 9}, {79, 9}, {79, 9}, {79, 9}, {79, 9}, {79, 9}, {79, 9},
+	{76, 9}, {76, 9}, {76, 9}, {76, 9}, {76, 9}, {76, 9}, {76, 9}, {76, 9},
+	{73, 9}, {73, 9}, {73, 9}, {73, 9}, {73, 9}, {73, 9}, {73, 9}, {73, 9},
+	{72, 9}, {72, 9}, {72, 9}, {72, 9}, {72, 9}, {72, 9}, {72, 9}, {72, 9},
+	{71, 9}, {71, 9}, {71, 9}, {71, 9}, {71, 9}, {71, 9}, {71, 9}, {71, 9},
+	{70, 9}, {70, 9}, {70, 9}, {70, 9}, {70, 9}, {70, 9}, {70, 9}, {70, 9},
+	{69, 9}, {69, 9}, {69, 9}, {69, 9}, {69, 9}, {69, 9}, {69, 9}, {69, 9},
+	{68, 9}, {68, 9}, {68, 9}, {68, 9}, {68, 9}, {68, 9}, {68, 9}, {68, 9},
+	{67, 9}, {67, 9}, {67, 9}, {67, 9}, {67, 9}, {67, 9}, {67, 9}, {67, 9},
+	{66, 9}, {66, 9}, {66, 9}, {66, 9}, {66, 9}, {66, 9}, {66, 9}, {66, 9},
+	{65, 9}, {65, 9}, {65, 9}, {65, 9}, {65, 9}, {65, 9}, {65, 9}, {65, 9},
+	{63, 9}, {63, 9}, {63, 9}, {63, 9}, {63, 9}, {63, 9}, {63, 9}, {63, 9},
+	{62, 9}, {62, 9}, {62, 9}, {62, 9}, {62, 9}, {62, 9}, {62, 9}, {62, 9},
+	{61, 9}, {61, 9}, {61, 9}, {61, 9}, {61, 9}, {61, 9}, {61, 9}, {61, 9},
+	{60, 9}, {60, 9}, {60, 9}, {60, 9}, {60, 9}, {60, 9}, {60, 9}, {60, 9},
+	{59, 9}, {59, 9}, {59, 9}, {59, 9}, {59, 9}, {59, 9}, {59, 9}, {59, 9},
+	{58, 9}, {58, 9}, {58, 9}, {58, 9}, {58, 9}, {58, 9}, {58, 9}, {58, 9},
+	{57, 9}, {57, 9}, {57, 9}, {57, 9}, {57, 9}, {57, 9}, {57, 9}, {57, 9},
+	{56, 9}, {56, 9}, {56, 9}, {56, 9}, {56, 9}, {56, 9}, {56, 9}, {56, 9},
+	{55, 9}, {55, 9}, {55, 9}, {55, 9}, {55, 9}, {55, 9}, {55, 9}, {55, 9},
+	{54, 9}, {54, 9}, {54, 9}, {54, 9}, {54, 9}, {54, 9}, {54, 9}, {54, 9},
+	{53, 9}, {53, 9}, {53, 9}, {53, 9}, {53, 9}, {53, 9}, {53, 9}, {53, 9},
+	{52, 9}, {52, 9}, {52, 9}, {52, 9}, {52, 9}, {52, 9}, {52, 9}, {52, 9},
+	{51, 9}, {51, 9}, {51, 9}, {51, 9}, {51, 9}, {51, 9}, {51, 9}, {51, 9},
+	{50, 9}, {50, 9}, {50, 9}, {50, 9}, {50, 9}, {50, 9}, {50, 9}, {50, 9},
+	{49, 9}, {49, 9}, {49, 9}, {49, 9}, {49, 9}, {49, 9}, {49, 9}, {49, 9},
+	{47, 9}, {47, 9}, {47, 9}, {47, 9}, {47, 9}, {47, 9}, {47, 9}, {47, 9},
+	{46, 9}, {46, 9}, {46, 9}, {46, 9}, {46, 9}, {46, 9}, {46, 9}, {46, 9},
+	{45, 9}, {45, 9}, {45, 9}, {45, 9}, {45, 9}, {45, 9}, {45, 9}, {45, 9},
+	{44, 9}, {44, 9}, {44, 9}, {44, 9}, {44, 9}, {44, 9}, {44, 9}, {44, 9},
+	{43, 9}, {43, 9}, {43, 9}, {43, 9}, {43, 9}, {43, 9}, {43, 9}, {43, 9},
+	{42, 9}, {42, 9}, {42, 9}, {42, 9}, {42, 9}, {42, 9}, {42, 9}, {42, 9},
+	{41, 9}, {41, 9}, {41, 9}, {41, 9}, {41, 9}, {41, 9}, {41, 9}, {41, 9},
+	{40, 9}, {40, 9}, {40, 9}, {40, 9}, {40, 9}, {40, 9}, {40, 9}, {40, 9},
+	{39, 9}, {39, 9}, {39, 9}, {39, 9}, {39, 9}, {39, 9}, {39, 9}, {39, 9},
+	{38, 9}, {38, 9}, {38, 9}, {38, 9}, {38, 9}, {38, 9}, {38, 9}, {38, 9},
+	{37, 9}, {37, 9}, {37, 9}, {37, 9}, {37, 9}, {37, 9}, {37, 9}, {37, 9},
+	{240, 8}, {240, 8}, {240, 8}, {240, 8}, {240, 8}, {240, 8}, {240, 8}, {240, 8},
+	{240, 8}, {240, 8}, {240, 8}, {240, 8}, {240, 8}, {240, 8}, {240, 8}, {240, 8},
+	{64, 8}, {64, 8}, {64, 8}, {64, 8}, {64, 8}, {64, 8}, {64, 8}, {64, 8},
+	{64, 8}, {64, 8}, {64, 8}, {64, 8}, {64, 8}, {64, 8}, {64, 8}, {64, 8},
+	{48, 8}, {48, 8}, {48, 8}, {48, 8}, {48, 8}, {48, 8}, {48, 8}, {48, 8},
+	{48, 8}, {48, 8}, {48, 8}, {48, 8}, {48, 8}, {48, 8}, {48, 8}, {48, 8},
+	{36, 8}, {36, 8}, {36, 8}, {36, 8}, {36, 8}, {36, 8}, {36, 8}, {36, 8},
+	{36, 8}, {36, 8}, {36, 8}, {36, 8}, {36, 8}, {36, 8}, {36, 8}, {36, 8},
+	{35, 8}, {35, 8}, {35, 8}, {35, 8}, {35, 8}, {35, 8}, {35, 8}, {35, 8},
+	{35, 8}, {35, 8}, {35, 8}, {35, 8}, {35, 8}, {35, 8}, {35, 8}, {35, 8},
+	{34, 8}, {34, 8}, {34, 8}, {34, 8}, {34, 8}, {34, 8}, {34, 8}, {34, 8},
+	{34, 8}, {34, 8}, {34, 8}, {34, 8}, {34, 8}, {34, 8}, {34, 8}, {34, 8},
+	{33, 8}, {33, 8}, {33, 8}, {33, 8}, {33, 8}, {33, 8}, {33, 8}, {33, 8},
+	{33, 8}, {33, 8}, {33, 8}, {33, 8}, {33, 8}, {33, 8}, {33, 8}, {33, 8},
+	{32, 8}, {32, 8}, {32, 8}, {32, 8}, {32, 8}, {32, 8}, {32, 8}, {32, 8},
+	{32, 8}, {32, 8}, {32, 8}, {32, 8}, {32, 8}, {32, 8}, {32, 8}, {32, 8},
+	{31, 8}, {31, 8}, {31, 8}, {31, 8}, {31, 8}, {31, 8}, {31, 8}, {31, 8},
+	{31, 8}, {31, 8}, {31, 8}, {31, 8}, {31, 8}, {31, 8}, {31, 8}, {31, 8},
+	{30, 8}, {30, 8}, {30, 8}, {30, 8}, {30, 8}, {30, 8}, {30, 8}, {30, 8},
+	{30, 8}, {30, 8}, {30, 8}, {30, 8}, {30, 8}, {30, 8}, {30, 8}, {30, 8},
+	{29, 8}, {29, 8}, {29, 8}, {29, 8}, {29, 8}, {29, 8}, {29, 8}, {29, 8},
+	{29, 8}, {29, 8}, {29, 8}, {29, 8}, {29, 8}, {29, 8}, {29, 8}, {29, 8},
+	{28, 8}, {28, 8}, {28, 8}, {28, 8}, {28, 8}, {28, 8}, {28, 8}, {28, 8},
+	{28, 8}, {28, 8}, {28, 8}, {28, 8}, {28, 8}, {28, 8}, {28, 8}, {28, 8},
+	{27, 8}, {27, 8}, {27, 8}, {27, 8}, {27, 8}, {27, 8}, {27, 8}, {27, 8},
+	{27, 8}, {27, 8}, {27, 8}, {27, 8}, {27, 8}, {27, 8}, {27, 8}, {27, 8},
+	{26, 8}, {26, 8}, {26, 8}, {26, 8}, {26, 8}, {26, 8}, {26, 8}, {26, 8},
+	{26, 8}, {26, 8}, {26, 8}, {26, 8}, {26, 8}, {26, 8}, {26, 8}, {26, 8},
+	{25, 8}, {25, 8}, {25, 8}, {25, 8}, {25, 8}, {25, 8}, {25, 8}, {25, 8},
+	{25, 8}, {25, 8}, {25, 8}, {25, 8}, {25, 8}, {25, 8}, {25, 8}, {25, 8},
+	{24, 8}, {24, 8}, {24, 8}, {24, 8}, {24, 8}, {24, 8}, {24, 8}, {24, 8},
+	{24, 8}, {24, 8}, {24, 8}, {24, 8}, {24, 8}, {24, 8}, {24, 8}, {24, 8},
+	{23, 8}, {23, 8}, {23, 8}, {23, 8}, {23, 8}, {23, 8}, {23, 8}, {23, 8},
+	{23, 8}, {23, 8}, {23, 8}, {23, 8}, {23, 8}, {23, 8}, {23, 8}, {23, 8},
+	{22, 8}, {22, 8}, {22, 8}, {22, 8}, {22, 8}, {22, 8}, {22, 8}, {22, 8},
+	{22, 8}, {22, 8}, {22, 8}, {22, 8}, {22, 8}, {22, 8}, {22, 8}, {22, 8},
+	{21, 8}, {21, 8}, {21, 8}, {21, 8}, {21, 8}, {21, 8}, {21, 8}, {21, 8},
+	{21, 8}, {21, 8}, {21, 8}, {21, 8}, {21, 8}, {21, 8}, {21, 8}, {21, 8},
+	{20, 8}, {20, 8}, {20, 8}, {20, 8}, {20, 8}, {20, 8}, {20, 8}, {20, 8},
+	{20, 8}, {20, 8}, {20, 8}, {20, 8}, {20, 8}, {20, 8}, {20, 8}, {20, 8},
+	{19, 8}, {19, 8}, {19, 8}, {19, 8}, {19, 8}, {19, 8}, {19, 8}, {19, 8},
+	{19, 8}, {19, 8}, {19, 8}, {19, 8}, {19, 8}, {19, 8}, {19, 8}, {19, 8},
+	{18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7},
+	{18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7},
+	{18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7},
+	{18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7}, {18, 7},
+	{17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7},
+	{17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7},
+	{17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7},
+	{17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7}, {17, 7},
+	{15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7},
+	{15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7},
+	{15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7},
+	{15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7}, {15, 7},
+	{14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7},
+	{14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7},
+	{14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7},
+	{14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7}, {14, 7},
+	{13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7},
+	{13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7},
+	{13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7},
+	{13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7}, {13, 7},
+	{12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7},
+	{12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7},
+	{12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7},
+	{12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7}, {12, 7},
+	{11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7},
+	{11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7},
+	{11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7},
+	{11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7}, {11, 7},
+	{10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7},
+	{10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7},
+	{10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7},
+	{10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7}, {10, 7},
+	{9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7},
+	{9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7},
+	{9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7},
+	{9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7}, {9, 7},
+	{16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6},
+	{16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6},
+	{16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6},
+	{16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6},
+	{16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6},
+	{16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6},
+	{16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6},
+	{16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6}, {16, 6},
+	{8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6},
+	{8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6},
+	{8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6},
+	{8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6},
+	{8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6},
+	{8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6},
+	{8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6},
+	{8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6}, {8, 6},
+	{7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6},
+	{7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6},
+	{7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6},
+	{7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6},
+	{7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6},
+	{7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6},
+	{7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6},
+	{7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6}, {7, 6},
+	{6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6},
+	{6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6},
+	{6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6},
+	{6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6},
+	{6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6},
+	{6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6},
+	{6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6},
+	{6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6}, {6, 6},
+	{5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6},
+	{5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6},
+	{5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6},
+	{5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6},
+	{5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6},
+	{5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6},
+	{5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6},
+	{5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6}, {5, 6},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5}, {80, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5}, {4, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5}, {3, 5},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4}, {2, 4},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3}, {1, 3},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+	{0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2}, {0, 2},
+}
@@ -0,0 +1,299 @@
+// Package offload copies synced sessions from the Pi SD card to an attached
+// USB stick or SSD.
+//
+// Each session is streamed with read-ahead into large sequential writes,
+// fsynced, then read back and checked against the SHA-256 in its manifest
+// before it counts as offloaded. The manifest is written last, so a session
+// directory on the USB drive without one is an interrupted copy and is redone.
+package offload
+
+import (
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/storage"
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+const (
+	// DestDirName is the directory created on the USB drive for sessions.
+	DestDirName = "logfalcon"
+
+	chunkSize      = 1 << 20 // large writes suit USB flash translation layers
+	readAhead      = 4       // chunks read ahead of the writer
+	busyCheckEvery = 64      // chunks between sync-active checks
+	partSuffix     = ".part"
+)
+
+var (
+	// ErrNotMounted is returned when the destination is not a mount point, so
+	// nothing is copied onto the SD card's own filesystem by mistake.
+	ErrNotMounted = errors.New("offload destination is not a mounted filesystem")
+	// ErrSyncActive is returned when a sync starts; the job stops at once and
+	// picks up where it left off next time.
+	ErrSyncActive = errors.New("sync in progress")
+	// ErrVerifyFailed is returned when the copy does not match the manifest.
+	ErrVerifyFailed = errors.New("offloaded copy does not match manifest hash")
+)
+
+// Options configures an offload run.
+type Options struct {
+	// Dest is the mount point of the USB drive.
+	Dest string
+	// DeleteLocal removes verified sessions from the SD card, except pinned ones.
+	DeleteLocal bool
+	// SkipMountCheck allows a plain directory as Dest (tests).
+	SkipMountCheck bool
+	// SyncActive reports whether a sync is running; nil means never.
+	SyncActive func() bool
+}
+
+// Result summarises an offload run.
+type Result struct {
+	Offloaded      []string // sessions copied and verified in this run
+	AlreadyPresent int      // sessions found complete on the drive
+	Bytes          int64    // raw flash bytes copied
+	DeletedLocal   []string // sessions removed from the SD card afterwards
+}
+
+// Run offloads every complete session in store that is not yet on the drive,
+// oldest first.
+func Run(store storage.Store, opts Options) (*Result, error) {
+	busy := opts.SyncActive
+	if busy == nil {
+		busy = func() bool { return false }
+	}
+	if _, err := os.Stat(opts.Dest); err != nil {
+		return nil, fmt.Errorf("offload destination: %w", err)
+	}
+	if !opts.SkipMountCheck {
+		mounted, err := util.IsMountPoint(opts.Dest)
+		if err != nil {
+			return nil, fmt.Errorf("offload destination: %w", err)
+		}
+		if !mounted {
+			return nil, ErrNotMounted
+		}
+	}
+
+	sessions, err := store.ListSessions()
+	if err != nil {
+		return nil, fmt.Errorf("list sessions: %w", err)
+	}
+
+	res := &Result{}
+	destRoot := filepath.Join(opts.Dest, DestDirName)
+	for i := len(sessions) - 1; i >= 0; i-- {
+		sess := sessions[i]
+		m := sess.Manifest
+		if m == nil || m.File.SHA256 == "" {
+			continue // sync still running or never finished
+		}
+		if busy() {
+			return res, ErrSyncActive
+		}
+
+		dir := filepath.Join(destRoot, sess.FCDir, sess.SessionDir)
+		if onDrive(dir, m) {
+			res.AlreadyPresent++
+		} else {
+			n, err := copySession(store, sess, dir, busy)
+			if err != nil {
+				return res, fmt.Errorf("offload %s: %w", sess.SessionID, err)
+			}
+			res.Offloaded = append(res.Offloaded, sess.SessionID)
+			res.Bytes += n
+		}
+
+		if m.OffloadedUTC == "" {
+			_ = store.UpdateManifest(sess.SessionID, func(m *storage.Manifest) {
+				m.OffloadedUTC = time.Now().UTC().Format(time.RFC3339)
+			})
+		}
+		if opts.DeleteLocal && !m.Pinned {
+			if err := store.Delete(sess.SessionID); err != nil && !errors.Is(err, os.ErrNotExist) {
+				return res, fmt.Errorf("free local copy of %s: %w", sess.SessionID, err)
+			}
+			res.DeletedLocal = append(res.DeletedLocal, sess.SessionID)
+		}
+	}
+	return res, nil
+}
+
+// onDrive reports whether dir already holds a verified copy matching m.
+func onDrive(dir string, m *storage.Manifest) bool {
+	data, err := os.ReadFile(filepath.Join(dir, storage.ManifestFilename))
+	if err != nil {
+		return false
+	}
+	var onUSB storage.Manifest
+	if err := json.Unmarshal(data, &onUSB); err != nil || onUSB.File.SHA256 != m.File.SHA256 {
+		return false
+	}
+	info, err := os.Stat(filepath.Join(dir, storage.RawFlashFilename))
+	return err == nil && info.Size() == m.File.Bytes
+}
+
+// copySession streams one session's raw flash into dir, verifies it and then
+// writes its manifest. Returns the bytes copied.
+func copySession(store storage.Store, sess *storage.Session, dir string, busy func() bool) (int64, error) {
+	if err := os.MkdirAll(dir, 0o755); err != nil {
+		return 0, err
+	}
+	src, err := store.Open(sess.SessionID, storage.RawFlashFilename)
+	if err != nil {
+		return 0, err
+	}
+	defer src.Close()
+
+	dst := filepath.Join(dir, storage.RawFlashFilename)
+	part := dst + partSuffix
+	f, err := os.OpenFile(part, os.O_WRONLY|os.O_CREATE|os.O_TRUNC, 0o644)
+	if err != nil {
+		return 0, err
+	}
+	n, err := copyReadAhead(f, src, busy)
+	if err == nil && n != sess.Manifest.File.Bytes {
+		err = fmt.Errorf("copied %d bytes, manifest says %d", n, sess.Manifest.File.Bytes)
+	}
+	if err == nil {
+		err = f.Sync()
+	}
+	if cerr := f.Close(); err == nil {
+		err = cerr
+	}
+	if err == nil {
+		err = verifyFile(part, sess.Manifest.File.SHA256)
+	}
+	if err != nil {
+		_ = os.Remove(part)
+		return 0, err
+	}
+	if err := os.Rename(part, dst); err != nil {
+		return 0, err
+	}
+
+	m := *sess.Manifest
+	m.OffloadedUTC = time.Now().UTC().Format(time.RFC3339)
+	data, err := json.MarshalIndent(&m, "", "  ")
+	if err != nil {
+		return 0, err
+	}
+	if err := writeSync(filepath.Join(dir, storage.ManifestFilename), data); err != nil {
+		return 0, err
+	}
+	_ = syncDir(dir) // best effort: not every USB filesystem supports it
+	return n, nil
+}
+
+// copyReadAhead copies src to dst in chunkSize writes. The reads stay on the
+// calling goroutine, and so on the caller's OS thread and its idle I/O class.
+// A writer goroutine drains up to readAhead filled chunks, so SD reads and
+// USB writes overlap. It checks busy every busyCheckEvery chunks and stops
+// with ErrSyncActive.
+func copyReadAhead(dst io.Writer, src io.Reader, busy func() bool) (int64, error) {
+	type result struct {
+		n   int64
+		err error
+	}
+	// There are only readAhead buffers, so sending to full never blocks.
+	free := make(chan []byte, readAhead)
+	for i := 0; i < readAhead; i++ {
+		free <- make([]byte, chunkSize)
+	}
+	full := make(chan []byte, readAhead)
+	wrote := make(chan result, 1)
+
+	go func() {
+		var written int64
+		for buf := range full {
+			if _, err := dst.Write(buf); err != nil {
+				wrote <- result{written, err}
+				return
+			}
+			written += int64(len(buf))
+			free <- buf[:cap(buf)]
+		}
+		wrote <- result{written, nil}
+	}()
+
+	var readErr error
+	for i := 1; ; i++ {
+		var buf []byte
+		select {
+		case buf = <-free:
+		case r := <-wrote: // the writer failed
+			return r.n, r.err
+		}
+		n, err := io.ReadFull(src, buf)
+		if n > 0 {
+			full <- buf[:n]
+		}
+		if err == io.EOF || err == io.ErrUnexpectedEOF {
+			break
+		}
+		if err != nil {
+			readErr = err
+			break
+		}
+		if i%busyCheckEvery == 0 && busy() {
+			readErr = ErrSyncActive
+			break
+		}
+	}
+	close(full)
+	r := <-wrote
+	if r.err != nil {
+		return r.n, r.err
+	}
+	return r.n, readErr
+}
+
+// verifyFile re-reads path from the drive and compares its SHA-256 to want.
+func verifyFile(path, want string) error {
+	f, err := os.Open(path)
+	if err != nil {
+		return err
+	}
+	defer f.Close()
+	h := sha256.New()
+	if _, err := io.CopyBuffer(h, f, make([]byte, chunkSize)); err != nil {
+		return err
+	}
+	if hex.EncodeToString(h.Sum(nil)) != want {
+		return ErrVerifyFailed
+	}
+	return nil
+}
+
+func writeSync(path string, data []byte) error {
+	f, err := os.OpenFile(path, os.O_WRONLY|os.O_CREATE|os.O_TRUNC, 0o644)
+	if err != nil {
+		return err
+	}
+	if _, err := f.Write(data); err != nil {
+		_ = f.Close()
+		return err
+	}
+	if err := f.Sync(); err != nil {
+		_ = f.Close()
+		return err
+	}
+	return f.Close()
+}
+
+func syncDir(dir string) error {
+	d, err := os.Open(dir)
+	if err != nil {
+		return err
+	}
+	defer d.Close()
+	return d.Sync()
+}
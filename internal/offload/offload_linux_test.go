@@ -0,0 +1,39 @@
+package offload
+
+import (
+	"bytes"
+	"io"
+	"runtime"
+	"syscall"
+	"testing"
+)
+
+// threadReader fails the test if it is read from any thread but tid.
+type threadReader struct {
+	t   *testing.T
+	r   io.Reader
+	tid int
+}
+
+func (r *threadReader) Read(p []byte) (int, error) {
+	if tid := syscall.Gettid(); tid != r.tid {
+		r.t.Errorf("read on thread %d, want the caller's thread %d", tid, r.tid)
+	}
+	return r.r.Read(p)
+}
+
+// The caller's thread carries the idle I/O class, so every SD read must
+// happen there and only the writes may move.
+func TestCopyReadAheadReadsOnCallerThread(t *testing.T) {
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+
+	data := bytes.Repeat([]byte("logfalcon"), (3*chunkSize)/9+1234)
+	src := &threadReader{t: t, r: bytes.NewReader(data), tid: syscall.Gettid()}
+	var dst bytes.Buffer
+	n, err := copyReadAhead(&dst, src, func() bool { return false })
+	if err != nil || n != int64(len(data)) || !bytes.Equal(dst.Bytes(), data) {
+		t.Fatalf("copyReadAhead = %d, %v; copied %d of %d bytes intact=%v",
+			n, err, dst.Len(), len(data), bytes.Equal(dst.Bytes(), data))
+	}
+}
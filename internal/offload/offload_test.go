@@ -0,0 +1,166 @@
+package offload
+
+import (
+	"bytes"
+	"errors"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/proeugene/logfalcon/internal/storage"
+)
+
+func addSession(t *testing.T, store storage.Store, uid string, data []byte) string {
+	t.Helper()
+	info := &storage.FCInfo{APIMajor: 1, APIMinor: 46, Variant: "BTFL", UID: uid}
+	id, w, err := store.Create(info)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if _, err := w.Write(data); err != nil {
+		t.Fatal(err)
+	}
+	if err := w.Close(); err != nil {
+		t.Fatal(err)
+	}
+	m := storage.NewManifest(info, w.SHA256Hex(), int64(len(data)), true, true, nil)
+	if err := store.PutManifest(id, m); err != nil {
+		t.Fatal(err)
+	}
+	return id
+}
+
+func TestOffloadCopiesAndVerifies(t *testing.T) {
+	store := storage.NewDirStore(t.TempDir())
+	dest := t.TempDir()
+	big := bytes.Repeat([]byte("0123456789abcdef"), (3*chunkSize)/16+77) // several chunks plus a tail
+	id := addSession(t, store, "aaaaaaaa", big)
+
+	res, err := Run(store, Options{Dest: dest, SkipMountCheck: true})
+	if err != nil {
+		t.Fatalf("Run: %v", err)
+	}
+	if len(res.Offloaded) != 1 || res.Bytes != int64(len(big)) {
+		t.Fatalf("result = %+v", res)
+	}
+	got, err := os.ReadFile(filepath.Join(dest, DestDirName, id, storage.RawFlashFilename))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got, big) {
+		t.Fatal("offloaded bytes differ from the session")
+	}
+	if _, err := os.Stat(filepath.Join(dest, DestDirName, id, storage.ManifestFilename)); err != nil {
+		t.Fatalf("manifest not offloaded: %v", err)
+	}
+
+	sessions, _ := store.ListSessions()
+	if sessions[0].Manifest.OffloadedUTC == "" {
+		t.Error("local manifest should record the offload")
+	}
+
+	// A second run finds the copy and does not rewrite it.
+	res, err = Run(store, Options{Dest: dest, SkipMountCheck: true})
+	if err != nil {
+		t.Fatalf("second Run: %v", err)
+	}
+	if len(res.Offloaded) != 0 || res.AlreadyPresent != 1 {
+		t.Fatalf("second run result = %+v, want already present", res)
+	}
+}
+
+func TestOffloadRedoesInterruptedCopy(t *testing.T) {
+	store := storage.NewDirStore(t.TempDir())
+	dest := t.TempDir()
+	id := addSession(t, store, "aaaaaaaa", []byte("flight data"))
+
+	// Leftover from an interrupted run: data without a manifest.
+	dir := filepath.Join(dest, DestDirName, id)
+	if err := os.MkdirAll(dir, 0o755); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.WriteFile(filepath.Join(dir, storage.RawFlashFilename), []byte("flig"), 0o644); err != nil {
+		t.Fatal(err)
+	}
+
+	res, err := Run(store, Options{Dest: dest, SkipMountCheck: true})
+	if err != nil {
+		t.Fatalf("Run: %v", err)
+	}
+	if len(res.Offloaded) != 1 {
+		t.Fatalf("interrupted copy should be redone, result = %+v", res)
+	}
+}
+
+func TestOffloadDeleteLocalKeepsPinned(t *testing.T) {
+	store := storage.NewDirStore(t.TempDir())
+	dest := t.TempDir()
+	keep := addSession(t, store, "aaaaaaaa", []byte("pinned flight"))
+	addSession(t, store, "bbbbbbbb", []byte("other flight"))
+	if err := store.UpdateManifest(keep, func(m *storage.Manifest) { m.Pinned = true }); err != nil {
+		t.Fatal(err)
+	}
+
+	res, err := Run(store, Options{Dest: dest, DeleteLocal: true, SkipMountCheck: true})
+	if err != nil {
+		t.Fatalf("Run: %v", err)
+	}
+	if len(res.Offloaded) != 2 || len(res.DeletedLocal) != 1 {
+		t.Fatalf("result = %+v, want 2 offloaded and 1 deleted", res)
+	}
+	sessions, _ := store.ListSessions()
+	if len(sessions) != 1 || sessions[0].SessionID != keep {
+		t.Fatalf("local sessions after offload = %d, want only the pinned one", len(sessions))
+	}
+}
+
+func TestOffloadStopsForSync(t *testing.T) {
+	store := storage.NewDirStore(t.TempDir())
+	dest := t.TempDir()
+	addSession(t, store, "aaaaaaaa", []byte("flight"))
+
+	_, err := Run(store, Options{Dest: dest, SkipMountCheck: true, SyncActive: func() bool { return true }})
+	if !errors.Is(err, ErrSyncActive) {
+		t.Fatalf("Run during sync = %v, want ErrSyncActive", err)
+	}
+	if _, err := os.Stat(filepath.Join(dest, DestDirName)); !os.IsNotExist(err) {
+		t.Error("nothing should be written while a sync is active")
+	}
+}
+
+func TestOffloadRequiresMount(t *testing.T) {
+	store := storage.NewDirStore(t.TempDir())
+	if _, err := Run(store, Options{Dest: t.TempDir()}); !errors.Is(err, ErrNotMounted) {
+		t.Fatalf("Run on plain directory = %v, want ErrNotMounted", err)
+	}
+}
+
+// TestOffloadLoopMount runs against a real filesystem image. Set
+// LOGFALCON_OFFLOAD_TEST_MOUNT to a writable loop mount to enable it:
+//
+//	truncate -s 64M usb.img && mkfs.vfat usb.img
+//	sudo mount -o loop,uid=$(id -u) usb.img /mnt/usb
+//	LOGFALCON_OFFLOAD_TEST_MOUNT=/mnt/usb go test -run LoopMount ./internal/offload
+func TestOffloadLoopMount(t *testing.T) {
+	mount := os.Getenv("LOGFALCON_OFFLOAD_TEST_MOUNT")
+	if mount == "" {
+		t.Skip("LOGFALCON_OFFLOAD_TEST_MOUNT not set")
+	}
+	store := storage.NewDirStore(t.TempDir())
+	data := bytes.Repeat([]byte{0xa5}, 5*chunkSize+123)
+	id := addSession(t, store, "10095e11", data)
+	t.Cleanup(func() { _ = os.RemoveAll(filepath.Join(mount, DestDirName)) })
+
+	res, err := Run(store, Options{Dest: mount})
+	if err != nil {
+		t.Fatalf("Run: %v", err)
+	}
+	if len(res.Offloaded) != 1 {
+		t.Fatalf("result = %+v", res)
+	}
+	sessions, _ := store.ListSessions()
+	if err := verifyFile(filepath.Join(mount, DestDirName, id, storage.RawFlashFilename),
+		sessions[0].Manifest.File.SHA256); err != nil {
+		t.Fatalf("verify on loop mount: %v", err)
+	}
+}
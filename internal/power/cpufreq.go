@@ -0,0 +1,229 @@
+// Package power manages the Pi's CPU clock policy around syncs.
+//
+// The Pi spends most of its life idle on battery under the ondemand or
+// powersave governor, but during a sync every MHz shortens the time the
+// pilot waits. Boost switches every cpufreq policy to a faster governor (or,
+// if that governor is not offered, raises scaling_min_freq to the maximum)
+// and Restore puts the previous settings back.
+//
+// A boost outlives the process if the sync is killed before Restore runs, so
+// the previous settings are also saved to a state file; RestoreSaved puts
+// them back from there (at the next boost, or from the unit's ExecStopPost).
+package power
+
+import (
+	"encoding/json"
+	"errors"
+	"fmt"
+	"os"
+	"path/filepath"
+	"strconv"
+	"strings"
+	"sync"
+)
+
+// BoostStateName is the file in the runtime directory holding the settings
+// a boost replaced until Restore puts them back.
+const BoostStateName = "cpu_boost.json"
+
+// cpufreqRoot holds one policyN directory per clock domain; replaceable in
+// tests.
+var cpufreqRoot = "/sys/devices/system/cpu/cpufreq"
+
+// Boost remembers what it changed so Restore can undo it. Restore may be
+// called from a signal handler while the sync is still running.
+type Boost struct {
+	mu        sync.Mutex
+	saved     []policyState
+	statePath string
+}
+
+type policyState struct {
+	Dir      string `json:"dir"`
+	Governor string `json:"governor,omitempty"` // previous governor, if changed
+	MinFreq  string `json:"min_freq,omitempty"` // previous scaling_min_freq, if changed
+}
+
+// BoostCPU switches every cpufreq policy to governor. An empty governor
+// returns a no-op Boost. It fails only if no policy could be changed, e.g.
+// without write access to sysfs.
+//
+// If statePath is set, a boost left behind by a killed sync is undone first,
+// and the settings this boost replaces are saved there until Restore.
+func BoostCPU(governor, statePath string) (*Boost, error) {
+	b := &Boost{statePath: statePath}
+	if governor == "" {
+		return b, nil
+	}
+	if err := RestoreSaved(statePath); err != nil {
+		return b, fmt.Errorf("restoring an earlier boost: %w", err)
+	}
+	dirs, _ := filepath.Glob(filepath.Join(cpufreqRoot, "policy*"))
+	if len(dirs) == 0 {
+		return b, fmt.Errorf("no cpufreq policies under %s", cpufreqRoot)
+	}
+	var lastErr error
+	for _, dir := range dirs {
+		st, err := boostPolicy(dir, governor)
+		if err != nil {
+			lastErr = err
+			continue
+		}
+		b.saved = append(b.saved, st)
+	}
+	if len(b.saved) == 0 {
+		return b, lastErr
+	}
+	if statePath != "" {
+		// Without the state file a killed sync would leave the boost in
+		// place for good, so a failed save undoes it.
+		if err := saveState(statePath, b.saved); err != nil {
+			_ = b.Restore()
+			return b, fmt.Errorf("saving the boost state: %w", err)
+		}
+	}
+	return b, nil
+}
+
+func boostPolicy(dir, governor string) (policyState, error) {
+	st := policyState{Dir: dir}
+	current := readAttr(dir, "scaling_governor")
+	if current == governor {
+		return st, nil
+	}
+	if strings.Contains(" "+readAttr(dir, "scaling_available_governors")+" ", " "+governor+" ") {
+		if err := writeAttr(dir, "scaling_governor", governor); err != nil {
+			return st, err
+		}
+		st.Governor = current
+		return st, nil
+	}
+	// Governor not built in: pin the floor to the top frequency instead.
+	max := readAttr(dir, "cpuinfo_max_freq")
+	if max == "" {
+		return st, fmt.Errorf("%s: governor %q not available", dir, governor)
+	}
+	prevMin := readAttr(dir, "scaling_min_freq")
+	if err := writeAttr(dir, "scaling_min_freq", max); err != nil {
+		return st, err
+	}
+	st.MinFreq = prevMin
+	return st, nil
+}
+
+// Restore puts back the governors and minimum frequencies BoostCPU changed
+// and removes the state file. It is safe to call more than once, and
+// concurrently.
+func (b *Boost) Restore() error {
+	if b == nil {
+		return nil
+	}
+	b.mu.Lock()
+	defer b.mu.Unlock()
+	if len(b.saved) == 0 {
+		return nil
+	}
+	err := restorePolicies(b.saved)
+	b.saved = nil
+	if b.statePath != "" {
+		if rmErr := os.Remove(b.statePath); rmErr != nil && !errors.Is(rmErr, os.ErrNotExist) && err == nil {
+			err = rmErr
+		}
+	}
+	return err
+}
+
+// RestoreSaved undoes a boost whose process died before calling Restore,
+// using the settings saved in statePath. Without a state file it does
+// nothing.
+func RestoreSaved(statePath string) error {
+	if statePath == "" {
+		return nil
+	}
+	data, err := os.ReadFile(statePath)
+	if errors.Is(err, os.ErrNotExist) {
+		return nil
+	}
+	if err != nil {
+		return err
+	}
+	var saved []policyState
+	if err := json.Unmarshal(data, &saved); err != nil {
+		// Unreadable: nothing to put back, and keeping it would block boosts.
+		return os.Remove(statePath)
+	}
+	if err := restorePolicies(saved); err != nil {
+		return err
+	}
+	return os.Remove(statePath)
+}
+
+func restorePolicies(saved []policyState) error {
+	var firstErr error
+	for _, st := range saved {
+		if st.MinFreq != "" {
+			if err := writeAttr(st.Dir, "scaling_min_freq", st.MinFreq); err != nil && firstErr == nil {
+				firstErr = err
+			}
+		}
+		if st.Governor != "" {
+			if err := writeAttr(st.Dir, "scaling_governor", st.Governor); err != nil && firstErr == nil {
+				firstErr = err
+			}
+		}
+	}
+	return firstErr
+}
+
+// saveState writes the replaced settings atomically, so a crash mid-write
+// cannot leave a truncated file behind.
+func saveState(path string, saved []policyState) error {
+	data, err := json.Marshal(saved)
+	if err != nil {
+		return err
+	}
+	if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
+		return err
+	}
+	tmp := path + ".tmp"
+	if err := os.WriteFile(tmp, data, 0o644); err != nil {
+		return err
+	}
+	return os.Rename(tmp, path)
+}
+
+// Freq is a snapshot of the first cpufreq policy.
+type Freq struct {
+	Governor string
+	CurKHz   int
+	MinKHz   int
+	MaxKHz   int
+}
+
+// Sample reads the current clock policy. Missing values are zero.
+func Sample() Freq {
+	dir := filepath.Join(cpufreqRoot, "policy0")
+	return Freq{
+		Governor: readAttr(dir, "scaling_governor"),
+		CurKHz:   atoi(readAttr(dir, "scaling_cur_freq")),
+		MinKHz:   atoi(readAttr(dir, "scaling_min_freq")),
+		MaxKHz:   atoi(readAttr(dir, "scaling_max_freq")),
+	}
+}
+
+func readAttr(dir, name string) string {
+	data, err := os.ReadFile(filepath.Join(dir, name))
+	if err != nil {
+		return ""
+	}
+	return strings.TrimSpace(string(data))
+}
+
+func writeAttr(dir, name, val string) error {
+	return os.WriteFile(filepath.Join(dir, name), []byte(val), 0o644)
+}
+
+func atoi(s string) int {
+	n, _ := strconv.Atoi(s)
+	return n
+}
@@ -0,0 +1,140 @@
+package power
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+func fakePolicy(t *testing.T, attrs map[string]string) string {
+	t.Helper()
+	root := t.TempDir()
+	dir := filepath.Join(root, "policy0")
+	if err := os.MkdirAll(dir, 0o755); err != nil {
+		t.Fatal(err)
+	}
+	for name, val := range attrs {
+		if err := os.WriteFile(filepath.Join(dir, name), []byte(val+"\n"), 0o644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	old := cpufreqRoot
+	cpufreqRoot = root
+	t.Cleanup(func() { cpufreqRoot = old })
+	return dir
+}
+
+func TestBoostSwitchesGovernorAndRestores(t *testing.T) {
+	dir := fakePolicy(t, map[string]string{
+		"scaling_governor":            "ondemand",
+		"scaling_available_governors": "conservative ondemand userspace powersave performance schedutil",
+		"scaling_cur_freq":            "1000000",
+		"scaling_min_freq":            "700000",
+		"scaling_max_freq":            "1000000",
+	})
+
+	b, err := BoostCPU("performance", "")
+	if err != nil {
+		t.Fatalf("BoostCPU: %v", err)
+	}
+	if got := readAttr(dir, "scaling_governor"); got != "performance" {
+		t.Fatalf("governor during sync = %q, want performance", got)
+	}
+	if f := Sample(); f.Governor != "performance" || f.CurKHz != 1000000 || f.MinKHz != 700000 {
+		t.Errorf("Sample = %+v", f)
+	}
+
+	if err := b.Restore(); err != nil {
+		t.Fatalf("Restore: %v", err)
+	}
+	if got := readAttr(dir, "scaling_governor"); got != "ondemand" {
+		t.Errorf("governor after restore = %q, want ondemand", got)
+	}
+	if err := b.Restore(); err != nil {
+		t.Errorf("second Restore: %v", err)
+	}
+}
+
+func TestBoostRaisesMinFreqWithoutGovernor(t *testing.T) {
+	dir := fakePolicy(t, map[string]string{
+		"scaling_governor":            "powersave",
+		"scaling_available_governors": "powersave",
+		"cpuinfo_max_freq":            "1000000",
+		"scaling_min_freq":            "700000",
+	})
+
+	b, err := BoostCPU("performance", "")
+	if err != nil {
+		t.Fatalf("BoostCPU: %v", err)
+	}
+	if got := readAttr(dir, "scaling_min_freq"); got != "1000000" {
+		t.Fatalf("min freq during sync = %q, want the maximum", got)
+	}
+	if got := readAttr(dir, "scaling_governor"); got != "powersave" {
+		t.Errorf("governor should be left alone, got %q", got)
+	}
+	_ = b.Restore()
+	if got := readAttr(dir, "scaling_min_freq"); got != "700000" {
+		t.Errorf("min freq after restore = %q, want 700000", got)
+	}
+}
+
+func TestBoostDisabled(t *testing.T) {
+	dir := fakePolicy(t, map[string]string{"scaling_governor": "ondemand"})
+	b, err := BoostCPU("", "")
+	if err != nil {
+		t.Fatal(err)
+	}
+	_ = b.Restore()
+	if got := readAttr(dir, "scaling_governor"); got != "ondemand" {
+		t.Errorf("governor = %q, want untouched", got)
+	}
+}
+
+func TestBoostLeftByKilledSyncIsRestored(t *testing.T) {
+	dir := fakePolicy(t, map[string]string{
+		"scaling_governor":            "ondemand",
+		"scaling_available_governors": "ondemand performance",
+	})
+	state := filepath.Join(t.TempDir(), BoostStateName)
+
+	// The first sync is killed without calling Restore.
+	if _, err := BoostCPU("performance", state); err != nil {
+		t.Fatal(err)
+	}
+	if _, err := os.Stat(state); err != nil {
+		t.Fatalf("boost state not saved: %v", err)
+	}
+
+	// The next sync must still put ondemand back when it finishes.
+	b, err := BoostCPU("performance", state)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if got := readAttr(dir, "scaling_governor"); got != "performance" {
+		t.Fatalf("governor during sync = %q", got)
+	}
+	if err := b.Restore(); err != nil {
+		t.Fatal(err)
+	}
+	if got := readAttr(dir, "scaling_governor"); got != "ondemand" {
+		t.Errorf("governor after restore = %q, want ondemand", got)
+	}
+	if _, err := os.Stat(state); !os.IsNotExist(err) {
+		t.Errorf("state file left after Restore: %v", err)
+	}
+
+	// ExecStopPost restores a killed sync's boost on its own.
+	if _, err := BoostCPU("performance", state); err != nil {
+		t.Fatal(err)
+	}
+	if err := RestoreSaved(state); err != nil {
+		t.Fatal(err)
+	}
+	if got := readAttr(dir, "scaling_governor"); got != "ondemand" {
+		t.Errorf("governor after RestoreSaved = %q, want ondemand", got)
+	}
+	if err := RestoreSaved(state); err != nil {
+		t.Errorf("RestoreSaved without state: %v", err)
+	}
+}
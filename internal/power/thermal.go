@@ -0,0 +1,201 @@
+package power
+
+import (
+	"os"
+	"strconv"
+	"strings"
+	gosync "sync"
+	"sync/atomic"
+	"time"
+)
+
+// Probe sources, replaceable in tests. get_throttled is the sysfs form of
+// `vcgencmd get_throttled` on Raspberry Pi kernels.
+var (
+	thermalZonePath = "/sys/class/thermal/thermal_zone0/temp"
+	throttledPath   = "/sys/devices/platform/soc/soc:firmware/get_throttled"
+)
+
+// Firmware throttle flags (current state). Bits 16-19 of get_throttled are
+// sticky "occurred since boot" copies of the same four flags.
+const (
+	UnderVoltage  uint32 = 1 << 0
+	FreqCapped    uint32 = 1 << 1
+	Throttled     uint32 = 1 << 2
+	SoftTempLimit uint32 = 1 << 3
+
+	flagMask    = 0xf
+	stickyShift = 16
+)
+
+// HotTempC is where the sync starts easing off, a few degrees below the
+// firmware's 80 °C soft limit.
+const HotTempC = 75.0
+
+// Health is one reading of SoC temperature and firmware throttle flags.
+type Health struct {
+	TempC    float64 // 0 if unknown
+	Flags    uint32  // current throttle flags
+	Sticky   uint32  // flags set at any time since boot, same bit layout
+	HasFlags bool    // whether the firmware reported flags at all
+}
+
+// ReadHealth samples the thermal zone and the firmware throttle flags.
+func ReadHealth() Health {
+	var h Health
+	if data, err := os.ReadFile(thermalZonePath); err == nil {
+		if milli, err := strconv.Atoi(strings.TrimSpace(string(data))); err == nil {
+			h.TempC = float64(milli) / 1000
+		}
+	}
+	if data, err := os.ReadFile(throttledPath); err == nil {
+		s := strings.TrimPrefix(strings.TrimSpace(string(data)), "0x")
+		if v, err := strconv.ParseUint(s, 16, 32); err == nil {
+			h.Flags = uint32(v) & flagMask
+			h.Sticky = uint32(v>>stickyShift) & flagMask
+			h.HasFlags = true
+		}
+	}
+	return h
+}
+
+// Degraded reports whether the Pi is running below full speed or close to
+// it: undervoltage, any firmware throttling, or a hot SoC.
+func (h Health) Degraded() bool {
+	return h.Flags != 0 || h.TempC >= HotTempC
+}
+
+// Warning is a short pilot-facing explanation, or "" when all is well.
+func (h Health) Warning() string {
+	switch {
+	case h.Flags&UnderVoltage != 0:
+		return "Power supply voltage is too low. Syncs slow down and USB may drop out; use a stronger power bank or shorter cable."
+	case h.Flags&(Throttled|FreqCapped|SoftTempLimit) != 0:
+		return "The Pi is throttling to cool down. Syncs will be slower; keep it shaded or ventilated."
+	case h.TempC >= HotTempC:
+		return "The Pi is running hot and may start throttling soon."
+	}
+	return ""
+}
+
+// ThrottleEvent marks a change in throttle flags during a run. Flags that
+// came and went between two samples are only visible in the sticky bits;
+// they are reported as an event with those flags at the later sample,
+// followed by one back to the current flags.
+type ThrottleEvent struct {
+	AtSec float64
+	Flags uint32
+	TempC float64
+}
+
+// Report summarises what a Monitor saw.
+type Report struct {
+	MaxTempC  float64
+	SeenFlags uint32 // every flag that was set at some point, sticky bits included
+	Events    []ThrottleEvent
+}
+
+// maxEvents bounds the history kept for a single sync.
+const maxEvents = 64
+
+// Monitor samples Health in the background so hot paths can check
+// Degraded with a single atomic load.
+type Monitor struct {
+	start    time.Time
+	degraded atomic.Bool
+	stop     chan struct{}
+	done     chan struct{}
+
+	mu         gosync.Mutex
+	report     Report
+	last       uint32
+	lastSticky uint32
+}
+
+// StartMonitor samples every interval until Stop.
+func StartMonitor(interval time.Duration) *Monitor {
+	m := &Monitor{
+		start: time.Now(),
+		stop:  make(chan struct{}),
+		done:  make(chan struct{}),
+	}
+	h := ReadHealth()
+	m.lastSticky = h.Sticky // events from before the run are not ours
+	m.record(h)
+	go func() {
+		defer close(m.done)
+		t := time.NewTicker(interval)
+		defer t.Stop()
+		for {
+			select {
+			case <-m.stop:
+				return
+			case <-t.C:
+				m.sample()
+			}
+		}
+	}()
+	return m
+}
+
+func (m *Monitor) sample() {
+	m.record(ReadHealth())
+}
+
+func (m *Monitor) record(h Health) {
+	m.degraded.Store(h.Degraded())
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	if h.TempC > m.report.MaxTempC {
+		m.report.MaxTempC = h.TempC
+	}
+	// A sticky bit that is new since the last sample but no longer current
+	// is an undervoltage or throttle that fell between two samples.
+	missed := h.Sticky &^ m.lastSticky &^ h.Flags
+	m.lastSticky |= h.Sticky
+	m.report.SeenFlags |= h.Flags | missed
+	if missed != 0 {
+		m.addEvent(h.Flags|missed, h.TempC)
+		m.last = h.Flags | missed
+	}
+	if h.Flags != m.last {
+		m.addEvent(h.Flags, h.TempC)
+	}
+	m.last = h.Flags
+}
+
+// addEvent appends to the history until maxEvents. Callers hold m.mu.
+func (m *Monitor) addEvent(flags uint32, tempC float64) {
+	if len(m.report.Events) < maxEvents {
+		m.report.Events = append(m.report.Events, ThrottleEvent{
+			AtSec: time.Since(m.start).Seconds(),
+			Flags: flags,
+			TempC: tempC,
+		})
+	}
+}
+
+// Degraded reports the latest sample's Health.Degraded. A nil Monitor is
+// never degraded.
+func (m *Monitor) Degraded() bool {
+	return m != nil && m.degraded.Load()
+}
+
+// Report returns what the monitor has seen so far.
+func (m *Monitor) Report() Report {
+	m.mu.Lock()
+	defer m.mu.Unlock()
+	r := m.report
+	r.Events = append([]ThrottleEvent(nil), r.Events...)
+	return r
+}
+
+// Stop ends sampling. It is safe to call more than once.
+func (m *Monitor) Stop() {
+	select {
+	case <-m.stop:
+	default:
+		close(m.stop)
+		<-m.done
+	}
+}
@@ -0,0 +1,106 @@
+package power
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+	"time"
+)
+
+func fakeHealth(t *testing.T, tempMilli, throttled string) {
+	t.Helper()
+	dir := t.TempDir()
+	oldTemp, oldThrottled := thermalZonePath, throttledPath
+	t.Cleanup(func() { thermalZonePath, throttledPath = oldTemp, oldThrottled })
+	thermalZonePath = filepath.Join(dir, "temp")
+	throttledPath = filepath.Join(dir, "get_throttled")
+	setHealth(t, tempMilli, throttled)
+}
+
+func setHealth(t *testing.T, tempMilli, throttled string) {
+	t.Helper()
+	if err := os.WriteFile(thermalZonePath, []byte(tempMilli+"\n"), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if err := os.WriteFile(throttledPath, []byte(throttled+"\n"), 0o644); err != nil {
+		t.Fatal(err)
+	}
+}
+
+func TestReadHealth(t *testing.T) {
+	fakeHealth(t, "48312", "50000") // only sticky "occurred since boot" bits
+	h := ReadHealth()
+	if h.TempC != 48.312 || h.Flags != 0 || h.Sticky != UnderVoltage|Throttled || !h.HasFlags {
+		t.Fatalf("ReadHealth = %+v", h)
+	}
+	if h.Degraded() || h.Warning() != "" {
+		t.Error("sticky bits alone should not degrade the sync")
+	}
+
+	setHealth(t, "48312", "0x50005")
+	h = ReadHealth()
+	if h.Flags != UnderVoltage|Throttled || !h.Degraded() {
+		t.Fatalf("ReadHealth = %+v, want undervoltage and throttled", h)
+	}
+	if h.Warning() == "" {
+		t.Error("undervoltage should produce a warning")
+	}
+}
+
+func TestMonitorRecordsHistory(t *testing.T) {
+	fakeHealth(t, "50000", "0")
+	m := StartMonitor(5 * time.Millisecond)
+	defer m.Stop()
+
+	setHealth(t, "81000", "8")
+	deadline := time.Now().Add(2 * time.Second)
+	for !m.Degraded() {
+		if time.Now().After(deadline) {
+			t.Fatal("monitor never saw the soft temperature limit")
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	m.Stop()
+
+	r := m.Report()
+	if r.MaxTempC != 81 || r.SeenFlags != SoftTempLimit {
+		t.Errorf("report = %+v", r)
+	}
+	if len(r.Events) != 1 || r.Events[0].Flags != SoftTempLimit {
+		t.Errorf("events = %+v, want one soft-limit transition", r.Events)
+	}
+
+	var nilMonitor *Monitor
+	if nilMonitor.Degraded() {
+		t.Error("nil monitor should never be degraded")
+	}
+}
+
+func TestMonitorCatchesEventsBetweenSamples(t *testing.T) {
+	fakeHealth(t, "50000", "0x10000") // undervoltage before this run
+	m := StartMonitor(5 * time.Millisecond)
+	defer m.Stop()
+
+	// A throttle that started and ended between two samples leaves only
+	// its sticky bit behind.
+	setHealth(t, "50000", "0x50000")
+	deadline := time.Now().Add(2 * time.Second)
+	for len(m.Report().Events) < 2 {
+		if time.Now().After(deadline) {
+			t.Fatal("monitor never reported the missed throttle")
+		}
+		time.Sleep(5 * time.Millisecond)
+	}
+	m.Stop()
+
+	r := m.Report()
+	if r.SeenFlags != Throttled {
+		t.Errorf("seen flags = %#x, want only the throttle from this run", r.SeenFlags)
+	}
+	if len(r.Events) != 2 || r.Events[0].Flags != Throttled || r.Events[1].Flags != 0 {
+		t.Errorf("events = %+v, want the throttle and its end", r.Events)
+	}
+	if m.Degraded() {
+		t.Error("a throttle that already ended should not degrade the sync")
+	}
+}
@@ -0,0 +1,276 @@
+package storage
+
+import (
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"math"
+	"math/bits"
+	"os"
+	"path/filepath"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+// CardHealthName is the file in the storage root that keeps the SD card's
+// I/O history: cumulative writes, recent sync throughput, the boot probe and
+// the last capacity check.
+const CardHealthName = ".card_health.json"
+
+// Slow-card thresholds. A genuine class 10 card sustains 10 MB/s and flushes
+// 256 KB in a few tens of milliseconds; worn and counterfeit cards stall for
+// seconds.
+const (
+	SlowCardMBps  = 2.0
+	SlowCardTail  = 500 * time.Millisecond // p99 of a write or 256 KB flush
+	cardRecentMax = 10                     // sync samples kept
+)
+
+// latencyBuckets covers 1 µs to about 16 s in powers of two.
+const latencyBuckets = 25
+
+// LatencyHist is a log2 histogram of latencies: bucket i counts samples in
+// [2^i, 2^(i+1)) microseconds.
+type LatencyHist struct {
+	Buckets [latencyBuckets]int64 `json:"buckets_us_log2"`
+	Count   int64                 `json:"count"`
+	MaxUS   int64                 `json:"max_us"`
+}
+
+// Observe adds one sample.
+func (h *LatencyHist) Observe(d time.Duration) {
+	us := d.Microseconds()
+	i := 0
+	if us > 0 {
+		i = min(bits.Len64(uint64(us))-1, latencyBuckets-1)
+	}
+	h.Buckets[i]++
+	h.Count++
+	h.MaxUS = max(h.MaxUS, us)
+}
+
+// Quantile returns the upper bound of the bucket holding quantile q, capped
+// at the largest sample, or 0 without samples.
+func (h *LatencyHist) Quantile(q float64) time.Duration {
+	if h.Count == 0 {
+		return 0
+	}
+	rank := int64(q * float64(h.Count))
+	if rank >= h.Count {
+		rank = h.Count - 1
+	}
+	var seen int64
+	for i, n := range h.Buckets {
+		if seen += n; seen > rank {
+			return time.Duration(min(int64(1)<<(i+1), h.MaxUS)) * time.Microsecond
+		}
+	}
+	return time.Duration(h.MaxUS) * time.Microsecond
+}
+
+// IOProfile records how the card kept up with one writer: the latency of
+// each write to the file (page cache stalls show up here once the card falls
+// behind) and of each fsync, and the time spent in both.
+type IOProfile struct {
+	Bytes  int64
+	Busy   time.Duration
+	Writes LatencyHist
+	Fsyncs LatencyHist
+}
+
+// MBps is bytes written per second spent writing and syncing; with the final
+// fsync included it is what the card sustained.
+func (p *IOProfile) MBps() float64 {
+	if p.Busy <= 0 {
+		return 0
+	}
+	return float64(p.Bytes) / (1024 * 1024) / p.Busy.Seconds()
+}
+
+// Sample summarises the profile for the card history and the manifest.
+func (p *IOProfile) Sample() *CardSample {
+	return &CardSample{
+		AtUTC:       time.Now().UTC().Format(time.RFC3339),
+		Bytes:       p.Bytes,
+		MBps:        round2(p.MBps()),
+		WriteP99MS:  ms(p.Writes.Quantile(0.99)),
+		FsyncP99MS:  ms(p.Fsyncs.Quantile(0.99)),
+		FsyncMaxMS:  ms(time.Duration(p.Fsyncs.MaxUS) * time.Microsecond),
+		WriteStalls: p.Writes.countAbove(SlowCardTail),
+	}
+}
+
+// countAbove counts samples in buckets entirely above d.
+func (h *LatencyHist) countAbove(d time.Duration) int64 {
+	var n int64
+	for i, c := range h.Buckets {
+		if time.Duration(int64(1)<<i)*time.Microsecond >= d {
+			n += c
+		}
+	}
+	return n
+}
+
+// write writes p to f and records it.
+func (p *IOProfile) write(f *os.File, b []byte) (int, error) {
+	start := time.Now()
+	n, err := f.Write(b)
+	p.observeWrite(start, n)
+	return n, err
+}
+
+// writeAt is write at an offset.
+func (p *IOProfile) writeAt(f *os.File, b []byte, off int64) (int, error) {
+	start := time.Now()
+	n, err := f.WriteAt(b, off)
+	p.observeWrite(start, n)
+	return n, err
+}
+
+func (p *IOProfile) observeWrite(start time.Time, n int) {
+	d := time.Since(start)
+	p.Writes.Observe(d)
+	p.Busy += d
+	p.Bytes += int64(n)
+}
+
+// fsync syncs f and records it.
+func (p *IOProfile) fsync(f *os.File) error {
+	start := time.Now()
+	err := f.Sync()
+	d := time.Since(start)
+	p.Fsyncs.Observe(d)
+	p.Busy += d
+	return err
+}
+
+// profiledFile is the io.Writer under a writer's bufio buffer, so every
+// buffer flush is timed.
+type profiledFile struct {
+	f *os.File
+	p *IOProfile
+}
+
+func (w profiledFile) Write(b []byte) (int, error) { return w.p.write(w.f, b) }
+
+var _ io.Writer = profiledFile{}
+
+// CardSample is the I/O summary of one sync or probe.
+type CardSample struct {
+	AtUTC       string  `json:"at_utc"`
+	Bytes       int64   `json:"bytes"`
+	MBps        float64 `json:"mbps"`
+	WriteP99MS  float64 `json:"write_p99_ms"`
+	FsyncP99MS  float64 `json:"fsync_p99_ms"`
+	FsyncMaxMS  float64 `json:"fsync_max_ms"`
+	WriteStalls int64   `json:"write_stalls,omitempty"` // writes slower than SlowCardTail
+}
+
+// slow reports whether the sample crosses the slow-card thresholds. Fsync
+// tails only count for probes, whose flushes have a fixed size; a sync's
+// final fsync grows with the log.
+func (s *CardSample) slow(probe bool) bool {
+	if s.MBps > 0 && s.MBps < SlowCardMBps {
+		return true
+	}
+	tail := float64(SlowCardTail.Milliseconds())
+	return s.WriteP99MS > tail || (probe && s.FsyncP99MS > tail)
+}
+
+// CapacityCheck is the result of the on-demand fake-capacity test.
+type CapacityCheck struct {
+	AtUTC      string `json:"at_utc"`
+	Blocks     int    `json:"blocks"`
+	Bad        int    `json:"bad"`
+	SpanBytes  int64  `json:"span_bytes"`
+	FirstBadAt int64  `json:"first_bad_at,omitempty"` // file offset; roughly the real capacity in use
+	Error      string `json:"error,omitempty"`
+}
+
+// CardHealth is the SD card's I/O history, kept in CardHealthName.
+type CardHealth struct {
+	BytesWritten int64          `json:"bytes_written"` // by syncs and probes since tracking began
+	Syncs        int64          `json:"syncs"`
+	Recent       []CardSample   `json:"recent,omitempty"` // newest last
+	Probe        *CardSample    `json:"probe,omitempty"`
+	ProbeBootID  string         `json:"probe_boot_id,omitempty"`
+	Capacity     *CapacityCheck `json:"capacity,omitempty"`
+}
+
+// Warning is a short pilot-facing explanation, or "" when the card looks
+// fine.
+func (h *CardHealth) Warning() string {
+	if h == nil {
+		return ""
+	}
+	if c := h.Capacity; c != nil && c.Bad > 0 {
+		return fmt.Sprintf("This SD card is fake or failing: %d of %d test blocks did not read back. Logs saved past about %.1f GB may be lost. Replace the card.",
+			c.Bad, c.Blocks, float64(c.FirstBadAt)/(1<<30))
+	}
+	slow := 0
+	for i := range h.Recent {
+		if h.Recent[i].slow(false) {
+			slow++
+		}
+	}
+	if (h.Probe != nil && h.Probe.slow(true)) || (len(h.Recent) >= 3 && slow*2 > len(h.Recent)) {
+		return "This SD card is slow or worn; syncs will take longer. A new A1/class 10 card from a trusted brand fixes this."
+	}
+	return ""
+}
+
+// LoadCardHealth reads the card history under root. A missing file is an
+// empty history.
+func LoadCardHealth(root string) (*CardHealth, error) {
+	data, err := os.ReadFile(filepath.Join(root, CardHealthName))
+	if errors.Is(err, os.ErrNotExist) {
+		return &CardHealth{}, nil
+	}
+	if err != nil {
+		return nil, err
+	}
+	var h CardHealth
+	if err := json.Unmarshal(data, &h); err != nil {
+		return nil, err
+	}
+	return &h, nil
+}
+
+// UpdateCardHealth applies fn to the card history under root and saves it.
+// The sync and the web process both update it, so it is locked.
+func UpdateCardHealth(root string, fn func(*CardHealth)) error {
+	path := filepath.Join(root, CardHealthName)
+	lock, err := util.LockFile(path + ".lock")
+	if err != nil {
+		return err
+	}
+	defer lock.Close()
+	h, err := LoadCardHealth(root)
+	if err != nil {
+		h = &CardHealth{} // unreadable history: start over
+	}
+	fn(h)
+	if n := len(h.Recent); n > cardRecentMax {
+		h.Recent = append([]CardSample(nil), h.Recent[n-cardRecentMax:]...)
+	}
+	tmp := path + ".tmp"
+	if err := atomicJSONWrite(tmp, h); err != nil {
+		return err
+	}
+	return os.Rename(tmp, path)
+}
+
+// RecordSync adds a finished sync's profile to the card history.
+func RecordSync(root string, p *IOProfile) error {
+	return UpdateCardHealth(root, func(h *CardHealth) {
+		h.BytesWritten += p.Bytes
+		h.Syncs++
+		h.Recent = append(h.Recent, *p.Sample())
+	})
+}
+
+func ms(d time.Duration) float64 { return round2(float64(d.Microseconds()) / 1000) }
+
+func round2(v float64) float64 { return math.Round(v*100) / 100 }
@@ -0,0 +1,140 @@
+package storage
+
+import (
+	"bytes"
+	"context"
+	"os"
+	"path/filepath"
+	"strings"
+	"testing"
+	"time"
+)
+
+func TestLatencyHistQuantile(t *testing.T) {
+	var h LatencyHist
+	if h.Quantile(0.99) != 0 {
+		t.Fatal("empty histogram should report 0")
+	}
+	for i := 0; i < 98; i++ {
+		h.Observe(3 * time.Millisecond)
+	}
+	h.Observe(700 * time.Millisecond)
+	h.Observe(2 * time.Second)
+
+	if p50 := h.Quantile(0.5); p50 < 3*time.Millisecond || p50 > 6*time.Millisecond {
+		t.Errorf("p50 = %v, want the 3 ms bucket", p50)
+	}
+	if p99 := h.Quantile(0.99); p99 < 2*time.Second || p99 > 2*time.Second {
+		t.Errorf("p99 = %v, want the largest sample", p99)
+	}
+	if n := h.countAbove(SlowCardTail); n != 2 {
+		t.Errorf("countAbove = %d, want 2", n)
+	}
+}
+
+func TestStreamWriterProfile(t *testing.T) {
+	w, err := NewStreamWriter(filepath.Join(t.TempDir(), "raw_flash.bbl"))
+	if err != nil {
+		t.Fatal(err)
+	}
+	chunk := bytes.Repeat([]byte{7}, 6<<10) // flash-chunk sized, as the sync writes
+	for i := 0; i < 100; i++ {
+		if _, err := w.Write(chunk); err != nil {
+			t.Fatal(err)
+		}
+	}
+	if err := w.Close(); err != nil {
+		t.Fatal(err)
+	}
+	p := w.Profile()
+	if p.Bytes != 100*int64(len(chunk)) || p.Writes.Count < 2 || p.Fsyncs.Count != 1 {
+		t.Fatalf("profile = %d bytes, %d writes, %d fsyncs", p.Bytes, p.Writes.Count, p.Fsyncs.Count)
+	}
+	if p.MBps() <= 0 {
+		t.Error("throughput not measured")
+	}
+}
+
+func TestCardHealthHistory(t *testing.T) {
+	root := t.TempDir()
+	fast := &IOProfile{Bytes: 16 << 20, Busy: time.Second}
+	for i := 0; i < cardRecentMax+2; i++ {
+		if err := RecordSync(root, fast); err != nil {
+			t.Fatal(err)
+		}
+	}
+	h, err := LoadCardHealth(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if h.Syncs != cardRecentMax+2 || len(h.Recent) != cardRecentMax || h.BytesWritten != (cardRecentMax+2)*16<<20 {
+		t.Fatalf("history: %d syncs, %d recent, %d bytes", h.Syncs, len(h.Recent), h.BytesWritten)
+	}
+	if w := h.Warning(); w != "" {
+		t.Fatalf("healthy card warns: %q", w)
+	}
+
+	// Mostly slow syncs: 1 MB/s.
+	slow := &IOProfile{Bytes: 1 << 20, Busy: time.Second}
+	for i := 0; i < cardRecentMax; i++ {
+		_ = RecordSync(root, slow)
+	}
+	h, _ = LoadCardHealth(root)
+	if !strings.Contains(h.Warning(), "slow") {
+		t.Errorf("slow card warning = %q", h.Warning())
+	}
+
+	h.Capacity = &CapacityCheck{Blocks: 512, Bad: 100, FirstBadAt: 8 << 30}
+	if w := h.Warning(); !strings.Contains(w, "fake") || !strings.Contains(w, "8.0 GB") {
+		t.Errorf("fake card warning = %q", w)
+	}
+}
+
+func TestProbeCard(t *testing.T) {
+	root := t.TempDir()
+	sample, err := ProbeCard(context.Background(), root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if sample.Bytes != probeChunks*probeChunk || sample.MBps <= 0 {
+		t.Errorf("probe sample = %+v", sample)
+	}
+	if _, err := os.Stat(filepath.Join(root, probeFileName)); !os.IsNotExist(err) {
+		t.Error("probe file left behind")
+	}
+}
+
+func TestCheckCapacity(t *testing.T) {
+	root := t.TempDir()
+	res, err := CheckCapacity(context.Background(), root)
+	if err == ErrNotEnoughSpace || err == ErrNoSparseFiles {
+		t.Skip(err)
+	}
+	if err != nil {
+		t.Fatal(err)
+	}
+	if res.Blocks != capacityBlocks || res.Bad != 0 || res.SpanBytes <= 0 {
+		t.Errorf("genuine disk: %+v", res)
+	}
+	if _, err := os.Stat(filepath.Join(root, capacityFileName)); !os.IsNotExist(err) {
+		t.Error("test file left behind")
+	}
+
+	ctx, cancel := context.WithCancel(context.Background())
+	cancel()
+	if _, err := CheckCapacity(ctx, root); err != context.Canceled {
+		t.Errorf("cancelled check: %v", err)
+	}
+}
+
+func TestFillStampIsUnique(t *testing.T) {
+	a, b := make([]byte, capacityBlock), make([]byte, capacityBlock)
+	fillStamp(a, 1)
+	fillStamp(b, 2)
+	if bytes.Equal(a, b) || !bytes.HasPrefix(a, capacityMagic[:]) {
+		t.Fatal("stamps must carry the magic and differ per seed")
+	}
+	if len(alignedBlock()) != capacityBlock {
+		t.Fatal("aligned block has the wrong size")
+	}
+}
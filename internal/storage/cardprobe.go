@@ -0,0 +1,178 @@
+package storage
+
+import (
+	"bytes"
+	"context"
+	"encoding/binary"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"time"
+	"unsafe"
+
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+// Calibrated boot probe: a fixed number of fixed-size flushes, so results
+// compare across boots and cards.
+const (
+	probeFileName = ".card_probe.tmp"
+	probeChunk    = 256 << 10
+	probeChunks   = 32 // 8 MB, past the write cache of most cards
+
+	// ProbeBytes is the scratch space ProbeCard writes.
+	ProbeBytes = probeChunk * probeChunks
+)
+
+// Fake-capacity check: stamped blocks spread over the free space.
+const (
+	capacityFileName = ".card_capacity.tmp"
+	capacityBlock    = 4096
+	capacityBlocks   = 512
+	capacityMargin   = 64 << 20 // never planned into: the sync may need it
+
+	// CapacityCheckBytes is the space CheckCapacity allocates; the rest of
+	// its file is holes.
+	CapacityCheckBytes = capacityBlock * capacityBlocks
+)
+
+var capacityMagic = [8]byte{'L', 'F', 'C', 'A', 'P', '0', '0', '1'}
+
+// ErrNotEnoughSpace is returned by CheckCapacity when the card is too full to
+// test.
+var ErrNotEnoughSpace = errors.New("not enough free space to test the card")
+
+// ErrNoSparseFiles is returned by CheckCapacity on FAT and exFAT, where the
+// sparse test file would be zero-filled across the whole card.
+var ErrNoSparseFiles = errors.New("the storage filesystem has no sparse files; use a full-card tool such as f3")
+
+// ProbeCard measures the card under root: it writes probeChunks chunks of
+// probeChunk bytes to a scratch file, syncing after each, and removes the
+// file again.
+func ProbeCard(ctx context.Context, root string) (*CardSample, error) {
+	path := filepath.Join(root, probeFileName)
+	f, err := os.OpenFile(path, os.O_WRONLY|os.O_CREATE|os.O_TRUNC, 0o644)
+	if err != nil {
+		return nil, err
+	}
+	defer os.Remove(path)
+	defer f.Close()
+
+	chunk := make([]byte, probeChunk)
+	fillStamp(chunk, uint64(time.Now().UnixNano())) // incompressible, for cards that compress
+	var p IOProfile
+	for i := 0; i < probeChunks; i++ {
+		if err := ctx.Err(); err != nil {
+			return nil, err
+		}
+		if _, err := p.write(f, chunk); err != nil {
+			return nil, err
+		}
+		if err := p.fsync(f); err != nil {
+			return nil, err
+		}
+	}
+	return p.Sample(), nil
+}
+
+// CheckCapacity looks for a card that claims more space than it has. Such
+// cards accept writes past their real size but wrap them onto earlier blocks
+// or drop them. It writes capacityBlocks stamped blocks spread over the free
+// space into a sparse scratch file, syncs, reads them back around the page
+// cache and counts the ones that do not match. ext4 places the blocks of a
+// sparse file near their file offset, so the stamps land across the card,
+// while the test only uses capacityBlocks*capacityBlock bytes. The scratch
+// file is removed afterwards.
+func CheckCapacity(ctx context.Context, root string) (*CapacityCheck, error) {
+	if sparse, err := util.SupportsSparseFiles(root); err != nil {
+		return nil, err
+	} else if !sparse {
+		return nil, ErrNoSparseFiles
+	}
+	free, err := util.FreeBytes(root)
+	if err != nil {
+		return nil, err
+	}
+	span := (free - capacityMargin) &^ (capacityBlock - 1)
+	if span < capacityBlocks*capacityBlock {
+		return nil, ErrNotEnoughSpace
+	}
+	res := &CapacityCheck{AtUTC: time.Now().UTC().Format(time.RFC3339), Blocks: capacityBlocks, SpanBytes: span}
+	nonce := uint64(time.Now().UnixNano())
+	offset := func(i int) int64 {
+		return (span / capacityBlocks * int64(i)) &^ (capacityBlock - 1)
+	}
+
+	path := filepath.Join(root, capacityFileName)
+	defer os.Remove(path)
+	f, err := os.OpenFile(path, os.O_WRONLY|os.O_CREATE|os.O_TRUNC, 0o644)
+	if err != nil {
+		return nil, err
+	}
+	block := alignedBlock()
+	for i := 0; i < capacityBlocks; i++ {
+		if err := ctx.Err(); err != nil {
+			f.Close()
+			return nil, err
+		}
+		fillStamp(block, nonce^uint64(offset(i)))
+		if _, err := f.WriteAt(block, offset(i)); err != nil {
+			f.Close()
+			return nil, fmt.Errorf("write test block: %w", err)
+		}
+	}
+	if err := f.Sync(); err != nil {
+		f.Close()
+		return nil, fmt.Errorf("fsync: %w", err)
+	}
+	if err := f.Close(); err != nil {
+		return nil, err
+	}
+
+	r, _, err := util.OpenDirect(path)
+	if err != nil {
+		return nil, err
+	}
+	defer r.Close()
+	want := make([]byte, capacityBlock)
+	for i := 0; i < capacityBlocks; i++ {
+		if err := ctx.Err(); err != nil {
+			return nil, err
+		}
+		off := offset(i)
+		fillStamp(want, nonce^uint64(off))
+		if _, err := r.ReadAt(block, off); (err != nil && err != io.EOF) || !bytes.Equal(block, want) {
+			if res.Bad == 0 {
+				res.FirstBadAt = off
+			}
+			res.Bad++
+		}
+	}
+	return res, nil
+}
+
+// fillStamp fills b with a block header (magic, seed) and xorshift data
+// derived from seed, so every block is unique and checkable.
+func fillStamp(b []byte, seed uint64) {
+	copy(b, capacityMagic[:])
+	binary.LittleEndian.PutUint64(b[8:], seed)
+	x := seed | 1
+	for i := 16; i+8 <= len(b); i += 8 {
+		x ^= x << 13
+		x ^= x >> 7
+		x ^= x << 17
+		binary.LittleEndian.PutUint64(b[i:], x)
+	}
+}
+
+// alignedBlock returns a capacityBlock-sized buffer aligned for O_DIRECT.
+func alignedBlock() []byte {
+	buf := make([]byte, 2*capacityBlock)
+	skew := int(uintptr(unsafe.Pointer(&buf[0])) & (capacityBlock - 1))
+	if skew != 0 {
+		skew = capacityBlock - skew
+	}
+	return buf[skew : skew+capacityBlock]
+}
@@ -0,0 +1,92 @@
+package storage
+
+import (
+	"encoding/json"
+	"errors"
+	"fmt"
+	"os"
+	"path/filepath"
+	"sort"
+)
+
+// CoverageFilename records which byte ranges of an out-of-order copy are
+// durable. It exists only while (or because) such a copy is incomplete.
+const CoverageFilename = "coverage.json"
+
+// PartialInterrupted marks a session whose copy stopped before every byte
+// of the flash was read; ManifestPartial.Ranges holds what was saved.
+const PartialInterrupted = "interrupted"
+
+// Range is a span of file offsets [Off, Off+Len).
+type Range struct {
+	Off int64 `json:"off"`
+	Len int64 `json:"len"`
+}
+
+// End returns the offset just past the range.
+func (r Range) End() int64 { return r.Off + r.Len }
+
+// AddRange merges r into the sorted, non-overlapping list rs.
+func AddRange(rs []Range, r Range) []Range {
+	if r.Len <= 0 {
+		return rs
+	}
+	rs = append(rs, r)
+	sort.Slice(rs, func(a, b int) bool { return rs[a].Off < rs[b].Off })
+	out := rs[:1]
+	for _, next := range rs[1:] {
+		last := &out[len(out)-1]
+		if next.Off <= last.End() {
+			if next.End() > last.End() {
+				last.Len = next.End() - last.Off
+			}
+			continue
+		}
+		out = append(out, next)
+	}
+	return out
+}
+
+// CoveredBytes returns the total length of rs.
+func CoveredBytes(rs []Range) int64 {
+	var n int64
+	for _, r := range rs {
+		n += r.Len
+	}
+	return n
+}
+
+// newestRange returns the range holding the highest offsets, which for a
+// tail-first copy is the contiguous run of the newest flights.
+func newestRange(rs []Range) (Range, bool) {
+	if len(rs) == 0 {
+		return Range{}, false
+	}
+	return rs[len(rs)-1], true
+}
+
+// writeCoverage records rs in dir, or removes the record when rs is nil.
+func writeCoverage(dir string, rs []Range) error {
+	path := filepath.Join(dir, CoverageFilename)
+	if rs == nil {
+		if err := os.Remove(path); err != nil && !errors.Is(err, os.ErrNotExist) {
+			return err
+		}
+		return nil
+	}
+	return atomicJSONWrite(path, rs)
+}
+
+// readCoverage returns the coverage recorded in dir; os.ErrNotExist means
+// the session was copied in order or completely.
+func readCoverage(dir string) ([]Range, error) {
+	data, err := os.ReadFile(filepath.Join(dir, CoverageFilename))
+	if err != nil {
+		return nil, err
+	}
+	var rs []Range
+	if err := json.Unmarshal(data, &rs); err != nil {
+		return nil, fmt.Errorf("decode coverage: %w", err)
+	}
+	return rs, nil
+}
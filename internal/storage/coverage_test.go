@@ -0,0 +1,79 @@
+package storage
+
+import (
+	"bytes"
+	"io"
+	"reflect"
+	"testing"
+)
+
+func TestAddRange(t *testing.T) {
+	var rs []Range
+	for _, r := range []Range{{Off: 300, Len: 100}, {Off: 100, Len: 50}, {Off: 150, Len: 50}, {Off: 0, Len: 0}, {Off: 350, Len: 100}} {
+		rs = AddRange(rs, r)
+	}
+	want := []Range{{Off: 100, Len: 100}, {Off: 300, Len: 150}}
+	if !reflect.DeepEqual(rs, want) {
+		t.Fatalf("ranges = %v, want %v", rs, want)
+	}
+	if n := CoveredBytes(rs); n != 250 {
+		t.Fatalf("CoveredBytes = %d, want 250", n)
+	}
+}
+
+// TestInterruptedTailFirstSession covers a sync killed mid-copy: only the
+// tail of the file was written and committed, and no manifest exists.
+func TestInterruptedTailFirstSession(t *testing.T) {
+	store := NewDirStore(t.TempDir())
+	id, w, err := store.Create(testFCInfo())
+	if err != nil {
+		t.Fatal(err)
+	}
+	ow := w.(OffsetWriter)
+	tail := bytes.Repeat([]byte("newest flight "), 100)
+	if _, err := ow.WriteAt(tail, 4096); err != nil {
+		t.Fatal(err)
+	}
+	covered := []Range{{Off: 4096, Len: int64(len(tail))}}
+	if err := ow.Commit(covered); err != nil {
+		t.Fatal(err)
+	}
+
+	sessions, err := store.ListSessions()
+	if err != nil || len(sessions) != 1 {
+		t.Fatalf("sessions = %d, err = %v; want the interrupted one", len(sessions), err)
+	}
+	m := sessions[0].Manifest
+	if m.Partial == nil || m.Partial.Mode != PartialInterrupted || m.File.Bytes != int64(len(tail)) {
+		t.Fatalf("manifest = %+v, want an interrupted partial of %d bytes", m, len(tail))
+	}
+
+	f, err := store.Open(id, RawFlashFilename)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer f.Close()
+	got, _ := io.ReadAll(f)
+	if f.Size != int64(len(tail)) || !bytes.Equal(got, tail) {
+		t.Fatalf("served %d bytes (size %d), want only the committed tail", len(got), f.Size)
+	}
+
+	// Completing the copy drops the coverage record.
+	if _, err := ow.WriteAt(make([]byte, 4096), 0); err != nil {
+		t.Fatal(err)
+	}
+	if err := ow.Commit(nil); err != nil {
+		t.Fatal(err)
+	}
+	if err := w.Close(); err != nil {
+		t.Fatal(err)
+	}
+	f2, err := store.Open(id, RawFlashFilename)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer f2.Close()
+	if want := int64(4096 + len(tail)); f2.Size != want {
+		t.Fatalf("complete file size = %d, want %d", f2.Size, want)
+	}
+}
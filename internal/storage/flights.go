@@ -0,0 +1,52 @@
+package storage
+
+import (
+	"errors"
+	"fmt"
+	"io"
+	"math"
+	"os"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/blackbox"
+)
+
+// maxIndexBytes bounds the raw files IndexFlights reads into memory; the
+// largest SPI flash chips in use are 128 MB.
+const maxIndexBytes = 256 << 20
+
+// IndexFlights finds the flights in a session's raw file and stores them,
+// with their sparklines, in its manifest. It returns the number of flights.
+// A session without a readable raw file is marked indexed with none.
+func IndexFlights(store Store, sessionID string) (int, error) {
+	var flights []ManifestFlight
+	f, err := store.Open(sessionID, RawFlashFilename)
+	switch {
+	case errors.Is(err, os.ErrNotExist):
+	case err != nil:
+		return 0, err
+	default:
+		var data []byte
+		if f.Size <= maxIndexBytes {
+			data, err = io.ReadAll(f)
+		}
+		f.Close()
+		if err != nil {
+			return 0, fmt.Errorf("read raw flash: %w", err)
+		}
+		for _, fl := range blackbox.Index(data) {
+			flights = append(flights, ManifestFlight{
+				Offset:      fl.Offset,
+				Bytes:       fl.Bytes,
+				DurationSec: math.Round(fl.Duration().Seconds()*10) / 10,
+				MaxGyroDPS:  math.Round(fl.MaxGyroDPS()),
+				Sparkline:   fl.Sparkline(),
+			})
+		}
+	}
+	err = store.UpdateManifest(sessionID, func(m *Manifest) {
+		m.Flights = flights
+		m.IndexedUTC = time.Now().UTC().Format(time.RFC3339)
+	})
+	return len(flights), err
+}
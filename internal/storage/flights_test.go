@@ -0,0 +1,48 @@
+package storage
+
+import (
+	"bytes"
+	"testing"
+
+	"github.com/proeugene/logfalcon/internal/blackbox"
+)
+
+// tinyLog returns a blackbox log of n intra frames with the roll rate at
+// gyro deg/s.
+func tinyLog(n int, gyro byte) []byte {
+	var b bytes.Buffer
+	b.Write(blackbox.Preamble)
+	b.WriteString("\nH Field I name:time,rcCommand[3],gyroADC[0],gyroADC[1],gyroADC[2]\n")
+	b.WriteString("H Field I encoding:1,1,1,1,1\n")
+	for i := 0; i < n; i++ {
+		b.Write([]byte{'I', byte(i), 0x80 | 0x5c, 0x0b, gyro, 0, 0}) // throttle 1500
+	}
+	b.Write([]byte{'E', 255})
+	b.WriteString("End of log\x00")
+	return b.Bytes()
+}
+
+func TestIndexFlights(t *testing.T) {
+	s, err := OpenSegmentStore(t.TempDir())
+	if err != nil {
+		t.Fatal(err)
+	}
+	data := append(tinyLog(100, 20), tinyLog(10, 120)...)
+	id := writeSegmentSession(t, s, testFCInfo(), data)
+
+	n, err := IndexFlights(s, id)
+	if err != nil || n != 2 {
+		t.Fatalf("IndexFlights = %d, %v; want 2 flights", n, err)
+	}
+	sessions, err := s.ListSessions()
+	if err != nil {
+		t.Fatal(err)
+	}
+	m := sessions[0].Manifest
+	if m.IndexedUTC == "" || len(m.Flights) != 2 {
+		t.Fatalf("manifest flights = %+v, indexed %q", m.Flights, m.IndexedUTC)
+	}
+	if f := m.Flights[1]; f.Offset != int64(len(tinyLog(100, 20))) || f.MaxGyroDPS != 120 || !blackbox.ValidSparkline(f.Sparkline) {
+		t.Errorf("second flight = %+v", f)
+	}
+}
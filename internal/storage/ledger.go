@@ -0,0 +1,177 @@
+package storage
+
+import (
+	"encoding/json"
+	"errors"
+	"fmt"
+	"os"
+	"path/filepath"
+	"sync/atomic"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+// LedgerName is the reservation ledger in the runtime directory. It only
+// describes running processes, so it lives on tmpfs and is not fsynced.
+const LedgerName = "reservations.json"
+
+// SpaceError is returned by Reserve when the request does not fit.
+type SpaceError struct {
+	Need      int64 // bytes asked for plus the floor
+	Free      int64 // statfs free bytes
+	Reserved  int64 // outstanding reservations of other writers
+	Available int64 // Free - Reserved
+}
+
+func (e *SpaceError) Error() string {
+	return fmt.Sprintf("need %d bytes, %d free of which %d reserved", e.Need, e.Free, e.Reserved)
+}
+
+// Ledger tracks space that writers to the storage root have claimed but not
+// yet written, across processes: a sync reserves the flash size before it
+// copies, background jobs reserve their scratch space. Free space is statfs
+// minus the outstanding reservations, so two writers admitted at the same
+// time cannot both count on the same bytes. Reservations of processes that
+// died are dropped.
+type Ledger struct {
+	path string // ledger file
+	root string // filesystem the reservations are for
+}
+
+type ledgerEntry struct {
+	ID      string `json:"id"`
+	PID     int    `json:"pid"`
+	Bytes   int64  `json:"bytes"`
+	Purpose string `json:"purpose"`
+	At      string `json:"at"`
+}
+
+// Reservation is space held in a Ledger until Release.
+type Reservation struct {
+	ledger *Ledger
+	id     string
+	Bytes  int64
+}
+
+var reservationSeq atomic.Int64
+
+// OpenLedger returns the ledger in runtimeDir for the storage root.
+func OpenLedger(runtimeDir, root string) *Ledger {
+	return &Ledger{path: filepath.Join(runtimeDir, LedgerName), root: root}
+}
+
+// Reserve claims n bytes if, after it, at least floor bytes stay free for
+// everyone else. It reads statfs once. A *SpaceError says how much is
+// missing.
+func (l *Ledger) Reserve(n, floor int64, purpose string) (*Reservation, error) {
+	var r *Reservation
+	err := l.update(func(entries []ledgerEntry, reserved int64) ([]ledgerEntry, error) {
+		free, err := util.FreeBytes(l.root)
+		if err != nil {
+			return nil, err
+		}
+		if free-reserved < n+floor {
+			return nil, &SpaceError{Need: n + floor, Free: free, Reserved: reserved, Available: free - reserved}
+		}
+		r = &Reservation{ledger: l, id: fmt.Sprintf("%d-%d", os.Getpid(), reservationSeq.Add(1)), Bytes: n}
+		return append(entries, ledgerEntry{ID: r.id, PID: os.Getpid(), Bytes: n, Purpose: purpose,
+			At: time.Now().UTC().Format(time.RFC3339)}), nil
+	})
+	if err != nil {
+		return nil, err
+	}
+	return r, nil
+}
+
+// Reserved returns the bytes reserved by live writers.
+func (l *Ledger) Reserved() (int64, error) {
+	var total int64
+	err := l.update(func(entries []ledgerEntry, reserved int64) ([]ledgerEntry, error) {
+		total = reserved
+		return entries, nil
+	})
+	return total, err
+}
+
+// Available returns statfs free bytes minus outstanding reservations.
+func (l *Ledger) Available() (int64, error) {
+	reserved, err := l.Reserved()
+	if err != nil {
+		return 0, err
+	}
+	free, err := util.FreeBytes(l.root)
+	if err != nil {
+		return 0, err
+	}
+	return free - reserved, nil
+}
+
+// Release returns the reservation's bytes: call it once the data is on disk
+// (statfs counts it from then on) or the write was abandoned. Releasing a
+// nil or released reservation is a no-op.
+func (r *Reservation) Release() error {
+	if r == nil || r.id == "" {
+		return nil
+	}
+	id := r.id
+	r.id = ""
+	return r.ledger.update(func(entries []ledgerEntry, _ int64) ([]ledgerEntry, error) {
+		for i, e := range entries {
+			if e.ID == id {
+				return append(entries[:i], entries[i+1:]...), nil
+			}
+		}
+		return entries, nil
+	})
+}
+
+// update runs fn on the live entries under the ledger lock and saves what it
+// returns. reserved is the sum of the live entries.
+func (l *Ledger) update(fn func(entries []ledgerEntry, reserved int64) ([]ledgerEntry, error)) error {
+	if err := os.MkdirAll(filepath.Dir(l.path), 0o755); err != nil {
+		return err
+	}
+	lock, err := util.LockFile(l.path + ".lock")
+	if err != nil {
+		return err
+	}
+	defer lock.Close()
+
+	var entries []ledgerEntry
+	if data, err := os.ReadFile(l.path); err == nil {
+		_ = json.Unmarshal(data, &entries) // a damaged ledger starts over
+	} else if !errors.Is(err, os.ErrNotExist) {
+		return err
+	}
+	live := entries[:0]
+	var reserved int64
+	for _, e := range entries {
+		if util.ProcessAlive(e.PID) {
+			live = append(live, e)
+			reserved += e.Bytes
+		}
+	}
+	pruned := len(live) != len(entries)
+
+	out, err := fn(live, reserved)
+	if err != nil {
+		if pruned {
+			_ = l.save(live)
+		}
+		return err
+	}
+	return l.save(out)
+}
+
+func (l *Ledger) save(entries []ledgerEntry) error {
+	data, err := json.Marshal(entries)
+	if err != nil {
+		return err
+	}
+	tmp := l.path + ".tmp"
+	if err := os.WriteFile(tmp, data, 0o644); err != nil {
+		return err
+	}
+	return os.Rename(tmp, l.path)
+}
@@ -0,0 +1,84 @@
+package storage
+
+import (
+	"errors"
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+func TestLedgerAdmission(t *testing.T) {
+	root := t.TempDir()
+	l := OpenLedger(filepath.Join(t.TempDir(), "run"), root)
+	free, err := util.FreeBytes(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	// Leave room for one 2 MB writer, not two.
+	floor := free - 3<<20
+
+	first, err := l.Reserve(2<<20, floor, "sync")
+	if err != nil {
+		t.Fatalf("first Reserve: %v", err)
+	}
+	if reserved, _ := l.Reserved(); reserved != 2<<20 {
+		t.Errorf("Reserved = %d, want %d", reserved, 2<<20)
+	}
+	_, err = l.Reserve(2<<20, floor, "card_check")
+	var short *SpaceError
+	if !errors.As(err, &short) {
+		t.Fatalf("second Reserve err = %v, want a SpaceError", err)
+	}
+	if short.Reserved != 2<<20 || short.Available != short.Free-short.Reserved {
+		t.Errorf("SpaceError = %+v, want the first reservation counted", short)
+	}
+
+	if err := first.Release(); err != nil {
+		t.Fatalf("Release: %v", err)
+	}
+	if err := first.Release(); err != nil {
+		t.Fatalf("second Release: %v", err)
+	}
+	second, err := l.Reserve(2<<20, floor, "card_check")
+	if err != nil {
+		t.Fatalf("Reserve after Release: %v", err)
+	}
+	defer second.Release()
+	if reserved, _ := l.Reserved(); reserved != 2<<20 {
+		t.Errorf("Reserved = %d, want only the second reservation", reserved)
+	}
+}
+
+func TestLedgerDropsDeadWriters(t *testing.T) {
+	run := t.TempDir()
+	l := OpenLedger(run, t.TempDir())
+	// A sync that was killed mid-copy, and a damaged entry list.
+	stale := `[{"id":"x","pid":2147483647,"bytes":1073741824,"purpose":"sync","at":"2026-01-01T00:00:00Z"}]`
+	if err := os.WriteFile(filepath.Join(run, LedgerName), []byte(stale), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if reserved, err := l.Reserved(); err != nil || reserved != 0 {
+		t.Fatalf("Reserved = %d, %v; want the dead writer's reservation dropped", reserved, err)
+	}
+
+	if err := os.WriteFile(filepath.Join(run, LedgerName), []byte("{not json"), 0o644); err != nil {
+		t.Fatal(err)
+	}
+	r, err := l.Reserve(1, 0, "sync")
+	if err != nil {
+		t.Fatalf("Reserve on a damaged ledger: %v", err)
+	}
+	if reserved, _ := l.Reserved(); reserved != 1 {
+		t.Errorf("Reserved = %d, want 1", reserved)
+	}
+	_ = r.Release()
+}
+
+func TestNilReservationRelease(t *testing.T) {
+	var r *Reservation
+	if err := r.Release(); err != nil {
+		t.Fatal(err)
+	}
+}
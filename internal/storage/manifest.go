@@ -6,6 +6,7 @@ import (
 	"os"
 	"path/filepath"
 	"sort"
+	"strings"
 	"time"
 
 	"github.com/proeugene/logfalcon/internal/util"
@@ -34,6 +35,82 @@ type Manifest struct {
 	EraseAttempted bool               `json:"erase_attempted"`
 	EraseCompleted bool               `json:"erase_completed"`
 	Timing         map[string]float64 `json:"timing,omitempty"`
+	// DownloadedUTC is set by the web server the first time the raw flash is
+	// downloaded; retention prefers evicting such sessions.
+	DownloadedUTC string `json:"downloaded_utc,omitempty"`
+	// OffloadedUTC is set once a verified copy exists on USB storage.
+	OffloadedUTC string `json:"offloaded_utc,omitempty"`
+	// Pinned sessions are never deleted automatically.
+	Pinned bool `json:"pinned,omitempty"`
+	// CPU records the clock policy the copy ran under.
+	CPU *ManifestCPU `json:"cpu,omitempty"`
+	// Throttle records heat and power trouble seen during the sync, so a
+	// slow sync can be attributed to it.
+	Throttle *ManifestThrottle `json:"throttle,omitempty"`
+	// Timeline marks each startup and sync stage from the moment the FC was
+	// plugged in, to show where the pilot's wait went.
+	Timeline []ManifestStage `json:"timeline,omitempty"`
+	// Partial is set when only part of the flash was copied.
+	Partial *ManifestPartial `json:"partial,omitempty"`
+	// Card is how the Pi SD card kept up with the copy.
+	Card *CardSample `json:"card,omitempty"`
+	// Flights lists the logs found in the raw file by post-sync indexing;
+	// IndexedUTC is set once it ran, even if it found none.
+	Flights    []ManifestFlight `json:"flights,omitempty"`
+	IndexedUTC string           `json:"indexed_utc,omitempty"`
+}
+
+// ManifestFlight is one blackbox log inside the raw file, with a pre-rendered
+// throttle/gyro sparkline for the session list.
+type ManifestFlight struct {
+	Offset      int64   `json:"offset"`
+	Bytes       int64   `json:"bytes"`
+	DurationSec float64 `json:"duration_sec"`
+	MaxGyroDPS  float64 `json:"max_gyro_dps"`
+	Sparkline   string  `json:"sparkline_svg,omitempty"`
+}
+
+// ManifestPartial describes which part of the FC flash a partial session
+// holds: the file is flash bytes [FlashOffset, FlashUsed).
+type ManifestPartial struct {
+	Mode        string `json:"mode"` // "last_flight" or PartialInterrupted
+	FlashOffset int64  `json:"flash_offset"`
+	FlashUsed   int64  `json:"flash_used"`
+	// Ranges lists the file offsets actually saved by an interrupted copy;
+	// the rest of the file is a hole.
+	Ranges []Range `json:"ranges,omitempty"`
+}
+
+// ManifestStage is a sync stage reached AtMS milliseconds after the first
+// recorded event (normally udev seeing the FC).
+type ManifestStage struct {
+	Stage string  `json:"stage"`
+	AtMS  float64 `json:"at_ms"`
+}
+
+// ManifestCPU holds the CPU clock sampled at the end of the flash copy.
+type ManifestCPU struct {
+	Governor string `json:"governor"`
+	CurKHz   int    `json:"cur_khz"`
+	MinKHz   int    `json:"min_khz"`
+	MaxKHz   int    `json:"max_khz"`
+}
+
+// ManifestThrottle summarises the SoC temperature and firmware throttle
+// flags sampled during a sync.
+type ManifestThrottle struct {
+	MaxTempC     float64                 `json:"max_temp_c"`
+	UnderVoltage bool                    `json:"under_voltage"`
+	Throttled    bool                    `json:"throttled"`
+	Events       []ManifestThrottleEvent `json:"events,omitempty"`
+}
+
+// ManifestThrottleEvent is a change of firmware throttle flags
+// (vcgencmd get_throttled bits 0-3) at AtSec into the sync.
+type ManifestThrottleEvent struct {
+	AtSec float64 `json:"at_sec"`
+	Flags uint32  `json:"flags"`
+	TempC float64 `json:"temp_c"`
 }
 
 // ManifestFC holds flight-controller metadata inside a manifest.
@@ -67,6 +144,11 @@ func atomicJSONWrite(path string, data any) error {
 	if err != nil {
 		return fmt.Errorf("marshal json: %w", err)
 	}
+	return writeFileSync(path, b)
+}
+
+// writeFileSync truncates path, writes b and fsyncs before closing.
+func writeFileSync(path string, b []byte) error {
 	f, err := os.OpenFile(path, os.O_WRONLY|os.O_CREATE|os.O_TRUNC, 0o644)
 	if err != nil {
 		return fmt.Errorf("open file: %w", err)
@@ -85,17 +167,8 @@ func atomicJSONWrite(path string, data any) error {
 // MakeSessionDir creates a timestamped session directory.
 // Layout: <root>/fc_<VARIANT>_uid-<uid8>/<YYYY-MM-DD_HHMMSS>/
 func MakeSessionDir(root string, info *FCInfo) (string, error) {
-	uidShort := "unknown"
-	if info.UID != "" && info.UID != "unknown" {
-		if len(info.UID) > 8 {
-			uidShort = info.UID[:8]
-		} else {
-			uidShort = info.UID
-		}
-	}
-	fcDir := filepath.Join(root, fmt.Sprintf("fc_%s_uid-%s", info.Variant, uidShort))
-	timestamp := time.Now().Format("2006-01-02_150405")
-	sessionDir := filepath.Join(fcDir, timestamp)
+	fcDir, timestamp := sessionNames(info, time.Now())
+	sessionDir := filepath.Join(root, fcDir, timestamp)
 	if err := os.MkdirAll(sessionDir, 0o755); err != nil {
 		return "", fmt.Errorf("create session dir: %w", err)
 	}
@@ -106,48 +179,82 @@ func MakeSessionDir(root string, info *FCInfo) (string, error) {
 func WriteManifest(dir string, info *FCInfo, sha256hex string, usedSize int64,
 	eraseCompleted, eraseAttempted bool, timing map[string]float64) error {
 
-	m := Manifest{
-		Version:    1,
-		CreatedUTC: time.Now().UTC().Format(time.RFC3339),
-		FC: ManifestFC{
-			Variant:        info.Variant,
-			UID:            info.UID,
-			APIVersion:     fmt.Sprintf("%d.%d", info.APIMajor, info.APIMinor),
-			BlackboxDevice: info.BlackboxDevice,
-		},
-		File: ManifestFile{
-			Name:   RawFlashFilename,
-			SHA256: sha256hex,
-			Bytes:  usedSize,
-		},
-		EraseAttempted: eraseAttempted,
-		EraseCompleted: eraseCompleted,
-		Timing:         timing,
-	}
+	m := NewManifest(info, sha256hex, usedSize, eraseCompleted, eraseAttempted, timing)
 	return atomicJSONWrite(filepath.Join(dir, ManifestFilename), m)
 }
 
 // UpdateManifestErase updates erase fields in an existing manifest.
 func UpdateManifestErase(dir string, eraseCompleted bool, timing map[string]float64) error {
-	path := filepath.Join(dir, ManifestFilename)
-	data, err := os.ReadFile(path)
+	m, err := ReadManifest(dir)
 	if err != nil {
-		return fmt.Errorf("read manifest: %w", err)
-	}
-	var m Manifest
-	if err := json.Unmarshal(data, &m); err != nil {
-		return fmt.Errorf("decode manifest: %w", err)
+		return err
 	}
 	m.EraseAttempted = true
 	m.EraseCompleted = eraseCompleted
 	if timing != nil {
 		m.Timing = timing
 	}
-	return atomicJSONWrite(path, m)
+	return atomicJSONWrite(filepath.Join(dir, ManifestFilename), m)
+}
+
+// ReadManifest loads manifest.json from a session directory.
+func ReadManifest(dir string) (*Manifest, error) {
+	data, err := os.ReadFile(filepath.Join(dir, ManifestFilename))
+	if err != nil {
+		return nil, fmt.Errorf("read manifest: %w", err)
+	}
+	var m Manifest
+	if err := json.Unmarshal(data, &m); err != nil {
+		return nil, fmt.Errorf("decode manifest: %w", err)
+	}
+	return &m, nil
 }
 
 // ListSessions returns all sessions under root, newest first.
 func ListSessions(root string) ([]*Session, error) {
+	refs, err := sessionRefs(root)
+	if err != nil {
+		return nil, err
+	}
+	var sessions []*Session
+	for _, ref := range refs {
+		if sess := loadSession(root, ref); sess != nil {
+			sessions = append(sessions, sess)
+		}
+	}
+	return sessions, nil
+}
+
+// ListSessionsAfter returns up to limit sessions under root that follow the
+// session ID after in ListSessions order ("" starts at the newest), and how
+// many session directories come after them. Only directory names are read
+// for the rest of the store, so the cost of a page does not grow with the
+// manifests on the card. The count may include orphaned directories that
+// ListSessions leaves out.
+func ListSessionsAfter(root, after string, limit int) ([]*Session, int, error) {
+	refs, err := sessionRefs(root)
+	if err != nil {
+		return nil, 0, err
+	}
+	i := sessionCursor(len(refs), func(i int) (string, string) { return refs[i].id(), refs[i].sessDir }, after)
+	var sessions []*Session
+	for ; i < len(refs) && len(sessions) < limit; i++ {
+		if sess := loadSession(root, refs[i]); sess != nil {
+			sessions = append(sessions, sess)
+		}
+	}
+	return sessions, len(refs) - i, nil
+}
+
+// sessionRef names one session directory.
+type sessionRef struct{ fcDir, sessDir string }
+
+func (r sessionRef) id() string { return r.fcDir + "/" + r.sessDir }
+
+// sessionRefs lists the session directories under root, newest first by
+// session directory name (timestamp-based), then by ID like the segment
+// layout, so the order is stable for paging.
+func sessionRefs(root string) ([]sessionRef, error) {
 	entries, err := os.ReadDir(root)
 	if err != nil {
 		if os.IsNotExist(err) {
@@ -155,77 +262,145 @@ func ListSessions(root string) ([]*Session, error) {
 		}
 		return nil, fmt.Errorf("read root dir: %w", err)
 	}
-
-	var sessions []*Session
+	var refs []sessionRef
 	for _, fcEntry := range entries {
 		if !fcEntry.IsDir() {
 			continue
 		}
-		fcDirName := fcEntry.Name()
-		fcDirPath := filepath.Join(root, fcDirName)
-		sessionEntries, err := os.ReadDir(fcDirPath)
+		sessionEntries, err := os.ReadDir(filepath.Join(root, fcEntry.Name()))
 		if err != nil {
 			continue
 		}
 		for _, sessEntry := range sessionEntries {
-			if !sessEntry.IsDir() {
-				continue
-			}
-			sessDirName := sessEntry.Name()
-			sessDirPath := filepath.Join(fcDirPath, sessDirName)
-			manifestPath := filepath.Join(sessDirPath, ManifestFilename)
-			data, err := os.ReadFile(manifestPath)
-			if err != nil {
-				continue
+			if sessEntry.IsDir() {
+				refs = append(refs, sessionRef{fcEntry.Name(), sessEntry.Name()})
 			}
-			var m Manifest
-			if err := json.Unmarshal(data, &m); err != nil {
-				continue // skip corrupted manifests
-			}
-			bblPath := filepath.Join(sessDirPath, RawFlashFilename)
-			var bblPtr *string
-			if _, err := os.Stat(bblPath); err == nil {
-				bblPtr = &bblPath
-			}
-			sessions = append(sessions, &Session{
-				SessionID:  fmt.Sprintf("%s/%s", fcDirName, sessDirName),
-				FCDir:      fcDirName,
-				SessionDir: sessDirName,
-				Path:       sessDirPath,
-				BBLPath:    bblPtr,
-				Manifest:   &m,
-			})
 		}
 	}
+	sort.Slice(refs, func(i, j int) bool {
+		return sessionNewer(refs[i].sessDir, refs[i].id(), refs[j].sessDir, refs[j].id())
+	})
+	return refs, nil
+}
+
+// sessionNewer orders sessions newest first: by session directory, then ID.
+func sessionNewer(dirA, idA, dirB, idB string) bool {
+	if dirA != dirB {
+		return dirA > dirB
+	}
+	return idA > idB
+}
 
-	// Sort newest first by session directory name (timestamp-based).
-	sort.Slice(sessions, func(i, j int) bool {
-		return sessions[i].SessionDir > sessions[j].SessionDir
+// sessionCursor returns the index of the first of n sessions in newest-first
+// order that comes after the session ID after; at(i) gives the i-th ID and
+// session directory. The cursor still works once that session is deleted.
+func sessionCursor(n int, at func(int) (id, sessDir string), after string) int {
+	if after == "" {
+		return 0
+	}
+	_, afterDir, _ := strings.Cut(after, "/")
+	return sort.Search(n, func(i int) bool {
+		id, dir := at(i)
+		return sessionNewer(afterDir, after, dir, id)
 	})
-	return sessions, nil
 }
 
-// CleanupOldestSessions deletes oldest sessions until requiredFreeBytes is
-// available. Returns deleted session IDs.
-func CleanupOldestSessions(root string, requiredFreeBytes int64) ([]string, error) {
+// loadSession reads a session's manifest, or nil if the directory is not a
+// listable session.
+func loadSession(root string, ref sessionRef) *Session {
+	sessDirPath := filepath.Join(root, ref.fcDir, ref.sessDir)
+	var m Manifest
+	if data, err := os.ReadFile(filepath.Join(sessDirPath, ManifestFilename)); err == nil {
+		if err := json.Unmarshal(data, &m); err != nil {
+			return nil // skip corrupted manifests
+		}
+	} else if rs, err := readCoverage(sessDirPath); err == nil {
+		// The sync was killed mid tail-first copy, before it could write a
+		// manifest; list what reached the disk.
+		m = Manifest{
+			Version: 1,
+			File:    ManifestFile{Name: RawFlashFilename, Bytes: CoveredBytes(rs)},
+			Partial: &ManifestPartial{Mode: PartialInterrupted, Ranges: rs},
+		}
+	} else {
+		return nil
+	}
+	bblPath := filepath.Join(sessDirPath, RawFlashFilename)
+	var bblPtr *string
+	if _, err := os.Stat(bblPath); err == nil {
+		bblPtr = &bblPath
+	}
+	return &Session{
+		SessionID:  ref.id(),
+		FCDir:      ref.fcDir,
+		SessionDir: ref.sessDir,
+		Path:       sessDirPath,
+		BBLPath:    bblPtr,
+		Manifest:   &m,
+	}
+}
+
+// orphanGrace is how long a session directory without a manifest or coverage
+// is left alone: another FC's sync may still be copying into it.
+const orphanGrace = 10 * time.Minute
+
+// CleanupOldestSessions deletes sessions chosen by policy until
+// requiredFreeBytes is available. Orphaned session directories (a sync killed
+// before it saved anything, which ListSessions does not show) go first. The
+// deletions are planned up front from manifest byte counts, and free space is
+// checked again at the end: a *SpaceError means the target was not reached.
+// Returns deleted session IDs.
+func CleanupOldestSessions(root string, requiredFreeBytes int64, policy RetentionPolicy) ([]string, error) {
 	if requiredFreeBytes <= 0 {
 		return nil, nil
 	}
 	if _, err := os.Stat(root); os.IsNotExist(err) {
 		return nil, nil
 	}
+	free, err := util.FreeBytes(root)
+	if err != nil {
+		return nil, fmt.Errorf("check free space: %w", err)
+	}
+	if free >= requiredFreeBytes {
+		return nil, nil
+	}
+
+	deleted, err := sweepOrphans(root, requiredFreeBytes)
+	if err != nil {
+		return deleted, err
+	}
+	sessions, err := ListSessions(root)
+	if err != nil {
+		return deleted, fmt.Errorf("list sessions: %w", err)
+	}
+	if free, err = util.FreeBytes(root); err != nil {
+		return deleted, fmt.Errorf("check free space: %w", err)
+	}
 
-	// Collect all session directories, sorted oldest first.
-	type candidate struct {
-		sessionID  string
-		sessionDir string
+	plan, _ := policy.Plan(sessions, free, requiredFreeBytes)
+	for _, sess := range plan {
+		if err := removeSessionDir(sess.Path); err != nil {
+			return deleted, fmt.Errorf("remove session %s: %w", sess.SessionID, err)
+		}
+		deleted = append(deleted, sess.SessionID)
 	}
-	var candidates []candidate
+	_, err = checkFree(root, requiredFreeBytes)
+	return deleted, err
+}
 
+// sweepOrphans removes session directories that have neither a readable
+// manifest nor coverage and were not written for orphanGrace, oldest first,
+// until requiredFreeBytes is free.
+func sweepOrphans(root string, requiredFreeBytes int64) ([]string, error) {
+	type orphan struct {
+		id, path string
+	}
+	var orphans []orphan
 	fcEntries, err := os.ReadDir(root)
 	if err != nil {
 		return nil, fmt.Errorf("read root dir: %w", err)
 	}
+	cutoff := time.Now().Add(-orphanGrace)
 	for _, fcEntry := range fcEntries {
 		if !fcEntry.IsDir() {
 			continue
@@ -236,23 +411,19 @@ func CleanupOldestSessions(root string, requiredFreeBytes int64) ([]string, erro
 			continue
 		}
 		for _, sessEntry := range sessEntries {
-			if !sessEntry.IsDir() {
+			dir := filepath.Join(fcDirPath, sessEntry.Name())
+			if !sessEntry.IsDir() || !isOrphan(dir, cutoff) {
 				continue
 			}
-			candidates = append(candidates, candidate{
-				sessionID:  fmt.Sprintf("%s/%s", fcEntry.Name(), sessEntry.Name()),
-				sessionDir: filepath.Join(fcDirPath, sessEntry.Name()),
-			})
+			orphans = append(orphans, orphan{id: fcEntry.Name() + "/" + sessEntry.Name(), path: dir})
 		}
 	}
-
-	// Sort oldest first (ascending by session directory name).
-	sort.Slice(candidates, func(i, j int) bool {
-		return filepath.Base(candidates[i].sessionDir) < filepath.Base(candidates[j].sessionDir)
+	sort.Slice(orphans, func(i, j int) bool {
+		return filepath.Base(orphans[i].path) < filepath.Base(orphans[j].path)
 	})
 
 	var deleted []string
-	for _, c := range candidates {
+	for _, o := range orphans {
 		free, err := util.FreeBytes(root)
 		if err != nil {
 			return deleted, fmt.Errorf("check free space: %w", err)
@@ -260,16 +431,40 @@ func CleanupOldestSessions(root string, requiredFreeBytes int64) ([]string, erro
 		if free >= requiredFreeBytes {
 			break
 		}
-		if err := os.RemoveAll(c.sessionDir); err != nil {
-			return deleted, fmt.Errorf("remove session %s: %w", c.sessionID, err)
+		if err := removeSessionDir(o.path); err != nil {
+			return deleted, fmt.Errorf("remove orphaned session %s: %w", o.id, err)
 		}
-		// Remove empty FC directory.
-		parent := filepath.Dir(c.sessionDir)
-		remaining, _ := os.ReadDir(parent)
-		if len(remaining) == 0 {
-			_ = os.Remove(parent)
-		}
-		deleted = append(deleted, c.sessionID)
+		deleted = append(deleted, o.id)
 	}
 	return deleted, nil
 }
+
+// isOrphan reports whether dir is a session ListSessions skips and nothing
+// has written to it since cutoff.
+func isOrphan(dir string, cutoff time.Time) bool {
+	if _, err := ReadManifest(dir); err == nil {
+		return false
+	}
+	if _, err := readCoverage(dir); err == nil {
+		return false
+	}
+	for _, path := range []string{dir, filepath.Join(dir, RawFlashFilename)} {
+		if info, err := os.Stat(path); err == nil && info.ModTime().After(cutoff) {
+			return false
+		}
+	}
+	return true
+}
+
+// removeSessionDir deletes a session directory and its FC directory once
+// empty.
+func removeSessionDir(dir string) error {
+	if err := os.RemoveAll(dir); err != nil {
+		return err
+	}
+	parent := filepath.Dir(dir)
+	if remaining, _ := os.ReadDir(parent); len(remaining) == 0 {
+		_ = os.Remove(parent)
+	}
+	return nil
+}
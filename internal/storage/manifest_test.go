@@ -2,6 +2,7 @@ package storage
 
 import (
 	"encoding/json"
+	"errors"
 	"os"
 	"path/filepath"
 	"strings"
@@ -223,6 +224,49 @@ func TestListSessionsEmpty(t *testing.T) {
 	}
 }
 
+func TestCleanupSweepsOrphanedSessions(t *testing.T) {
+	root := t.TempDir()
+	info := testFCInfo()
+	kept, err := MakeSessionDir(root, info)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if err := WriteManifest(kept, info, "abcd", 256, false, false, nil); err != nil {
+		t.Fatal(err)
+	}
+	// A sync killed before saving anything, and one still copying.
+	old := filepath.Join(filepath.Dir(kept), "2020-01-01_000000")
+	fresh := filepath.Join(filepath.Dir(kept), "2020-01-02_000000")
+	for _, dir := range []string{old, fresh} {
+		if err := os.MkdirAll(dir, 0o755); err != nil {
+			t.Fatal(err)
+		}
+		if err := os.WriteFile(filepath.Join(dir, RawFlashFilename), []byte("torn"), 0o644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	stale := time.Now().Add(-time.Hour)
+	for _, path := range []string{filepath.Join(old, RawFlashFilename), old} {
+		if err := os.Chtimes(path, stale, stale); err != nil {
+			t.Fatal(err)
+		}
+	}
+
+	deleted, err := CleanupOldestSessions(root, 1<<62, RetentionPolicy{KeepLastPerFC: 1})
+	var short *SpaceError
+	if !errors.As(err, &short) {
+		t.Fatalf("CleanupOldestSessions = %v, want a *SpaceError for the unreachable target", err)
+	}
+	if len(deleted) != 1 || !strings.HasSuffix(deleted[0], "/2020-01-01_000000") {
+		t.Errorf("deleted %v, want only the stale orphan", deleted)
+	}
+	for dir, want := range map[string]bool{old: false, fresh: true, kept: true} {
+		if _, err := os.Stat(dir); (err == nil) != want {
+			t.Errorf("%s exists = %v, want %v", filepath.Base(dir), err == nil, want)
+		}
+	}
+}
+
 func TestCleanupNotNeeded(t *testing.T) {
 	root := t.TempDir()
 	info := testFCInfo()
@@ -238,7 +282,7 @@ func TestCleanupNotNeeded(t *testing.T) {
 	}
 
 	// Request 1 byte free — should already be satisfied, nothing deleted.
-	deleted, err := CleanupOldestSessions(root, 1)
+	deleted, err := CleanupOldestSessions(root, 1, RetentionPolicy{})
 	if err != nil {
 		t.Fatalf("CleanupOldestSessions: %v", err)
 	}
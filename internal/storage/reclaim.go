@@ -0,0 +1,126 @@
+package storage
+
+import (
+	"errors"
+	"fmt"
+	"os"
+
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+// DefaultExpectedFlashBytes is the flash size assumed before any session has
+// been recorded (16 MB is the most common SPI flash on Betaflight boards).
+const DefaultExpectedFlashBytes int64 = 16 << 20
+
+// ReclaimResult summarises one background reclaim pass.
+type ReclaimResult struct {
+	TargetFreeBytes int64    // headroom the pass aimed for
+	FreeBefore      int64    // free bytes when the pass started
+	PlannedBytes    int64    // manifest bytes of the sessions chosen for deletion
+	Deleted         []string // session IDs actually removed
+	FreeAfter       int64    // free bytes when the pass finished
+}
+
+// ExpectedFlashBytes returns the largest flash image seen in sessions, which
+// is the space the next sync is expected to need.
+func ExpectedFlashBytes(sessions []*Session) int64 {
+	var largest int64
+	for _, s := range sessions {
+		if b := sessionBytes(s); b > largest {
+			largest = b
+		}
+	}
+	if largest == 0 {
+		return DefaultExpectedFlashBytes
+	}
+	return largest
+}
+
+// Reclaim makes sure the storage root has room for the largest flash seen so
+// far plus reserveBytes and that every FC is within its quota, deleting
+// sessions as the retention policy allows. Each FC's newest session is always
+// kept: it is usually the one its pilot has not downloaded yet. Meant to run
+// off the sync path, at idle I/O priority.
+//
+// The plan counts manifest bytes, which is not what the filesystem gives back
+// when a segment store cannot compact yet, so free space is measured again
+// afterwards; a *SpaceError means the target is still out of reach.
+func Reclaim(store Store, reserveBytes int64, policy RetentionPolicy) (*ReclaimResult, error) {
+	sessions, err := store.ListSessions()
+	if err != nil {
+		return nil, fmt.Errorf("list sessions: %w", err)
+	}
+	res := &ReclaimResult{TargetFreeBytes: ExpectedFlashBytes(sessions) + reserveBytes}
+	res.FreeBefore, err = util.FreeBytes(store.Root())
+	if err != nil {
+		return nil, fmt.Errorf("check free space: %w", err)
+	}
+	res.FreeAfter = res.FreeBefore
+	if res.FreeBefore >= res.TargetFreeBytes && policy.FCQuotaBytes == 0 {
+		return res, nil
+	}
+
+	if policy.KeepLastPerFC < 1 {
+		policy.KeepLastPerFC = 1
+	}
+	plan, planned := policy.Plan(sessions, res.FreeBefore, res.TargetFreeBytes)
+	res.PlannedBytes = planned
+	res.Deleted, err = deleteSessions(store, plan)
+	if err != nil {
+		return res, err
+	}
+	if c, ok := store.(interface{ Compact() error }); ok && len(res.Deleted) > 0 {
+		if err := c.Compact(); err != nil && !errors.Is(err, ErrStoreBusy) {
+			return res, fmt.Errorf("compact: %w", err)
+		}
+	}
+	res.FreeAfter, err = checkFree(store.Root(), res.TargetFreeBytes)
+	var short *SpaceError
+	if errors.As(err, &short) && res.FreeBefore >= res.TargetFreeBytes {
+		err = nil // a quota-only pass: the headroom was there to begin with
+	}
+	return res, err
+}
+
+// checkFree measures free space after deleting and returns a *SpaceError if
+// it is below target.
+func checkFree(root string, target int64) (int64, error) {
+	free, err := util.FreeBytes(root)
+	if err != nil {
+		return 0, fmt.Errorf("check free space: %w", err)
+	}
+	if free < target {
+		return free, &SpaceError{Need: target, Free: free, Available: free}
+	}
+	return free, nil
+}
+
+// deleteSessions removes each planned session, skipping ones that another
+// process (e.g. a storage-pressure cleanup during sync) already removed.
+func deleteSessions(store Store, plan []*Session) ([]string, error) {
+	var deleted []string
+	for _, s := range plan {
+		if err := store.Delete(s.SessionID); err != nil {
+			if errors.Is(err, os.ErrNotExist) {
+				continue
+			}
+			return deleted, fmt.Errorf("remove session %s: %w", s.SessionID, err)
+		}
+		deleted = append(deleted, s.SessionID)
+	}
+	return deleted, nil
+}
+
+// sessionBytes returns the flash size recorded for s, falling back to the
+// size of the data file for sessions that never got a manifest.
+func sessionBytes(s *Session) int64 {
+	if s.Manifest != nil {
+		return s.Manifest.File.Bytes
+	}
+	if s.BBLPath != nil {
+		if info, err := os.Stat(*s.BBLPath); err == nil {
+			return info.Size()
+		}
+	}
+	return 0
+}
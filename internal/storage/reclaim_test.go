@@ -0,0 +1,71 @@
+package storage
+
+import (
+	"errors"
+	"testing"
+)
+
+func TestExpectedFlashBytes(t *testing.T) {
+	if got := ExpectedFlashBytes(nil); got != DefaultExpectedFlashBytes {
+		t.Errorf("no history: got %d, want default %d", got, DefaultExpectedFlashBytes)
+	}
+	sessions := []*Session{sessionOfSize("a", 4<<20), sessionOfSize("b", 32<<20), sessionOfSize("c", 1<<20)}
+	if got := ExpectedFlashBytes(sessions); got != 32<<20 {
+		t.Errorf("got %d, want largest flash %d", got, 32<<20)
+	}
+}
+
+func TestReclaimKeepsNewestSessionPerFC(t *testing.T) {
+	root := t.TempDir()
+	s, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	for _, uid := range []string{"aaaaaaaa", "bbbbbbbb", "cccccccc"} {
+		writeSegmentSession(t, s, uniqueInfo(uid), []byte("flight of "+uid))
+	}
+
+	// An unreachable reserve forces the reclaimer to delete all it may, but
+	// every session is the newest of its FC.
+	res, err := Reclaim(s, 1<<62, RetentionPolicy{})
+	var short *SpaceError
+	if !errors.As(err, &short) || short.Free != res.FreeAfter {
+		t.Fatalf("Reclaim = %v, want a *SpaceError for the unreachable target", err)
+	}
+	if len(res.Deleted) != 0 {
+		t.Fatalf("deleted %v, want every FC's newest session kept", res.Deleted)
+	}
+	sessions, err := s.ListSessions()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(sessions) != 3 {
+		t.Fatalf("remaining = %v, want all three", ids(sessions))
+	}
+}
+
+func TestReclaimNothingToDo(t *testing.T) {
+	root := t.TempDir()
+	store := NewDirStore(root)
+	syncSession(t, store, uniqueInfo("aaaaaaaa"), []byte("one"))
+	syncSession(t, store, uniqueInfo("bbbbbbbb"), []byte("two"))
+
+	res, err := Reclaim(store, 0, RetentionPolicy{})
+	if err != nil {
+		t.Fatalf("Reclaim: %v", err)
+	}
+	if len(res.Deleted) != 0 {
+		t.Errorf("deleted %v with plenty of free space", res.Deleted)
+	}
+	if res.TargetFreeBytes != 3 {
+		t.Errorf("TargetFreeBytes = %d, want largest flash (3)", res.TargetFreeBytes)
+	}
+}
+
+func ids(sessions []*Session) []string {
+	out := make([]string, len(sessions))
+	for i, s := range sessions {
+		out[i] = s.SessionID
+	}
+	return out
+}
@@ -0,0 +1,98 @@
+package storage
+
+import "sort"
+
+// RetentionPolicy decides which sessions cleanup may evict. The zero value is
+// plain oldest-first across all FCs.
+type RetentionPolicy struct {
+	// KeepLastPerFC protects the newest N sessions of every FC.
+	KeepLastPerFC int
+	// FCQuotaBytes caps the space one FC's sessions may use (0 = no cap).
+	// Quotas are enforced even when the card is not short of space, so one
+	// busy pilot cannot push everyone else's logs out of a shared box.
+	FCQuotaBytes int64
+	// PreferDownloaded evicts sessions already fetched through the web UI or
+	// offloaded to USB before ones that only exist on the Pi.
+	PreferDownloaded bool
+}
+
+// Plan picks the sessions to delete so that every FC is within its quota and
+// freeBytes reaches targetFreeBytes. sessions must be sorted newest first, as
+// returned by ListSessions; the plan is computed from the listing alone, so a
+// segment store answers it from its in-memory index. Pinned sessions and each
+// FC's newest KeepLastPerFC sessions are never planned. Returns the plan in
+// deletion order and its total manifest bytes.
+func (p RetentionPolicy) Plan(sessions []*Session, freeBytes, targetFreeBytes int64) ([]*Session, int64) {
+	byFC := make(map[string][]*Session)
+	var fcs []string
+	for _, s := range sessions {
+		if _, ok := byFC[s.FCDir]; !ok {
+			fcs = append(fcs, s.FCDir)
+		}
+		byFC[s.FCDir] = append(byFC[s.FCDir], s)
+	}
+	sort.Strings(fcs)
+
+	protected := make(map[*Session]bool)
+	for _, list := range byFC {
+		for i, s := range list {
+			if i < p.KeepLastPerFC || (s.Manifest != nil && s.Manifest.Pinned) {
+				protected[s] = true
+			}
+		}
+	}
+
+	var (
+		plan    []*Session
+		planned int64
+		evicted = make(map[*Session]bool)
+	)
+	evict := func(s *Session) {
+		evicted[s] = true
+		plan = append(plan, s)
+		planned += sessionBytes(s)
+	}
+
+	// Quotas first: they hold regardless of free space.
+	if p.FCQuotaBytes > 0 {
+		for _, fc := range fcs {
+			list := byFC[fc]
+			var used int64
+			for _, s := range list {
+				used += sessionBytes(s)
+			}
+			for i := len(list) - 1; i >= 0 && used > p.FCQuotaBytes; i-- {
+				if protected[list[i]] {
+					continue
+				}
+				used -= sessionBytes(list[i])
+				evict(list[i])
+			}
+		}
+	}
+
+	// Then free space, oldest first, optionally downloaded sessions first.
+	var candidates []*Session
+	for i := len(sessions) - 1; i >= 0; i-- {
+		if s := sessions[i]; !protected[s] && !evicted[s] {
+			candidates = append(candidates, s)
+		}
+	}
+	if p.PreferDownloaded {
+		sort.SliceStable(candidates, func(i, j int) bool {
+			return copiedElsewhere(candidates[i]) && !copiedElsewhere(candidates[j])
+		})
+	}
+	for _, s := range candidates {
+		if freeBytes+planned >= targetFreeBytes {
+			break
+		}
+		evict(s)
+	}
+	return plan, planned
+}
+
+// copiedElsewhere reports whether a copy of s exists off the Pi.
+func copiedElsewhere(s *Session) bool {
+	return s.Manifest != nil && (s.Manifest.DownloadedUTC != "" || s.Manifest.OffloadedUTC != "")
+}
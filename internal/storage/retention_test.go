@@ -0,0 +1,101 @@
+package storage
+
+import (
+	"reflect"
+	"testing"
+)
+
+func sessionOfSize(id string, bytes int64) *Session {
+	return &Session{SessionID: id, FCDir: "fc_BTFL_uid-aaaaaaaa", Manifest: &Manifest{File: ManifestFile{Bytes: bytes}}}
+}
+
+func fcSession(fc, id string, bytes int64) *Session {
+	s := sessionOfSize(id, bytes)
+	s.FCDir = fc
+	return s
+}
+
+func TestPlanOldestFirst(t *testing.T) {
+	// Newest first, as returned by ListSessions.
+	sessions := []*Session{
+		sessionOfSize("newest", 100),
+		sessionOfSize("middle", 100),
+		sessionOfSize("older", 100),
+		sessionOfSize("oldest", 100),
+	}
+
+	plan, planned := RetentionPolicy{}.Plan(sessions, 50, 220)
+	if got := ids(plan); !reflect.DeepEqual(got, []string{"oldest", "older"}) {
+		t.Fatalf("plan = %v, want [oldest older]", got)
+	}
+	if planned != 200 {
+		t.Errorf("planned = %d, want 200", planned)
+	}
+
+	if plan, _ := (RetentionPolicy{}).Plan(sessions, 500, 220); len(plan) != 0 {
+		t.Errorf("enough free space: plan = %v, want empty", ids(plan))
+	}
+}
+
+func TestPlanKeepLastPerFC(t *testing.T) {
+	sessions := []*Session{
+		fcSession("a", "a3", 100),
+		fcSession("b", "b2", 100),
+		fcSession("a", "a2", 100),
+		fcSession("b", "b1", 100),
+		fcSession("a", "a1", 100),
+	}
+	plan, _ := RetentionPolicy{KeepLastPerFC: 2}.Plan(sessions, 0, 1<<40)
+	if got := ids(plan); !reflect.DeepEqual(got, []string{"a1"}) {
+		t.Fatalf("plan = %v, want only a1 (the rest are each FC's last two)", got)
+	}
+}
+
+func TestPlanPinnedNeverEvicted(t *testing.T) {
+	sessions := []*Session{
+		sessionOfSize("new", 100),
+		sessionOfSize("pinned", 100),
+		sessionOfSize("old", 100),
+	}
+	sessions[1].Manifest.Pinned = true
+	plan, _ := RetentionPolicy{}.Plan(sessions, 0, 1<<40)
+	if got := ids(plan); !reflect.DeepEqual(got, []string{"old", "new"}) {
+		t.Fatalf("plan = %v, want [old new]", got)
+	}
+}
+
+func TestPlanPrefersDownloaded(t *testing.T) {
+	sessions := []*Session{
+		sessionOfSize("new-downloaded", 100),
+		sessionOfSize("mid", 100),
+		sessionOfSize("old", 100),
+	}
+	sessions[0].Manifest.DownloadedUTC = "2026-01-01T00:00:00Z"
+
+	plan, _ := RetentionPolicy{PreferDownloaded: true}.Plan(sessions, 0, 150)
+	if got := ids(plan); !reflect.DeepEqual(got, []string{"new-downloaded", "old"}) {
+		t.Fatalf("plan = %v, want downloaded session first", got)
+	}
+	plan, _ = RetentionPolicy{}.Plan(sessions, 0, 150)
+	if got := ids(plan); !reflect.DeepEqual(got, []string{"old", "mid"}) {
+		t.Fatalf("plan without preference = %v, want oldest first", got)
+	}
+}
+
+func TestPlanFCQuota(t *testing.T) {
+	// FC "busy" uses 400 bytes against a 250-byte quota; "rare" is under it.
+	sessions := []*Session{
+		fcSession("busy", "busy4", 100),
+		fcSession("rare", "rare1", 100),
+		fcSession("busy", "busy3", 100),
+		fcSession("busy", "busy2", 100),
+		fcSession("busy", "busy1", 100),
+	}
+	plan, planned := RetentionPolicy{FCQuotaBytes: 250}.Plan(sessions, 1<<40, 0)
+	if got := ids(plan); !reflect.DeepEqual(got, []string{"busy1", "busy2"}) {
+		t.Fatalf("plan = %v, want the two oldest of the over-quota FC", got)
+	}
+	if planned != 200 {
+		t.Errorf("planned = %d, want 200", planned)
+	}
+}
@@ -0,0 +1,802 @@
+package storage
+
+import (
+	"bufio"
+	"crypto/sha256"
+	"encoding/hex"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"hash"
+	"io"
+	"math"
+	"os"
+	"path/filepath"
+	"sort"
+	"strconv"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+// Segment layout:
+//
+//	<root>/segments/seg-000001.dat   append-only raw flash data, many sessions per file
+//	<root>/segments/index.log        append-only JSON lines: put/del records
+//	<root>/segments/.lock            flock held by the writer and by compaction
+//	<root>/segments/index.lock       flock held while index.log is read, changed and appended
+//
+// A sync appends its flash data to the newest segment and then appends one
+// index record per manifest change, so a session costs no directory or inode
+// creation at all. Deleting a session only appends a "del" record; space comes
+// back when a whole segment is dead (unlink) or through compaction, which
+// copies live sessions out of mostly-dead segments.
+const (
+	SegmentDirName = "segments"
+
+	segmentIndexName   = "index.log"
+	segmentLockName    = ".lock"
+	segmentIndexLock   = "index.lock"
+	segmentFilePrefix  = "seg-"
+	segmentFileSuffix  = ".dat"
+	compactDeadRatio   = 0.5     // compact segments that are at least half dead
+	indexRewriteSlack  = 64      // superseded records tolerated before rewriting the index
+	segmentIndexRecMax = 1 << 20 // refuse absurd index lines when replaying
+)
+
+// segmentMaxBytes is the size past which new sessions roll to a new segment.
+var segmentMaxBytes int64 = 64 << 20
+
+// ErrStoreBusy is returned when a maintenance operation needs the writer lock
+// while a sync holds it.
+var ErrStoreBusy = errors.New("session store busy")
+
+// indexRecord is one line of index.log.
+type indexRecord struct {
+	Op       string    `json:"op"` // "put" or "del"
+	ID       string    `json:"id"`
+	Segment  int       `json:"seg,omitempty"`
+	Offset   int64     `json:"off,omitempty"`
+	Length   int64     `json:"len,omitempty"`
+	Manifest *Manifest `json:"manifest,omitempty"`
+}
+
+// segEntry is the in-memory index entry for one live session.
+type segEntry struct {
+	id       string
+	segment  int
+	offset   int64
+	length   int64
+	manifest *Manifest
+}
+
+// SegmentStore is the append-only, segment-based session store.
+type SegmentStore struct {
+	root string
+	dir  string
+
+	mu        sync.Mutex
+	entries   map[string]*segEntry
+	records   int         // records in the current index file
+	indexInfo os.FileInfo // index.log as of the last replay
+	pending   map[string]*segEntry
+	lockFile  *os.File // non-nil while this process holds the writer lock
+	stats     ioCounters
+}
+
+// OpenSegmentStore opens (creating if needed) the segment store under root.
+func OpenSegmentStore(root string) (*SegmentStore, error) {
+	s := &SegmentStore{
+		root:    root,
+		dir:     filepath.Join(root, SegmentDirName),
+		entries: make(map[string]*segEntry),
+		pending: make(map[string]*segEntry),
+	}
+	if _, err := os.Stat(s.dir); os.IsNotExist(err) {
+		if err := os.MkdirAll(s.dir, 0o755); err != nil {
+			return nil, fmt.Errorf("create segment dir: %w", err)
+		}
+		s.stats.dirsCreated.Add(1)
+	}
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if err := s.refreshLocked(); err != nil {
+		return nil, err
+	}
+	return s, nil
+}
+
+// Root returns the storage root directory.
+func (s *SegmentStore) Root() string { return s.root }
+
+// Stats returns cumulative I/O counters.
+func (s *SegmentStore) Stats() IOStats { return s.stats.snapshot() }
+
+// Create takes the writer lock and starts appending to the newest segment.
+// The lock is held until PutManifest or Abort (or process exit).
+func (s *SegmentStore) Create(info *FCInfo) (string, SessionWriter, error) {
+	lock, err := s.lock(true)
+	if err != nil {
+		return "", nil, err
+	}
+	seg, err := s.activeSegment()
+	if err != nil {
+		s.unlock(lock)
+		return "", nil, err
+	}
+	path := s.segmentPath(seg)
+	_, statErr := os.Stat(path)
+	f, err := os.OpenFile(path, os.O_WRONLY|os.O_CREATE, 0o644)
+	if err != nil {
+		s.unlock(lock)
+		return "", nil, fmt.Errorf("open segment: %w", err)
+	}
+	if os.IsNotExist(statErr) {
+		s.stats.filesCreated.Add(1)
+	}
+	start, err := f.Seek(0, io.SeekEnd)
+	if err != nil {
+		_ = f.Close()
+		s.unlock(lock)
+		return "", nil, fmt.Errorf("seek segment: %w", err)
+	}
+
+	fcDir, sessDir := sessionNames(info, time.Now())
+	id := fcDir + "/" + sessDir
+	w := &segmentWriter{
+		store:   s,
+		id:      id,
+		segment: seg,
+		path:    path,
+		file:    f,
+		start:   start,
+		hasher:  sha256.New(),
+	}
+	w.buf = bufio.NewWriterSize(profiledFile{f, &w.profile}, bufSize)
+
+	s.mu.Lock()
+	s.lockFile = lock
+	s.mu.Unlock()
+	return id, w, nil
+}
+
+// PutManifest appends a put record binding the session's data to m, and
+// releases the writer lock taken by Create.
+func (s *SegmentStore) PutManifest(sessionID string, m *Manifest) error {
+	ilock, err := s.lockIndex()
+	if err != nil {
+		return err
+	}
+	defer ilock.Close()
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if err := s.refreshLocked(); err != nil {
+		return err
+	}
+	e, ok := s.pending[sessionID]
+	if !ok {
+		e, ok = s.entries[sessionID]
+	}
+	if !ok {
+		return fmt.Errorf("unknown session %s: %w", sessionID, os.ErrNotExist)
+	}
+	rec := indexRecord{Op: "put", ID: sessionID, Segment: e.segment, Offset: e.offset, Length: e.length, Manifest: m}
+	if err := s.appendRecordsLocked(rec); err != nil {
+		return err
+	}
+	delete(s.pending, sessionID)
+	s.releaseLocked()
+	return nil
+}
+
+// UpdateManifest appends a put record carrying the modified manifest. The
+// sync and the web process both update manifests, so the read, fn and the
+// append happen under the index lock.
+func (s *SegmentStore) UpdateManifest(sessionID string, fn func(*Manifest)) error {
+	ilock, err := s.lockIndex()
+	if err != nil {
+		return err
+	}
+	defer ilock.Close()
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if err := s.refreshLocked(); err != nil {
+		return err
+	}
+	e, ok := s.entries[sessionID]
+	if !ok {
+		return fmt.Errorf("unknown session %s: %w", sessionID, os.ErrNotExist)
+	}
+	m := *e.manifest
+	fn(&m)
+	return s.appendRecordsLocked(indexRecord{Op: "put", ID: sessionID, Segment: e.segment, Offset: e.offset, Length: e.length, Manifest: &m})
+}
+
+// ListSessions returns all committed sessions from the index, newest first.
+func (s *SegmentStore) ListSessions() ([]*Session, error) {
+	sessions, _, err := s.ListSessionsAfter("", math.MaxInt)
+	return sessions, err
+}
+
+// ListSessionsAfter pages through the in-memory index, copying manifests for
+// the returned sessions only.
+func (s *SegmentStore) ListSessionsAfter(after string, limit int) ([]*Session, int, error) {
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if err := s.refreshLocked(); err != nil {
+		return nil, 0, err
+	}
+	type ref struct {
+		e       *segEntry
+		sessDir string
+	}
+	refs := make([]ref, 0, len(s.entries))
+	for _, e := range s.entries {
+		_, sessDir, _ := splitSessionID(e.id)
+		refs = append(refs, ref{e, sessDir})
+	}
+	sort.Slice(refs, func(i, j int) bool {
+		return sessionNewer(refs[i].sessDir, refs[i].e.id, refs[j].sessDir, refs[j].e.id)
+	})
+	start := sessionCursor(len(refs), func(i int) (string, string) { return refs[i].e.id, refs[i].sessDir }, after)
+	end := start + min(limit, len(refs)-start)
+	sessions := make([]*Session, 0, end-start)
+	for _, r := range refs[start:end] {
+		fcDir, sessDir, _ := splitSessionID(r.e.id)
+		segPath := s.segmentPath(r.e.segment)
+		m := *r.e.manifest
+		sessions = append(sessions, &Session{
+			SessionID:  r.e.id,
+			FCDir:      fcDir,
+			SessionDir: sessDir,
+			Path:       segPath,
+			BBLPath:    &segPath,
+			Manifest:   &m,
+		})
+	}
+	return sessions, len(refs) - end, nil
+}
+
+// Open returns a section reader over the session's bytes in its segment, or
+// the manifest rendered as JSON.
+func (s *SegmentStore) Open(sessionID, filename string) (*SessionFile, error) {
+	if _, _, err := splitSessionID(sessionID); err != nil {
+		return nil, err
+	}
+	s.mu.Lock()
+	if err := s.refreshLocked(); err != nil {
+		s.mu.Unlock()
+		return nil, err
+	}
+	e, ok := s.entries[sessionID]
+	var ent segEntry
+	if ok {
+		ent = *e
+	}
+	s.mu.Unlock()
+	if !ok {
+		return nil, os.ErrNotExist
+	}
+
+	modTime, _ := time.Parse(time.RFC3339, ent.manifest.CreatedUTC)
+	switch filename {
+	case ManifestFilename:
+		return manifestFile(ent.manifest, modTime)
+	case RawFlashFilename:
+		// An open fd keeps reading the old bytes even if compaction unlinks
+		// the segment mid-download.
+		f, err := os.Open(s.segmentPath(ent.segment))
+		if err != nil {
+			return nil, err
+		}
+		return &SessionFile{
+			ReadSeeker: io.NewSectionReader(f, ent.offset, ent.length),
+			Size:       ent.length,
+			ModTime:    modTime,
+			closer:     f,
+		}, nil
+	default:
+		return nil, ErrFileNotAllowed
+	}
+}
+
+// Delete appends a del record and unlinks any segment left fully dead.
+func (s *SegmentStore) Delete(sessionID string) error {
+	if _, _, err := splitSessionID(sessionID); err != nil {
+		return err
+	}
+	ilock, err := s.lockIndex()
+	if err != nil {
+		return err
+	}
+	defer ilock.Close()
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if err := s.refreshLocked(); err != nil {
+		return err
+	}
+	if _, ok := s.entries[sessionID]; !ok {
+		return os.ErrNotExist
+	}
+	if err := s.appendRecordsLocked(indexRecord{Op: "del", ID: sessionID}); err != nil {
+		return err
+	}
+	s.dropDeadSegmentsLocked()
+	return nil
+}
+
+// CleanupOldestSessions deletes the sessions policy picks to reach
+// requiredFreeBytes, planned in one pass from the index, then compacts so the
+// space of partly dead segments is returned too. A deleted session's space
+// only comes back once its segment is dropped or compacted, so free space is
+// measured again at the end; a *SpaceError means the target was not reached.
+func (s *SegmentStore) CleanupOldestSessions(requiredFreeBytes int64, policy RetentionPolicy) ([]string, error) {
+	if requiredFreeBytes <= 0 {
+		return nil, nil
+	}
+	sessions, err := s.ListSessions()
+	if err != nil {
+		return nil, err
+	}
+	free, err := util.FreeBytes(s.root)
+	if err != nil {
+		return nil, fmt.Errorf("check free space: %w", err)
+	}
+	if free >= requiredFreeBytes {
+		return nil, nil
+	}
+	plan, _ := policy.Plan(sessions, free, requiredFreeBytes)
+	deleted, err := deleteSessions(s, plan)
+	if err != nil {
+		return deleted, err
+	}
+	compactErr := s.Compact()
+	if compactErr != nil && !errors.Is(compactErr, ErrStoreBusy) {
+		return deleted, compactErr
+	}
+	if _, err := checkFree(s.root, requiredFreeBytes); err != nil {
+		if compactErr != nil {
+			return deleted, fmt.Errorf("%w (compaction deferred: %w)", err, compactErr)
+		}
+		return deleted, err
+	}
+	return deleted, nil
+}
+
+// Compact rewrites mostly-dead segments and the index. It needs the writer
+// lock and returns ErrStoreBusy instead of waiting for a running sync.
+func (s *SegmentStore) Compact() error {
+	lock, err := s.lock(false)
+	if err != nil {
+		return err
+	}
+	defer s.unlock(lock)
+	// No appends from other processes while the index is rewritten.
+	ilock, err := s.lockIndex()
+	if err != nil {
+		return err
+	}
+	defer ilock.Close()
+
+	s.mu.Lock()
+	defer s.mu.Unlock()
+	if err := s.refreshLocked(); err != nil {
+		return err
+	}
+	s.dropDeadSegmentsLocked()
+
+	live := s.liveBytesLocked()
+	segs, err := s.segmentNumbers()
+	if err != nil {
+		return err
+	}
+	for _, seg := range segs {
+		info, err := os.Stat(s.segmentPath(seg))
+		if err != nil || info.Size() == 0 {
+			continue
+		}
+		dead := info.Size() - live[seg]
+		if float64(dead)/float64(info.Size()) < compactDeadRatio {
+			continue
+		}
+		if err := s.compactSegmentLocked(seg); err != nil {
+			return fmt.Errorf("compact segment %d: %w", seg, err)
+		}
+	}
+	return s.rewriteIndexLocked()
+}
+
+// compactSegmentLocked copies live sessions of seg into a fresh segment,
+// re-points them in the index and unlinks seg.
+func (s *SegmentStore) compactSegmentLocked(seg int) error {
+	var moving []*segEntry
+	for _, e := range s.entries {
+		if e.segment == seg {
+			moving = append(moving, e)
+		}
+	}
+	sort.Slice(moving, func(i, j int) bool { return moving[i].offset < moving[j].offset })
+
+	if len(moving) > 0 {
+		segs, err := s.segmentNumbers()
+		if err != nil {
+			return err
+		}
+		dst := segs[len(segs)-1] + 1
+		src, err := os.Open(s.segmentPath(seg))
+		if err != nil {
+			return err
+		}
+		defer src.Close()
+		out, err := os.OpenFile(s.segmentPath(dst), os.O_WRONLY|os.O_CREATE|os.O_EXCL, 0o644)
+		if err != nil {
+			return err
+		}
+		s.stats.filesCreated.Add(1)
+		var recs []indexRecord
+		var off int64
+		for _, e := range moving {
+			n, err := io.Copy(out, io.NewSectionReader(src, e.offset, e.length))
+			if err != nil {
+				_ = out.Close()
+				return err
+			}
+			s.stats.compactionBytes.Add(n)
+			recs = append(recs, indexRecord{Op: "put", ID: e.id, Segment: dst, Offset: off, Length: e.length, Manifest: e.manifest})
+			off += n
+		}
+		if err := out.Sync(); err != nil {
+			_ = out.Close()
+			return err
+		}
+		s.stats.fsyncs.Add(1)
+		if err := out.Close(); err != nil {
+			return err
+		}
+		if err := s.appendRecordsLocked(recs...); err != nil {
+			return err
+		}
+	}
+	if err := os.Remove(s.segmentPath(seg)); err != nil {
+		return err
+	}
+	s.stats.filesRemoved.Add(1)
+	return nil
+}
+
+// rewriteIndexLocked replaces index.log with one record per live session once
+// superseded records pile up.
+func (s *SegmentStore) rewriteIndexLocked() error {
+	if s.records <= len(s.entries)+indexRewriteSlack {
+		return nil
+	}
+	ids := make([]string, 0, len(s.entries))
+	for id := range s.entries {
+		ids = append(ids, id)
+	}
+	sort.Strings(ids)
+	var b strings.Builder
+	for _, id := range ids {
+		e := s.entries[id]
+		line, err := json.Marshal(indexRecord{Op: "put", ID: e.id, Segment: e.segment, Offset: e.offset, Length: e.length, Manifest: e.manifest})
+		if err != nil {
+			return err
+		}
+		b.Write(line)
+		b.WriteByte('\n')
+	}
+	tmp := filepath.Join(s.dir, segmentIndexName+".tmp")
+	if err := writeFileSync(tmp, []byte(b.String())); err != nil {
+		return err
+	}
+	s.stats.filesCreated.Add(1)
+	s.stats.fsyncs.Add(1)
+	s.stats.metadataBytes.Add(int64(b.Len()))
+	if err := os.Rename(tmp, s.indexPath()); err != nil {
+		return err
+	}
+	s.stats.renames.Add(1)
+	s.indexInfo = nil // force a replay of the new file
+	return s.refreshLocked()
+}
+
+// dropDeadSegmentsLocked unlinks segments that hold no live session, except
+// the newest one, which a sync may still be appending to.
+func (s *SegmentStore) dropDeadSegmentsLocked() {
+	segs, err := s.segmentNumbers()
+	if err != nil || len(segs) < 2 {
+		return
+	}
+	live := s.liveBytesLocked()
+	for _, seg := range segs[:len(segs)-1] {
+		if live[seg] > 0 || s.pendingIn(seg) {
+			continue
+		}
+		if err := os.Remove(s.segmentPath(seg)); err == nil {
+			s.stats.filesRemoved.Add(1)
+		}
+	}
+}
+
+func (s *SegmentStore) pendingIn(seg int) bool {
+	for _, e := range s.pending {
+		if e.segment == seg {
+			return true
+		}
+	}
+	return false
+}
+
+func (s *SegmentStore) liveBytesLocked() map[int]int64 {
+	live := make(map[int]int64)
+	for _, e := range s.entries {
+		live[e.segment] += e.length
+	}
+	return live
+}
+
+// appendRecordsLocked appends records to index.log in a single write and
+// fsyncs, then applies them to the in-memory index.
+func (s *SegmentStore) appendRecordsLocked(recs ...indexRecord) error {
+	var b []byte
+	for _, r := range recs {
+		line, err := json.Marshal(r)
+		if err != nil {
+			return fmt.Errorf("marshal index record: %w", err)
+		}
+		b = append(b, line...)
+		b = append(b, '\n')
+	}
+	path := s.indexPath()
+	_, statErr := os.Stat(path)
+	f, err := os.OpenFile(path, os.O_WRONLY|os.O_CREATE|os.O_APPEND, 0o644)
+	if err != nil {
+		return fmt.Errorf("open index: %w", err)
+	}
+	if os.IsNotExist(statErr) {
+		s.stats.filesCreated.Add(1)
+	}
+	if _, err := f.Write(b); err != nil {
+		_ = f.Close()
+		return fmt.Errorf("append index: %w", err)
+	}
+	if err := f.Sync(); err != nil {
+		_ = f.Close()
+		return fmt.Errorf("fsync index: %w", err)
+	}
+	if err := f.Close(); err != nil {
+		return err
+	}
+	s.stats.fsyncs.Add(1)
+	s.stats.metadataBytes.Add(int64(len(b)))
+	for _, r := range recs {
+		s.apply(r)
+	}
+	s.records += len(recs)
+	if info, err := os.Stat(path); err == nil {
+		s.indexInfo = info
+	}
+	return nil
+}
+
+// refreshLocked replays index.log when another process changed it.
+func (s *SegmentStore) refreshLocked() error {
+	info, err := os.Stat(s.indexPath())
+	if os.IsNotExist(err) {
+		s.entries = make(map[string]*segEntry)
+		s.records = 0
+		s.indexInfo = nil
+		return nil
+	}
+	if err != nil {
+		return fmt.Errorf("stat index: %w", err)
+	}
+	if s.indexInfo != nil && os.SameFile(s.indexInfo, info) && s.indexInfo.Size() == info.Size() {
+		return nil
+	}
+
+	f, err := os.Open(s.indexPath())
+	if err != nil {
+		return fmt.Errorf("open index: %w", err)
+	}
+	defer f.Close()
+	s.entries = make(map[string]*segEntry)
+	s.records = 0
+	sc := bufio.NewScanner(f)
+	sc.Buffer(make([]byte, 0, 4096), segmentIndexRecMax)
+	for sc.Scan() {
+		var r indexRecord
+		if err := json.Unmarshal(sc.Bytes(), &r); err != nil {
+			continue // torn trailing line after a crash
+		}
+		s.apply(r)
+		s.records++
+	}
+	s.indexInfo = info
+	return nil
+}
+
+func (s *SegmentStore) apply(r indexRecord) {
+	switch r.Op {
+	case "put":
+		if r.Manifest == nil {
+			return
+		}
+		s.entries[r.ID] = &segEntry{id: r.ID, segment: r.Segment, offset: r.Offset, length: r.Length, manifest: r.Manifest}
+	case "del":
+		delete(s.entries, r.ID)
+	}
+}
+
+// activeSegment returns the segment a new session should append to.
+func (s *SegmentStore) activeSegment() (int, error) {
+	segs, err := s.segmentNumbers()
+	if err != nil {
+		return 0, err
+	}
+	if len(segs) == 0 {
+		return 1, nil
+	}
+	last := segs[len(segs)-1]
+	if info, err := os.Stat(s.segmentPath(last)); err == nil && info.Size() >= segmentMaxBytes {
+		return last + 1, nil
+	}
+	return last, nil
+}
+
+// segmentNumbers lists segment numbers on disk in ascending order.
+func (s *SegmentStore) segmentNumbers() ([]int, error) {
+	entries, err := os.ReadDir(s.dir)
+	if err != nil {
+		return nil, fmt.Errorf("read segment dir: %w", err)
+	}
+	var segs []int
+	for _, e := range entries {
+		name := e.Name()
+		if !strings.HasPrefix(name, segmentFilePrefix) || !strings.HasSuffix(name, segmentFileSuffix) {
+			continue
+		}
+		n, err := strconv.Atoi(strings.TrimSuffix(strings.TrimPrefix(name, segmentFilePrefix), segmentFileSuffix))
+		if err != nil {
+			continue
+		}
+		segs = append(segs, n)
+	}
+	sort.Ints(segs)
+	return segs, nil
+}
+
+func (s *SegmentStore) segmentPath(seg int) string {
+	return filepath.Join(s.dir, fmt.Sprintf("%s%06d%s", segmentFilePrefix, seg, segmentFileSuffix))
+}
+
+func (s *SegmentStore) indexPath() string {
+	return filepath.Join(s.dir, segmentIndexName)
+}
+
+// lock takes the cross-process writer lock. With wait=false it returns
+// ErrStoreBusy instead of blocking.
+func (s *SegmentStore) lock(wait bool) (*os.File, error) {
+	path := filepath.Join(s.dir, segmentLockName)
+	if wait {
+		return util.LockFile(path)
+	}
+	f, err := util.TryLockFile(path)
+	if errors.Is(err, util.ErrLocked) {
+		return nil, ErrStoreBusy
+	}
+	return f, err
+}
+
+// lockIndex serialises changes to index.log across processes. It is held
+// only for one read-modify-append, unlike the writer lock, which a sync holds
+// for the whole copy.
+func (s *SegmentStore) lockIndex() (*os.File, error) {
+	return util.LockFile(filepath.Join(s.dir, segmentIndexLock))
+}
+
+func (s *SegmentStore) unlock(f *os.File) {
+	if f != nil {
+		_ = f.Close() // closing the fd drops the flock
+	}
+}
+
+// releaseLocked drops the writer lock taken by Create, if held.
+func (s *SegmentStore) releaseLocked() {
+	s.unlock(s.lockFile)
+	s.lockFile = nil
+}
+
+// segmentWriter appends one session's raw flash to a segment.
+type segmentWriter struct {
+	store        *SegmentStore
+	id           string
+	segment      int
+	path         string
+	file         *os.File
+	buf          *bufio.Writer
+	hasher       hash.Hash
+	start        int64
+	bytesWritten int64
+	profile      IOProfile
+}
+
+// Write implements io.Writer. Every byte is hashed and counted.
+func (w *segmentWriter) Write(data []byte) (int, error) {
+	n, err := w.buf.Write(data)
+	if n > 0 {
+		w.hasher.Write(data[:n])
+		w.bytesWritten += int64(n)
+	}
+	return n, err
+}
+
+// Close flushes and fsyncs the segment and registers the session as pending
+// until its manifest is put.
+func (w *segmentWriter) Close() error {
+	if err := w.buf.Flush(); err != nil {
+		_ = w.file.Close()
+		return fmt.Errorf("flush: %w", err)
+	}
+	if err := w.profile.fsync(w.file); err != nil {
+		_ = w.file.Close()
+		return fmt.Errorf("fsync: %w", err)
+	}
+	if err := w.file.Close(); err != nil {
+		return err
+	}
+	w.store.stats.fsyncs.Add(1)
+	w.store.stats.dataBytes.Add(w.bytesWritten)
+
+	w.store.mu.Lock()
+	w.store.pending[w.id] = &segEntry{id: w.id, segment: w.segment, offset: w.start, length: w.bytesWritten}
+	w.store.mu.Unlock()
+	return nil
+}
+
+// Abort truncates the segment back to where this session started and
+// releases the writer lock.
+func (w *segmentWriter) Abort() error {
+	_ = w.file.Close()
+	err := os.Truncate(w.path, w.start)
+	w.store.mu.Lock()
+	delete(w.store.pending, w.id)
+	w.store.releaseLocked()
+	w.store.mu.Unlock()
+	return err
+}
+
+// Preallocate reserves size bytes after the session's start in the segment.
+func (w *segmentWriter) Preallocate(size int64) error {
+	return util.Preallocate(w.file, w.start, size)
+}
+
+// BytesWritten returns the total number of bytes written so far.
+func (w *segmentWriter) BytesWritten() int64 { return w.bytesWritten }
+
+// Profile returns the card I/O recorded so far.
+func (w *segmentWriter) Profile() *IOProfile { return &w.profile }
+
+// SHA256Hex returns the hex-encoded SHA-256 digest of all data written.
+func (w *segmentWriter) SHA256Hex() string {
+	return hex.EncodeToString(w.hasher.Sum(nil))
+}
+
+// VerifyAgainstFile re-reads this session's range of the segment and compares
+// its SHA-256 with the in-memory hash.
+func (w *segmentWriter) VerifyAgainstFile() (bool, string, error) {
+	f, err := os.Open(w.path)
+	if err != nil {
+		return false, "", fmt.Errorf("open for verify: %w", err)
+	}
+	defer f.Close()
+
+	h := sha256.New()
+	if _, err := io.Copy(h, io.NewSectionReader(f, w.start, w.bytesWritten)); err != nil {
+		return false, "", fmt.Errorf("read for verify: %w", err)
+	}
+	fileHash := hex.EncodeToString(h.Sum(nil))
+	return fileHash == w.SHA256Hex(), fileHash, nil
+}
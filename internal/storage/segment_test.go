@@ -0,0 +1,493 @@
+package storage
+
+import (
+	"bytes"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"testing"
+)
+
+// writeSegmentSession writes data as a complete session (data + manifest).
+func writeSegmentSession(t *testing.T, s *SegmentStore, info *FCInfo, data []byte) string {
+	t.Helper()
+	id, w, err := s.Create(info)
+	if err != nil {
+		t.Fatalf("Create: %v", err)
+	}
+	if _, err := w.Write(data); err != nil {
+		t.Fatalf("Write: %v", err)
+	}
+	if err := w.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+	match, sum, err := w.VerifyAgainstFile()
+	if err != nil || !match {
+		t.Fatalf("VerifyAgainstFile: match=%v err=%v", match, err)
+	}
+	m := NewManifest(info, sum, int64(len(data)), false, false, nil)
+	if err := s.PutManifest(id, m); err != nil {
+		t.Fatalf("PutManifest: %v", err)
+	}
+	return id
+}
+
+// uniqueInfo returns FC info whose UID yields a distinct session ID even when
+// several sessions start within the same second.
+func uniqueInfo(uid string) *FCInfo {
+	info := testFCInfo()
+	info.UID = uid
+	return info
+}
+
+func readSessionFile(t *testing.T, s Store, id, name string) []byte {
+	t.Helper()
+	f, err := s.Open(id, name)
+	if err != nil {
+		t.Fatalf("Open(%s, %s): %v", id, name, err)
+	}
+	defer f.Close()
+	b, err := io.ReadAll(f)
+	if err != nil {
+		t.Fatalf("ReadAll: %v", err)
+	}
+	if int64(len(b)) != f.Size {
+		t.Fatalf("read %d bytes, Size=%d", len(b), f.Size)
+	}
+	return b
+}
+
+func TestSegmentStoreRoundTrip(t *testing.T) {
+	root := t.TempDir()
+	s, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatalf("OpenSegmentStore: %v", err)
+	}
+
+	data := bytes.Repeat([]byte("H Product:Blackbox flight data recorder\n"), 100)
+	id := writeSegmentSession(t, s, testFCInfo(), data)
+
+	sessions, err := s.ListSessions()
+	if err != nil {
+		t.Fatalf("ListSessions: %v", err)
+	}
+	if len(sessions) != 1 || sessions[0].SessionID != id {
+		t.Fatalf("sessions = %+v, want one with ID %s", sessions, id)
+	}
+	if sessions[0].FCDir != "fc_BTFL_uid-abc12345" {
+		t.Errorf("FCDir = %q", sessions[0].FCDir)
+	}
+	if sessions[0].BBLPath == nil {
+		t.Error("BBLPath should be set")
+	}
+	if got := readSessionFile(t, s, id, RawFlashFilename); !bytes.Equal(got, data) {
+		t.Fatal("raw flash content mismatch")
+	}
+	if got := readSessionFile(t, s, id, ManifestFilename); !bytes.Contains(got, []byte(`"sha256"`)) {
+		t.Fatalf("manifest download missing sha256: %s", got)
+	}
+
+	if err := s.UpdateManifest(id, func(m *Manifest) {
+		m.EraseAttempted = true
+		m.EraseCompleted = true
+	}); err != nil {
+		t.Fatalf("UpdateManifest: %v", err)
+	}
+
+	// A second instance (e.g. the web process) replays the index from disk.
+	other, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatalf("reopen: %v", err)
+	}
+	sessions, err = other.ListSessions()
+	if err != nil {
+		t.Fatalf("ListSessions after reopen: %v", err)
+	}
+	if len(sessions) != 1 || !sessions[0].Manifest.EraseCompleted {
+		t.Fatalf("reopened store should see erase update, got %+v", sessions)
+	}
+}
+
+func TestSegmentStoreAppendsToOneFile(t *testing.T) {
+	root := t.TempDir()
+	s, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatalf("OpenSegmentStore: %v", err)
+	}
+	for i, uid := range []string{"aaaaaaaa", "bbbbbbbb", "cccccccc"} {
+		writeSegmentSession(t, s, uniqueInfo(uid), bytes.Repeat([]byte{byte(i)}, 1000))
+	}
+
+	entries, err := os.ReadDir(filepath.Join(root, SegmentDirName))
+	if err != nil {
+		t.Fatal(err)
+	}
+	var segs int
+	for _, e := range entries {
+		if filepath.Ext(e.Name()) == segmentFileSuffix {
+			segs++
+		}
+	}
+	if segs != 1 {
+		t.Fatalf("expected all sessions in one segment, found %d segment files", segs)
+	}
+	if st := s.Stats(); st.FilesCreated > 3 || st.DirsCreated > 1 {
+		t.Errorf("unexpected metadata churn: %+v", st)
+	}
+}
+
+func TestSegmentStoreAbort(t *testing.T) {
+	root := t.TempDir()
+	s, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatalf("OpenSegmentStore: %v", err)
+	}
+	keep := writeSegmentSession(t, s, uniqueInfo("aaaaaaaa"), []byte("first session"))
+
+	_, w, err := s.Create(uniqueInfo("bbbbbbbb"))
+	if err != nil {
+		t.Fatalf("Create: %v", err)
+	}
+	if _, err := w.Write([]byte("partial data that must vanish")); err != nil {
+		t.Fatal(err)
+	}
+	if err := w.Abort(); err != nil {
+		t.Fatalf("Abort: %v", err)
+	}
+
+	info, err := os.Stat(s.segmentPath(1))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if info.Size() != int64(len("first session")) {
+		t.Fatalf("segment size after abort = %d, want %d", info.Size(), len("first session"))
+	}
+	if got := readSessionFile(t, s, keep, RawFlashFilename); string(got) != "first session" {
+		t.Fatalf("surviving session = %q", got)
+	}
+
+	// The writer lock must be free again.
+	if err := s.Compact(); err != nil {
+		t.Fatalf("Compact after abort: %v", err)
+	}
+}
+
+func TestSegmentStoreDeleteAndCompact(t *testing.T) {
+	old := segmentMaxBytes
+	segmentMaxBytes = 1000
+	defer func() { segmentMaxBytes = old }()
+
+	root := t.TempDir()
+	s, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatalf("OpenSegmentStore: %v", err)
+	}
+	a := writeSegmentSession(t, s, uniqueInfo("aaaaaaaa"), bytes.Repeat([]byte{'a'}, 400))
+	b := writeSegmentSession(t, s, uniqueInfo("bbbbbbbb"), bytes.Repeat([]byte{'b'}, 400))
+	c := writeSegmentSession(t, s, uniqueInfo("cccccccc"), bytes.Repeat([]byte{'c'}, 400))
+	d := writeSegmentSession(t, s, uniqueInfo("dddddddd"), bytes.Repeat([]byte{'d'}, 400))
+
+	// a, b, c share segment 1 (rolled past 1000 bytes); d starts segment 2.
+	if _, err := os.Stat(s.segmentPath(2)); err != nil {
+		t.Fatalf("expected a second segment: %v", err)
+	}
+
+	for _, id := range []string{a, b} {
+		if err := s.Delete(id); err != nil {
+			t.Fatalf("Delete(%s): %v", id, err)
+		}
+	}
+	if err := s.Delete(a); !errors.Is(err, os.ErrNotExist) {
+		t.Fatalf("second Delete = %v, want ErrNotExist", err)
+	}
+
+	if err := s.Compact(); err != nil {
+		t.Fatalf("Compact: %v", err)
+	}
+	if _, err := os.Stat(s.segmentPath(1)); !os.IsNotExist(err) {
+		t.Fatalf("segment 1 should be compacted away, stat err=%v", err)
+	}
+	if got := readSessionFile(t, s, c, RawFlashFilename); !bytes.Equal(got, bytes.Repeat([]byte{'c'}, 400)) {
+		t.Fatal("session c corrupted by compaction")
+	}
+	if got := readSessionFile(t, s, d, RawFlashFilename); !bytes.Equal(got, bytes.Repeat([]byte{'d'}, 400)) {
+		t.Fatal("session d corrupted by compaction")
+	}
+	if st := s.Stats(); st.CompactionBytes != 400 {
+		t.Errorf("CompactionBytes = %d, want 400", st.CompactionBytes)
+	}
+
+	sessions, err := s.ListSessions()
+	if err != nil {
+		t.Fatal(err)
+	}
+	if len(sessions) != 2 {
+		t.Fatalf("expected 2 sessions after delete, got %d", len(sessions))
+	}
+}
+
+func TestSegmentStoreCompactBusyDuringSync(t *testing.T) {
+	root := t.TempDir()
+	writer, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	web, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	id, w, err := writer.Create(testFCInfo())
+	if err != nil {
+		t.Fatal(err)
+	}
+	if err := web.Compact(); !errors.Is(err, ErrStoreBusy) {
+		t.Fatalf("Compact during sync = %v, want ErrStoreBusy", err)
+	}
+	if _, err := w.Write([]byte("data")); err != nil {
+		t.Fatal(err)
+	}
+	if err := w.Close(); err != nil {
+		t.Fatal(err)
+	}
+	if err := writer.PutManifest(id, NewManifest(testFCInfo(), w.SHA256Hex(), 4, false, false, nil)); err != nil {
+		t.Fatal(err)
+	}
+	if err := web.Compact(); err != nil {
+		t.Fatalf("Compact after sync = %v", err)
+	}
+	sessions, err := web.ListSessions()
+	if err != nil || len(sessions) != 1 {
+		t.Fatalf("web process sees %d sessions (err=%v), want 1", len(sessions), err)
+	}
+}
+
+func TestSegmentStoreUpdateManifestAcrossProcesses(t *testing.T) {
+	root := t.TempDir()
+	syncer, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	web, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	id := writeSegmentSession(t, syncer, testFCInfo(), []byte("flight"))
+
+	// Each update appends a flight; a lost read-modify-write drops one.
+	const updates = 40
+	errs := make(chan error, updates)
+	for i := 0; i < updates; i++ {
+		store := syncer
+		if i%2 == 1 {
+			store = web
+		}
+		go func(store *SegmentStore, i int) {
+			errs <- store.UpdateManifest(id, func(m *Manifest) {
+				m.Flights = append(m.Flights, ManifestFlight{Offset: int64(i)})
+			})
+		}(store, i)
+	}
+	for i := 0; i < updates; i++ {
+		if err := <-errs; err != nil {
+			t.Fatalf("UpdateManifest: %v", err)
+		}
+	}
+	sessions, err := web.ListSessions()
+	if err != nil || len(sessions) != 1 {
+		t.Fatalf("ListSessions: %d sessions, err=%v", len(sessions), err)
+	}
+	if n := len(sessions[0].Manifest.Flights); n != updates {
+		t.Errorf("manifest has %d of %d updates", n, updates)
+	}
+}
+
+func TestSegmentStoreCleanupReportsShortfall(t *testing.T) {
+	root := t.TempDir()
+	s, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	writeSegmentSession(t, s, uniqueInfo("aaaaaaaa"), []byte("old flight"))
+	writeSegmentSession(t, s, uniqueInfo("aaaaaaaa"), []byte("new flight"))
+	syncer, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	_, w, err := syncer.Create(uniqueInfo("bbbbbbbb"))
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer w.Abort()
+
+	// Deleting cannot reach the target, and compaction waits for the sync.
+	_, err = s.CleanupOldestSessions(1<<62, RetentionPolicy{})
+	var short *SpaceError
+	if !errors.As(err, &short) || !errors.Is(err, ErrStoreBusy) {
+		t.Fatalf("CleanupOldestSessions = %v, want a *SpaceError noting the busy store", err)
+	}
+}
+
+func TestSegmentStoreListSessionsAfter(t *testing.T) {
+	root := t.TempDir()
+	s, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	for _, uid := range []string{"aaaaaaaa", "bbbbbbbb", "cccccccc", "dddddddd", "eeeeeeee"} {
+		writeSegmentSession(t, s, uniqueInfo(uid), []byte(uid))
+	}
+	all, err := s.ListSessions()
+	if err != nil {
+		t.Fatal(err)
+	}
+
+	first, remaining, err := s.ListSessionsAfter("", 2)
+	if err != nil || remaining != 3 || fmt.Sprint(ids(first)) != fmt.Sprint(ids(all[:2])) {
+		t.Fatalf("first page = %v (%d remaining, err %v), want %v", ids(first), remaining, err, ids(all[:2]))
+	}
+	// Deleting the cursor's session does not shift the next page.
+	if err := s.Delete(first[1].SessionID); err != nil {
+		t.Fatal(err)
+	}
+	rest, remaining, err := s.ListSessionsAfter(first[1].SessionID, 10)
+	if err != nil || remaining != 0 || fmt.Sprint(ids(rest)) != fmt.Sprint(ids(all[2:])) {
+		t.Errorf("next page = %v (%d remaining, err %v), want %v", ids(rest), remaining, err, ids(all[2:]))
+	}
+}
+
+func TestSegmentStoreIgnoresTornIndexLine(t *testing.T) {
+	root := t.TempDir()
+	s, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	writeSegmentSession(t, s, testFCInfo(), []byte("payload"))
+
+	f, err := os.OpenFile(s.indexPath(), os.O_WRONLY|os.O_APPEND, 0o644)
+	if err != nil {
+		t.Fatal(err)
+	}
+	_, _ = f.WriteString(`{"op":"put","id":"fc_BTFL_uid-x/2025`)
+	_ = f.Close()
+
+	reopened, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatalf("reopen with torn line: %v", err)
+	}
+	sessions, err := reopened.ListSessions()
+	if err != nil || len(sessions) != 1 {
+		t.Fatalf("sessions=%d err=%v, want 1", len(sessions), err)
+	}
+}
+
+func TestOpenStoreLayouts(t *testing.T) {
+	root := t.TempDir()
+	for _, layout := range []string{"", LayoutDirectory, LayoutSegment} {
+		if _, err := OpenStore(layout, root); err != nil {
+			t.Errorf("OpenStore(%q): %v", layout, err)
+		}
+	}
+	if _, err := OpenStore("zip", root); err == nil {
+		t.Error("OpenStore with unknown layout should fail")
+	}
+}
+
+func TestStoreRejectsTraversal(t *testing.T) {
+	root := t.TempDir()
+	seg, err := OpenSegmentStore(root)
+	if err != nil {
+		t.Fatal(err)
+	}
+	for _, s := range []Store{NewDirStore(root), seg} {
+		for _, id := range []string{"../etc", "a/../../b", "only-one-part", "a/b/c"} {
+			if _, err := s.Open(id, RawFlashFilename); !errors.Is(err, ErrInvalidSessionID) {
+				t.Errorf("%T.Open(%q) = %v, want ErrInvalidSessionID", s, id, err)
+			}
+			if err := s.Delete(id); !errors.Is(err, ErrInvalidSessionID) {
+				t.Errorf("%T.Delete(%q) = %v, want ErrInvalidSessionID", s, id, err)
+			}
+		}
+	}
+}
+
+// --- write amplification: directory vs segment layout ---
+
+// syncSession mimics the orchestrator's storage calls for one sync.
+func syncSession(tb testing.TB, s Store, info *FCInfo, data []byte) {
+	tb.Helper()
+	id, w, err := s.Create(info)
+	if err != nil {
+		tb.Fatalf("Create: %v", err)
+	}
+	if _, err := w.Write(data); err != nil {
+		tb.Fatalf("Write: %v", err)
+	}
+	if err := w.Close(); err != nil {
+		tb.Fatalf("Close: %v", err)
+	}
+	if _, _, err := w.VerifyAgainstFile(); err != nil {
+		tb.Fatalf("Verify: %v", err)
+	}
+	timing := map[string]float64{"stream_sec": 1}
+	if err := s.PutManifest(id, NewManifest(info, w.SHA256Hex(), int64(len(data)), false, false, timing)); err != nil {
+		tb.Fatalf("PutManifest: %v", err)
+	}
+	if err := s.UpdateManifest(id, func(m *Manifest) {
+		m.EraseAttempted = true
+		m.EraseCompleted = true
+	}); err != nil {
+		tb.Fatalf("UpdateManifest: %v", err)
+	}
+}
+
+func TestSegmentLayoutReducesMetadataOps(t *testing.T) {
+	data := bytes.Repeat([]byte{0x5a}, 64*1024)
+	seg, err := OpenSegmentStore(t.TempDir())
+	if err != nil {
+		t.Fatal(err)
+	}
+	stores := map[string]Store{LayoutDirectory: NewDirStore(t.TempDir()), LayoutSegment: seg}
+	stats := map[string]IOStats{}
+	for name, s := range stores {
+		for i := 0; i < 5; i++ {
+			syncSession(t, s, uniqueInfo(string(rune('a'+i))+"0000000"), data)
+		}
+		stats[name] = s.Stats()
+		t.Logf("%s: metadata ops=%d fsyncs=%d write-amp=%.4f",
+			name, stats[name].MetadataOps(), stats[name].Fsyncs, stats[name].WriteAmplification())
+	}
+	if stats[LayoutSegment].MetadataOps() >= stats[LayoutDirectory].MetadataOps() {
+		t.Errorf("segment layout metadata ops %d, want fewer than directory layout %d",
+			stats[LayoutSegment].MetadataOps(), stats[LayoutDirectory].MetadataOps())
+	}
+}
+
+// BenchmarkSessionWrite compares per-sync cost of both layouts. Run on the Pi
+// against the real SD card for meaningful sync times:
+//
+//	go test -run ^$ -bench SessionWrite ./internal/storage
+func BenchmarkSessionWrite(b *testing.B) {
+	data := bytes.Repeat([]byte{0x5a}, 1<<20)
+	for _, layout := range []string{LayoutDirectory, LayoutSegment} {
+		b.Run(layout, func(b *testing.B) {
+			s, err := OpenStore(layout, b.TempDir())
+			if err != nil {
+				b.Fatal(err)
+			}
+			b.SetBytes(int64(len(data)))
+			b.ResetTimer()
+			for i := 0; i < b.N; i++ {
+				info := uniqueInfo(fmt.Sprintf("%08x", i))
+				syncSession(b, s, info, data)
+			}
+			b.StopTimer()
+			st := s.Stats()
+			b.ReportMetric(float64(st.MetadataOps())/float64(b.N), "metaops/op")
+			b.ReportMetric(float64(st.Fsyncs)/float64(b.N), "fsyncs/op")
+			b.ReportMetric(st.WriteAmplification(), "write-amp")
+		})
+	}
+}
@@ -0,0 +1,408 @@
+package storage
+
+import (
+	"bytes"
+	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"os"
+	"path/filepath"
+	"strings"
+	"sync/atomic"
+	"time"
+)
+
+// Storage layouts selectable via the storage_layout config key.
+const (
+	LayoutDirectory = "directory"
+	LayoutSegment   = "segment"
+)
+
+// ErrInvalidSessionID is returned for session IDs that are malformed or would
+// resolve outside the storage root.
+var ErrInvalidSessionID = errors.New("invalid session id")
+
+// ErrFileNotAllowed is returned by Open for anything but the raw flash file
+// and the manifest.
+var ErrFileNotAllowed = errors.New("file not allowed")
+
+// Store abstracts how sessions are persisted on the Pi SD card. The sync
+// orchestrator writes through it and the web server lists, serves and deletes
+// through it, so both processes agree on the layout.
+type Store interface {
+	// Root returns the storage root directory.
+	Root() string
+	// Create starts a new session and returns its ID and raw flash writer.
+	Create(info *FCInfo) (string, SessionWriter, error)
+	// PutManifest stores the manifest for a session, replacing any previous one.
+	PutManifest(sessionID string, m *Manifest) error
+	// UpdateManifest applies fn to the stored manifest and persists the result.
+	UpdateManifest(sessionID string, fn func(*Manifest)) error
+	// ListSessions returns all sessions, newest first.
+	ListSessions() ([]*Session, error)
+	// ListSessionsAfter returns up to limit sessions that follow the session
+	// ID after in ListSessions order ("" starts at the newest) and how many
+	// come after them, reading manifests for the returned sessions only.
+	ListSessionsAfter(after string, limit int) ([]*Session, int, error)
+	// Open returns a downloadable file (raw_flash.bbl or manifest.json).
+	Open(sessionID, filename string) (*SessionFile, error)
+	// Delete removes a session.
+	Delete(sessionID string) error
+	// CleanupOldestSessions deletes the sessions policy allows, oldest first,
+	// until requiredFreeBytes is available. Returns deleted session IDs.
+	CleanupOldestSessions(requiredFreeBytes int64, policy RetentionPolicy) ([]string, error)
+	// Stats returns cumulative I/O counters for this store instance.
+	Stats() IOStats
+}
+
+// SessionWriter receives raw flash data for a new session. *StreamWriter
+// satisfies it for the directory layout.
+type SessionWriter interface {
+	io.Writer
+	Close() error
+	Abort() error
+	// Preallocate reserves disk space for the size bytes about to be
+	// written. Filesystems without fallocate support return an error that
+	// callers may ignore.
+	Preallocate(size int64) error
+	BytesWritten() int64
+	SHA256Hex() string
+	VerifyAgainstFile() (bool, string, error)
+	// Profile returns the write and fsync latencies seen so far, for the
+	// SD card health history.
+	Profile() *IOProfile
+}
+
+// OffsetWriter is implemented by session writers that accept data out of
+// order, for tail-first copies. Only the directory layout supports it: the
+// segment layout packs sessions back to back.
+type OffsetWriter interface {
+	WriteAt(p []byte, off int64) (int, error)
+	// Commit makes everything written so far durable and records covered
+	// (file offsets) as the readable part of the session. A nil covered
+	// marks the copy complete.
+	Commit(covered []Range) error
+}
+
+// SessionFile is an open, seekable session file ready to be served.
+type SessionFile struct {
+	io.ReadSeeker
+	Size    int64
+	ModTime time.Time
+	closer  io.Closer
+}
+
+// Close releases the underlying file, if any.
+func (f *SessionFile) Close() error {
+	if f.closer == nil {
+		return nil
+	}
+	return f.closer.Close()
+}
+
+// IOStats counts the filesystem operations a store performed. Metadata
+// operations (creates, renames, unlinks, mkdirs) are what wear SD cards and
+// stall FAT/ext4 journals, so they are tracked separately from data bytes.
+type IOStats struct {
+	DirsCreated     int64 `json:"dirs_created"`
+	FilesCreated    int64 `json:"files_created"`
+	FilesRemoved    int64 `json:"files_removed"`
+	Renames         int64 `json:"renames"`
+	Fsyncs          int64 `json:"fsyncs"`
+	DataBytes       int64 `json:"data_bytes"`
+	MetadataBytes   int64 `json:"metadata_bytes"`
+	CompactionBytes int64 `json:"compaction_bytes"`
+}
+
+// MetadataOps returns the number of directory-entry changes.
+func (s IOStats) MetadataOps() int64 {
+	return s.DirsCreated + s.FilesCreated + s.FilesRemoved + s.Renames
+}
+
+// WriteAmplification returns total bytes written per byte of flash data.
+func (s IOStats) WriteAmplification() float64 {
+	if s.DataBytes == 0 {
+		return 0
+	}
+	return float64(s.DataBytes+s.MetadataBytes+s.CompactionBytes) / float64(s.DataBytes)
+}
+
+// ioCounters is the atomic backing for IOStats.
+type ioCounters struct {
+	dirsCreated, filesCreated, filesRemoved, renames, fsyncs atomic.Int64
+	dataBytes, metadataBytes, compactionBytes                atomic.Int64
+}
+
+func (c *ioCounters) snapshot() IOStats {
+	return IOStats{
+		DirsCreated:     c.dirsCreated.Load(),
+		FilesCreated:    c.filesCreated.Load(),
+		FilesRemoved:    c.filesRemoved.Load(),
+		Renames:         c.renames.Load(),
+		Fsyncs:          c.fsyncs.Load(),
+		DataBytes:       c.dataBytes.Load(),
+		MetadataBytes:   c.metadataBytes.Load(),
+		CompactionBytes: c.compactionBytes.Load(),
+	}
+}
+
+// OpenStore returns the Store for the given layout name rooted at root.
+// An empty layout selects the directory layout.
+func OpenStore(layout, root string) (Store, error) {
+	switch layout {
+	case "", LayoutDirectory:
+		return NewDirStore(root), nil
+	case LayoutSegment:
+		return OpenSegmentStore(root)
+	default:
+		return nil, fmt.Errorf("unknown storage layout %q", layout)
+	}
+}
+
+// NewManifest builds a version-1 manifest for a freshly copied session.
+func NewManifest(info *FCInfo, sha256hex string, usedSize int64,
+	eraseCompleted, eraseAttempted bool, timing map[string]float64) *Manifest {
+
+	return &Manifest{
+		Version:    1,
+		CreatedUTC: time.Now().UTC().Format(time.RFC3339),
+		FC: ManifestFC{
+			Variant:        info.Variant,
+			UID:            info.UID,
+			APIVersion:     fmt.Sprintf("%d.%d", info.APIMajor, info.APIMinor),
+			BlackboxDevice: info.BlackboxDevice,
+		},
+		File: ManifestFile{
+			Name:   RawFlashFilename,
+			SHA256: sha256hex,
+			Bytes:  usedSize,
+		},
+		EraseAttempted: eraseAttempted,
+		EraseCompleted: eraseCompleted,
+		Timing:         timing,
+	}
+}
+
+// sessionNames returns the FC directory and session directory names used for
+// a session started at t. Both layouts share them so session IDs and download
+// URLs do not depend on the layout.
+func sessionNames(info *FCInfo, t time.Time) (fcDir, sessDir string) {
+	uidShort := "unknown"
+	if info.UID != "" && info.UID != "unknown" {
+		if len(info.UID) > 8 {
+			uidShort = info.UID[:8]
+		} else {
+			uidShort = info.UID
+		}
+	}
+	return fmt.Sprintf("fc_%s_uid-%s", info.Variant, uidShort), t.Format("2006-01-02_150405")
+}
+
+// splitSessionID validates a "<fc_dir>/<session_dir>" ID and returns its parts.
+func splitSessionID(sessionID string) (string, string, error) {
+	parts := strings.Split(sessionID, "/")
+	if len(parts) != 2 || parts[0] == "" || parts[1] == "" {
+		return "", "", ErrInvalidSessionID
+	}
+	if strings.Contains(parts[0], "..") || strings.Contains(parts[1], "..") ||
+		strings.ContainsRune(sessionID, '\\') {
+		return "", "", fmt.Errorf("%w: path traversal", ErrInvalidSessionID)
+	}
+	return parts[0], parts[1], nil
+}
+
+// ---------- directory layout ----------
+
+// DirStore is the original one-directory-per-session layout:
+// <root>/fc_<VARIANT>_uid-<uid8>/<YYYY-MM-DD_HHMMSS>/{raw_flash.bbl,manifest.json}
+type DirStore struct {
+	root  string
+	stats ioCounters
+}
+
+// NewDirStore returns a DirStore rooted at root.
+func NewDirStore(root string) *DirStore {
+	return &DirStore{root: root}
+}
+
+// Root returns the storage root directory.
+func (s *DirStore) Root() string { return s.root }
+
+// Stats returns cumulative I/O counters.
+func (s *DirStore) Stats() IOStats { return s.stats.snapshot() }
+
+// Create makes the session directory and opens its raw flash file.
+func (s *DirStore) Create(info *FCInfo) (string, SessionWriter, error) {
+	fcDir, _ := sessionNames(info, time.Now())
+	if _, err := os.Stat(filepath.Join(s.root, fcDir)); os.IsNotExist(err) {
+		s.stats.dirsCreated.Add(1)
+	}
+	sessionDir, err := MakeSessionDir(s.root, info)
+	if err != nil {
+		return "", nil, err
+	}
+	s.stats.dirsCreated.Add(1)
+	w, err := NewStreamWriter(filepath.Join(sessionDir, RawFlashFilename))
+	if err != nil {
+		return "", nil, err
+	}
+	s.stats.filesCreated.Add(1)
+	id := filepath.Base(filepath.Dir(sessionDir)) + "/" + filepath.Base(sessionDir)
+	return id, &countingWriter{StreamWriter: w, stats: &s.stats}, nil
+}
+
+// PutManifest writes manifest.json into the session directory.
+func (s *DirStore) PutManifest(sessionID string, m *Manifest) error {
+	dir, err := s.sessionPath(sessionID)
+	if err != nil {
+		return err
+	}
+	path := filepath.Join(dir, ManifestFilename)
+	if _, err := os.Stat(path); os.IsNotExist(err) {
+		s.stats.filesCreated.Add(1)
+	}
+	n, err := writeManifestFile(path, m)
+	s.stats.metadataBytes.Add(int64(n))
+	s.stats.fsyncs.Add(1)
+	return err
+}
+
+// UpdateManifest rewrites manifest.json after applying fn.
+func (s *DirStore) UpdateManifest(sessionID string, fn func(*Manifest)) error {
+	dir, err := s.sessionPath(sessionID)
+	if err != nil {
+		return err
+	}
+	m, err := ReadManifest(dir)
+	if err != nil {
+		return err
+	}
+	fn(m)
+	return s.PutManifest(sessionID, m)
+}
+
+// ListSessions scans the FC and session directories.
+func (s *DirStore) ListSessions() ([]*Session, error) {
+	return ListSessions(s.root)
+}
+
+// ListSessionsAfter lists session directory names and reads one page of
+// manifests.
+func (s *DirStore) ListSessionsAfter(after string, limit int) ([]*Session, int, error) {
+	return ListSessionsAfter(s.root, after, limit)
+}
+
+// Open opens a file inside a session directory.
+func (s *DirStore) Open(sessionID, filename string) (*SessionFile, error) {
+	if filename != RawFlashFilename && filename != ManifestFilename {
+		return nil, ErrFileNotAllowed
+	}
+	dir, err := s.sessionPath(sessionID)
+	if err != nil {
+		return nil, err
+	}
+	f, err := os.Open(filepath.Join(dir, filename))
+	if err != nil {
+		return nil, err
+	}
+	info, err := f.Stat()
+	if err != nil {
+		_ = f.Close()
+		return nil, err
+	}
+	if filename == RawFlashFilename {
+		// An interrupted tail-first copy is served up to its newest
+		// contiguous run; the rest of the file was never written.
+		if rs, err := readCoverage(dir); err == nil {
+			if r, ok := newestRange(rs); ok {
+				return &SessionFile{ReadSeeker: io.NewSectionReader(f, r.Off, r.Len), Size: r.Len, ModTime: info.ModTime(), closer: f}, nil
+			}
+		}
+	}
+	return &SessionFile{ReadSeeker: f, Size: info.Size(), ModTime: info.ModTime(), closer: f}, nil
+}
+
+// Delete removes the session directory and its FC directory once empty.
+func (s *DirStore) Delete(sessionID string) error {
+	dir, err := s.sessionPath(sessionID)
+	if err != nil {
+		return err
+	}
+	if _, err := os.Stat(dir); err != nil {
+		return err
+	}
+	if err := os.RemoveAll(dir); err != nil {
+		return err
+	}
+	s.stats.filesRemoved.Add(1)
+	parent := filepath.Dir(dir)
+	remaining, _ := os.ReadDir(parent)
+	if len(remaining) == 0 {
+		_ = os.Remove(parent)
+	}
+	return nil
+}
+
+// CleanupOldestSessions deletes session directories under pressure.
+func (s *DirStore) CleanupOldestSessions(requiredFreeBytes int64, policy RetentionPolicy) ([]string, error) {
+	return CleanupOldestSessions(s.root, requiredFreeBytes, policy)
+}
+
+// sessionPath resolves a session ID to its directory, refusing anything that
+// escapes the storage root (including through symlinks).
+func (s *DirStore) sessionPath(sessionID string) (string, error) {
+	fcDir, sessDir, err := splitSessionID(sessionID)
+	if err != nil {
+		return "", err
+	}
+	absStorage, err := filepath.Abs(s.root)
+	if err != nil {
+		return "", err
+	}
+	// Resolve symlinks on the storage root for consistent prefix checking
+	// (e.g. macOS /var → /private/var).
+	resolvedStorage, err := filepath.EvalSymlinks(absStorage)
+	if err != nil {
+		resolvedStorage = absStorage
+	}
+	candidate := filepath.Join(absStorage, fcDir, sessDir)
+	resolved, err := filepath.EvalSymlinks(candidate)
+	if err != nil {
+		resolved = filepath.Clean(candidate)
+	}
+	if !strings.HasPrefix(resolved, resolvedStorage) {
+		return "", fmt.Errorf("%w: path outside storage root", ErrInvalidSessionID)
+	}
+	return candidate, nil
+}
+
+// countingWriter adds DirStore accounting to a StreamWriter.
+type countingWriter struct {
+	*StreamWriter
+	stats *ioCounters
+}
+
+func (w *countingWriter) Close() error {
+	w.stats.dataBytes.Add(w.BytesWritten())
+	w.stats.fsyncs.Add(1)
+	return w.StreamWriter.Close()
+}
+
+// writeManifestFile marshals m to path with fsync and returns the bytes written.
+func writeManifestFile(path string, m *Manifest) (int, error) {
+	b, err := json.MarshalIndent(m, "", "  ")
+	if err != nil {
+		return 0, fmt.Errorf("marshal json: %w", err)
+	}
+	return len(b), writeFileSync(path, b)
+}
+
+// manifestFile wraps manifest JSON bytes as a SessionFile.
+func manifestFile(m *Manifest, modTime time.Time) (*SessionFile, error) {
+	b, err := json.MarshalIndent(m, "", "  ")
+	if err != nil {
+		return nil, fmt.Errorf("marshal json: %w", err)
+	}
+	return &SessionFile{ReadSeeker: bytes.NewReader(b), Size: int64(len(b)), ModTime: modTime}, nil
+}
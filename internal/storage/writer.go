@@ -9,18 +9,36 @@ import (
 	"io"
 	"os"
 	"path/filepath"
+
+	"github.com/proeugene/logfalcon/internal/util"
 )
 
 const bufSize = 256 * 1024
 
 // StreamWriter writes data to a file with buffering, tracks bytes written,
 // and computes a running SHA-256 hash.
+//
+// It also implements OffsetWriter. Data written out of order cannot share
+// one running hash, so each contiguous run of WriteAt calls is hashed on
+// its own and VerifyAgainstFile checks every run.
 type StreamWriter struct {
 	path         string
 	file         *os.File
 	buf          *bufio.Writer
 	hasher       hash.Hash
 	bytesWritten int64
+
+	runs     []writtenRun // finished WriteAt runs
+	run      writtenRun   // current WriteAt run
+	fileHash string       // whole-file hash once an unordered file is verified
+
+	profile IOProfile
+}
+
+// writtenRun is a contiguous span written with WriteAt and its SHA-256.
+type writtenRun struct {
+	Range
+	sum [sha256.Size]byte
 }
 
 // NewStreamWriter creates parent directories if needed, opens the file for
@@ -38,7 +56,7 @@ func NewStreamWriter(path string) (*StreamWriter, error) {
 		file:   f,
 		hasher: sha256.New(),
 	}
-	w.buf = bufio.NewWriterSize(f, bufSize)
+	w.buf = bufio.NewWriterSize(profiledFile{f, &w.profile}, bufSize)
 	return w, nil
 }
 
@@ -58,7 +76,7 @@ func (w *StreamWriter) Close() error {
 		_ = w.file.Close()
 		return fmt.Errorf("flush: %w", err)
 	}
-	if err := w.file.Sync(); err != nil {
+	if err := w.profile.fsync(w.file); err != nil {
 		_ = w.file.Close()
 		return fmt.Errorf("fsync: %w", err)
 	}
@@ -71,13 +89,73 @@ func (w *StreamWriter) Abort() error {
 	return os.Remove(w.path)
 }
 
+// WriteAt writes p at file offset off. The running hash no longer covers
+// the file once WriteAt is used; see VerifyAgainstFile.
+func (w *StreamWriter) WriteAt(p []byte, off int64) (int, error) {
+	if err := w.buf.Flush(); err != nil {
+		return 0, err
+	}
+	if w.run.Len == 0 || off != w.run.End() {
+		w.endRun()
+		w.run.Off = off
+		w.hasher.Reset()
+	}
+	n, err := w.profile.writeAt(w.file, p, off)
+	w.hasher.Write(p[:n])
+	w.run.Len += int64(n)
+	w.bytesWritten += int64(n)
+	return n, err
+}
+
+// endRun closes the current WriteAt run.
+func (w *StreamWriter) endRun() {
+	if w.run.Len == 0 {
+		return
+	}
+	copy(w.run.sum[:], w.hasher.Sum(nil))
+	w.runs = append(w.runs, w.run)
+	w.run = writtenRun{}
+}
+
+// unordered reports whether WriteAt was used.
+func (w *StreamWriter) unordered() bool {
+	return len(w.runs) > 0 || w.run.Len > 0
+}
+
+// Commit fsyncs the data written so far and records covered next to the
+// file, so an interrupted copy can be opened up to what is on disk. A nil
+// covered marks the copy complete and drops the record.
+func (w *StreamWriter) Commit(covered []Range) error {
+	if err := w.buf.Flush(); err != nil {
+		return fmt.Errorf("flush: %w", err)
+	}
+	if err := w.profile.fsync(w.file); err != nil {
+		return fmt.Errorf("fsync: %w", err)
+	}
+	return writeCoverage(filepath.Dir(w.path), covered)
+}
+
+// Preallocate reserves size bytes for the file without changing its size.
+func (w *StreamWriter) Preallocate(size int64) error {
+	return util.Preallocate(w.file, 0, size)
+}
+
+// Profile returns the card I/O recorded so far.
+func (w *StreamWriter) Profile() *IOProfile {
+	return &w.profile
+}
+
 // BytesWritten returns the total number of bytes written so far.
 func (w *StreamWriter) BytesWritten() int64 {
 	return w.bytesWritten
 }
 
 // SHA256Hex returns the hex-encoded SHA-256 digest of all data written.
+// After WriteAt it is only known once VerifyAgainstFile has succeeded.
 func (w *StreamWriter) SHA256Hex() string {
+	if w.unordered() {
+		return w.fileHash
+	}
 	return hex.EncodeToString(w.hasher.Sum(nil))
 }
 
@@ -91,6 +169,10 @@ func (w *StreamWriter) VerifyAgainstFile() (bool, string, error) {
 	}
 	defer f.Close()
 
+	if w.unordered() {
+		return w.verifyRuns(f)
+	}
+
 	h := sha256.New()
 	if _, err := io.Copy(h, f); err != nil {
 		return false, "", fmt.Errorf("read for verify: %w", err)
@@ -98,3 +180,29 @@ func (w *StreamWriter) VerifyAgainstFile() (bool, string, error) {
 	fileHash := hex.EncodeToString(h.Sum(nil))
 	return fileHash == w.SHA256Hex(), fileHash, nil
 }
+
+// verifyRuns checks each WriteAt run against the file and hashes the whole
+// file for the manifest.
+func (w *StreamWriter) verifyRuns(f *os.File) (bool, string, error) {
+	w.endRun()
+	h := sha256.New()
+	match := true
+	for _, r := range w.runs {
+		h.Reset()
+		if _, err := io.Copy(h, io.NewSectionReader(f, r.Off, r.Len)); err != nil {
+			return false, "", fmt.Errorf("read for verify: %w", err)
+		}
+		if [sha256.Size]byte(h.Sum(nil)) != r.sum {
+			match = false
+		}
+	}
+	h.Reset()
+	if _, err := io.Copy(h, f); err != nil {
+		return false, "", fmt.Errorf("read for verify: %w", err)
+	}
+	fileHash := hex.EncodeToString(h.Sum(nil))
+	if match {
+		w.fileHash = fileHash
+	}
+	return match, fileHash, nil
+}
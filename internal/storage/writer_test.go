@@ -129,3 +129,68 @@ func TestStreamWriterEmpty(t *testing.T) {
 		t.Fatalf("file size = %d, want 0", info.Size())
 	}
 }
+
+func TestStreamWriterPreallocateKeepsSize(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "prealloc.bin")
+	w, err := NewStreamWriter(path)
+	if err != nil {
+		t.Fatalf("NewStreamWriter: %v", err)
+	}
+	if err := w.Preallocate(1 << 20); err != nil {
+		t.Skipf("filesystem does not support preallocation: %v", err)
+	}
+	data := []byte("short log")
+	if _, err := w.Write(data); err != nil {
+		t.Fatalf("Write: %v", err)
+	}
+	if err := w.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+	info, err := os.Stat(path)
+	if err != nil {
+		t.Fatalf("Stat: %v", err)
+	}
+	if info.Size() != int64(len(data)) {
+		t.Fatalf("file size = %d, want %d", info.Size(), len(data))
+	}
+	if ok, _, err := w.VerifyAgainstFile(); err != nil || !ok {
+		t.Fatalf("VerifyAgainstFile = %v, %v", ok, err)
+	}
+}
+
+func TestStreamWriterWriteAtVerify(t *testing.T) {
+	path := filepath.Join(t.TempDir(), "unordered.bin")
+	w, err := NewStreamWriter(path)
+	if err != nil {
+		t.Fatalf("NewStreamWriter: %v", err)
+	}
+	data := make([]byte, 3000)
+	for i := range data {
+		data[i] = byte(i * 7)
+	}
+	// Tail first, in two runs of two writes each.
+	for _, r := range [][2]int{{2000, 500}, {2500, 500}, {0, 1000}, {1000, 1000}} {
+		if _, err := w.WriteAt(data[r[0]:r[0]+r[1]], int64(r[0])); err != nil {
+			t.Fatalf("WriteAt(%d): %v", r[0], err)
+		}
+	}
+	if err := w.Close(); err != nil {
+		t.Fatalf("Close: %v", err)
+	}
+
+	ok, fileHash, err := w.VerifyAgainstFile()
+	want := sha256.Sum256(data)
+	if err != nil || !ok || fileHash != hex.EncodeToString(want[:]) || w.SHA256Hex() != fileHash {
+		t.Fatalf("verify = %v, %s, %v; want a match with hash %x", ok, fileHash, err, want)
+	}
+
+	// Corrupt one byte on disk: the run covering it must fail.
+	raw, _ := os.ReadFile(path)
+	raw[1500] ^= 0xff
+	if err := os.WriteFile(path, raw, 0o644); err != nil {
+		t.Fatal(err)
+	}
+	if ok, _, err := w.VerifyAgainstFile(); err != nil || ok {
+		t.Fatalf("verify after corruption = %v, %v; want a mismatch", ok, err)
+	}
+}
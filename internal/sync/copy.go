@@ -0,0 +1,233 @@
+package sync
+
+import (
+	"context"
+	"fmt"
+	"log/slog"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/msp"
+	"github.com/proeugene/logfalcon/internal/storage"
+)
+
+// Read orders for step 6.
+const (
+	// ReadOrderLinear copies the flash from its first byte to its last.
+	ReadOrderLinear = "linear"
+	// ReadOrderTailFirst copies tailStripeSize stripes from the end of the
+	// used area backwards, so the newest flights are on the SD card first
+	// if the FC is unplugged early.
+	ReadOrderTailFirst = "tail_first"
+)
+
+// tailStripeSize is the unit of a tail-first copy. Each stripe is read in
+// order with the usual pipelining, then fsynced and recorded as covered.
+const tailStripeSize = 1 << 20
+
+// span is a half-open range of flash addresses [from, to).
+type span struct{ from, to uint32 }
+
+func (s span) empty() bool { return s.to <= s.from }
+
+// tailStripes splits [start, end) into stripes, newest first. The newest
+// stripe takes the remainder so the others stay aligned to start.
+func tailStripes(start, end uint32) []span {
+	if end <= start {
+		return nil
+	}
+	var out []span
+	hi := end
+	lo := start + (end-start-1)/tailStripeSize*tailStripeSize
+	for {
+		out = append(out, span{lo, hi})
+		if lo == start {
+			return out
+		}
+		hi, lo = lo, lo-tailStripeSize
+	}
+}
+
+// copyError is a failed flash copy with its dashboard message.
+type copyError struct {
+	msg string
+}
+
+func (e *copyError) Error() string { return e.msg }
+
+// flashCopier streams flash ranges from the FC with pipelined reads. It is
+// shared by both read orders and keeps progress across ranges.
+type flashCopier struct {
+	o           *Orchestrator
+	client      *msp.Client
+	total       uint32 // bytes to copy across all ranges
+	copied      uint32
+	started     time.Time
+	chunkSize   uint16
+	compression bool
+	eased       bool
+}
+
+func (o *Orchestrator) newFlashCopier(client *msp.Client, total uint32) *flashCopier {
+	return &flashCopier{
+		o:           o,
+		client:      client,
+		total:       total,
+		started:     time.Now(),
+		chunkSize:   uint16(o.Config.FlashChunkSize),
+		compression: o.Config.FlashReadCompression,
+	}
+}
+
+// copyRange reads cur in order and hands each chunk to sink, returning the
+// address it got to (short of cur.to if the FC ran out of data). primed
+// means the request for cur.from has already been sent. Once the last chunk of
+// cur has arrived, the first chunk of next (if any) is requested, so the FC
+// works while the caller finishes up cur.
+func (c *flashCopier) copyRange(cur, next span, primed bool, sink func(addr uint32, data []byte) error) (uint32, error) {
+	o, client := c.o, c.client
+	address := cur.from
+	consecutiveErrors := 0
+	send := func(addr uint32) error {
+		return sendFlashRead(client, addr, cur.to, c.chunkSize, c.compression)
+	}
+
+	// Send first request (prime the pipeline) unless already done.
+	if !primed {
+		if err := send(address); err != nil {
+			slog.Error("failed to send initial flash read request", "error", err)
+			return address, &copyError{"Could not start reading flash data from the FC."}
+		}
+	}
+
+	for address < cur.to {
+		chunkAddr, data, err := client.ReceiveFlashReadResponse()
+		if err != nil {
+			consecutiveErrors++
+			slog.Warn("flash read error", "address", fmt.Sprintf("0x%08x", address),
+				"attempt", consecutiveErrors, "maxAttempts", maxConsecutiveErrors, "error", err)
+			if consecutiveErrors >= maxConsecutiveErrors {
+				slog.Error("too many consecutive read errors — aborting")
+				return address, &copyError{"Too many FC read errors. Try another USB cable and sync again."}
+			}
+			time.Sleep(10 * time.Millisecond)
+			// Re-send the same request on error.
+			_ = send(address)
+			continue
+		}
+
+		if chunkAddr != address {
+			slog.Warn("address mismatch — retrying", "expected", fmt.Sprintf("0x%08x", address), "got", fmt.Sprintf("0x%08x", chunkAddr))
+			consecutiveErrors++
+			if consecutiveErrors >= maxConsecutiveErrors {
+				slog.Error("too many address mismatches — aborting")
+				return address, &copyError{"The FC returned inconsistent data. Reconnect and try again."}
+			}
+			_ = send(address)
+			continue
+		}
+
+		if len(data) == 0 {
+			slog.Info("FC returned 0 bytes — end of data", "address", fmt.Sprintf("0x%08x", address))
+			break
+		}
+
+		consecutiveErrors = 0
+		o.recvGaps.observe(time.Now())
+
+		// Ease off while the Pi is hot or undervolted: smaller chunks and no
+		// Huffman decoding on the Pi.
+		if degraded := o.thermal.Degraded(); degraded != c.eased {
+			c.eased = degraded
+			c.chunkSize, c.compression = uint16(o.Config.FlashChunkSize), o.Config.FlashReadCompression
+			if c.eased {
+				c.chunkSize = min(c.chunkSize, throttledChunkSize)
+				c.compression = false
+			}
+			slog.Warn("adjusting flash reads for Pi health", "throttled", c.eased,
+				"chunk", c.chunkSize, "compression", c.compression)
+		}
+
+		// Pipeline: send next request BEFORE processing current data.
+		nextAddr := address + uint32(len(data))
+		if nextAddr < cur.to {
+			_ = send(nextAddr)
+		} else if !next.empty() {
+			_ = sendFlashRead(client, next.from, next.to, c.chunkSize, c.compression)
+		}
+		// Slot in one queued FC query while the FC works on the next chunk.
+		o.sched.Interleave()
+		// Both requests must be on the wire before the SD write, not held
+		// back by a network port until the next read.
+		_ = client.Flush()
+
+		if err := sink(address, data); err != nil {
+			slog.Error("failed to write flash data", "error", err)
+			return address, &copyError{"Failed to write data to the output file."}
+		}
+		address = nextAddr
+		c.copied += uint32(len(data))
+		c.progress(address)
+	}
+	return address, nil
+}
+
+// progress publishes the copy progress, speed and ETA.
+func (c *flashCopier) progress(address uint32) {
+	percent := int(uint64(c.copied) * 100 / uint64(c.total))
+
+	// Compute real-time transfer speed and ETA.
+	elapsed := time.Since(c.started).Seconds()
+	var speedBPS float64
+	var etaSec int
+	if elapsed > 0 {
+		speedBPS = float64(c.copied) / elapsed
+		if speedBPS > 0 {
+			etaSec = int(float64(c.total-c.copied) / speedBPS)
+		}
+	}
+	SetStatusSync("syncing", percent, "Copying blackbox flash to the Pi SD card.",
+		c.copied, c.total, speedBPS, etaSec)
+
+	// Guarded so the Sprintf calls stay off the steady-state path.
+	if address%(uint32(c.chunkSize)*64) < uint32(c.chunkSize) && slog.Default().Enabled(context.Background(), slog.LevelDebug) {
+		slog.Debug("flash read progress", "address", fmt.Sprintf("0x%08x", address),
+			"copied", c.copied, "total", c.total, "percent", percent)
+	}
+}
+
+// copyTailFirst copies [start, end) stripe by stripe from the end, writing
+// each chunk at its offset in the session file. After every stripe the file
+// is fsynced and the covered ranges (file offsets) are recorded, so an
+// unplug leaves the newest flights readable. primed means the first
+// (newest) stripe has already been requested.
+func (c *flashCopier) copyTailFirst(w storage.OffsetWriter, start, end uint32, primed bool, covered *[]storage.Range) error {
+	sink := func(addr uint32, data []byte) error {
+		_, err := w.WriteAt(data, int64(addr-start))
+		return err
+	}
+	stripes := tailStripes(start, end)
+	for i, s := range stripes {
+		var next span
+		if i+1 < len(stripes) {
+			next = stripes[i+1]
+		}
+		reached, err := c.copyRange(s, next, primed || i > 0, sink)
+		if err != nil {
+			return err
+		}
+		*covered = storage.AddRange(*covered, storage.Range{Off: int64(s.from - start), Len: int64(reached - s.from)})
+		if err := w.Commit(*covered); err != nil {
+			slog.Error("failed to commit flash stripe", "error", err)
+			return &copyError{"Failed to write data to the output file."}
+		}
+	}
+	if storage.CoveredBytes(*covered) < int64(end-start) {
+		return nil // the FC ran out of data; verification reports it
+	}
+	// Complete: verification and the manifest take over from here.
+	if err := w.Commit(nil); err != nil {
+		slog.Error("failed to commit flash copy", "error", err)
+		return &copyError{"Failed to write data to the output file."}
+	}
+	return nil
+}
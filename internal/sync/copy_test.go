@@ -0,0 +1,107 @@
+package sync
+
+import (
+	"bytes"
+	"errors"
+	"math/rand"
+	"os"
+	"path/filepath"
+	"reflect"
+	"testing"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/config"
+	"github.com/proeugene/logfalcon/internal/msp"
+	"github.com/proeugene/logfalcon/internal/storage"
+)
+
+func TestTailStripes(t *testing.T) {
+	const mb = tailStripeSize
+	got := tailStripes(0, 2*mb+mb/2)
+	want := []span{{2 * mb, 2*mb + mb/2}, {mb, 2 * mb}, {0, mb}}
+	if !reflect.DeepEqual(got, want) {
+		t.Fatalf("stripes = %v, want %v", got, want)
+	}
+	if got := tailStripes(100, 100+mb); !reflect.DeepEqual(got, []span{{100, 100 + mb}}) {
+		t.Fatalf("single stripe = %v", got)
+	}
+	if got := tailStripes(5, 5); got != nil {
+		t.Fatalf("empty range = %v, want nil", got)
+	}
+}
+
+// tailFirstFixture returns a copier reading flash through a fake FC, and
+// a directory-layout session writer.
+func tailFirstFixture(t *testing.T, fcPort *flashFC) (*flashCopier, storage.Store, string, storage.SessionWriter) {
+	t.Helper()
+	cfg := config.Default()
+	o := &Orchestrator{Config: cfg}
+	client := msp.NewClient(fcPort, 20*time.Millisecond)
+	client.FCVariant = msp.INAVVariant
+	store := storage.NewDirStore(t.TempDir())
+	id, w, err := store.Create(&storage.FCInfo{Variant: "INAV", UID: "feed"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	return o.newFlashCopier(client, uint32(len(fcPort.flash))), store, id, w
+}
+
+func TestCopyTailFirst(t *testing.T) {
+	flash := make([]byte, 2*tailStripeSize+12345)
+	rand.New(rand.NewSource(4)).Read(flash)
+	c, store, id, w := tailFirstFixture(t, &flashFC{flash: flash, dec: msp.NewFrameDecoder()})
+
+	var covered []storage.Range
+	if err := c.copyTailFirst(w.(storage.OffsetWriter), 0, uint32(len(flash)), false, &covered); err != nil {
+		t.Fatalf("copyTailFirst: %v", err)
+	}
+	if err := w.Close(); err != nil {
+		t.Fatal(err)
+	}
+	if ok, _, err := w.VerifyAgainstFile(); err != nil || !ok {
+		t.Fatalf("verify = %v, %v", ok, err)
+	}
+	if w.BytesWritten() != int64(len(flash)) {
+		t.Fatalf("BytesWritten = %d, want %d", w.BytesWritten(), len(flash))
+	}
+	f, err := store.Open(id, storage.RawFlashFilename)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer f.Close()
+	got := make([]byte, f.Size)
+	if _, err := f.Read(got); err != nil || !bytes.Equal(got, flash) {
+		t.Fatalf("session file differs from flash (err %v)", err)
+	}
+}
+
+func TestCopyTailFirstInterrupted(t *testing.T) {
+	flash := make([]byte, 2*tailStripeSize+tailStripeSize/2)
+	rand.New(rand.NewSource(5)).Read(flash)
+	fcPort := &flashFC{flash: flash, dec: msp.NewFrameDecoder(), silentBelow: tailStripeSize + 4096}
+	c, store, id, w := tailFirstFixture(t, fcPort)
+
+	var covered []storage.Range
+	err := c.copyTailFirst(w.(storage.OffsetWriter), 0, uint32(len(flash)), false, &covered)
+	var ce *copyError
+	if !errors.As(err, &ce) {
+		t.Fatalf("err = %v, want a copy error", err)
+	}
+	// Only the newest stripe was committed; the second one failed midway.
+	want := []storage.Range{{Off: 2 * tailStripeSize, Len: tailStripeSize / 2}}
+	if !reflect.DeepEqual(covered, want) {
+		t.Fatalf("covered = %v, want %v", covered, want)
+	}
+	if _, err := os.Stat(filepath.Join(store.Root(), id, storage.CoverageFilename)); err != nil {
+		t.Fatalf("coverage record missing: %v", err)
+	}
+	f, err := store.Open(id, storage.RawFlashFilename)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer f.Close()
+	got := make([]byte, f.Size)
+	if _, err := f.Read(got); err != nil || !bytes.Equal(got, flash[2*tailStripeSize:]) {
+		t.Fatalf("partial session does not serve the newest stripe (err %v)", err)
+	}
+}
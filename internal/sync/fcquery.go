@@ -0,0 +1,140 @@
+package sync
+
+import (
+	"context"
+	"encoding/binary"
+	"encoding/hex"
+	"encoding/json"
+	"errors"
+	"log/slog"
+	"net"
+	"net/http"
+	"os"
+	"path/filepath"
+	"strings"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/msp"
+)
+
+// FCQuerySocketName is the Unix socket in the runtime directory on which a
+// running sync answers live FC queries for the web process.
+const FCQuerySocketName = "fc.sock"
+
+const (
+	// fcQueryTimeout bounds how long a queued query may wait for its answer.
+	fcQueryTimeout = 3 * time.Second
+	// fcQueryMSPTimeout is how long the FC gets to answer once the query has
+	// been sent.
+	fcQueryMSPTimeout = 2 * time.Second
+)
+
+// fcQuery is a read-only MSP query the web UI may run during a sync.
+type fcQuery struct {
+	code   uint16
+	decode func(payload []byte) map[string]any
+}
+
+// fcQueries lists what the web UI may ask. Nothing that changes FC state is
+// exposed.
+var fcQueries = map[string]fcQuery{
+	"status": {msp.MSPStatus, decodeMSPStatus},
+	"analog": {msp.MSPAnalog, decodeMSPAnalog},
+	"name":   {msp.MSPName, func(p []byte) map[string]any { return map[string]any{"name": string(p)} }},
+}
+
+// decodeMSPStatus reads the fields MSP_STATUS has in both Betaflight and
+// iNav: cycle time, I2C errors, sensors and the active flight mode flags.
+func decodeMSPStatus(p []byte) map[string]any {
+	if len(p) < 10 {
+		return nil
+	}
+	flags := binary.LittleEndian.Uint32(p[6:10])
+	return map[string]any{
+		"cycle_time_us": binary.LittleEndian.Uint16(p[0:2]),
+		"i2c_errors":    binary.LittleEndian.Uint16(p[2:4]),
+		"sensors":       binary.LittleEndian.Uint16(p[4:6]),
+		"mode_flags":    flags,
+		"armed":         flags&1 != 0,
+	}
+}
+
+// decodeMSPAnalog reads MSP_ANALOG. Betaflight appends the battery voltage in
+// 0.01 V after the legacy 0.1 V byte; iNav only has the legacy one.
+func decodeMSPAnalog(p []byte) map[string]any {
+	if len(p) < 7 {
+		return nil
+	}
+	voltage := float64(p[0]) / 10
+	if len(p) >= 9 {
+		voltage = float64(binary.LittleEndian.Uint16(p[7:9])) / 100
+	}
+	return map[string]any{
+		"voltage":   voltage,
+		"mah_drawn": binary.LittleEndian.Uint16(p[1:3]),
+		"rssi":      binary.LittleEndian.Uint16(p[3:5]),
+		"amps":      float64(int16(binary.LittleEndian.Uint16(p[5:7]))) / 100,
+	}
+}
+
+// fcQueryHandler answers GET /fc/<query> from the scheduler.
+func fcQueryHandler(sched *msp.Scheduler) http.Handler {
+	return http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		name := strings.TrimPrefix(r.URL.Path, "/fc/")
+		q, ok := fcQueries[name]
+		if r.Method != http.MethodGet || !ok {
+			writeQueryJSON(w, http.StatusNotFound, map[string]any{"error": "Unknown FC query."})
+			return
+		}
+		ctx, cancel := context.WithTimeout(r.Context(), fcQueryTimeout)
+		defer cancel()
+		payload, err := sched.Do(ctx, msp.PriorityInteractive, q.code, nil)
+		var timeout *msp.TimeoutError
+		switch {
+		case errors.Is(err, msp.ErrSchedulerClosed):
+			writeQueryJSON(w, http.StatusServiceUnavailable, map[string]any{"error": "The sync has finished with the flight controller."})
+		case errors.As(err, &timeout), errors.Is(err, context.DeadlineExceeded):
+			writeQueryJSON(w, http.StatusGatewayTimeout, map[string]any{"error": "The flight controller did not answer in time."})
+		case err != nil:
+			writeQueryJSON(w, http.StatusBadGateway, map[string]any{"error": err.Error()})
+		default:
+			writeQueryJSON(w, http.StatusOK, map[string]any{
+				"query": name,
+				"code":  q.code,
+				"data":  q.decode(payload),
+				"raw":   hex.EncodeToString(payload),
+			})
+		}
+	})
+}
+
+func writeQueryJSON(w http.ResponseWriter, status int, v any) {
+	w.Header().Set("Content-Type", "application/json")
+	w.WriteHeader(status)
+	_ = json.NewEncoder(w).Encode(v)
+}
+
+// startFCQueryServer serves live FC queries on the Unix socket at path until
+// stop is called. A socket left behind by a killed sync is replaced.
+func startFCQueryServer(path string, sched *msp.Scheduler) (stop func(), err error) {
+	if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
+		return nil, err
+	}
+	_ = os.Remove(path)
+	ln, err := net.Listen("unix", path)
+	if err != nil {
+		return nil, err
+	}
+	srv := &http.Server{Handler: fcQueryHandler(sched), ReadHeaderTimeout: 5 * time.Second}
+	go func() {
+		if err := srv.Serve(ln); err != nil && !errors.Is(err, http.ErrServerClosed) {
+			slog.Warn("FC query server stopped", "error", err)
+		}
+	}()
+	return func() {
+		ctx, cancel := context.WithTimeout(context.Background(), time.Second)
+		defer cancel()
+		_ = srv.Shutdown(ctx)
+		_ = os.Remove(path)
+	}, nil
+}
@@ -0,0 +1,97 @@
+package sync
+
+import (
+	"context"
+	"encoding/json"
+	"net"
+	"net/http"
+	"path/filepath"
+	"testing"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/msp"
+)
+
+func TestDecodeMSPAnalog(t *testing.T) {
+	// vbat 16.8 V legacy, 1234 mAh, rssi 512, -1.50 A, 16.74 V precise.
+	btfl := []byte{168, 0xd2, 0x04, 0x00, 0x02, 0x6a, 0xff, 0x8a, 0x06}
+	got := decodeMSPAnalog(btfl)
+	if got["voltage"] != 16.74 || got["mah_drawn"] != uint16(1234) || got["rssi"] != uint16(512) || got["amps"] != -1.5 {
+		t.Errorf("betaflight analog = %v", got)
+	}
+	if got := decodeMSPAnalog(btfl[:7]); got["voltage"] != 16.8 {
+		t.Errorf("iNav analog voltage = %v, want 16.8", got["voltage"])
+	}
+	if decodeMSPAnalog(btfl[:3]) != nil {
+		t.Error("short payload should not decode")
+	}
+}
+
+func TestDecodeMSPStatus(t *testing.T) {
+	p := []byte{0xe8, 0x03, 0, 0, 0x23, 0, 0x05, 0, 0, 0, 0}
+	got := decodeMSPStatus(p)
+	if got["cycle_time_us"] != uint16(1000) || got["mode_flags"] != uint32(5) || got["armed"] != true {
+		t.Errorf("status = %v", got)
+	}
+}
+
+func unixHTTPClient(path string) *http.Client {
+	return &http.Client{Transport: &http.Transport{
+		DialContext: func(ctx context.Context, _, _ string) (net.Conn, error) {
+			return (&net.Dialer{}).DialContext(ctx, "unix", path)
+		},
+	}}
+}
+
+func TestFCQueryServer(t *testing.T) {
+	fc := &flashFC{dec: msp.NewFrameDecoder(), replies: map[uint16][]byte{
+		msp.MSPAnalog: {168, 0, 0, 0, 0, 0, 0},
+	}}
+	client := msp.NewClient(fc, 100*time.Millisecond)
+	sched := msp.NewScheduler(client, time.Second)
+
+	path := filepath.Join(t.TempDir(), FCQuerySocketName)
+	stop, err := startFCQueryServer(path, sched)
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer stop()
+
+	// The sync goroutine, waiting on an erase.
+	done := make(chan struct{})
+	go func() {
+		defer close(done)
+		for i := 0; i < 100; i++ {
+			sched.Wait(10 * time.Millisecond)
+		}
+	}()
+
+	get := func(name string) (int, map[string]any) {
+		t.Helper()
+		resp, err := unixHTTPClient(path).Get("http://fc/fc/" + name)
+		if err != nil {
+			t.Fatal(err)
+		}
+		defer resp.Body.Close()
+		var body map[string]any
+		_ = json.NewDecoder(resp.Body).Decode(&body)
+		return resp.StatusCode, body
+	}
+
+	code, body := get("analog")
+	if code != http.StatusOK || body["raw"] != "a8000000000000" {
+		t.Fatalf("analog: %d %v", code, body)
+	}
+	if data, _ := body["data"].(map[string]any); data["voltage"] != 16.8 {
+		t.Errorf("voltage = %v, want 16.8", data["voltage"])
+	}
+	if code, _ := get("erase"); code != http.StatusNotFound {
+		t.Errorf("unknown query: %d, want 404", code)
+	}
+
+	<-done
+	sched.Close()
+	if code, _ := get("status"); code != http.StatusServiceUnavailable {
+		t.Errorf("after close: %d, want 503", code)
+	}
+}
@@ -0,0 +1,104 @@
+package sync
+
+import (
+	"bytes"
+	"fmt"
+
+	"github.com/proeugene/logfalcon/internal/blackbox"
+	"github.com/proeugene/logfalcon/internal/msp"
+)
+
+const (
+	// Probes read probeSize bytes every probeStride bytes, walking back from
+	// the end of the used area. A log header is several KB of "H name:value"
+	// lines, longer than probeStride+probeSize, so no header is skipped.
+	probeStride = 2048
+	probeSize   = 128
+	// headerScanBack is how far before a probe that hit header text the
+	// preamble is searched for; on a miss probing continues further back.
+	headerScanBack = 16 * 1024
+	// probeRetries bounds MSP errors per probe read.
+	probeRetries = 3
+)
+
+// flashReadFunc reads n bytes of FC flash starting at addr.
+type flashReadFunc func(addr uint32, n int) ([]byte, error)
+
+// findLastLog locates the start of the last blackbox log in the used flash
+// area with sparse probing reads from the end, so a quick sync does not
+// have to copy everything before it. It returns 0 when the flash holds a
+// single log, and the number of probes it took.
+func findLastLog(read flashReadFunc, usedSize uint32) (uint32, int, error) {
+	if usedSize <= probeSize {
+		return 0, 0, nil
+	}
+	probes := 0
+	addr := usedSize - probeSize
+	for {
+		probe, err := read(addr, probeSize)
+		probes++
+		if err != nil {
+			return 0, probes, err
+		}
+		if looksLikeHeader(probe) {
+			lo := addr - min(addr, headerScanBack)
+			hi := min(usedSize, addr+probeSize+uint32(len(blackbox.Preamble)))
+			window, err := read(lo, int(hi-lo))
+			if err != nil {
+				return 0, probes, err
+			}
+			if i := bytes.LastIndex(window, blackbox.Preamble); i >= 0 {
+				return lo + uint32(i), probes, nil
+			}
+			addr = lo
+		}
+		if addr == 0 {
+			return 0, probes, nil
+		}
+		addr -= min(addr, probeStride)
+	}
+}
+
+// looksLikeHeader reports whether p is from the text header of a log: almost
+// all printable ASCII and holding the start of an "H " line. Encoded frame
+// data is binary and fails the first test.
+func looksLikeHeader(p []byte) bool {
+	printable := 0
+	for _, c := range p {
+		if c == '\n' || (c >= 0x20 && c < 0x7f) {
+			printable++
+		}
+	}
+	if printable*10 < len(p)*9 {
+		return false
+	}
+	return bytes.HasPrefix(p, []byte("H ")) || bytes.Contains(p, []byte("\nH "))
+}
+
+// clientFlashReader returns a flashReadFunc issuing uncompressed
+// MSP_DATAFLASH_READ requests of at most chunkSize bytes.
+func clientFlashReader(client *msp.Client, usedSize uint32, chunkSize uint16) flashReadFunc {
+	return func(addr uint32, n int) ([]byte, error) {
+		out := make([]byte, 0, n)
+		failures := 0
+		for len(out) < n {
+			at := addr + uint32(len(out))
+			size := uint16(min(n-len(out), int(chunkSize)))
+			gotAddr, data, err := client.ReadFlashChunk(at, size, false)
+			if err == nil && gotAddr != at {
+				err = fmt.Errorf("FC answered for 0x%08x, asked 0x%08x", gotAddr, at)
+			}
+			if err != nil {
+				if failures++; failures >= probeRetries {
+					return nil, err
+				}
+				continue
+			}
+			if len(data) == 0 || at >= usedSize {
+				break
+			}
+			out = append(out, data...)
+		}
+		return out, nil
+	}
+}
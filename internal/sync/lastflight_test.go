@@ -0,0 +1,134 @@
+package sync
+
+import (
+	"bytes"
+	"encoding/binary"
+	"fmt"
+	"math/rand"
+	"testing"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/blackbox"
+	"github.com/proeugene/logfalcon/internal/msp"
+)
+
+// fakeLog returns a blackbox log: a text header of roughly headerLines
+// lines followed by frameBytes of binary frame data.
+func fakeLog(rng *rand.Rand, headerLines, frameBytes int) []byte {
+	var b bytes.Buffer
+	b.Write(blackbox.Preamble)
+	b.WriteByte('\n')
+	for i := 0; i < headerLines; i++ {
+		fmt.Fprintf(&b, "H field_%d:%d,%d,%d\n", i, rng.Intn(1000), rng.Intn(1000), rng.Intn(1000))
+	}
+	frames := make([]byte, frameBytes)
+	rng.Read(frames)
+	b.Write(frames)
+	return b.Bytes()
+}
+
+func sliceReader(flash []byte, reads *int) flashReadFunc {
+	return func(addr uint32, n int) ([]byte, error) {
+		*reads++
+		end := min(len(flash), int(addr)+n)
+		return append([]byte(nil), flash[addr:end]...), nil
+	}
+}
+
+func TestFindLastLog(t *testing.T) {
+	rng := rand.New(rand.NewSource(1))
+	var flash []byte
+	for _, frames := range []int{300_000, 120_000} {
+		flash = append(flash, fakeLog(rng, 150, frames)...)
+	}
+	lastStart := uint32(len(flash))
+	flash = append(flash, fakeLog(rng, 150, 80_000)...)
+
+	reads := 0
+	start, probes, err := findLastLog(sliceReader(flash, &reads), uint32(len(flash)))
+	if err != nil {
+		t.Fatal(err)
+	}
+	if start != lastStart {
+		t.Fatalf("start = %d, want %d", start, lastStart)
+	}
+	// Sparse: about one probe per stride of the last log, not a full read.
+	if maxProbes := 80_000/probeStride + 5; probes > maxProbes {
+		t.Errorf("%d probes, want at most %d", probes, maxProbes)
+	}
+}
+
+func TestFindLastLogSingleLog(t *testing.T) {
+	rng := rand.New(rand.NewSource(2))
+	flash := fakeLog(rng, 150, 50_000)
+	reads := 0
+	start, _, err := findLastLog(sliceReader(flash, &reads), uint32(len(flash)))
+	if err != nil || start != 0 {
+		t.Fatalf("start = %d, err = %v; want 0", start, err)
+	}
+
+	// Flash without any header (corrupt or foreign data) falls back to 0.
+	junk := make([]byte, 20_000)
+	rng.Read(junk)
+	if start, _, err := findLastLog(sliceReader(junk, &reads), uint32(len(junk))); err != nil || start != 0 {
+		t.Fatalf("start = %d, err = %v; want 0", start, err)
+	}
+}
+
+// flashFC serves MSP_DATAFLASH_READ requests iNav-style from flash, and
+// other requests from replies.
+type flashFC struct {
+	flash   []byte
+	replies map[uint16][]byte
+	dec     *msp.FrameDecoder
+	out     bytes.Buffer
+	// silentBelow leaves requests below this address unanswered, like an
+	// FC unplugged partway through a tail-first copy.
+	silentBelow uint32
+}
+
+func (f *flashFC) Write(data []byte) (int, error) {
+	f.dec.Feed(data)
+	for _, req := range f.dec.Frames {
+		if req.Code != msp.MSPDataflashRead {
+			if reply, ok := f.replies[req.Code]; ok {
+				resp := msp.EncodeV2(req.Code, reply)
+				resp[2] = '>'
+				f.out.Write(resp)
+			}
+			continue
+		}
+		addr := binary.LittleEndian.Uint32(req.Payload[0:4])
+		size := int(binary.LittleEndian.Uint16(req.Payload[4:6]))
+		if addr < f.silentBelow {
+			continue
+		}
+		end := min(len(f.flash), int(addr)+size)
+		payload := binary.LittleEndian.AppendUint32(nil, addr)
+		payload = append(payload, f.flash[addr:end]...)
+		resp := msp.EncodeV2(msp.MSPDataflashRead, payload)
+		resp[2] = '>'
+		f.out.Write(resp)
+	}
+	f.dec.Frames = f.dec.Frames[:0]
+	return len(data), nil
+}
+
+func (f *flashFC) Read(buf []byte) (int, error) { return f.out.Read(buf) }
+func (f *flashFC) Close() error                 { return nil }
+
+func TestClientFlashReader(t *testing.T) {
+	flash := make([]byte, 10_000)
+	rand.New(rand.NewSource(3)).Read(flash)
+	client := msp.NewClient(&flashFC{flash: flash, dec: msp.NewFrameDecoder()}, 100*time.Millisecond)
+	client.FCVariant = msp.INAVVariant
+
+	read := clientFlashReader(client, uint32(len(flash)), 1024)
+	got, err := read(1500, 3000)
+	if err != nil {
+		t.Fatal(err)
+	}
+	if !bytes.Equal(got, flash[1500:4500]) {
+		t.Fatal("read returned the wrong bytes")
+	}
+}
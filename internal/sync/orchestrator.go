@@ -1,7 +1,7 @@
 // Package sync implements the 10-step blackbox flash sync state machine.
 //
 // Steps:
-//  1. Open serial port → create MSP client
+//  1. Open serial port, wait until the FC answers MSP → create MSP client
 //  2. Identify FC (MSP handshake, verify supported variant)
 //  3. Query flash state (dataflash summary)
 //  4. Check Pi storage (free space, cleanup if needed)
@@ -11,9 +11,13 @@
 //  8. Write manifest
 //  9. Erase FC flash (poll until empty or timeout)
 //  10. Signal result (LED + status)
+//
+// The FC-independent half of steps 4–5 runs concurrently with steps 2–3,
+// and the first flash read request goes out before step 4 joins it.
 package sync
 
 import (
+	"context"
 	"errors"
 	"fmt"
 	"log/slog"
@@ -23,12 +27,11 @@ import (
 	"sync"
 	"time"
 
-	goSerial "go.bug.st/serial"
-
 	"github.com/proeugene/logfalcon/internal/config"
 	"github.com/proeugene/logfalcon/internal/fc"
 	"github.com/proeugene/logfalcon/internal/led"
 	"github.com/proeugene/logfalcon/internal/msp"
+	"github.com/proeugene/logfalcon/internal/power"
 	"github.com/proeugene/logfalcon/internal/storage"
 	"github.com/proeugene/logfalcon/internal/util"
 )
@@ -36,6 +39,13 @@ import (
 const (
 	maxConsecutiveErrors = 5
 	erasePollInterval    = 2 * time.Second
+
+	// thermalSampleInterval is how often temperature and throttle flags are
+	// read during a sync.
+	thermalSampleInterval = time.Second
+	// throttledChunkSize caps flash reads while the Pi is hot or
+	// undervolted: shorter USB bursts and cheaper retries.
+	throttledChunkSize = 1024
 )
 
 // SyncResult represents the outcome of a sync operation.
@@ -64,6 +74,9 @@ type Status struct {
 	// Warning is non-empty when firmware is newer than max tested.
 	// The sync proceeds but the user is shown an amber notice.
 	Warning string `json:"warning,omitempty"`
+	// Timeline is the stage breakdown of the last finished sync, from plug-in
+	// to result LED.
+	Timeline []storage.ManifestStage `json:"timeline,omitempty"`
 }
 
 var (
@@ -76,6 +89,7 @@ var (
 
 // GetStatus returns a snapshot of the current sync status (thread-safe).
 func GetStatus() Status {
+	refreshFollowed()
 	statusMu.RLock()
 	defer statusMu.RUnlock()
 	return currentStatus
@@ -96,7 +110,9 @@ func SetStatus(state string, progress int, message string) {
 		FCFirmwareVersion: prev.FCFirmwareVersion,
 		FCAPIVersion:      prev.FCAPIVersion,
 		Warning:           prev.Warning,
+		Timeline:          prev.Timeline,
 	}
+	publishLocked()
 }
 
 // setFCIdentity stores the FC identity fields after a successful handshake.
@@ -108,6 +124,16 @@ func setFCIdentity(info *fc.FCInfo) {
 	currentStatus.FCFirmwareVersion = info.FirmwareVersion
 	currentStatus.FCAPIVersion = fmt.Sprintf("%d.%d", info.APIMajor, info.APIMinor)
 	currentStatus.Warning = info.Warning
+	publishLocked()
+}
+
+// setStatusTimeline publishes the stage breakdown of the finished sync.
+func setStatusTimeline(stages []storage.ManifestStage) {
+	statusMu.Lock()
+	defer statusMu.Unlock()
+	currentStatus.Timeline = stages
+	lastPublished = time.Time{} // the process exits next; skip the rate limit
+	publishLocked()
 }
 
 // SetStatusSync updates sync status with real-time transfer metrics (thread-safe).
@@ -128,7 +154,9 @@ func SetStatusSync(state string, progress int, message string, bytesCopied, tota
 		FCFirmwareVersion: prev.FCFirmwareVersion,
 		FCAPIVersion:      prev.FCAPIVersion,
 		Warning:           prev.Warning,
+		Timeline:          prev.Timeline,
 	}
+	publishLocked()
 }
 
 
@@ -137,10 +165,57 @@ type Orchestrator struct {
 	Config *config.Config
 	LED    *led.Controller
 	DryRun bool
+	// Timeline, if set, is marked at each stage and saved in the manifest.
+	Timeline *Timeline
+	// StartupTrace prints the timeline up to the first MSP byte to stderr.
+	StartupTrace bool
+
+	cpuBoost *power.Boost
+	thermal  *power.Monitor
+	recvGaps gapStats
+	sched    *msp.Scheduler // live FC queries from the web UI
+	// reservation holds the session's space in the ledger until it is
+	// preallocated or written.
+	reservation *storage.Reservation
+}
+
+// SyncLockName is the file in the storage root that a sync holds locked for
+// its whole run. Background jobs check it so they stay off the SD card while
+// a pilot is waiting.
+const SyncLockName = ".sync.lock"
+
+// SyncActive reports whether a sync process currently holds the sync lock.
+func SyncActive(storagePath string) bool {
+	return util.IsLocked(filepath.Join(storagePath, SyncLockName))
 }
 
 // Run opens the serial port and executes the 10-step sync workflow.
-func (o *Orchestrator) Run(portPath string) SyncResult {
+// Cancelling ctx (SIGTERM when the FC is unplugged) puts the CPU clock back
+// at once and makes further port I/O fail, so the sync unwinds through its
+// usual cleanup.
+func (o *Orchestrator) Run(ctx context.Context, portPath string) SyncResult {
+	if err := os.MkdirAll(o.Config.StoragePath, 0o755); err == nil {
+		if lock, err := util.LockFile(filepath.Join(o.Config.StoragePath, SyncLockName)); err == nil {
+			defer lock.Close()
+		} else {
+			slog.Warn("could not take sync lock", "error", err)
+		}
+	}
+
+	boost, err := power.BoostCPU(o.Config.SyncCPUGovernor, BoostStatePath(o.Config))
+	if err != nil {
+		slog.Warn("could not raise the CPU clock for this sync", "error", err)
+	}
+	o.cpuBoost = boost
+	defer o.restoreCPU()
+	stopInterrupt := context.AfterFunc(ctx, func() {
+		slog.Warn("sync interrupted")
+		o.restoreCPU()
+	})
+	defer stopInterrupt()
+	o.thermal = power.StartMonitor(thermalSampleInterval)
+	defer o.thermal.Stop()
+
 	defer func() {
 		if r := recover(); r != nil {
 			slog.Error("panic during sync", "error", r)
@@ -149,40 +224,54 @@ func (o *Orchestrator) Run(portPath string) SyncResult {
 		}
 	}()
 
-	result, err := o.run(portPath)
+	result, err := o.run(ctx, portPath)
 	if err != nil {
 		slog.Error("sync error", "error", err)
 		o.LED.SetState(led.Error)
 		SetStatus("error", 0, "Unexpected sync error. Check the service log for details.")
-		return ResultError
+		result = ResultError
 	}
+	if ctx.Err() != nil && result == ResultError {
+		SetStatus("error", 0, "Sync stopped: the flight controller was unplugged or the service was stopped.")
+	}
+	o.Timeline.Mark(StageDone)
+	o.Timeline.log()
+	setStatusTimeline(o.Timeline.Stages())
 	return result
 }
 
-func (o *Orchestrator) run(portPath string) (SyncResult, error) {
+func (o *Orchestrator) run(ctx context.Context, portPath string) (SyncResult, error) {
 	cfg := o.Config
 	totalStarted := time.Now()
 	timings := make(map[string]float64)
 
 	// --- Step 1: Open serial port ---
 	slog.Info("step 1: opening serial port", "port", portPath, "baud", cfg.SerialBaud)
-	port, err := goSerial.Open(portPath, &goSerial.Mode{
-		BaudRate: cfg.SerialBaud,
-		DataBits: 8,
-		StopBits: goSerial.OneStopBit,
-		Parity:   goSerial.NoParity,
-	})
+	SetStatus("identifying", 0, "Waiting for the flight controller to answer.")
+	readyStarted := time.Now()
+	port, attempts, err := waitForFC(ctx, portPath, cfg.SerialBaud, time.Duration(cfg.FCReadyTimeout*float64(time.Second)),
+		func() { o.Timeline.Mark(StageFirstByte) })
 	if err != nil {
 		o.LED.SetState(led.Error)
-		SetStatus("error", 0, fmt.Sprintf("Could not open serial port %s.", portPath))
+		SetStatus("error", 0, err.Error())
 		return ResultError, nil
 	}
+	port = cancelPort{SerialPort: port, ctx: ctx}
 	defer port.Close()
+	o.Timeline.Mark(StageFCReady)
+	if o.StartupTrace {
+		o.Timeline.WriteStartup(os.Stderr)
+	}
+	timings["ready_sec"] = secondsSince(readyStarted)
+	slog.Info("FC ready", "attempts", attempts, "sec", timings["ready_sec"])
 
 	timeout := time.Duration(cfg.SerialTimeout * float64(time.Second))
 	client := msp.NewClient(port, timeout)
 	defer client.Close()
 
+	// Storage work overlaps the handshake; step 4 joins it.
+	prep := startStoragePrep(cfg)
+
 	// --- Step 2: Identify FC ---
 	// Clear any FC identity from the previous session so the dashboard doesn't
 	// show stale version info while the new handshake is in progress.
@@ -192,6 +281,7 @@ func (o *Orchestrator) run(portPath string) (SyncResult, error) {
 	currentStatus.FCFirmwareVersion = ""
 	currentStatus.FCAPIVersion = ""
 	currentStatus.Warning = ""
+	currentStatus.Timeline = nil
 	statusMu.Unlock()
 	SetStatus("identifying", 0, "Checking the flight controller over MSP.")
 	identifyStarted := time.Now()
@@ -201,8 +291,19 @@ func (o *Orchestrator) run(portPath string) (SyncResult, error) {
 		return *result, nil
 	}
 	setFCIdentity(fcInfo) // publish FC identity + warning to dashboard
+	o.Timeline.Mark(StageIdentified)
 	timings["identify_sec"] = secondsSince(identifyStarted)
 
+	// From here on the web UI may query the FC; requests are slotted in
+	// between our own.
+	o.sched = msp.NewScheduler(client, fcQueryMSPTimeout)
+	if stop, err := startFCQueryServer(filepath.Join(cfg.RuntimeDir, FCQuerySocketName), o.sched); err != nil {
+		slog.Warn("live FC queries disabled", "error", err)
+	} else {
+		defer stop()
+	}
+	defer o.sched.Close()
+
 	// --- Step 3: Query flash state ---
 	slog.Info("step 3: querying flash state")
 	SetStatus("querying", 0, "Reading blackbox flash usage from the FC.")
@@ -212,26 +313,69 @@ func (o *Orchestrator) run(portPath string) (SyncResult, error) {
 	if result != nil {
 		return *result, nil
 	}
+	o.Timeline.Mark(StageFlashQueried)
 	timings["query_sec"] = secondsSince(queryStarted)
 
+	// Quick mode: copy only the last log, from start to the end of the used
+	// area.
+	var start uint32
+	if cfg.LastFlightOnly {
+		locateStarted := time.Now()
+		start, result = o.locateLastFlight(client, usedSize)
+		if result != nil {
+			return *result, nil
+		}
+		timings["locate_sec"] = secondsSince(locateStarted)
+	}
+	copySize := usedSize - start
+
+	// Tail-first needs offset writes, which only the directory layout has.
+	tailFirst := cfg.ReadOrder == ReadOrderTailFirst
+	if tailFirst && cfg.StorageLayout == storage.LayoutSegment {
+		slog.Warn("read_order=tail_first needs the directory storage layout — reading linearly")
+		tailFirst = false
+	}
+
+	// Ask for the first chunk right away: the FC reads its flash while the
+	// Pi finishes preparing storage.
+	first := span{start, usedSize}
+	if tailFirst {
+		first = tailStripes(start, usedSize)[0]
+	}
+	primed := sendFlashRead(client, first.from, first.to, uint16(cfg.FlashChunkSize), cfg.FlashReadCompression) == nil &&
+		client.Flush() == nil
+
 	// --- Step 4: Check Pi storage ---
 	slog.Info("step 4: checking Pi storage")
-	sessionDir, writer, result := o.checkStorageAndPrepare(fcInfo, usedSize)
+	storageStarted := time.Now()
+	store, sessionID, writer, result := o.checkStorageAndPrepare(prep, fcInfo, copySize)
 	if result != nil {
 		return *result, nil
 	}
+	defer o.reservation.Release()
+	o.Timeline.Mark(StageStorageReady)
+	timings["storage_sec"] = secondsSince(storageStarted)
 
 	// --- Step 6: Stream flash read ---
-	slog.Info("step 6: reading flash", "bytes", usedSize, "dir", sessionDir)
+	slog.Info("step 6: reading flash", "bytes", copySize, "from", start, "session", sessionID)
 	o.LED.SetState(led.Busy)
 	SetStatus("syncing", 0, "Copying blackbox flash to the Pi SD card.")
 	streamStarted := time.Now()
 
-	result = o.readFlash(client, writer, usedSize)
+	var covered []storage.Range
+	o.inRealtime(func() {
+		covered, result = o.readFlash(client, writer, start, usedSize, primed, tailFirst)
+	})
 	if result != nil {
+		if len(covered) > 0 {
+			o.keepInterrupted(store, sessionID, fcInfo, start, usedSize, covered, timings)
+		}
 		return *result, nil
 	}
+	o.Timeline.Mark(StageCopied)
 	timings["stream_sec"] = secondsSince(streamStarted)
+	o.recvGaps.record(timings)
+	cpu := power.Sample()
 
 	// --- Step 7: Verify integrity ---
 	slog.Info("step 7: verifying integrity")
@@ -239,23 +383,49 @@ func (o *Orchestrator) run(portPath string) (SyncResult, error) {
 	SetStatus("verifying", 0, "Verifying the copied file before erase.")
 	verifyStarted := time.Now()
 
-	fileSHA256, result := o.verifyIntegrity(writer, usedSize)
+	fileSHA256, result := o.verifyIntegrity(writer, copySize)
 	if result != nil {
 		return *result, nil
 	}
+	o.Timeline.Mark(StageVerified)
 	timings["verify_sec"] = secondsSince(verifyStarted)
 
 	// --- Step 8: Write manifest ---
 	slog.Info("step 8: writing manifest")
 	timings["total_sec"] = secondsSince(totalStarted)
+	o.Timeline.Mark(StageManifest)
+	o.Timeline.record(timings)
 	storageInfo := fcInfoToStorage(fcInfo)
-	if err := storage.WriteManifest(sessionDir, storageInfo, fileSHA256, int64(usedSize),
-		false, false, timings); err != nil {
+	manifest := storage.NewManifest(storageInfo, fileSHA256, int64(copySize), false, false, timings)
+	if cfg.LastFlightOnly {
+		manifest.Partial = &storage.ManifestPartial{
+			Mode:        "last_flight",
+			FlashOffset: int64(start),
+			FlashUsed:   int64(usedSize),
+		}
+	}
+	if cpu.CurKHz > 0 {
+		manifest.CPU = &storage.ManifestCPU{
+			Governor: cpu.Governor,
+			CurKHz:   cpu.CurKHz,
+			MinKHz:   cpu.MinKHz,
+			MaxKHz:   cpu.MaxKHz,
+		}
+	}
+	manifest.Throttle = o.throttleSummary()
+	manifest.Timeline = o.Timeline.Stages()
+	manifest.Card = writer.Profile().Sample()
+	if err := store.PutManifest(sessionID, manifest); err != nil {
 		slog.Warn("failed to write manifest", "error", err)
 		o.LED.SetState(led.Error)
 		SetStatus("error", 0, "Failed to write the session manifest.")
 		return ResultError, nil
 	}
+	slog.Info("SD card I/O", "MBps", manifest.Card.MBps, "write_p99_ms", manifest.Card.WriteP99MS,
+		"fsync_max_ms", manifest.Card.FsyncMaxMS)
+	if err := storage.RecordSync(store.Root(), writer.Profile()); err != nil {
+		slog.Warn("could not update SD card health", "error", err)
+	}
 
 	if o.DryRun {
 		slog.Info("DRY RUN — skipping erase")
@@ -264,6 +434,14 @@ func (o *Orchestrator) run(portPath string) (SyncResult, error) {
 		return ResultDryRun, nil
 	}
 
+	if cfg.LastFlightOnly {
+		// Erasing would lose the earlier logs that were not copied.
+		slog.Info("last-flight sync — skipping erase")
+		o.LED.SetState(led.Done)
+		SetStatus("idle", 0, "Last flight copied. The FC flash was kept; run a full sync to erase it.")
+		return ResultSuccess, nil
+	}
+
 	if !cfg.EraseAfterSync {
 		slog.Info("erase_after_sync=false — skipping erase")
 		o.LED.SetState(led.Done)
@@ -272,15 +450,24 @@ func (o *Orchestrator) run(portPath string) (SyncResult, error) {
 	}
 
 	// --- Step 9: Erase FC flash ---
+	// The erase wait is idle polling; drop back to the power-saving clock.
+	o.restoreCPU()
 	slog.Info("step 9: erasing FC flash")
 	o.LED.SetState(led.Busy)
 	SetStatus("erasing", 0, "Erasing the FC flash now that the copy is verified.")
 	eraseStarted := time.Now()
 
-	eraseOK := o.waitForErase(client)
+	eraseOK := o.waitForErase(ctx, client)
 	timings["erase_sec"] = secondsSince(eraseStarted)
 	timings["total_sec"] = secondsSince(totalStarted)
-	_ = storage.UpdateManifestErase(sessionDir, eraseOK, timings)
+	o.Timeline.Mark(StageErased)
+	_ = store.UpdateManifest(sessionID, func(m *storage.Manifest) {
+		m.EraseAttempted = true
+		m.EraseCompleted = eraseOK
+		m.Timing = timings
+		m.Throttle = o.throttleSummary()
+		m.Timeline = o.Timeline.Stages()
+	})
 
 	if !eraseOK {
 		slog.Warn("flash erase did not complete within timeout")
@@ -297,6 +484,64 @@ func (o *Orchestrator) run(portPath string) (SyncResult, error) {
 	return ResultSuccess, nil
 }
 
+// keepInterrupted writes a manifest for a tail-first copy that failed after
+// saving some stripes, so the newest flights stay listed and downloadable.
+// The FC flash is never erased in this case.
+func (o *Orchestrator) keepInterrupted(store storage.Store, sessionID string, fcInfo *fc.FCInfo, start, usedSize uint32, covered []storage.Range, timings map[string]float64) {
+	saved := storage.CoveredBytes(covered)
+	manifest := storage.NewManifest(fcInfoToStorage(fcInfo), "", saved, false, false, timings)
+	manifest.Partial = &storage.ManifestPartial{
+		Mode:        storage.PartialInterrupted,
+		FlashOffset: int64(start),
+		FlashUsed:   int64(usedSize),
+		Ranges:      covered,
+	}
+	manifest.Timeline = o.Timeline.Stages()
+	if err := store.PutManifest(sessionID, manifest); err != nil {
+		slog.Warn("failed to write manifest for the interrupted copy", "error", err)
+		return
+	}
+	slog.Warn("copy interrupted — kept the newest part of the flash", "saved_bytes", saved, "of", usedSize-start)
+	SetStatus("error", 0, fmt.Sprintf("Copy interrupted. The newest %.1f MB were saved; sync again for the rest.", float64(saved)/(1024*1024)))
+}
+
+// throttleSummary converts the thermal monitor's report for the manifest,
+// or returns nil if the Pi exposes neither temperature nor throttle flags.
+func (o *Orchestrator) throttleSummary() *storage.ManifestThrottle {
+	if o.thermal == nil {
+		return nil
+	}
+	r := o.thermal.Report()
+	if r.MaxTempC == 0 && r.SeenFlags == 0 {
+		return nil
+	}
+	t := &storage.ManifestThrottle{
+		MaxTempC:     r.MaxTempC,
+		UnderVoltage: r.SeenFlags&power.UnderVoltage != 0,
+		Throttled:    r.SeenFlags&(power.Throttled|power.FreqCapped|power.SoftTempLimit) != 0,
+	}
+	for _, ev := range r.Events {
+		t.Events = append(t.Events, storage.ManifestThrottleEvent{AtSec: ev.AtSec, Flags: ev.Flags, TempC: ev.TempC})
+	}
+	return t
+}
+
+// BoostStatePath is where a sync saves the clock settings its boost
+// replaced, or "" without a runtime directory.
+func BoostStatePath(cfg *config.Config) string {
+	if cfg.RuntimeDir == "" {
+		return ""
+	}
+	return filepath.Join(cfg.RuntimeDir, power.BoostStateName)
+}
+
+// restoreCPU undoes the sync clock boost; safe to call more than once.
+func (o *Orchestrator) restoreCPU() {
+	if err := o.cpuBoost.Restore(); err != nil {
+		slog.Warn("could not restore the CPU clock policy", "error", err)
+	}
+}
+
 // identifyFC performs the MSP handshake and returns FC info.
 // Returns (fcInfo, nil) on success or (nil, result) on failure.
 func (o *Orchestrator) identifyFC(client *msp.Client) (*fc.FCInfo, *SyncResult) {
@@ -363,200 +608,166 @@ func (o *Orchestrator) queryFlashState(client *msp.Client) (uint32, *SyncResult)
 	return summary.UsedSize, nil
 }
 
-// checkStorageAndPrepare validates free space, cleans up if needed, and creates
-// the session directory and stream writer (Steps 4–5).
-func (o *Orchestrator) checkStorageAndPrepare(fcInfo *fc.FCInfo, usedSize uint32) (string, *storage.StreamWriter, *SyncResult) {
+// checkStorageAndPrepare joins the storage preparation started during the
+// handshake, validates free space for usedSize bytes, cleans up if needed,
+// and creates the session and its stream writer (Steps 4–5).
+func (o *Orchestrator) checkStorageAndPrepare(prep *storagePrep, fcInfo *fc.FCInfo, usedSize uint32) (storage.Store, string, storage.SessionWriter, *SyncResult) {
 	cfg := o.Config
-	storagePath := cfg.StoragePath
-	if err := os.MkdirAll(storagePath, 0o755); err != nil {
-		slog.Error("failed to create storage dir", "error", err)
+	waited := prep.wait()
+	if prep.err != nil {
+		slog.Error("storage preparation failed", "layout", cfg.StorageLayout, "error", prep.err)
+		o.LED.SetState(led.Error)
+		SetStatus("error", 0, prep.message)
+		r := ResultError
+		return nil, "", nil, &r
+	}
+	store := prep.store
+
+	// Reserve the copy in the ledger rather than trusting statfs alone:
+	// another writer (a second FC's sync, a card check) may have been admitted
+	// against the same free space and not written it yet.
+	need, floor := int64(usedSize), int64(cfg.MinFreeSpaceMB)*1024*1024
+	slog.Info("storage check", "requiredMB", float64(need+floor)/(1024*1024), "availableMB", prep.availableMB,
+		"prep_wait_ms", waited.Milliseconds())
+	res, err := prep.ledger.Reserve(need, floor, "sync")
+	var short *storage.SpaceError
+	if errors.As(err, &short) && cfg.StoragePressureCleanup {
+		// The web process's reclaim job normally keeps this headroom between
+		// syncs; deleting here is the fallback for a larger-than-ever flash.
+		slog.Warn("headroom below need, cleaning up during sync",
+			"availableMB", short.Available/(1024*1024), "reservedMB", short.Reserved/(1024*1024))
+		SetStatus("querying", 0, "Storage is tight, cleaning up the oldest sessions first.")
+		deleted, cleanErr := store.CleanupOldestSessions(short.Need+short.Reserved, RetentionPolicy(cfg))
+		if cleanErr != nil {
+			slog.Warn("storage cleanup error", "error", cleanErr)
+		}
+		if len(deleted) > 0 {
+			slog.Info("reclaimed storage", "deleted_sessions", len(deleted))
+		}
+		res, err = prep.ledger.Reserve(need, floor, "sync")
+	}
+	if errors.As(err, &short) {
+		slog.Error("insufficient Pi storage",
+			"availableMB", short.Available/(1024*1024), "requiredMB", short.Need/(1024*1024),
+			"reservedMB", short.Reserved/(1024*1024))
 		o.LED.SetState(led.Error)
-		SetStatus("error", 0, "Could not create the storage directory.")
+		SetStatus("error", 0, "Not enough free space on the Pi SD card to copy this log safely.")
 		r := ResultError
-		return "", nil, &r
+		return nil, "", nil, &r
 	}
-
-	requiredMB := float64(usedSize)/(1024*1024) + float64(cfg.MinFreeSpaceMB)
-	availableMB, err := util.FreeMB(storagePath)
 	if err != nil {
-		slog.Error("failed to check free space", "error", err)
+		slog.Error("could not reserve storage space", "error", err)
 		o.LED.SetState(led.Error)
 		SetStatus("error", 0, "Could not check available storage space.")
 		r := ResultError
-		return "", nil, &r
-	}
-	slog.Info("storage check", "requiredMB", requiredMB, "availableMB", availableMB)
-
-	if availableMB < requiredMB {
-		if cfg.StoragePressureCleanup {
-			SetStatus("querying", 0, "Storage is tight, cleaning up the oldest sessions first.")
-			requiredBytes := int64(requiredMB * 1024 * 1024)
-			deleted, cleanErr := storage.CleanupOldestSessions(storagePath, requiredBytes)
-			if cleanErr != nil {
-				slog.Warn("storage cleanup error", "error", cleanErr)
-			}
-			if len(deleted) > 0 {
-				slog.Info("reclaimed storage", "deleted_sessions", len(deleted))
-			}
-			availableMB, _ = util.FreeMB(storagePath)
-			slog.Info("storage after cleanup", "availableMB", availableMB)
-		}
-		if availableMB < requiredMB {
-			slog.Error("insufficient Pi storage",
-				"availableMB", availableMB, "requiredMB", requiredMB)
-			o.LED.SetState(led.Error)
-			SetStatus("error", 0, "Not enough free space on the Pi SD card to copy this log safely.")
-			r := ResultError
-			return "", nil, &r
-		}
+		return nil, "", nil, &r
 	}
+	o.reservation = res
 
 	// --- Step 5: Prepare output ---
-	slog.Info("step 5: preparing output directory")
+	slog.Info("step 5: preparing output", "layout", cfg.StorageLayout)
 	storageInfo := fcInfoToStorage(fcInfo)
-	sessionDir, err := storage.MakeSessionDir(storagePath, storageInfo)
+	sessionID, writer, err := store.Create(storageInfo)
 	if err != nil {
-		slog.Error("failed to create session dir", "error", err)
+		slog.Error("failed to create session", "error", err)
+		_ = res.Release()
 		o.LED.SetState(led.Error)
-		SetStatus("error", 0, "Could not create the output directory.")
+		SetStatus("error", 0, "Could not open the output file for writing.")
 		r := ResultError
-		return "", nil, &r
+		return nil, "", nil, &r
+	}
+	// Once preallocated the space shows up in statfs and the reservation is
+	// no longer needed; otherwise it is held until the copy is done.
+	if err := writer.Preallocate(int64(usedSize)); err != nil {
+		slog.Debug("could not preallocate session file", "error", err)
+	} else {
+		_ = res.Release()
+	}
+
+	return store, sessionID, writer, nil
+}
+
+// sendFlashRead requests the chunk at addr, clipped to the end of the used
+// area.
+func sendFlashRead(client *msp.Client, addr, usedSize uint32, chunkSize uint16, compression bool) error {
+	size := chunkSize
+	if remaining := usedSize - addr; remaining < uint32(size) {
+		size = uint16(remaining)
 	}
+	return client.SendFlashReadRequest(addr, size, compression)
+}
 
-	bblPath := filepath.Join(sessionDir, storage.RawFlashFilename)
-	writer, err := storage.NewStreamWriter(bblPath)
+// locateLastFlight finds where the last log starts for a quick sync.
+func (o *Orchestrator) locateLastFlight(client *msp.Client, usedSize uint32) (uint32, *SyncResult) {
+	SetStatus("querying", 0, "Looking for the start of the last flight.")
+	read := clientFlashReader(client, usedSize, uint16(o.Config.FlashChunkSize))
+	start, probes, err := findLastLog(read, usedSize)
 	if err != nil {
-		slog.Error("failed to create stream writer", "error", err)
+		slog.Error("could not locate the last flight", "probes", probes, "error", err)
 		o.LED.SetState(led.Error)
-		SetStatus("error", 0, "Could not open the output file for writing.")
+		SetStatus("error", 0, "Could not find the last flight in the FC flash. Try a full sync.")
 		r := ResultError
-		return "", nil, &r
+		return 0, &r
 	}
-
-	return sessionDir, writer, nil
+	slog.Info("last flight located", "start", fmt.Sprintf("0x%08x", start),
+		"bytes", usedSize-start, "of", usedSize, "probes", probes)
+	return start, nil
 }
 
-// readFlash streams flash data from the FC using pipelined reads (Step 6).
-func (o *Orchestrator) readFlash(client *msp.Client, writer *storage.StreamWriter, usedSize uint32) *SyncResult {
-	cfg := o.Config
-	var address uint32
-	consecutiveErrors := 0
-	chunkSize := uint16(cfg.FlashChunkSize)
-	compression := cfg.FlashReadCompression
-	syncStart := time.Now()
-
-	defer func() {
-		if r := recover(); r != nil {
-			slog.Error("panic during flash read", "error", r)
+// readFlash streams flash bytes [start, usedSize) from the FC using
+// pipelined reads (Step 6). primed means the first request has already been
+// sent: for start, or for the newest stripe when tailFirst is set and the
+// writer supports it. If a tail-first copy fails after some stripes were
+// committed, the writer is closed instead of aborted and the saved ranges
+// are returned with the error result.
+func (o *Orchestrator) readFlash(client *msp.Client, writer storage.SessionWriter, start, usedSize uint32, primed, tailFirst bool) (covered []storage.Range, result *SyncResult) {
+	c := o.newFlashCopier(client, usedSize-start)
+
+	fail := func(msg string) (*SyncResult, bool) {
+		kept := len(covered) > 0
+		if kept {
+			kept = writer.Close() == nil
+		}
+		if !kept {
 			_ = writer.Abort()
-			o.LED.SetState(led.Error)
-			SetStatus("error", 0, "Unexpected error while copying flash data.")
 		}
-	}()
-
-	// Send first request (prime the pipeline).
-	firstChunkSize := chunkSize
-	if remaining := usedSize - address; uint16(remaining) < firstChunkSize {
-		firstChunkSize = uint16(remaining)
-	}
-	if err := client.SendFlashReadRequest(address, firstChunkSize, compression); err != nil {
-		slog.Error("failed to send initial flash read request", "error", err)
-		_ = writer.Abort()
 		o.LED.SetState(led.Error)
-		SetStatus("error", 0, "Could not start reading flash data from the FC.")
+		SetStatus("error", 0, msg)
 		r := ResultError
-		return &r
+		return &r, kept
 	}
 
-	for address < usedSize {
-		chunkAddr, data, err := client.ReceiveFlashReadResponse()
-		if err != nil {
-			consecutiveErrors++
-			slog.Warn("flash read error", "address", fmt.Sprintf("0x%08x", address),
-				"attempt", consecutiveErrors, "maxAttempts", maxConsecutiveErrors, "error", err)
-			if consecutiveErrors >= maxConsecutiveErrors {
-				slog.Error("too many consecutive read errors — aborting")
-				_ = writer.Abort()
-				o.LED.SetState(led.Error)
-				SetStatus("error", 0, "Too many FC read errors. Try another USB cable and sync again.")
-				r := ResultError
-				return &r
-			}
-			time.Sleep(10 * time.Millisecond)
-			// Re-send the same request on error.
-			retrySize := chunkSize
-			if remaining := usedSize - address; uint16(remaining) < retrySize {
-				retrySize = uint16(remaining)
-			}
-			_ = client.SendFlashReadRequest(address, retrySize, compression)
-			continue
-		}
-
-		if chunkAddr != address {
-			slog.Warn("address mismatch — retrying", "expected", fmt.Sprintf("0x%08x", address), "got", fmt.Sprintf("0x%08x", chunkAddr))
-			consecutiveErrors++
-			if consecutiveErrors >= maxConsecutiveErrors {
-				slog.Error("too many address mismatches — aborting")
-				_ = writer.Abort()
-				o.LED.SetState(led.Error)
-				SetStatus("error", 0, "The FC returned inconsistent data. Reconnect and try again.")
-				r := ResultError
-				return &r
-			}
-			retrySize := chunkSize
-			if remaining := usedSize - address; uint16(remaining) < retrySize {
-				retrySize = uint16(remaining)
-			}
-			_ = client.SendFlashReadRequest(address, retrySize, compression)
-			continue
-		}
-
-		if len(data) == 0 {
-			slog.Info("FC returned 0 bytes — end of data", "address", fmt.Sprintf("0x%08x", address))
-			break
-		}
-
-		consecutiveErrors = 0
-
-		// Pipeline: send next request BEFORE processing current data.
-		nextAddr := address + uint32(len(data))
-		if nextAddr < usedSize {
-			nextChunkSize := chunkSize
-			if remaining := usedSize - nextAddr; uint16(remaining) < nextChunkSize {
-				nextChunkSize = uint16(remaining)
+	defer func() {
+		if r := recover(); r != nil {
+			slog.Error("panic during flash read", "error", r)
+			var kept bool
+			result, kept = fail("Unexpected error while copying flash data.")
+			if !kept {
+				covered = nil
 			}
-			_ = client.SendFlashReadRequest(nextAddr, nextChunkSize, compression)
 		}
+	}()
 
-		if _, err := writer.Write(data); err != nil {
-			slog.Error("failed to write flash data", "error", err)
-			_ = writer.Abort()
-			o.LED.SetState(led.Error)
-			SetStatus("error", 0, "Failed to write data to the output file.")
-			r := ResultError
-			return &r
-		}
-		address = nextAddr
-
-		progress := int(address * 100 / usedSize)
-
-		// Compute real-time transfer speed and ETA.
-		elapsed := time.Since(syncStart).Seconds()
-		var speedBPS float64
-		var etaSec int
-		if elapsed > 0 {
-			speedBPS = float64(address) / elapsed
-			if speedBPS > 0 {
-				etaSec = int(float64(usedSize-address) / speedBPS)
-			}
+	var err error
+	if ow, ok := writer.(storage.OffsetWriter); tailFirst && ok {
+		slog.Info("reading flash tail first", "stripe", tailStripeSize)
+		err = c.copyTailFirst(ow, start, usedSize, primed, &covered)
+	} else {
+		_, err = c.copyRange(span{start, usedSize}, span{}, primed, func(_ uint32, data []byte) error {
+			_, err := writer.Write(data)
+			return err
+		})
+	}
+	if err != nil {
+		msg := "Unexpected error while copying flash data."
+		if ce, ok := err.(*copyError); ok {
+			msg = ce.msg
 		}
-		SetStatusSync("syncing", progress, "Copying blackbox flash to the Pi SD card.",
-			address, usedSize, speedBPS, etaSec)
-
-		if address%(uint32(chunkSize)*64) < uint32(chunkSize) {
-			slog.Debug("flash read progress", "address", fmt.Sprintf("0x%08x", address),
-				"total", fmt.Sprintf("0x%08x", usedSize), "percent", progress)
+		r, kept := fail(msg)
+		if !kept {
+			covered = nil
 		}
+		return covered, r
 	}
 
 	if err := writer.Close(); err != nil {
@@ -564,15 +775,15 @@ func (o *Orchestrator) readFlash(client *msp.Client, writer *storage.StreamWrite
 		o.LED.SetState(led.Error)
 		SetStatus("error", 0, "Failed to finalize the output file.")
 		r := ResultError
-		return &r
+		return nil, &r
 	}
 
 	slog.Info("flash read complete", "bytes_written", writer.BytesWritten())
-	return nil
+	return nil, nil
 }
 
 // verifyIntegrity checks file size and SHA-256 (Step 7).
-func (o *Orchestrator) verifyIntegrity(writer *storage.StreamWriter, usedSize uint32) (string, *SyncResult) {
+func (o *Orchestrator) verifyIntegrity(writer storage.SessionWriter, usedSize uint32) (string, *SyncResult) {
 	if writer.BytesWritten() != int64(usedSize) {
 		slog.Warn("size mismatch", "written", writer.BytesWritten(), "expected", usedSize)
 		o.LED.SetState(led.Error)
@@ -602,15 +813,15 @@ func (o *Orchestrator) verifyIntegrity(writer *storage.StreamWriter, usedSize ui
 }
 
 // waitForErase sends the erase command and polls until flash is empty or timeout.
-func (o *Orchestrator) waitForErase(client *msp.Client) bool {
+func (o *Orchestrator) waitForErase(ctx context.Context, client *msp.Client) bool {
 	if err := client.EraseFlash(); err != nil {
 		slog.Error("failed to send erase command", "error", err)
 		return false
 	}
 
 	deadline := time.Now().Add(time.Duration(o.Config.EraseTimeoutSec) * time.Second)
-	for time.Now().Before(deadline) {
-		time.Sleep(erasePollInterval)
+	for time.Now().Before(deadline) && ctx.Err() == nil {
+		o.sched.Wait(erasePollInterval)
 		summary, err := client.GetDataflashSummary()
 		if err != nil {
 			slog.Warn("error polling flash summary during erase", "error", err)
@@ -635,6 +846,15 @@ func AutoDetectPort() string {
 	return matches[0]
 }
 
+// RetentionPolicy builds the storage retention policy from the config.
+func RetentionPolicy(cfg *config.Config) storage.RetentionPolicy {
+	return storage.RetentionPolicy{
+		KeepLastPerFC:    cfg.RetentionKeepLastPerFC,
+		FCQuotaBytes:     int64(cfg.RetentionFCQuotaMB) * 1024 * 1024,
+		PreferDownloaded: cfg.RetentionPreferDownloaded,
+	}
+}
+
 // fcInfoToStorage converts fc.FCInfo to storage.FCInfo to avoid circular imports.
 func fcInfoToStorage(info *fc.FCInfo) *storage.FCInfo {
 	return &storage.FCInfo{
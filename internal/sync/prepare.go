@@ -0,0 +1,60 @@
+package sync
+
+import (
+	"os"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/config"
+	"github.com/proeugene/logfalcon/internal/storage"
+)
+
+// storagePrep is the part of steps 4–5 that does not depend on the FC:
+// creating the storage directory, opening the session store and the space
+// ledger, and measuring free space. It starts as soon as the serial port is open and runs while
+// the MSP handshake is in flight; checkStorageAndPrepare joins it once the
+// used flash size is known.
+type storagePrep struct {
+	done        chan struct{}
+	store       storage.Store
+	ledger      *storage.Ledger
+	availableMB float64 // free minus other writers' reservations
+	err         error
+	message     string // dashboard message when err is set
+}
+
+func startStoragePrep(cfg *config.Config) *storagePrep {
+	p := &storagePrep{done: make(chan struct{})}
+	go func() {
+		defer close(p.done)
+		p.run(cfg)
+	}()
+	return p
+}
+
+func (p *storagePrep) run(cfg *config.Config) {
+	if err := os.MkdirAll(cfg.StoragePath, 0o755); err != nil {
+		p.err, p.message = err, "Could not create the storage directory."
+		return
+	}
+	store, err := storage.OpenStore(cfg.StorageLayout, cfg.StoragePath)
+	if err != nil {
+		p.err, p.message = err, "Could not open the session store on the Pi SD card."
+		return
+	}
+	p.store = store
+	p.ledger = storage.OpenLedger(cfg.RuntimeDir, cfg.StoragePath)
+	available, err := p.ledger.Available()
+	if err != nil {
+		p.err, p.message = err, "Could not check available storage space."
+		return
+	}
+	p.availableMB = float64(available) / (1024 * 1024)
+}
+
+// wait blocks until the preparation has finished and returns how long it
+// had to be waited for.
+func (p *storagePrep) wait() time.Duration {
+	started := time.Now()
+	<-p.done
+	return time.Since(started)
+}
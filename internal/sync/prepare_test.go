@@ -0,0 +1,40 @@
+package sync
+
+import (
+	"os"
+	"path/filepath"
+	"testing"
+
+	"github.com/proeugene/logfalcon/internal/config"
+)
+
+func TestStoragePrep(t *testing.T) {
+	cfg := config.Default()
+	cfg.StoragePath = filepath.Join(t.TempDir(), "logs")
+	cfg.RuntimeDir = filepath.Join(t.TempDir(), "run")
+	p := startStoragePrep(cfg)
+	p.wait()
+	if p.err != nil {
+		t.Fatalf("prep failed: %v", p.err)
+	}
+	if p.store == nil || p.ledger == nil || p.availableMB <= 0 {
+		t.Fatalf("store=%v ledger=%v availableMB=%v, want an open store, a ledger and free space", p.store, p.ledger, p.availableMB)
+	}
+	if _, err := os.Stat(cfg.StoragePath); err != nil {
+		t.Fatalf("storage dir not created: %v", err)
+	}
+}
+
+func TestStoragePrepError(t *testing.T) {
+	file := filepath.Join(t.TempDir(), "file")
+	if err := os.WriteFile(file, nil, 0o644); err != nil {
+		t.Fatal(err)
+	}
+	cfg := config.Default()
+	cfg.StoragePath = filepath.Join(file, "logs") // parent is not a directory
+	p := startStoragePrep(cfg)
+	p.wait()
+	if p.err == nil || p.message != "Could not create the storage directory." {
+		t.Fatalf("err=%v message=%q, want a directory error", p.err, p.message)
+	}
+}
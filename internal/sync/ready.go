@@ -0,0 +1,161 @@
+package sync
+
+import (
+	"context"
+	"errors"
+	"fmt"
+	"log/slog"
+	"time"
+
+	goSerial "go.bug.st/serial"
+
+	"github.com/proeugene/logfalcon/internal/msp"
+)
+
+const (
+	// readyAttemptTimeout is how long one MSP_API_VERSION probe waits for an
+	// answer; a booted FC replies within a few milliseconds.
+	readyAttemptTimeout = 250 * time.Millisecond
+	// Backoff between probes, doubling from min to max.
+	readyBackoffMin = 50 * time.Millisecond
+	readyBackoffMax = 500 * time.Millisecond
+	// serialReadTimeout bounds each port read so MSP receive deadlines hold
+	// even when the FC sends nothing.
+	serialReadTimeout = 100 * time.Millisecond
+)
+
+// openPort opens the FC serial port, or connects to a network MSP bridge
+// for tcp:// and udp:// paths; replaceable in tests.
+var openPort = func(path string, baud int) (msp.SerialPort, error) {
+	if msp.IsNetworkPort(path) {
+		return msp.DialNetwork(path, serialReadTimeout)
+	}
+	port, err := goSerial.Open(path, &goSerial.Mode{
+		BaudRate: baud,
+		DataBits: 8,
+		StopBits: goSerial.OneStopBit,
+		Parity:   goSerial.NoParity,
+	})
+	if err != nil {
+		return nil, err
+	}
+	if err := port.SetReadTimeout(serialReadTimeout); err != nil {
+		port.Close()
+		return nil, err
+	}
+	return port, nil
+}
+
+// errInterrupted is returned by port I/O once the sync is cancelled.
+var errInterrupted = errors.New("Sync stopped before it finished.")
+
+// cancelPort fails every read and write once ctx is done, so a cancelled
+// sync gives up within one read timeout instead of retrying a port that is
+// going away.
+type cancelPort struct {
+	msp.SerialPort
+	ctx context.Context
+}
+
+func (p cancelPort) Read(buf []byte) (int, error) {
+	if p.ctx.Err() != nil {
+		return 0, errInterrupted
+	}
+	return p.SerialPort.Read(buf)
+}
+
+func (p cancelPort) Write(data []byte) (int, error) {
+	if p.ctx.Err() != nil {
+		return 0, errInterrupted
+	}
+	return p.SerialPort.Write(data)
+}
+
+// Flush passes through to a batching port, such as a network bridge.
+func (p cancelPort) Flush() error {
+	if f, ok := p.SerialPort.(msp.Flusher); ok {
+		return f.Flush()
+	}
+	return nil
+}
+
+// firstByteReader calls fn the first time a read returns data.
+type firstByteReader struct {
+	msp.SerialPort
+	fn   func()
+	seen bool
+}
+
+func (r *firstByteReader) Read(buf []byte) (int, error) {
+	n, err := r.SerialPort.Read(buf)
+	if n > 0 && !r.seen {
+		r.seen = true
+		r.fn()
+	}
+	return n, err
+}
+
+// waitForFC opens portPath as soon as it can and probes the FC with
+// MSP_API_VERSION until it answers, instead of sleeping for a fixed time
+// after the USB device appears. A port that fails mid-probe (the FC
+// re-enumerated) is closed and reopened. firstByte, if set, is called when
+// the FC first sends anything. The returned error is suitable for the
+// dashboard.
+func waitForFC(ctx context.Context, portPath string, baud int, deadline time.Duration, firstByte func()) (msp.SerialPort, int, error) {
+	started := time.Now()
+	backoff := readyBackoffMin
+	var (
+		port    msp.SerialPort
+		client  *msp.Client
+		lastErr error
+		opened  bool
+	)
+	for attempt := 1; ; attempt++ {
+		if port == nil {
+			if p, err := openPort(portPath, baud); err != nil {
+				lastErr = err
+			} else {
+				port, opened = p, true
+				var probed msp.SerialPort = port
+				if firstByte != nil {
+					probed = &firstByteReader{SerialPort: port, fn: firstByte}
+				}
+				client = msp.NewClient(probed, readyAttemptTimeout)
+			}
+		}
+		if port != nil {
+			_, _, err := client.GetAPIVersion()
+			if err == nil {
+				return port, attempt, nil
+			}
+			lastErr = err
+			var timeout *msp.TimeoutError
+			if !errors.As(err, &timeout) {
+				port.Close()
+				port = nil
+			}
+		}
+
+		if time.Since(started)+backoff > deadline {
+			if port != nil {
+				port.Close()
+			}
+			slog.Error("FC not ready", "port", portPath, "attempts", attempt, "error", lastErr)
+			if !opened {
+				return nil, attempt, fmt.Errorf("Could not open serial port %s.", portPath)
+			}
+			return nil, attempt, fmt.Errorf("The flight controller on %s did not answer within %.0f s. Re-plug it to try again.", portPath, deadline.Seconds())
+		}
+		select {
+		case <-ctx.Done():
+			if port != nil {
+				port.Close()
+			}
+			return nil, attempt, errInterrupted
+		case <-time.After(backoff):
+		}
+		if backoff *= 2; backoff > readyBackoffMax {
+			backoff = readyBackoffMax
+		}
+	}
+}
@@ -0,0 +1,123 @@
+package sync
+
+import (
+	"bytes"
+	"context"
+	"errors"
+	"strings"
+	gosync "sync"
+	"testing"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/msp"
+)
+
+// bootingFC ignores the first `silent` MSP requests, like an FC that is
+// still starting up after being plugged in, then answers MSP_API_VERSION.
+type bootingFC struct {
+	mu       gosync.Mutex
+	silent   int
+	requests int
+	out      bytes.Buffer
+}
+
+func (f *bootingFC) Write(data []byte) (int, error) {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	f.requests++
+	if f.requests > f.silent {
+		payload := []byte{0, 1, 46}
+		body := append([]byte{byte(len(payload)), msp.MSPAPIVersion}, payload...)
+		f.out.Write([]byte("$M>"))
+		f.out.Write(body)
+		f.out.WriteByte(msp.CRC8Xor(body))
+	}
+	return len(data), nil
+}
+
+func (f *bootingFC) Read(buf []byte) (int, error) {
+	f.mu.Lock()
+	defer f.mu.Unlock()
+	if f.out.Len() == 0 {
+		f.mu.Unlock()
+		time.Sleep(time.Millisecond) // serial read timeout
+		f.mu.Lock()
+		return 0, nil
+	}
+	return f.out.Read(buf)
+}
+
+func (f *bootingFC) Close() error { return nil }
+
+func stubOpenPort(t *testing.T, open func(path string, baud int) (msp.SerialPort, error)) {
+	t.Helper()
+	orig := openPort
+	openPort = open
+	t.Cleanup(func() { openPort = orig })
+}
+
+func TestWaitForFCRetriesUntilAnswer(t *testing.T) {
+	fc := &bootingFC{silent: 2}
+	opens := 0
+	stubOpenPort(t, func(string, int) (msp.SerialPort, error) {
+		if opens++; opens < 3 {
+			return nil, errors.New("no such device") // still enumerating
+		}
+		return fc, nil
+	})
+
+	gotByte := false
+	port, attempts, err := waitForFC(context.Background(), "/dev/ttyACM0", 115200, 5*time.Second, func() { gotByte = true })
+	if err != nil {
+		t.Fatalf("waitForFC: %v", err)
+	}
+	if port != fc {
+		t.Error("waitForFC should return the probed port")
+	}
+	// Two failed opens, two unanswered probes, then the answer.
+	if attempts != 5 {
+		t.Errorf("attempts = %d, want 5", attempts)
+	}
+	if !gotByte {
+		t.Error("first byte callback not called")
+	}
+}
+
+func TestWaitForFCDeadline(t *testing.T) {
+	stubOpenPort(t, func(string, int) (msp.SerialPort, error) { return &bootingFC{silent: 1 << 30}, nil })
+	started := time.Now()
+	_, _, err := waitForFC(context.Background(), "/dev/ttyACM0", 115200, 600*time.Millisecond, nil)
+	if err == nil || !strings.Contains(err.Error(), "did not answer") {
+		t.Fatalf("err = %v, want a did-not-answer error", err)
+	}
+	if elapsed := time.Since(started); elapsed > 2*time.Second {
+		t.Errorf("gave up after %v, want close to the deadline", elapsed)
+	}
+
+	stubOpenPort(t, func(string, int) (msp.SerialPort, error) { return nil, errors.New("permission denied") })
+	if _, _, err := waitForFC(context.Background(), "/dev/ttyACM0", 115200, 200*time.Millisecond, nil); err == nil || !strings.Contains(err.Error(), "Could not open") {
+		t.Fatalf("err = %v, want an open error", err)
+	}
+}
+
+func TestWaitForFCCancelled(t *testing.T) {
+	fc := &bootingFC{silent: 1 << 30}
+	stubOpenPort(t, func(string, int) (msp.SerialPort, error) { return fc, nil })
+	ctx, cancel := context.WithTimeout(context.Background(), 300*time.Millisecond)
+	defer cancel()
+	started := time.Now()
+	if _, _, err := waitForFC(ctx, "/dev/ttyACM0", 115200, time.Minute, nil); !errors.Is(err, errInterrupted) {
+		t.Fatalf("err = %v, want errInterrupted", err)
+	}
+	if elapsed := time.Since(started); elapsed > 2*time.Second {
+		t.Errorf("gave up after %v, want soon after the cancel", elapsed)
+	}
+
+	port := cancelPort{SerialPort: fc, ctx: ctx}
+	if _, err := port.Write([]byte{'$'}); !errors.Is(err, errInterrupted) {
+		t.Errorf("Write after cancel = %v, want errInterrupted", err)
+	}
+	if _, err := port.Read(make([]byte, 8)); !errors.Is(err, errInterrupted) {
+		t.Errorf("Read after cancel = %v, want errInterrupted", err)
+	}
+}
@@ -0,0 +1,143 @@
+package sync
+
+import (
+	"errors"
+	"log/slog"
+	"math"
+	"runtime"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+// singleCoreNice is used instead of SCHED_FIFO on single-core Pis, where a
+// real-time thread busy with SD writes could starve hostapd and the web
+// server outright.
+const singleCoreNice = -10
+
+// inRealtime runs fn on its own OS thread set up by enterRealtime. It uses a
+// fresh goroutine so that, if the thread's scheduling cannot be put back,
+// the goroutine can exit still locked to it and the runtime discards the
+// thread instead of reusing it. A panic in fn is re-raised in the caller.
+func (o *Orchestrator) inRealtime(fn func()) {
+	done := make(chan any, 1)
+	go func() {
+		leave := o.enterRealtime()
+		defer func() {
+			r := recover()
+			leave()
+			done <- r
+		}()
+		fn()
+	}()
+	if r := <-done; r != nil {
+		panic(r)
+	}
+}
+
+// enterRealtime locks the calling goroutine to its OS thread for the flash
+// receive loop: pinned to cfg.SerialCPU and scheduled SCHED_FIFO at
+// cfg.SerialRTPriority, so hostapd, dnsmasq and the web server cannot
+// insert scheduling gaps into the MSP pipeline. The returned func undoes it,
+// restoring the affinity the thread had before; if any part cannot be
+// undone it leaves the thread locked, so only a goroutine that exits
+// afterwards should call it (see inRealtime). Each part is best effort;
+// failures are logged and the sync carries on.
+func (o *Orchestrator) enterRealtime() func() {
+	cfg := o.Config
+	if cfg.SerialRTPriority <= 0 && cfg.SerialCPU < 0 {
+		return func() {}
+	}
+	runtime.LockOSThread()
+	ncpu := runtime.NumCPU()
+
+	// The process mask may already exclude cores (AvoidCPU), so restore
+	// exactly what the thread had rather than every CPU.
+	var saved util.CPUMask
+	pinned := false
+	if cfg.SerialCPU >= 0 {
+		var err error
+		if cfg.SerialCPU >= ncpu || ncpu == 1 {
+			slog.Warn("serial_cpu ignored: no spare core", "cpu", cfg.SerialCPU, "cpus", ncpu)
+		} else if saved, err = util.ThreadAffinity(); err != nil {
+			slog.Warn("could not read the serial loop's CPU affinity", "error", err)
+		} else if err := util.PinThread(cfg.SerialCPU); err != nil {
+			slog.Warn("could not pin the serial loop", "cpu", cfg.SerialCPU, "error", err)
+		} else {
+			pinned = true
+		}
+	}
+
+	realtime, niced := false, false
+	if cfg.SerialRTPriority > 0 {
+		if ncpu == 1 {
+			niced = util.SetThreadNice(singleCoreNice) == nil
+		} else if err := util.SetThreadRealtime(cfg.SerialRTPriority); err != nil {
+			slog.Warn("could not raise the serial loop to SCHED_FIFO", "priority", cfg.SerialRTPriority, "error", err)
+			niced = util.SetThreadNice(singleCoreNice) == nil
+		} else {
+			realtime = true
+		}
+	}
+	slog.Info("serial loop scheduling", "pinned_cpu", pinned, "sched_fifo", realtime, "niced", niced)
+
+	return func() {
+		var errs []error
+		if realtime {
+			errs = append(errs, util.SetThreadNormal())
+		}
+		if niced {
+			errs = append(errs, util.SetThreadNice(0))
+		}
+		if pinned {
+			errs = append(errs, util.SetThreadAffinity(saved))
+		}
+		if err := errors.Join(errs...); err != nil {
+			// Keep the thread locked: returning it to the scheduler would
+			// run other goroutines with the serial loop's scheduling.
+			slog.Warn("could not restore the serial loop's thread; discarding it", "error", err)
+			return
+		}
+		runtime.UnlockOSThread()
+	}
+}
+
+// gapStats measures the time between consecutive flash chunks arriving,
+// which is where scheduler jitter shows up as pipeline bubbles.
+type gapStats struct {
+	last  time.Time
+	n     int
+	mean  float64 // ms
+	m2    float64 // sum of squared deviations (Welford)
+	maxMs float64
+}
+
+// observe records a chunk arrival.
+func (g *gapStats) observe(now time.Time) {
+	if !g.last.IsZero() {
+		ms := float64(now.Sub(g.last)) / float64(time.Millisecond)
+		g.n++
+		d := ms - g.mean
+		g.mean += d / float64(g.n)
+		g.m2 += d * (ms - g.mean)
+		if ms > g.maxMs {
+			g.maxMs = ms
+		}
+	}
+	g.last = now
+}
+
+// record adds the gap mean, maximum and standard deviation (the jitter) to
+// the manifest timings.
+func (g *gapStats) record(timings map[string]float64) {
+	if g.n == 0 {
+		return
+	}
+	timings["recv_gap_mean_ms"] = round3(g.mean)
+	timings["recv_gap_max_ms"] = round3(g.maxMs)
+	timings["recv_gap_jitter_ms"] = round3(math.Sqrt(g.m2 / float64(g.n)))
+}
+
+func round3(v float64) float64 {
+	return math.Round(v*1000) / 1000
+}
@@ -0,0 +1,44 @@
+package sync
+
+import (
+	"runtime"
+	"testing"
+
+	"github.com/proeugene/logfalcon/internal/config"
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+func TestEnterRealtimeRestoresNarrowedAffinity(t *testing.T) {
+	if runtime.NumCPU() < 3 {
+		t.Skip("needs three CPUs")
+	}
+	runtime.LockOSThread()
+	defer runtime.UnlockOSThread()
+	before, err := util.ThreadAffinity()
+	if err != nil {
+		t.Skipf("sched_getaffinity: %v", err)
+	}
+	// Like the web process after AvoidCPU: CPU 0 is off limits.
+	narrowed := before
+	narrowed[0] &^= 1
+	if err := util.SetThreadAffinity(narrowed); err != nil {
+		t.Skipf("sched_setaffinity: %v", err)
+	}
+	defer util.SetThreadAffinity(before)
+
+	o := &Orchestrator{Config: &config.Config{SerialCPU: 1}}
+	o.enterRealtime()()
+	if got, _ := util.ThreadAffinity(); got != narrowed {
+		t.Errorf("affinity after leaving = %x, want the narrowed %x", got[0], narrowed[0])
+	}
+}
+
+func TestInRealtimeReraisesPanics(t *testing.T) {
+	o := &Orchestrator{Config: &config.Config{SerialCPU: 0}}
+	defer func() {
+		if r := recover(); r != "boom" {
+			t.Errorf("recovered %v, want the copy loop's panic", r)
+		}
+	}()
+	o.inRealtime(func() { panic("boom") })
+}
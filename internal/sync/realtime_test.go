@@ -0,0 +1,29 @@
+package sync
+
+import (
+	"testing"
+	"time"
+)
+
+func TestGapStats(t *testing.T) {
+	var g gapStats
+	start := time.Unix(0, 0)
+	for _, gapMs := range []int{0, 10, 10, 10, 30} {
+		start = start.Add(time.Duration(gapMs) * time.Millisecond)
+		g.observe(start)
+	}
+	timings := map[string]float64{}
+	g.record(timings)
+	if timings["recv_gap_mean_ms"] != 15 || timings["recv_gap_max_ms"] != 30 {
+		t.Errorf("timings = %v, want mean 15 and max 30", timings)
+	}
+	if j := timings["recv_gap_jitter_ms"]; j < 8.6 || j > 8.7 {
+		t.Errorf("jitter = %v, want ~8.66", j)
+	}
+
+	empty := map[string]float64{}
+	(&gapStats{}).record(empty)
+	if len(empty) != 0 {
+		t.Errorf("no chunks should record nothing, got %v", empty)
+	}
+}
@@ -0,0 +1,121 @@
+package sync
+
+import (
+	"encoding/json"
+	"log/slog"
+	"os"
+	"path/filepath"
+	"time"
+)
+
+// StatusFileName is the file in the runtime directory through which the sync
+// process shares its status with the web process.
+const StatusFileName = "status.json"
+
+// statusPublishInterval limits how often progress-only updates are written;
+// state changes are always written at once.
+const statusPublishInterval = 250 * time.Millisecond
+
+// Cross-process status sharing, guarded by statusMu.
+var (
+	publishPath   string
+	lastPublished time.Time
+	lastState     string
+
+	followPath    string
+	followActive  func() bool
+	followModTime time.Time
+	followSize    int64
+)
+
+// PublishStatus makes every status change in this process visible to other
+// processes through path (normally on tmpfs, e.g. /run/logfalcon/status.json).
+func PublishStatus(path string) {
+	statusMu.Lock()
+	defer statusMu.Unlock()
+	if err := os.MkdirAll(filepath.Dir(path), 0o755); err != nil {
+		slog.Warn("status publishing disabled", "error", err)
+		return
+	}
+	publishPath = path
+	lastState = ""
+	publishLocked()
+}
+
+// FollowStatus makes GetStatus reflect the status published at path by a
+// sync process. active reports whether that process is still running; an
+// in-progress status left behind by a killed sync (e.g. the FC was unplugged)
+// is shown as an error instead of sticking forever.
+func FollowStatus(path string, active func() bool) {
+	statusMu.Lock()
+	defer statusMu.Unlock()
+	followPath = path
+	followActive = active
+	followModTime = time.Time{}
+}
+
+// publishLocked writes currentStatus to publishPath. Callers hold statusMu.
+func publishLocked() {
+	if publishPath == "" {
+		return
+	}
+	now := time.Now()
+	if currentStatus.State == lastState && now.Sub(lastPublished) < statusPublishInterval {
+		return
+	}
+	data, err := json.Marshal(currentStatus)
+	if err != nil {
+		return
+	}
+	tmp := publishPath + ".tmp"
+	if err := os.WriteFile(tmp, data, 0o644); err != nil {
+		slog.Debug("publishing status", "error", err)
+		return
+	}
+	if err := os.Rename(tmp, publishPath); err != nil {
+		slog.Debug("publishing status", "error", err)
+		return
+	}
+	lastPublished = now
+	lastState = currentStatus.State
+}
+
+// refreshFollowed reloads the followed status file if it changed.
+func refreshFollowed() {
+	statusMu.Lock()
+	defer statusMu.Unlock()
+	if followPath == "" {
+		return
+	}
+	defer markAbandonedLocked()
+	info, err := os.Stat(followPath)
+	if err != nil || (info.ModTime().Equal(followModTime) && info.Size() == followSize) {
+		return
+	}
+	data, err := os.ReadFile(followPath)
+	if err != nil {
+		return
+	}
+	var st Status
+	if err := json.Unmarshal(data, &st); err != nil {
+		return
+	}
+	currentStatus = st
+	followModTime = info.ModTime()
+	followSize = info.Size()
+}
+
+// markAbandonedLocked turns an in-progress followed status into an error once
+// the sync process is gone. Callers hold statusMu.
+func markAbandonedLocked() {
+	switch currentStatus.State {
+	case "", "idle", "error":
+		return
+	}
+	if followActive == nil || followActive() {
+		return
+	}
+	currentStatus.State = "error"
+	currentStatus.Progress = 0
+	currentStatus.Message = "Sync stopped before finishing. Reconnect the FC to try again."
+}
@@ -0,0 +1,36 @@
+package sync
+
+import (
+	"path/filepath"
+	"testing"
+)
+
+// resetStatusSharing undoes PublishStatus/FollowStatus for later tests.
+func resetStatusSharing() {
+	statusMu.Lock()
+	defer statusMu.Unlock()
+	publishPath, followPath, followActive = "", "", nil
+}
+
+func TestPublishAndFollowStatus(t *testing.T) {
+	t.Cleanup(resetStatusSharing)
+	path := filepath.Join(t.TempDir(), "run", StatusFileName)
+
+	PublishStatus(path)
+	SetStatus("erasing", 0, "Erasing the FC flash now that the copy is verified.")
+	resetStatusSharing()
+
+	// Simulate the web process: local state differs until the file is read.
+	SetStatus("idle", 0, "Ready for the next sync.")
+	active := true
+	FollowStatus(path, func() bool { return active })
+	if got := GetStatus(); got.State != "erasing" {
+		t.Fatalf("followed State = %q, want erasing", got.State)
+	}
+
+	// The sync process was killed mid-erase.
+	active = false
+	if got := GetStatus(); got.State != "error" {
+		t.Fatalf("State after sync process exit = %q, want error", got.State)
+	}
+}
@@ -0,0 +1,169 @@
+package sync
+
+import (
+	"fmt"
+	"io"
+	"log/slog"
+	"sort"
+	"strings"
+	"sync"
+	"time"
+
+	"github.com/proeugene/logfalcon/internal/storage"
+	"github.com/proeugene/logfalcon/internal/util"
+)
+
+// Timeline stages, in the order a sync normally reaches them.
+const (
+	StageDeviceAdded  = "device_added"  // udev initialised the FC's tty
+	StageProcessStart = "process_start" // systemd exec'd the sync binary
+	StageConfigLoaded = "config_loaded"
+	StageLEDOn        = "led_busy" // first LED feedback for the pilot
+	StageFirstByte    = "first_msp_byte"
+	StageFCReady      = "fc_ready" // FC answered the readiness probe
+	StageIdentified   = "identified"
+	StageFlashQueried = "flash_queried"
+	StageStorageReady = "storage_ready" // session open for writing
+	StageCopied       = "copied"
+	StageVerified     = "verified"
+	StageManifest     = "manifest"
+	StageErased       = "erased"
+	StageDone         = "done" // result LED shown
+)
+
+// Timeline records when each stage of a sync was reached on the monotonic
+// clock, starting from events before the process existed (udev, exec). A nil
+// Timeline records nothing.
+type Timeline struct {
+	mu      sync.Mutex
+	created time.Time
+	base    time.Duration // monotonic clock at created; 0 if unavailable
+	marks   map[string]time.Duration
+}
+
+// NewTimeline starts a timeline and marks the process start. Call it first
+// thing in main.
+func NewTimeline() *Timeline {
+	t := &Timeline{created: time.Now(), marks: make(map[string]time.Duration)}
+	if mono, ok := util.MonotonicNow(); ok {
+		t.base = mono
+		if start, ok := util.ProcessStart(); ok {
+			t.marks[StageProcessStart] = start
+		}
+	}
+	return t
+}
+
+// Mark records that stage was reached now. Repeated marks keep the first.
+func (t *Timeline) Mark(stage string) {
+	if t == nil {
+		return
+	}
+	now := t.base + time.Since(t.created)
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	if _, ok := t.marks[stage]; !ok {
+		t.marks[stage] = now
+	}
+}
+
+// DeviceAdded marks when udev set up the device node at portPath.
+func (t *Timeline) DeviceAdded(portPath string) {
+	if t == nil || t.base == 0 {
+		return
+	}
+	if at, ok := util.DeviceAdded(portPath); ok {
+		t.mu.Lock()
+		t.marks[StageDeviceAdded] = at
+		t.mu.Unlock()
+	}
+}
+
+// Stages returns the marks in time order, relative to the earliest one.
+func (t *Timeline) Stages() []storage.ManifestStage {
+	if t == nil {
+		return nil
+	}
+	t.mu.Lock()
+	defer t.mu.Unlock()
+	if len(t.marks) == 0 {
+		return nil
+	}
+	origin := time.Duration(-1)
+	for _, at := range t.marks {
+		if origin < 0 || at < origin {
+			origin = at
+		}
+	}
+	out := make([]storage.ManifestStage, 0, len(t.marks))
+	for stage, at := range t.marks {
+		out = append(out, storage.ManifestStage{Stage: stage, AtMS: float64((at - origin).Microseconds()) / 1000})
+	}
+	sort.SliceStable(out, func(a, b int) bool {
+		if out[a].AtMS != out[b].AtMS {
+			return out[a].AtMS < out[b].AtMS
+		}
+		return out[a].Stage < out[b].Stage
+	})
+	return out
+}
+
+// since returns seconds from the timeline's first mark to stage.
+func (t *Timeline) since(stage string) (float64, bool) {
+	for _, s := range t.Stages() {
+		if s.Stage == stage {
+			return s.AtMS / 1000, true
+		}
+	}
+	return 0, false
+}
+
+// record adds the pilot-facing latencies to timings.
+func (t *Timeline) record(timings map[string]float64) {
+	if sec, ok := t.since(StageLEDOn); ok {
+		timings["plug_to_led_sec"] = sec
+	}
+	if sec, ok := t.since(StageStorageReady); ok {
+		timings["plug_to_copy_sec"] = sec
+	}
+}
+
+// log writes the timeline as one line with each stage's delta to the
+// previous one, e.g. "device_added=+0s process_start=+412ms ...".
+func (t *Timeline) log() {
+	stages := t.Stages()
+	if len(stages) == 0 {
+		return
+	}
+	var b strings.Builder
+	prev := 0.0
+	for i, s := range stages {
+		if i > 0 {
+			b.WriteByte(' ')
+		}
+		b.WriteString(s.Stage)
+		b.WriteString("=+")
+		b.WriteString(time.Duration((s.AtMS - prev) * float64(time.Millisecond)).Round(time.Millisecond).String())
+		prev = s.AtMS
+	}
+	slog.Info("sync timeline", "stages", b.String(), "total_ms", stages[len(stages)-1].AtMS)
+}
+
+// WriteStartup prints each stage up to the first MSP byte in milliseconds
+// since exec, for --startup-trace. Stages before exec (udev) are negative.
+func (t *Timeline) WriteStartup(w io.Writer) {
+	stages := t.Stages()
+	origin := 0.0
+	for _, s := range stages {
+		if s.Stage == StageProcessStart {
+			origin = s.AtMS
+		}
+	}
+	fmt.Fprintln(w, "startup trace (ms since exec; exec time has 10 ms resolution):")
+	for _, s := range stages {
+		fmt.Fprintf(w, "%10.1f  %s\n", s.AtMS-origin, s.Stage)
+		if s.Stage == StageFirstByte {
+			break
+		}
+	}
+}
@@ -0,0 +1,47 @@
+package sync
+
+import (
+	"testing"
+	"time"
+)
+
+func TestTimelineStagesRelativeToPlugIn(t *testing.T) {
+	tl := &Timeline{created: time.Now(), base: 10 * time.Second, marks: map[string]time.Duration{
+		StageProcessStart: 9*time.Second + 400*time.Millisecond,
+		StageDeviceAdded:  9 * time.Second,
+	}}
+	tl.Mark(StageLEDOn)
+	tl.Mark(StageLEDOn) // the first mark wins
+
+	stages := tl.Stages()
+	if len(stages) != 3 {
+		t.Fatalf("stages = %+v, want 3", stages)
+	}
+	want := []string{StageDeviceAdded, StageProcessStart, StageLEDOn}
+	for i, s := range stages {
+		if s.Stage != want[i] {
+			t.Fatalf("stage %d = %s, want %s (%+v)", i, s.Stage, want[i], stages)
+		}
+	}
+	if stages[0].AtMS != 0 || stages[1].AtMS != 400 {
+		t.Errorf("offsets = %v, %v ms, want 0 and 400", stages[0].AtMS, stages[1].AtMS)
+	}
+	if stages[2].AtMS < 1000 || stages[2].AtMS > 2000 {
+		t.Errorf("led_busy at %v ms, want about 1000", stages[2].AtMS)
+	}
+
+	timings := map[string]float64{}
+	tl.record(timings)
+	if sec := timings["plug_to_led_sec"]; sec < 1 || sec > 2 {
+		t.Errorf("plug_to_led_sec = %v, want about 1", sec)
+	}
+}
+
+func TestNilTimeline(t *testing.T) {
+	var tl *Timeline
+	tl.Mark(StageDone)
+	tl.DeviceAdded("/dev/ttyACM0")
+	if tl.Stages() != nil {
+		t.Error("a nil timeline should have no stages")
+	}
+}
@@ -0,0 +1,82 @@
+package util
+
+import (
+	"bufio"
+	"fmt"
+	"os"
+	"strconv"
+	"strings"
+	"syscall"
+	"time"
+	"unsafe"
+)
+
+const (
+	clockMonotonic = 1
+	// clockTicks is USER_HZ, the unit of /proc/<pid>/stat times; 100 on
+	// every Linux architecture the Pi runs.
+	clockTicks = 100
+)
+
+// udevDataDir holds udev's device database.
+var udevDataDir = "/run/udev/data"
+
+// MonotonicNow returns CLOCK_MONOTONIC, the clock udev and systemd stamp
+// events with, so in-process marks can be placed on the same time line.
+func MonotonicNow() (time.Duration, bool) {
+	var ts syscall.Timespec
+	_, _, errno := syscall.RawSyscall(syscall.SYS_CLOCK_GETTIME, clockMonotonic, uintptr(unsafe.Pointer(&ts)), 0)
+	if errno != 0 {
+		return 0, false
+	}
+	return time.Duration(ts.Nano()), true
+}
+
+// ProcessStart returns when this process was exec'd, with 10 ms resolution.
+// The kernel counts it on the boot clock, which equals the monotonic clock
+// on a Pi since it never suspends.
+func ProcessStart() (time.Duration, bool) {
+	data, err := os.ReadFile("/proc/self/stat")
+	if err != nil {
+		return 0, false
+	}
+	// The command name may contain spaces; fields resume after its ')'.
+	s := string(data)
+	fields := strings.Fields(s[strings.LastIndexByte(s, ')')+1:])
+	if len(fields) < 20 {
+		return 0, false
+	}
+	ticks, err := strconv.ParseInt(fields[19], 10, 64) // field 22, starttime
+	if err != nil {
+		return 0, false
+	}
+	return time.Duration(ticks) * time.Second / clockTicks, true
+}
+
+// DeviceAdded returns when udev finished initialising the device node at
+// path (its USEC_INITIALIZED), on the monotonic clock.
+func DeviceAdded(path string) (time.Duration, bool) {
+	var st syscall.Stat_t
+	if err := syscall.Stat(path, &st); err != nil {
+		return 0, false
+	}
+	rdev := uint64(st.Rdev)
+	major := (rdev>>8)&0xfff | (rdev>>32)&^0xfff
+	minor := rdev&0xff | (rdev>>12)&^0xff
+	f, err := os.Open(fmt.Sprintf("%s/c%d:%d", udevDataDir, major, minor))
+	if err != nil {
+		return 0, false
+	}
+	defer f.Close()
+	sc := bufio.NewScanner(f)
+	for sc.Scan() {
+		if usec, ok := strings.CutPrefix(sc.Text(), "I:"); ok {
+			v, err := strconv.ParseInt(usec, 10, 64)
+			if err != nil || v <= 0 {
+				return 0, false
+			}
+			return time.Duration(v) * time.Microsecond, true
+		}
+	}
+	return 0, false
+}
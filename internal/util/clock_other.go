@@ -0,0 +1,11 @@
+//go:build !linux
+
+package util
+
+import "time"
+
+// Boot-relative timestamps are only available on Linux.
+
+func MonotonicNow() (time.Duration, bool)           { return 0, false }
+func ProcessStart() (time.Duration, bool)           { return 0, false }
+func DeviceAdded(path string) (time.Duration, bool) { return 0, false }
@@ -0,0 +1,20 @@
+package util
+
+import (
+	"errors"
+	"os"
+	"syscall"
+)
+
+// OpenDirect opens path for reading around the page cache (O_DIRECT), so
+// reads come from the storage device. Reads must use 4 KiB-aligned
+// buffers, offsets and sizes. Filesystems without O_DIRECT support (tmpfs)
+// get a normal, cached open; direct reports which one it was.
+func OpenDirect(path string) (f *os.File, direct bool, err error) {
+	f, err = os.OpenFile(path, os.O_RDONLY|syscall.O_DIRECT, 0)
+	if errors.Is(err, syscall.EINVAL) {
+		f, err = os.Open(path)
+		return f, false, err
+	}
+	return f, err == nil, err
+}
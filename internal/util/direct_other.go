@@ -0,0 +1,11 @@
+//go:build !linux
+
+package util
+
+import "os"
+
+// OpenDirect opens path normally outside Linux; reads may be cached.
+func OpenDirect(path string) (*os.File, bool, error) {
+	f, err := os.Open(path)
+	return f, false, err
+}
@@ -0,0 +1,21 @@
+package util
+
+import (
+	"os"
+	"syscall"
+)
+
+// fallocKeepSize is FALLOC_FL_KEEP_SIZE: allocate blocks without changing
+// the file size.
+const fallocKeepSize = 0x01
+
+// Preallocate reserves size bytes of disk space for f starting at offset,
+// so a long sequential write gets contiguous extents and cannot run out of
+// space halfway. The file size is left alone; unused blocks are released
+// when the file is truncated.
+func Preallocate(f *os.File, offset, size int64) error {
+	if size <= 0 {
+		return nil
+	}
+	return syscall.Fallocate(int(f.Fd()), fallocKeepSize, offset, size)
+}
@@ -0,0 +1,11 @@
+//go:build !linux
+
+package util
+
+import (
+	"errors"
+	"os"
+)
+
+// Preallocate is not supported outside Linux; callers carry on without it.
+func Preallocate(f *os.File, offset, size int64) error { return errors.ErrUnsupported }
@@ -0,0 +1,22 @@
+package util
+
+import "syscall"
+
+const (
+	ioprioWhoProcess = 1
+	ioprioClassIdle  = 3
+	ioprioClassShift = 13
+)
+
+// SetIdleIOPriority moves the calling OS thread to the idle I/O scheduling
+// class so its disk traffic only runs when nothing else wants the SD card.
+// Linux tracks I/O priority per thread: callers must hold
+// runtime.LockOSThread for as long as the priority should apply.
+func SetIdleIOPriority() error {
+	_, _, errno := syscall.Syscall(syscall.SYS_IOPRIO_SET,
+		ioprioWhoProcess, 0, ioprioClassIdle<<ioprioClassShift)
+	if errno != 0 {
+		return errno
+	}
+	return nil
+}
@@ -0,0 +1,6 @@
+//go:build !linux
+
+package util
+
+// SetIdleIOPriority is a no-op outside Linux.
+func SetIdleIOPriority() error { return nil }
@@ -0,0 +1,57 @@
+package util
+
+import (
+	"errors"
+	"fmt"
+	"os"
+	"syscall"
+)
+
+// ErrLocked is returned by TryLockFile when another process holds the lock.
+var ErrLocked = errors.New("lock held by another process")
+
+// LockFile takes an exclusive flock on path, creating it if needed, and waits
+// for any other holder. Closing the returned file releases the lock.
+func LockFile(path string) (*os.File, error) {
+	return lockFile(path, syscall.LOCK_EX)
+}
+
+// TryLockFile is LockFile without waiting: it returns ErrLocked at once if
+// the lock is held elsewhere.
+func TryLockFile(path string) (*os.File, error) {
+	return lockFile(path, syscall.LOCK_EX|syscall.LOCK_NB)
+}
+
+// IsLocked reports whether another process currently holds the lock on path.
+func IsLocked(path string) bool {
+	f, err := TryLockFile(path)
+	if err != nil {
+		return errors.Is(err, ErrLocked)
+	}
+	_ = f.Close()
+	return false
+}
+
+func lockFile(path string, how int) (*os.File, error) {
+	f, err := os.OpenFile(path, os.O_RDWR|os.O_CREATE, 0o644)
+	if err != nil {
+		return nil, fmt.Errorf("open lock: %w", err)
+	}
+	if err := syscall.Flock(int(f.Fd()), how); err != nil {
+		_ = f.Close()
+		if errors.Is(err, syscall.EWOULDBLOCK) {
+			return nil, ErrLocked
+		}
+		return nil, fmt.Errorf("flock: %w", err)
+	}
+	return f, nil
+}
+
+// ProcessAlive reports whether a process with pid exists.
+func ProcessAlive(pid int) bool {
+	if pid <= 0 {
+		return false
+	}
+	err := syscall.Kill(pid, 0)
+	return err == nil || errors.Is(err, syscall.EPERM)
+}
@@ -0,0 +1,39 @@
+package util
+
+import (
+	"path/filepath"
+	"syscall"
+)
+
+// IsMountPoint reports whether path is the root of a mounted filesystem, i.e.
+// it lives on a different device than its parent directory.
+func IsMountPoint(path string) (bool, error) {
+	var self, parent syscall.Stat_t
+	if err := syscall.Stat(path, &self); err != nil {
+		return false, err
+	}
+	if err := syscall.Stat(filepath.Join(path, ".."), &parent); err != nil {
+		return false, err
+	}
+	return self.Dev != parent.Dev || self.Ino == parent.Ino, nil
+}
+
+// statfs(2) magic numbers of filesystems without holes.
+const (
+	msdosSuperMagic = 0x4d44
+	exfatSuperMagic = 0x2011bab0
+)
+
+// SupportsSparseFiles reports whether the filesystem holding path stores
+// unwritten parts of a file as holes. FAT and exFAT zero-fill them instead.
+func SupportsSparseFiles(path string) (bool, error) {
+	var st syscall.Statfs_t
+	if err := syscall.Statfs(path, &st); err != nil {
+		return false, err
+	}
+	switch int64(st.Type) {
+	case msdosSuperMagic, exfatSuperMagic:
+		return false, nil
+	}
+	return true, nil
+}
@@ -0,0 +1,112 @@
+package util
+
+import (
+	"os"
+	"strconv"
+	"syscall"
+	"unsafe"
+)
+
+const (
+	schedOther = 0
+	schedFIFO  = 1
+)
+
+// CPUMask is a thread's CPU affinity; it mirrors the kernel's default
+// cpu_set_t (1024 CPUs).
+type CPUMask [16]uint64
+
+func (s *CPUMask) set(cpu int) { s[cpu/64] |= 1 << (uint(cpu) % 64) }
+
+func setAffinity(tid int, set *CPUMask) error {
+	_, _, errno := syscall.RawSyscall(syscall.SYS_SCHED_SETAFFINITY,
+		uintptr(tid), unsafe.Sizeof(*set), uintptr(unsafe.Pointer(set)))
+	if errno != 0 {
+		return errno
+	}
+	return nil
+}
+
+// PinThread restricts the calling OS thread to cpu. Callers must hold
+// runtime.LockOSThread.
+func PinThread(cpu int) error {
+	var set CPUMask
+	set.set(cpu)
+	return setAffinity(0, &set)
+}
+
+// ThreadAffinity returns the calling OS thread's CPU affinity, so it can be
+// put back with SetThreadAffinity after PinThread. Callers must hold
+// runtime.LockOSThread.
+func ThreadAffinity() (CPUMask, error) {
+	var set CPUMask
+	_, _, errno := syscall.RawSyscall(syscall.SYS_SCHED_GETAFFINITY,
+		0, unsafe.Sizeof(set), uintptr(unsafe.Pointer(&set)))
+	if errno != 0 {
+		return set, errno
+	}
+	return set, nil
+}
+
+// SetThreadAffinity restores an affinity saved by ThreadAffinity.
+func SetThreadAffinity(set CPUMask) error {
+	return setAffinity(0, &set)
+}
+
+// AvoidCPU moves every thread of this process off cpu, leaving it to a
+// process that pins itself there. New threads inherit the mask from the
+// thread that creates them, so call it early.
+func AvoidCPU(cpu, n int) error {
+	var set CPUMask
+	for c := 0; c < n; c++ {
+		if c != cpu {
+			set.set(c)
+		}
+	}
+	tasks, err := os.ReadDir("/proc/self/task")
+	if err != nil {
+		return err
+	}
+	for _, t := range tasks {
+		tid, err := strconv.Atoi(t.Name())
+		if err != nil {
+			continue
+		}
+		if err := setAffinity(tid, &set); err != nil {
+			return err
+		}
+	}
+	return nil
+}
+
+type schedParam struct {
+	priority int32
+}
+
+func setScheduler(policy, priority int) error {
+	p := schedParam{priority: int32(priority)}
+	_, _, errno := syscall.RawSyscall(syscall.SYS_SCHED_SETSCHEDULER,
+		0, uintptr(policy), uintptr(unsafe.Pointer(&p)))
+	if errno != 0 {
+		return errno
+	}
+	return nil
+}
+
+// SetThreadRealtime gives the calling OS thread SCHED_FIFO at priority
+// (1-99). It needs CAP_SYS_NICE or a matching RLIMIT_RTPRIO. Callers must
+// hold runtime.LockOSThread.
+func SetThreadRealtime(priority int) error {
+	return setScheduler(schedFIFO, priority)
+}
+
+// SetThreadNormal returns the calling OS thread to SCHED_OTHER.
+func SetThreadNormal() error {
+	return setScheduler(schedOther, 0)
+}
+
+// SetThreadNice sets the nice level of the calling OS thread; Linux applies
+// PRIO_PROCESS with who=0 to the calling thread only.
+func SetThreadNice(nice int) error {
+	return syscall.Setpriority(syscall.PRIO_PROCESS, 0, nice)
+}
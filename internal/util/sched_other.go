@@ -0,0 +1,16 @@
+//go:build !linux
+
+package util
+
+// Scheduling controls are no-ops outside Linux.
+
+// CPUMask is a thread's CPU affinity.
+type CPUMask struct{}
+
+func PinThread(cpu int) error          { return nil }
+func ThreadAffinity() (CPUMask, error) { return CPUMask{}, nil }
+func SetThreadAffinity(CPUMask) error  { return nil }
+func AvoidCPU(cpu, n int) error        { return nil }
+func SetThreadRealtime(prio int) error { return nil }
+func SetThreadNormal() error           { return nil }
+func SetThreadNice(nice int) error     { return nil }
@@ -0,0 +1,86 @@
+package web
+
+import (
+	"embed"
+	"net/http"
+	"path"
+	"strconv"
+	"strings"
+)
+
+//go:generate go run gen_assets.go
+
+// assetFS holds the built assets: each file under its content-hashed name,
+// with .gz and, if brotli was available at build time, .br variants. Pages
+// link them by hash, so browsers may cache them forever and never
+// revalidate; compression happened at build time.
+//
+//go:embed assets/dist
+var assetFS embed.FS
+
+// assetHashed is the set of served names, so only built assets are found.
+var assetHashed = func() map[string]bool {
+	m := make(map[string]bool, len(assetNames))
+	for _, hashed := range assetNames {
+		m[hashed] = true
+	}
+	return m
+}()
+
+var assetTypes = map[string]string{
+	".css": "text/css; charset=utf-8",
+	".js":  "text/javascript; charset=utf-8",
+}
+
+// assetURL returns the URL of the built asset for a source file in assets/.
+func assetURL(name string) string {
+	return "/static/" + assetNames[name]
+}
+
+// handleAsset serves a built asset, picking the best precompressed variant
+// the client accepts.
+func (s *Server) handleAsset(w http.ResponseWriter, r *http.Request) {
+	name := strings.TrimPrefix(r.URL.Path, "/static/")
+	if !assetHashed[name] {
+		s.sendError(w, r, http.StatusNotFound, "")
+		return
+	}
+	file := "assets/dist/" + name
+	data, err := assetFS.ReadFile(file)
+	if err != nil {
+		s.sendError(w, r, http.StatusNotFound, "")
+		return
+	}
+	h := w.Header()
+	h.Set("Content-Type", assetTypes[path.Ext(name)])
+	h.Set("Cache-Control", "public, max-age=31536000, immutable")
+	h.Set("Vary", "Accept-Encoding")
+	for _, v := range []struct{ coding, ext string }{{"br", ".br"}, {"gzip", ".gz"}} {
+		if !acceptsEncoding(r.Header.Get("Accept-Encoding"), v.coding) {
+			continue
+		}
+		if packed, err := assetFS.ReadFile(file + v.ext); err == nil {
+			h.Set("Content-Encoding", v.coding)
+			data = packed
+			break
+		}
+	}
+	h.Set("Content-Length", strconv.Itoa(len(data)))
+	if r.Method == http.MethodHead {
+		return
+	}
+	_, _ = w.Write(data)
+}
+
+// acceptsEncoding reports whether an Accept-Encoding header allows coding.
+func acceptsEncoding(header, coding string) bool {
+	for _, part := range strings.Split(header, ",") {
+		name, params, _ := strings.Cut(strings.TrimSpace(part), ";")
+		if !strings.EqualFold(strings.TrimSpace(name), coding) {
+			continue
+		}
+		q := strings.ReplaceAll(params, " ", "")
+		return q != "q=0" && q != "q=0.0" && q != "q=0.00" && q != "q=0.000"
+	}
+	return false
+}
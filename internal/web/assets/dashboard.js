@@ -0,0 +1,269 @@
+function fmtBytes(b) {
+  if (b >= 1048576) return (b / 1048576).toFixed(1) + ' MB';
+  if (b >= 1024) return (b / 1024).toFixed(0) + ' KB';
+  return b + ' B';
+}
+function fmtSpeed(bps) {
+  if (bps >= 1048576) return (bps / 1048576).toFixed(1) + ' MB/s';
+  if (bps >= 1024) return (bps / 1024).toFixed(0) + ' KB/s';
+  return Math.round(bps) + ' B/s';
+}
+function fmtMS(ms) {
+  if (ms >= 1000) return (ms / 1000).toFixed(1) + ' s';
+  return Math.round(ms) + ' ms';
+}
+function fmtETA(sec) {
+  if (sec <= 0) return '';
+  if (sec >= 60) return '~' + Math.ceil(sec / 60) + 'm remaining';
+  return '~' + sec + 's remaining';
+}
+
+// Live status arrives over /events: a full snapshot on connect, then only
+// the fields that changed. Polling /status is the fallback when the
+// stream cannot be used.
+const status = {};
+
+function renderStatus(data) {
+  const badge = document.getElementById('status-badge');
+  const detail = document.getElementById('status-detail');
+  const state = data.state || 'idle';
+  const progress = data.progress || 0;
+  const labels = {
+    idle: 'Idle',
+    identifying: 'Finding FC\u2026',
+    querying: 'Reading flash\u2026',
+    syncing: 'Syncing\u2026',
+    verifying: 'Verifying\u2026',
+    erasing: 'Erasing\u2026',
+    error: 'Error'
+  };
+  detail.textContent = data.message || 'Ready for the next sync.';
+  badge.textContent = (labels[state] || state) +
+    (state === 'syncing' && progress > 0 ? ' ' + progress + '%' : '');
+  badge.className = '';
+  if (state === 'syncing') badge.classList.add('syncing');
+  else if (state === 'identifying') badge.classList.add('identifying');
+  else if (state === 'querying') badge.classList.add('querying');
+  else if (state === 'erasing') badge.classList.add('erasing');
+  else if (state === 'verifying') badge.classList.add('verifying');
+  else if (state === 'error') badge.classList.add('error');
+
+  const progressContainer = document.getElementById('sync-progress-container');
+  const progressFill = document.getElementById('progress-fill');
+  const progressLabel = document.getElementById('sync-progress-label');
+  const progressMeta = document.getElementById('sync-progress-meta');
+  if (state === 'syncing') {
+    progressContainer.style.display = 'block';
+    progressFill.style.width = progress + '%';
+    const copied = data.bytes_copied || 0;
+    const total = data.total_bytes || 0;
+    const speed = data.speed_bps || 0;
+    const eta = data.eta_sec || 0;
+    progressLabel.textContent = 'Syncing flash\u2026 ' + progress + '%' +
+      (total > 0 ? '  (' + fmtBytes(copied) + ' / ' + fmtBytes(total) + ')' : '');
+    const parts = [];
+    if (speed > 0) parts.push(fmtSpeed(speed));
+    if (eta > 0) parts.push(fmtETA(eta));
+    progressMeta.textContent = parts.join('  \u00b7  ');
+  } else {
+    progressContainer.style.display = 'none';
+    if (progressMeta) progressMeta.textContent = '';
+  }
+
+  const shutBanner = document.getElementById('idle-shutdown-banner');
+  const shutText = document.getElementById('idle-shutdown-text');
+  const shutMin = data.idle_shutdown_minutes || 0;
+  const shutSec = data.idle_shutdown_remaining_sec;
+  if (shutMin > 0 && shutSec != null) {
+    const m = Math.floor(shutSec / 60);
+    const s = shutSec % 60;
+    shutText.textContent = '\u23fb Auto-shutdown in ' + m + ' min ' + s + ' sec \u2014 activity resets timer';
+    shutBanner.style.display = 'block';
+    if (shutSec < 60) {
+      shutBanner.style.background = '#2a0a0a';
+      shutBanner.style.borderBottomColor = '#6a1a1a';
+      shutText.style.color = '#e04040';
+    } else {
+      shutBanner.style.background = '#1a1400';
+      shutBanner.style.borderBottomColor = '#4a3a00';
+      shutText.style.color = '#d4a017';
+    }
+  } else {
+    shutBanner.style.display = 'none';
+  }
+
+  // FC identity line — shown once handshake completes.
+  const fcIdentity = document.getElementById('fc-identity');
+  const fcIdentityText = document.getElementById('fc-identity-text');
+  if (data.fc_variant) {
+    let fc = data.fc_variant;
+    if (data.fc_firmware_version) fc += ' ' + data.fc_firmware_version;
+    if (data.fc_api_version) fc += '  (API ' + data.fc_api_version + ')';
+    fcIdentityText.textContent = '\u26a1 FC: ' + fc;
+    fcIdentity.style.display = 'block';
+  } else {
+    fcIdentity.style.display = 'none';
+  }
+  // Live battery reading, asked through the sync while it holds the FC.
+  if (data.fc_variant && state !== 'idle' && state !== 'error') startBatteryPoll();
+  else stopBatteryPoll();
+
+  // Where the last sync's time went, stage by stage.
+  const timeline = document.getElementById('sync-timeline');
+  const stages = data.timeline || [];
+  if (stages.length > 1 && (state === 'idle' || state === 'error')) {
+    const bar = document.getElementById('sync-timeline-bar');
+    const colors = ['#2a4a6a', '#3a6a9a', '#60b0ff'];
+    const steps = [];
+    bar.textContent = '';
+    for (let i = 1; i < stages.length; i++) {
+      const delta = stages[i].at_ms - stages[i - 1].at_ms;
+      const seg = document.createElement('span');
+      seg.style.flexGrow = Math.max(delta, 1);
+      seg.style.background = colors[i % colors.length];
+      seg.title = stages[i].stage + ' +' + fmtMS(delta);
+      bar.appendChild(seg);
+      steps.push(stages[i].stage.replace(/_/g, ' ') + ' +' + fmtMS(delta));
+    }
+    document.getElementById('sync-timeline-total').textContent = fmtMS(stages[stages.length - 1].at_ms);
+    document.getElementById('sync-timeline-steps').textContent = steps.join('  \u00b7  ');
+    timeline.style.display = 'block';
+  } else {
+    timeline.style.display = 'none';
+  }
+
+  // Version warning banner — amber, persists until page reload.
+  const warnBanner = document.getElementById('version-warning-banner');
+  const warnText = document.getElementById('version-warning-text');
+  if (data.warning) {
+    warnText.textContent = data.warning;
+    warnBanner.style.display = 'block';
+  }
+
+  // Heat / undervoltage banner — live, clears when the Pi recovers.
+  const powerBanner = document.getElementById('power-warning-banner');
+  document.getElementById('power-warning-text').textContent = data.power_warning || '';
+  powerBanner.style.display = data.power_warning ? 'block' : 'none';
+
+  // Slow or fake SD card, from the card's I/O history.
+  const cardBanner = document.getElementById('card-warning-banner');
+  document.getElementById('card-warning-text').textContent = data.card_warning || '';
+  cardBanner.style.display = data.card_warning ? 'block' : 'none';
+}
+
+function applyStatus(delta) {
+  Object.assign(status, delta);
+  renderStatus(status);
+}
+
+const sessionGroup = document.body.dataset.group;
+// Reload the list after a change, keeping the pages already loaded.
+function refreshSessions() {
+  const shown = document.querySelectorAll('#sessions-list .session-card').length;
+  fetch('/sessions?format=html&group=' + sessionGroup + '&limit=' + shown)
+    .then(r => r.text())
+    .then(html => { document.getElementById('sessions-list').innerHTML = html; })
+    .catch(() => {});
+}
+
+function loadMoreSessions(btn) {
+  btn.disabled = true;
+  btn.textContent = 'Loading\u2026';
+  fetch('/sessions?format=html&group=' + sessionGroup + '&after=' + encodeURIComponent(btn.dataset.after))
+    .then(r => r.text())
+    .then(html => {
+      const list = document.getElementById('sessions-list');
+      const page = document.createElement('template');
+      page.innerHTML = html;
+      // Cards that continue the last group on screen go into it.
+      const cont = page.content.querySelector('.group-cont');
+      const groups = list.querySelectorAll('.fc-group > div');
+      if (cont && groups.length) groups[groups.length - 1].append(...cont.children);
+      btn.parentElement.remove();
+      list.append(page.content);
+    })
+    .catch(() => { btn.disabled = false; btn.textContent = 'Load more'; });
+}
+
+let batteryTimer = null;
+function startBatteryPoll() {
+  if (batteryTimer) return;
+  const poll = () => fetch('/fc/analog').then(r => r.ok ? r.json() : null).then(q => {
+    const v = q && q.data ? q.data.voltage : 0;
+    document.getElementById('fc-battery').textContent = v > 0 ? '  \u00b7  \ud83d\udd0b ' + v.toFixed(2) + ' V' : '';
+  }).catch(() => {});
+  poll();
+  batteryTimer = setInterval(poll, 5000);
+}
+function stopBatteryPoll() {
+  if (!batteryTimer) return;
+  clearInterval(batteryTimer);
+  batteryTimer = null;
+  document.getElementById('fc-battery').textContent = '';
+}
+
+let pollTimer = null;
+function startPolling() {
+  if (pollTimer) return;
+  const poll = () => fetch('/status').then(r => r.json()).then(applyStatus).catch(() => {});
+  poll();
+  pollTimer = setInterval(poll, 3000);
+}
+
+function connectEvents() {
+  if (!window.EventSource) { startPolling(); return; }
+  const es = new EventSource('/events');
+  es.addEventListener('status', e => {
+    if (pollTimer) { clearInterval(pollTimer); pollTimer = null; }
+    applyStatus(JSON.parse(e.data));
+  });
+  es.addEventListener('sessions', refreshSessions);
+  es.onerror = () => {
+    // The browser retries on its own; poll meanwhile, and open a fresh
+    // stream later if it gives up.
+    startPolling();
+    if (es.readyState === EventSource.CLOSED) setTimeout(connectEvents, 30000);
+  };
+}
+connectEvents();
+
+const csrfHeaders = { 'X-CSRF-Token': document.body.dataset.csrf };
+
+function pinSession(sessionId, action, btn) {
+  btn.disabled = true;
+  fetch('/sessions/' + sessionId + '/' + action, { method: 'POST', headers: csrfHeaders })
+    .then(r => r.json())
+    .then(() => refreshSessions())
+    .catch(() => {
+      btn.disabled = false;
+      alert('Pin request failed.');
+    });
+}
+
+function deleteSession(sessionId, btn) {
+  if (!confirm('Delete this session from the Pi?\n\nMake sure you have downloaded the .bbl file first.')) return;
+  btn.disabled = true;
+  btn.textContent = 'Deleting\u2026';
+  fetch('/sessions/' + sessionId, {
+    method: 'DELETE',
+    headers: csrfHeaders
+  })
+    .then(r => r.json())
+    .then(data => {
+      if (data.deleted) {
+        const card = btn.closest('.session-card');
+        card.style.transition = 'opacity 0.3s';
+        card.style.opacity = '0';
+        setTimeout(() => { card.remove(); refreshSessions(); }, 300);
+      } else {
+        btn.disabled = false;
+        btn.textContent = 'Delete from Pi';
+        alert('Delete failed.');
+      }
+    })
+    .catch(() => {
+      btn.disabled = false;
+      btn.textContent = 'Delete from Pi';
+      alert('Delete request failed.');
+    });
+}
@@ -0,0 +1,11 @@
+// Code generated by gen_assets.go; DO NOT EDIT.
+
+package web
+
+// assetNames maps each source in assets/ to its content-hashed name in
+// assets/dist.
+var assetNames = map[string]string{
+	"dashboard.css": "dashboard.25e067ced6.css",
+	"dashboard.js":  "dashboard.4d52463415.js",
+	"settings.css":  "settings.bfe08b029e.css",
+}
@@ -0,0 +1,94 @@
+package web
+
+import (
+	"fmt"
+	"log/slog"
+	"net/http"
+
+	"github.com/proeugene/logfalcon/internal/storage"
+)
+
+// CardCheckJob is the background job kind that runs the SD card
+// fake-capacity check.
+const CardCheckJob = "card_check"
+
+// cardHealth loads the SD card history; nil if it cannot be read.
+func (s *Server) cardHealth() *storage.CardHealth {
+	h, err := storage.LoadCardHealth(s.storagePath)
+	if err != nil {
+		slog.Debug("reading SD card health", "error", err)
+		return nil
+	}
+	return h
+}
+
+// cardHealthPayload is the "card" section of /health.
+func (s *Server) cardHealthPayload() map[string]any {
+	h := s.cardHealth()
+	if h == nil {
+		return map[string]any{"known": false}
+	}
+	payload := map[string]any{
+		"known":         true,
+		"warning":       h.Warning(),
+		"bytes_written": h.BytesWritten,
+		"syncs":         h.Syncs,
+		"probe":         h.Probe,
+		"capacity":      h.Capacity,
+	}
+	if n := len(h.Recent); n > 0 {
+		payload["last_sync"] = h.Recent[n-1]
+	}
+	return payload
+}
+
+// handleCardCheck handles POST /settings/card-check: it queues the
+// fake-capacity check, which runs once no sync is active.
+func (s *Server) handleCardCheck(w http.ResponseWriter, r *http.Request) {
+	if err := r.ParseForm(); err != nil || r.FormValue("csrf_token") != s.csrfToken {
+		s.sendError(w, r, http.StatusForbidden, "Invalid CSRF token")
+		return
+	}
+	if s.jobs == nil {
+		s.sendHTML(w, r, http.StatusServiceUnavailable, s.renderSettingsPage("Background jobs are not running; the card check is unavailable.", true))
+		return
+	}
+	if err := s.jobs.Enqueue(CardCheckJob, ""); err != nil {
+		slog.Error("queueing card check", "error", err)
+		s.sendHTML(w, r, http.StatusInternalServerError, s.renderSettingsPage("Could not queue the card check.", true))
+		return
+	}
+	slog.Info("SD card check queued", "client", r.RemoteAddr)
+	s.sendHTML(w, r, http.StatusOK, s.renderSettingsPage("SD card check queued. It runs when no sync is active; reload this page for the result.", false))
+}
+
+// renderCardSection summarises the SD card for the settings page.
+func renderCardSection(h *storage.CardHealth, csrfToken string) string {
+	summary := "No measurements yet."
+	if h != nil {
+		summary = fmt.Sprintf("%.1f GB written by %d syncs.", float64(h.BytesWritten)/(1<<30), h.Syncs)
+		if p := h.Probe; p != nil {
+			summary += fmt.Sprintf(" Boot probe: %.1f MB/s, 256 KB flush p99 %.0f ms.", p.MBps, p.FsyncP99MS)
+		}
+		switch c := h.Capacity; {
+		case c == nil:
+		case c.Error != "":
+			summary += " Last capacity check failed: " + c.Error
+		case c.Bad > 0:
+			summary += fmt.Sprintf(" Last capacity check: %d of %d blocks bad.", c.Bad, c.Blocks)
+		default:
+			summary += fmt.Sprintf(" Last capacity check (%s): all %d blocks OK.", c.AtUTC, c.Blocks)
+		}
+	}
+	warning := ""
+	if msg := h.Warning(); msg != "" {
+		warning = `<br><span style="color:#ff9080;">` + esc(msg) + `</span>`
+	}
+	return fmt.Sprintf(`<div class="current-info">
+    <strong>SD card:</strong> %s%s
+    <form method="POST" action="/settings/card-check" style="margin-top:8px;">
+      <input type="hidden" name="csrf_token" value="%s">
+      <button type="submit" class="btn-save">Check for fake capacity</button>
+    </form>
+  </div>`, esc(summary), warning, esc(csrfToken))
+}
@@ -0,0 +1,238 @@
+package web
+
+import (
+	"encoding/json"
+	"fmt"
+	"hash/fnv"
+	"log/slog"
+	"net/http"
+	"reflect"
+	gosync "sync"
+	"time"
+)
+
+const (
+	// eventsPollInterval is how often the hub samples sync status while at
+	// least one dashboard is connected.
+	eventsPollInterval = time.Second
+	// sessionsCheckEvery is how many polls pass between session-list checks
+	// for changes made by other processes or background jobs.
+	sessionsCheckEvery = 10
+	// sseHeartbeat keeps idle streams open through phone network stacks.
+	sseHeartbeat = 25 * time.Second
+	// subscriberBuffer is how many events a slow client may fall behind
+	// before it is dropped; the browser reconnects and gets a fresh snapshot.
+	subscriberBuffer = 16
+)
+
+// sseEvent is one server-sent event.
+type sseEvent struct {
+	name string
+	data []byte
+}
+
+// eventHub samples the dashboard state once for all connected streams and
+// fans out only the fields that changed. It runs only while someone is
+// connected, so an unwatched Pi does no dashboard work at all.
+type eventHub struct {
+	s *Server
+
+	mu       gosync.Mutex
+	subs     map[chan sseEvent]struct{}
+	running  bool
+	last     map[string]any
+	sessSig  uint64
+	lastSync string
+	wake     chan struct{}
+}
+
+func newEventHub(s *Server) *eventHub {
+	return &eventHub{
+		s:    s,
+		subs: make(map[chan sseEvent]struct{}),
+		wake: make(chan struct{}, 1),
+	}
+}
+
+// subscribe registers a stream and returns it with the full current state,
+// which the stream must send first.
+func (h *eventHub) subscribe() (chan sseEvent, map[string]any) {
+	h.mu.Lock()
+	defer h.mu.Unlock()
+	if !h.running {
+		h.last = h.s.statusPayload()
+		h.sessSig = h.s.sessionsSignature()
+		h.lastSync = fmt.Sprint(h.last["state"])
+		h.running = true
+		go h.run()
+	}
+	ch := make(chan sseEvent, subscriberBuffer)
+	h.subs[ch] = struct{}{}
+	snapshot := make(map[string]any, len(h.last))
+	for k, v := range h.last {
+		snapshot[k] = v
+	}
+	return ch, snapshot
+}
+
+func (h *eventHub) unsubscribe(ch chan sseEvent) {
+	h.mu.Lock()
+	defer h.mu.Unlock()
+	if _, ok := h.subs[ch]; ok {
+		delete(h.subs, ch)
+		close(ch)
+	}
+}
+
+// active reports whether any dashboard stream is connected.
+func (h *eventHub) active() bool {
+	h.mu.Lock()
+	defer h.mu.Unlock()
+	return len(h.subs) > 0
+}
+
+// sessionsChanged tells connected dashboards to reload the session list.
+func (h *eventHub) sessionsChanged() {
+	select {
+	case h.wake <- struct{}{}:
+	default:
+	}
+}
+
+func (h *eventHub) run() {
+	ticker := time.NewTicker(eventsPollInterval)
+	defer ticker.Stop()
+	polls := 0
+	for {
+		forceSessions := false
+		select {
+		case <-ticker.C:
+			polls++
+		case <-h.wake:
+			forceSessions = true
+		}
+
+		status := h.s.statusPayload()
+		state := fmt.Sprint(status["state"])
+
+		h.mu.Lock()
+		if len(h.subs) == 0 {
+			h.running = false
+			h.mu.Unlock()
+			return
+		}
+		syncEnded := state != h.lastSync && (state == "idle" || state == "error")
+		h.lastSync = state
+		delta := make(map[string]any)
+		for k, v := range status {
+			if old, ok := h.last[k]; !ok || !reflect.DeepEqual(old, v) {
+				delta[k] = v
+			}
+		}
+		h.last = status
+		h.mu.Unlock()
+
+		if len(delta) > 0 {
+			data, err := json.Marshal(delta)
+			if err != nil {
+				slog.Warn("failed to marshal SSE status", "error", err)
+			} else {
+				h.broadcast(sseEvent{name: "status", data: data})
+			}
+		}
+
+		if syncEnded {
+			h.s.resetSessionsCache() // a sync process may have added a session
+		}
+		if forceSessions || syncEnded || polls%sessionsCheckEvery == 0 {
+			h.checkSessions()
+		}
+	}
+}
+
+// checkSessions notifies streams when the session list differs from the
+// last one they were told about.
+func (h *eventHub) checkSessions() {
+	sig := h.s.sessionsSignature()
+	h.mu.Lock()
+	changed := sig != h.sessSig
+	h.sessSig = sig
+	h.mu.Unlock()
+	if changed {
+		h.broadcast(sseEvent{name: "sessions", data: []byte(fmt.Sprintf(`{"count":%d}`, len(h.s.getSessions())))})
+	}
+}
+
+// broadcast queues ev for every stream, dropping streams that fell behind.
+func (h *eventHub) broadcast(ev sseEvent) {
+	h.mu.Lock()
+	defer h.mu.Unlock()
+	for ch := range h.subs {
+		select {
+		case ch <- ev:
+		default:
+			delete(h.subs, ch)
+			close(ch)
+		}
+	}
+}
+
+// sessionsSignature hashes what the session list shows, so changes can be
+// detected without comparing whole lists.
+func (s *Server) sessionsSignature() uint64 {
+	hash := fnv.New64a()
+	for _, sess := range s.getSessions() {
+		fmt.Fprint(hash, sess.SessionID, "|")
+		if m := sess.Manifest; m != nil {
+			fmt.Fprint(hash, m.Pinned, m.DownloadedUTC != "", m.OffloadedUTC != "")
+		}
+		fmt.Fprint(hash, ";")
+	}
+	return hash.Sum64()
+}
+
+func (s *Server) handleSSE(w http.ResponseWriter, r *http.Request) {
+	rc := http.NewResponseController(w)
+	// Streams outlive the server-wide write timeout.
+	_ = rc.SetWriteDeadline(time.Time{})
+
+	w.Header().Set("Content-Type", "text/event-stream")
+	w.Header().Set("Cache-Control", "no-cache")
+	w.Header().Set("Connection", "keep-alive")
+	w.Header().Set("X-Accel-Buffering", "no")
+
+	ch, snapshot := s.events.subscribe()
+	defer s.events.unsubscribe(ch)
+
+	data, err := json.Marshal(snapshot)
+	if err != nil {
+		http.Error(w, "internal error", http.StatusInternalServerError)
+		return
+	}
+	// Reconnect quickly after a dropped stream; the first event is a full
+	// snapshot, later ones carry only changed fields.
+	fmt.Fprintf(w, "retry: 3000\nevent: status\ndata: %s\n\n", data)
+	if err := rc.Flush(); err != nil {
+		http.Error(w, "streaming not supported", http.StatusInternalServerError)
+		return
+	}
+
+	heartbeat := time.NewTicker(sseHeartbeat)
+	defer heartbeat.Stop()
+	for {
+		select {
+		case <-r.Context().Done():
+			return
+		case ev, ok := <-ch:
+			if !ok {
+				return // fell behind; the client reconnects
+			}
+			fmt.Fprintf(w, "event: %s\ndata: %s\n\n", ev.name, ev.data)
+		case <-heartbeat.C:
+			fmt.Fprint(w, ": ping\n\n")
+		}
+		if err := rc.Flush(); err != nil {
+			return
+		}
+	}
+}
@@ -0,0 +1,68 @@
+package web
+
+import (
+	"context"
+	"errors"
+	"io"
+	"net"
+	"net/http"
+	"os"
+	"path/filepath"
+	"strings"
+	"syscall"
+	"time"
+
+	lfSync "github.com/proeugene/logfalcon/internal/sync"
+)
+
+// fcQueryTimeout bounds a proxied FC query, including its wait in the sync's
+// queue.
+const fcQueryTimeout = 5 * time.Second
+
+// fcQueryClient returns an HTTP client that reaches the FC query socket of
+// a running sync in runtimeDir.
+func fcQueryClient(runtimeDir string) *http.Client {
+	path := filepath.Join(runtimeDir, lfSync.FCQuerySocketName)
+	return &http.Client{
+		Timeout: fcQueryTimeout,
+		Transport: &http.Transport{
+			DialContext: func(ctx context.Context, _, _ string) (net.Conn, error) {
+				return (&net.Dialer{}).DialContext(ctx, "unix", path)
+			},
+			DisableKeepAlives: true, // each sync has its own socket
+		},
+	}
+}
+
+// handleFCQuery forwards GET /fc/<query> to the sync process, which slots the
+// MSP request in between its flash reads. Without a sync there is no FC
+// connection to ask.
+func (s *Server) handleFCQuery(w http.ResponseWriter, r *http.Request) {
+	name := strings.TrimPrefix(r.URL.Path, "/fc/")
+	if name == "" || strings.Contains(name, "/") {
+		s.sendJSON(w, r, http.StatusNotFound, map[string]string{"error": "Unknown FC query."})
+		return
+	}
+	req, err := http.NewRequestWithContext(r.Context(), http.MethodGet, "http://fc/fc/"+name, nil)
+	if err != nil {
+		s.sendJSON(w, r, http.StatusBadRequest, map[string]string{"error": "Bad FC query."})
+		return
+	}
+	resp, err := s.fcClient.Do(req)
+	if err != nil {
+		if errors.Is(err, os.ErrNotExist) || errors.Is(err, syscall.ECONNREFUSED) {
+			s.sendJSON(w, r, http.StatusServiceUnavailable, map[string]string{"error": "No flight controller is being synced."})
+			return
+		}
+		s.sendJSON(w, r, http.StatusBadGateway, map[string]string{"error": "The sync did not answer."})
+		return
+	}
+	defer resp.Body.Close()
+	body, err := io.ReadAll(io.LimitReader(resp.Body, 64<<10))
+	if err != nil {
+		s.sendJSON(w, r, http.StatusBadGateway, map[string]string{"error": "The sync did not answer."})
+		return
+	}
+	w.Header().Set("Cache-Control", "no-store")
+	s.sendBody(w, r, resp.StatusCode, "application/json", body)
+}
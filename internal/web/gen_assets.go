@@ -0,0 +1,115 @@
+//go:build ignore
+
+// gen_assets.go builds the dashboard's static assets: every assets/*.css and
+// assets/*.js file is written to assets/dist under a content-hashed name,
+// next to a gzip variant and, when the brotli tool is installed, a brotli
+// one. The names go into assets_gen.go. Run it with `go generate
+// ./internal/web` after editing an asset.
+package main
+
+import (
+	"bytes"
+	"compress/gzip"
+	"crypto/sha256"
+	"encoding/hex"
+	"fmt"
+	"go/format"
+	"log"
+	"os"
+	"os/exec"
+	"path/filepath"
+	"sort"
+	"strings"
+)
+
+const (
+	srcDir  = "assets"
+	distDir = "assets/dist"
+)
+
+func main() {
+	var sources []string
+	for _, pattern := range []string{"*.css", "*.js"} {
+		matches, err := filepath.Glob(filepath.Join(srcDir, pattern))
+		if err != nil {
+			log.Fatal(err)
+		}
+		sources = append(sources, matches...)
+	}
+	sort.Strings(sources)
+
+	if err := os.RemoveAll(distDir); err != nil {
+		log.Fatal(err)
+	}
+	if err := os.MkdirAll(distDir, 0o755); err != nil {
+		log.Fatal(err)
+	}
+	_, err := exec.LookPath("brotli")
+	haveBrotli := err == nil
+	if !haveBrotli {
+		log.Print("brotli not found; building gzip variants only")
+	}
+
+	names := make(map[string]string)
+	for _, src := range sources {
+		data, err := os.ReadFile(src)
+		if err != nil {
+			log.Fatal(err)
+		}
+		base := filepath.Base(src)
+		ext := filepath.Ext(base)
+		sum := sha256.Sum256(data)
+		hashed := strings.TrimSuffix(base, ext) + "." + hex.EncodeToString(sum[:5]) + ext
+		names[base] = hashed
+
+		out := filepath.Join(distDir, hashed)
+		write(out, data)
+		write(out+".gz", gzipped(data))
+		if haveBrotli {
+			cmd := exec.Command("brotli", "--best", "--stdout", src)
+			br, err := cmd.Output()
+			if err != nil {
+				log.Fatalf("brotli %s: %v", src, err)
+			}
+			write(out+".br", br)
+		}
+	}
+
+	var b bytes.Buffer
+	b.WriteString("// Code generated by gen_assets.go; DO NOT EDIT.\n\npackage web\n\n")
+	b.WriteString("// assetNames maps each source in assets/ to its content-hashed name in\n// assets/dist.\n")
+	b.WriteString("var assetNames = map[string]string{\n")
+	for _, src := range sources {
+		base := filepath.Base(src)
+		fmt.Fprintf(&b, "\t%q: %q,\n", base, names[base])
+	}
+	b.WriteString("}\n")
+	code, err := format.Source(b.Bytes())
+	if err != nil {
+		log.Fatal(err)
+	}
+	write("assets_gen.go", code)
+}
+
+// gzipped compresses data with a header that carries no name or time, so
+// the output only changes with the input.
+func gzipped(data []byte) []byte {
+	var b bytes.Buffer
+	zw, err := gzip.NewWriterLevel(&b, gzip.BestCompression)
+	if err != nil {
+		log.Fatal(err)
+	}
+	if _, err := zw.Write(data); err != nil {
+		log.Fatal(err)
+	}
+	if err := zw.Close(); err != nil {
+		log.Fatal(err)
+	}
+	return b.Bytes()
+}
+
+func write(path string, data []byte) {
+	if err := os.WriteFile(path, data, 0o644); err != nil {
+		log.Fatal(err)
+	}
+}
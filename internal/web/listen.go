@@ -0,0 +1,89 @@
+package web
+
+import (
+	"context"
+	"fmt"
+	"log/slog"
+	"net"
+	"net/http"
+	"os"
+	"strconv"
+	"time"
+
+	lfSync "github.com/proeugene/logfalcon/internal/sync"
+)
+
+// listenFDsStart is the first descriptor systemd passes (SD_LISTEN_FDS_START).
+var listenFDsStart = 3
+
+// idleExitCheck is how often a socket-activated server checks whether it
+// may exit.
+var idleExitCheck = time.Minute
+
+// systemdListener returns the listening socket handed over by systemd socket
+// activation (logfalcon-web.socket), or nil when the server was started
+// directly. Only the first socket is used.
+func systemdListener() (net.Listener, error) {
+	pid, err := strconv.Atoi(os.Getenv("LISTEN_PID"))
+	if err != nil || pid != os.Getpid() {
+		return nil, nil
+	}
+	n, err := strconv.Atoi(os.Getenv("LISTEN_FDS"))
+	if err != nil || n < 1 {
+		return nil, nil
+	}
+	// Not meant for child processes (shutdown, nmcli, ...).
+	os.Unsetenv("LISTEN_PID")
+	os.Unsetenv("LISTEN_FDS")
+	os.Unsetenv("LISTEN_FDNAMES")
+
+	f := os.NewFile(uintptr(listenFDsStart), "logfalcon-web.socket")
+	defer f.Close() // the listener holds its own duplicate
+	ln, err := net.FileListener(f)
+	if err != nil {
+		return nil, fmt.Errorf("using socket from systemd: %w", err)
+	}
+	return ln, nil
+}
+
+// touch records request activity for the idle exit.
+func (s *Server) touch() {
+	s.lastRequest.Store(time.Now().UnixNano())
+}
+
+// mayExit reports whether the server has been unused for at least timeout:
+// no requests, no open dashboard streams, no sync in progress and no pending
+// background jobs.
+func (s *Server) mayExit(timeout time.Duration) bool {
+	if s.events.active() {
+		return false
+	}
+	if s.jobs != nil && !s.jobs.Idle() {
+		return false
+	}
+	status := lfSync.GetStatus()
+	if status.State != "idle" && status.State != "" && status.State != "error" {
+		return false
+	}
+	return time.Since(time.Unix(0, s.lastRequest.Load())) >= timeout
+}
+
+// idleExitMonitor shuts srv down once the server may exit. systemd keeps the
+// socket open meanwhile and starts the server again on the next connection.
+func (s *Server) idleExitMonitor(srv *http.Server) {
+	timeout := time.Duration(s.config.WebIdleExitMinutes) * time.Minute
+	slog.Info("idle exit enabled", "minutes", s.config.WebIdleExitMinutes)
+
+	ticker := time.NewTicker(idleExitCheck)
+	defer ticker.Stop()
+	for range ticker.C {
+		if !s.mayExit(timeout) {
+			continue
+		}
+		slog.Info("web server idle — exiting until the next connection", "idle_minutes", s.config.WebIdleExitMinutes)
+		ctx, cancel := context.WithTimeout(context.Background(), 10*time.Second)
+		_ = srv.Shutdown(ctx)
+		cancel()
+		return
+	}
+}
@@ -5,19 +5,23 @@ import (
 	"crypto/rand"
 	"encoding/hex"
 	"encoding/json"
+	"errors"
 	"fmt"
 	"io"
 	"log/slog"
+	"net"
 	"net/http"
 	"os"
 	"os/exec"
-	"path/filepath"
 	"strconv"
 	"strings"
 	gosync "sync"
+	"sync/atomic"
 	"time"
 
 	"github.com/proeugene/logfalcon/internal/config"
+	"github.com/proeugene/logfalcon/internal/jobs"
+	"github.com/proeugene/logfalcon/internal/power"
 	"github.com/proeugene/logfalcon/internal/storage"
 	lfSync "github.com/proeugene/logfalcon/internal/sync"
 	"github.com/proeugene/logfalcon/internal/util"
@@ -25,7 +29,7 @@ import (
 
 const (
 	sessionsCacheTTL       = 10 * time.Second
-	sseInterval            = 2 * time.Second
+	healthCacheTTL         = 5 * time.Second
 	fileChunkSize          = 1 << 20 // 1 MB
 	defaultHotspotPassword = "fpvpilot"
 	hostapdConf            = "/etc/hostapd/hostapd.conf"
@@ -66,6 +70,7 @@ var captivePortalPaths = map[string]struct {
 // Server is the LogFalcon HTTP server.
 type Server struct {
 	storagePath   string
+	store         storage.Store
 	config        *config.Config
 	csrfToken     string
 	mux           *http.ServeMux
@@ -75,8 +80,20 @@ type Server struct {
 		data []*storage.Session
 		ts   time.Time
 	}
+	// healthCache holds the power and SD card warnings for statusPayload,
+	// which the event hub calls every second while a dashboard is open.
+	healthCache struct {
+		mu    gosync.Mutex
+		power string
+		card  string
+		ts    time.Time
+	}
 	lastActivity     time.Time
 	lastActivityLock gosync.Mutex
+	jobs             *jobs.Scheduler
+	events           *eventHub
+	lastRequest      atomic.Int64 // unix nanoseconds, for the idle exit
+	fcClient         *http.Client // talks to the sync's FC query socket
 }
 
 // NewServer creates a configured Server with all routes registered.
@@ -87,24 +104,38 @@ func NewServer(storagePath string, cfg *config.Config) *Server {
 		return nil
 	}
 
+	store, err := storage.OpenStore(cfg.StorageLayout, storagePath)
+	if err != nil {
+		slog.Warn("opening session store, falling back to directory layout", "layout", cfg.StorageLayout, "error", err)
+		store = storage.NewDirStore(storagePath)
+	}
+
 	s := &Server{
 		storagePath: storagePath,
+		store:       store,
 		config:      cfg,
 		csrfToken:   hex.EncodeToString(token),
 		mux:         http.NewServeMux(),
 		startedAt:   time.Now(),
 		lastActivity: time.Now(),
 	}
+	s.events = newEventHub(s)
+	s.fcClient = fcQueryClient(cfg.RuntimeDir)
+	s.touch()
 
 	s.mux.HandleFunc("GET /", s.handleIndex)
 	s.mux.HandleFunc("GET /sessions", s.handleSessions)
+	s.mux.HandleFunc("GET /static/", s.handleAsset)
 	s.mux.HandleFunc("GET /status", s.handleStatus)
 	s.mux.HandleFunc("GET /events", s.handleSSE)
 	s.mux.HandleFunc("GET /health", s.handleHealth)
 	s.mux.HandleFunc("GET /download/", s.handleDownload)
 	s.mux.HandleFunc("DELETE /sessions/", s.handleDeleteSession)
+	s.mux.HandleFunc("POST /sessions/", s.handlePinSession)
+	s.mux.HandleFunc("GET /fc/", s.handleFCQuery)
 	s.mux.HandleFunc("GET /settings", s.handleSettingsGet)
 	s.mux.HandleFunc("POST /settings", s.handleSettingsPost)
+	s.mux.HandleFunc("POST /settings/card-check", s.handleCardCheck)
 
 	// Captive portal probes — respond with OS-specific "internet OK" responses
 	// so iOS/Android/Windows keep all traffic on the Wi-Fi interface.
@@ -122,13 +153,14 @@ func NewServer(storagePath string, cfg *config.Config) *Server {
 	return s
 }
 
-// ListenAndServe starts the HTTP server. It also starts the idle shutdown
-// goroutine when configured.
+// ListenAndServe starts the HTTP server on the socket passed by systemd
+// socket activation, or on addr when started directly. It also starts the
+// idle shutdown goroutine when configured. A socket-activated server exits
+// after web_idle_exit_minutes without use and then returns nil.
 func (s *Server) ListenAndServe(addr string) error {
 	if s.config.IdleShutdownMinutes > 0 {
 		go s.idleShutdownMonitor()
 	}
-	slog.Info("starting web server", "addr", addr)
 	srv := &http.Server{
 		Addr:           addr,
 		Handler:        s,
@@ -137,11 +169,39 @@ func (s *Server) ListenAndServe(addr string) error {
 		IdleTimeout:    120 * time.Second,
 		MaxHeaderBytes: 1 << 20, // 1 MB
 	}
-	return srv.ListenAndServe()
+
+	ln, err := systemdListener()
+	if err != nil {
+		return err
+	}
+	if ln != nil {
+		slog.Info("starting web server", "addr", ln.Addr().String(), "socket_activated", true)
+		// Idle shutdown powers the Pi off from this process, so it has to
+		// stay up for that.
+		if s.config.WebIdleExitMinutes > 0 && s.config.IdleShutdownMinutes <= 0 {
+			go s.idleExitMonitor(srv)
+		}
+	} else {
+		slog.Info("starting web server", "addr", addr)
+		if ln, err = net.Listen("tcp", addr); err != nil {
+			return err
+		}
+	}
+	if err := srv.Serve(ln); !errors.Is(err, http.ErrServerClosed) {
+		return err
+	}
+	return nil
+}
+
+// SetJobs attaches the background job scheduler so /health can report it and
+// idle shutdown waits for running jobs.
+func (s *Server) SetJobs(sched *jobs.Scheduler) {
+	s.jobs = sched
 }
 
 // ServeHTTP implements http.Handler, suppressing per-request log noise.
 func (s *Server) ServeHTTP(w http.ResponseWriter, r *http.Request) {
+	s.touch()
 	s.mux.ServeHTTP(w, r)
 }
 
@@ -152,7 +212,7 @@ func (s *Server) getSessions() []*storage.Session {
 	defer s.sessionsCache.mu.Unlock()
 
 	if time.Since(s.sessionsCache.ts) > sessionsCacheTTL {
-		sessions, err := storage.ListSessions(s.storagePath)
+		sessions, err := s.store.ListSessions()
 		if err != nil {
 			slog.Warn("listing sessions", "error", err)
 			sessions = nil
@@ -163,12 +223,33 @@ func (s *Server) getSessions() []*storage.Session {
 	return s.sessionsCache.data
 }
 
+// invalidateSessionsCache drops the cached list after a change made by this
+// process and tells connected dashboards to reload it.
 func (s *Server) invalidateSessionsCache() {
+	s.resetSessionsCache()
+	s.events.sessionsChanged()
+}
+
+func (s *Server) resetSessionsCache() {
 	s.sessionsCache.mu.Lock()
 	defer s.sessionsCache.mu.Unlock()
 	s.sessionsCache.ts = time.Time{}
 }
 
+// healthWarnings returns the power and SD card warnings, re-reading sysfs
+// and the card history at most once per healthCacheTTL.
+func (s *Server) healthWarnings() (powerWarning, cardWarning string) {
+	s.healthCache.mu.Lock()
+	defer s.healthCache.mu.Unlock()
+
+	if time.Since(s.healthCache.ts) > healthCacheTTL {
+		s.healthCache.power = power.ReadHealth().Warning()
+		s.healthCache.card = s.cardHealth().Warning()
+		s.healthCache.ts = time.Now()
+	}
+	return s.healthCache.power, s.healthCache.card
+}
+
 // ---------- route handlers ----------
 
 func (s *Server) handleIndex(w http.ResponseWriter, r *http.Request) {
@@ -177,7 +258,6 @@ func (s *Server) handleIndex(w http.ResponseWriter, r *http.Request) {
 		return
 	}
 
-	sessions := s.getSessions()
 	status := lfSync.GetStatus()
 
 	var usedGB, freeGB float64
@@ -194,7 +274,6 @@ func (s *Server) handleIndex(w http.ResponseWriter, r *http.Request) {
 		pct = int(usedGB / totalGB * 100)
 	}
 
-	sessionsHTML := RenderSessions(sessions)
 	statusMessage := status.Message
 	if statusMessage == "" {
 		statusMessage = "Ready for the next sync."
@@ -204,25 +283,40 @@ func (s *Server) handleIndex(w http.ResponseWriter, r *http.Request) {
 	if freeMB < float64(s.config.MinFreeSpaceMB) {
 		storageWarningHTML = fmt.Sprintf(
 			`<div class="warning-card">Low space: only %.1f MB free. `+
-				`Oldest sessions may be removed automatically during the next sync `+
-				`to stay above the %d MB reserve.</div>`,
+				`Unpinned sessions may be removed automatically, oldest and already `+
+				`downloaded first, to stay above the %d MB reserve.</div>`,
 			freeMB, s.config.MinFreeSpaceMB,
 		)
 	}
 
-	body := RenderIndex(IndexParams{
+	params := IndexParams{
 		UsedGB:             usedGB,
 		FreeGB:             freeGB,
 		Pct:                pct,
-		SessionsHTML:       sessionsHTML,
+		Group:              sessionGroup(r),
 		StatusMessage:      statusMessage,
 		StorageWarningHTML: storageWarningHTML,
 		CSRFToken:          s.csrfToken,
+	}
+	// The status part goes out before the session list is read, and only the
+	// first page of the list is read and rendered.
+	s.streamHTML(w, r, func(out io.Writer, flush func()) {
+		RenderIndex(out, params, func(out io.Writer) {
+			flush()
+			page := s.sessionPage(params.Group, "", sessionsPageSize)
+			_, _ = io.WriteString(out, RenderSessions(page))
+		})
 	})
-	s.sendHTML(w, r, http.StatusOK, body)
 }
 
 func (s *Server) handleSessions(w http.ResponseWriter, r *http.Request) {
+	if r.URL.Query().Get("format") == "html" {
+		// A page of the list: the next one for "Load more", or on a
+		// "sessions" event the range the dashboard already shows.
+		page := s.sessionPage(sessionGroup(r), r.URL.Query().Get("after"), sessionLimit(r))
+		s.sendHTML(w, r, http.StatusOK, RenderSessions(page))
+		return
+	}
 	sessions := s.getSessions()
 	if sessions == nil {
 		sessions = []*storage.Session{}
@@ -231,6 +325,11 @@ func (s *Server) handleSessions(w http.ResponseWriter, r *http.Request) {
 }
 
 func (s *Server) handleStatus(w http.ResponseWriter, r *http.Request) {
+	s.sendJSON(w, r, http.StatusOK, s.statusPayload())
+}
+
+// statusPayload is the dashboard status shared by /status and /events.
+func (s *Server) statusPayload() map[string]any {
 	status := lfSync.GetStatus()
 	payload := map[string]any{
 		"state":        status.State,
@@ -245,46 +344,14 @@ func (s *Server) handleStatus(w http.ResponseWriter, r *http.Request) {
 		"fc_firmware_version": status.FCFirmwareVersion,
 		"fc_api_version":      status.FCAPIVersion,
 		"warning":             status.Warning,
+		// Stage breakdown of the last finished sync.
+		"timeline": status.Timeline,
 	}
+	// Heat or undervoltage on the Pi itself, and a slow or fake SD card
+	// from its I/O history.
+	payload["power_warning"], payload["card_warning"] = s.healthWarnings()
 	s.addIdleShutdownInfo(payload)
-	s.sendJSON(w, r, http.StatusOK, payload)
-}
-
-func (s *Server) handleSSE(w http.ResponseWriter, r *http.Request) {
-	flusher, ok := w.(http.Flusher)
-	if !ok {
-		http.Error(w, "streaming not supported", http.StatusInternalServerError)
-		return
-	}
-
-	w.Header().Set("Content-Type", "text/event-stream")
-	w.Header().Set("Cache-Control", "no-cache")
-	w.Header().Set("Connection", "keep-alive")
-	w.Header().Set("X-Accel-Buffering", "no")
-
-	var prev string
-	ticker := time.NewTicker(sseInterval)
-	defer ticker.Stop()
-
-	for {
-		select {
-		case <-r.Context().Done():
-			return
-		case <-ticker.C:
-			status := lfSync.GetStatus()
-			data, err := json.Marshal(status)
-			if err != nil {
-				slog.Warn("failed to marshal SSE status", "error", err)
-				continue
-			}
-			payload := string(data)
-			if payload != prev {
-				fmt.Fprintf(w, "data: %s\n\n", payload)
-				flusher.Flush()
-				prev = payload
-			}
-		}
-	}
+	return payload
 }
 
 func (s *Server) handleHealth(w http.ResponseWriter, r *http.Request) {
@@ -317,11 +384,21 @@ func (s *Server) handleHealth(w http.ResponseWriter, r *http.Request) {
 			"storage_pressure_cleanup": s.config.StoragePressureCleanup,
 			"low_space":                freeMB < float64(s.config.MinFreeSpaceMB),
 		},
+		"card": s.cardHealthPayload(),
 		"hotspot": map[string]any{
 			"ssid":                      hostapd["ssid"],
 			"default_password_in_use":   hostapd["wpa_passphrase"] == defaultHotspotPassword,
 		},
 	}
+	if s.jobs != nil {
+		queued, running := s.jobs.Snapshot()
+		jobsInfo := map[string]any{"queued": len(queued), "running": nil}
+		if running != nil {
+			jobsInfo["queued"] = len(queued) - 1 // the running job stays queued until done
+			jobsInfo["running"] = running.Kind
+		}
+		payload["jobs"] = jobsInfo
+	}
 	s.sendJSON(w, r, http.StatusOK, payload)
 }
 
@@ -346,13 +423,44 @@ func (s *Server) handleDownload(w http.ResponseWriter, r *http.Request) {
 		return
 	}
 
-	filePath, err := s.resolveSessionFile(sessionID, filename)
+	f, err := s.store.Open(sessionID, filename)
 	if err != nil {
 		s.sendError(w, r, http.StatusNotFound, "")
 		return
 	}
+	defer f.Close()
+
+	status, written, err := s.sendFile(w, r, f, filename)
+	if err != nil {
+		slog.Info("download not completed", "session_id", sessionID, "file", filename, "bytes", written, "error", err)
+		return
+	}
+	// Only a whole file that reached the client counts: not a 304, HEAD or
+	// range, which leave the pilot without a full copy.
+	if filename == storage.RawFlashFilename && status == http.StatusOK && r.Method == http.MethodGet && written == f.Size {
+		s.markDownloaded(sessionID)
+	}
+}
 
-	s.sendFile(w, r, filePath, filename)
+// markDownloaded records the first full download of a session's raw flash so
+// retention can evict it before logs that only exist on the Pi. Callers make
+// sure the whole file was sent: retention deletes these sessions first.
+func (s *Server) markDownloaded(sessionID string) {
+	for _, sess := range s.getSessions() {
+		if sess.SessionID == sessionID && sess.Manifest != nil && sess.Manifest.DownloadedUTC != "" {
+			return
+		}
+	}
+	err := s.store.UpdateManifest(sessionID, func(m *storage.Manifest) {
+		if m.DownloadedUTC == "" {
+			m.DownloadedUTC = time.Now().UTC().Format(time.RFC3339)
+		}
+	})
+	if err != nil {
+		slog.Warn("recording download", "session_id", sessionID, "error", err)
+		return
+	}
+	s.invalidateSessionsCache()
 }
 
 func (s *Server) handleDeleteSession(w http.ResponseWriter, r *http.Request) {
@@ -362,33 +470,62 @@ func (s *Server) handleDeleteSession(w http.ResponseWriter, r *http.Request) {
 	}
 
 	sessionID := strings.TrimPrefix(r.URL.Path, "/sessions/")
-	sessionPath, err := s.resolveSessionPath(sessionID)
-	if err != nil {
-		s.sendError(w, r, http.StatusBadRequest, "")
+	if err := s.store.Delete(sessionID); err != nil {
+		switch {
+		case errors.Is(err, storage.ErrInvalidSessionID):
+			s.sendError(w, r, http.StatusBadRequest, "")
+		case errors.Is(err, os.ErrNotExist):
+			s.sendError(w, r, http.StatusNotFound, "")
+		default:
+			slog.Error("deleting session", "session_id", sessionID, "error", err)
+			s.sendError(w, r, http.StatusInternalServerError, "")
+		}
 		return
 	}
 
-	if _, err := os.Stat(sessionPath); os.IsNotExist(err) {
-		s.sendError(w, r, http.StatusNotFound, "")
+	s.invalidateSessionsCache()
+	slog.Info("deleted session", "session_id", sessionID, "client", r.RemoteAddr)
+	s.sendJSON(w, r, http.StatusOK, map[string]any{"deleted": true, "session_id": sessionID})
+}
+
+// handlePinSession handles POST /sessions/{id}/pin and /sessions/{id}/unpin.
+func (s *Server) handlePinSession(w http.ResponseWriter, r *http.Request) {
+	if r.Header.Get("X-CSRF-Token") != s.csrfToken {
+		s.sendError(w, r, http.StatusForbidden, "Invalid CSRF token")
 		return
 	}
 
-	if err := os.RemoveAll(sessionPath); err != nil {
-		slog.Error("deleting session", "path", sessionPath, "error", err)
-		s.sendError(w, r, http.StatusInternalServerError, "")
+	sub := strings.TrimPrefix(r.URL.Path, "/sessions/")
+	var (
+		sessionID string
+		pinned    bool
+	)
+	if strings.HasSuffix(sub, "/pin") {
+		sessionID, pinned = strings.TrimSuffix(sub, "/pin"), true
+	} else if strings.HasSuffix(sub, "/unpin") {
+		sessionID = strings.TrimSuffix(sub, "/unpin")
+	} else {
+		s.sendError(w, r, http.StatusNotFound, "")
 		return
 	}
 
-	// Remove empty FC parent directory.
-	parent := filepath.Dir(sessionPath)
-	remaining, _ := os.ReadDir(parent)
-	if len(remaining) == 0 {
-		_ = os.Remove(parent)
+	err := s.store.UpdateManifest(sessionID, func(m *storage.Manifest) { m.Pinned = pinned })
+	if err != nil {
+		switch {
+		case errors.Is(err, storage.ErrInvalidSessionID):
+			s.sendError(w, r, http.StatusBadRequest, "")
+		case errors.Is(err, os.ErrNotExist):
+			s.sendError(w, r, http.StatusNotFound, "")
+		default:
+			slog.Error("pinning session", "session_id", sessionID, "error", err)
+			s.sendError(w, r, http.StatusInternalServerError, "")
+		}
+		return
 	}
 
 	s.invalidateSessionsCache()
-	slog.Info("deleted session", "session_id", sessionID, "client", r.RemoteAddr)
-	s.sendJSON(w, r, http.StatusOK, map[string]any{"deleted": true, "session_id": sessionID})
+	slog.Info("session pin changed", "session_id", sessionID, "pinned", pinned, "client", r.RemoteAddr)
+	s.sendJSON(w, r, http.StatusOK, map[string]any{"pinned": pinned, "session_id": sessionID})
 }
 
 func (s *Server) handleSettingsGet(w http.ResponseWriter, r *http.Request) {
@@ -486,79 +623,25 @@ func (s *Server) renderSettingsPage(message string, isError bool) string {
 		MsgHTML:     msgHTML,
 		WarningHTML: warningHTML,
 		CSRFToken:   s.csrfToken,
+		CardHTML:    renderCardSection(s.cardHealth(), s.csrfToken),
 	})
 }
 
 // ---------- file serving ----------
 
-func (s *Server) resolveSessionPath(sessionID string) (string, error) {
-	parts := strings.Split(sessionID, "/")
-	if len(parts) != 2 {
-		return "", fmt.Errorf("invalid session_id")
-	}
-	fcDir, sessDir := parts[0], parts[1]
-	if strings.Contains(fcDir, "..") || strings.Contains(sessDir, "..") {
-		return "", fmt.Errorf("path traversal")
-	}
-
-	absStorage, err := filepath.Abs(s.storagePath)
-	if err != nil {
-		return "", err
-	}
-	// Resolve symlinks on the storage root for consistent prefix checking
-	// (e.g. macOS /var → /private/var).
-	resolvedStorage, err := filepath.EvalSymlinks(absStorage)
-	if err != nil {
-		resolvedStorage = absStorage
-	}
-	candidate := filepath.Join(absStorage, fcDir, sessDir)
-	resolved, err := filepath.EvalSymlinks(candidate)
-	if err != nil {
-		resolved = filepath.Clean(candidate)
-	}
-	if !strings.HasPrefix(resolved, resolvedStorage) {
-		return "", fmt.Errorf("path outside storage root")
-	}
-	return candidate, nil
-}
-
-func (s *Server) resolveSessionFile(sessionID, filename string) (string, error) {
-	if !allowedDownloads[filename] {
-		return "", fmt.Errorf("file not allowed")
-	}
-	sessPath, err := s.resolveSessionPath(sessionID)
-	if err != nil {
-		return "", err
-	}
-	filePath := filepath.Join(sessPath, filename)
-	if _, err := os.Stat(filePath); err != nil {
-		return "", err
-	}
-	return filePath, nil
-}
-
-func (s *Server) sendFile(w http.ResponseWriter, r *http.Request, path, filename string) {
-	info, err := os.Stat(path)
-	if err != nil {
-		s.sendError(w, r, http.StatusNotFound, "")
-		return
-	}
-	size := info.Size()
-	mtime := info.ModTime()
+// sendFile answers a download with the whole file, a byte range or a 304. It
+// returns the status sent and how many body bytes reached the connection; the
+// error is set if the body was cut short.
+func (s *Server) sendFile(w http.ResponseWriter, r *http.Request, f *storage.SessionFile, filename string) (int, int64, error) {
+	size := f.Size
+	mtime := f.ModTime
 	etag := fmt.Sprintf(`"%d-%d"`, mtime.Unix(), size)
 
 	// ETag: If-None-Match
 	if inm := r.Header.Get("If-None-Match"); inm == etag {
 		w.WriteHeader(http.StatusNotModified)
-		return
-	}
-
-	f, err := os.Open(path)
-	if err != nil {
-		s.sendError(w, r, http.StatusInternalServerError, "")
-		return
+		return http.StatusNotModified, 0, nil
 	}
-	defer f.Close()
 
 	lastModified := mtime.UTC().Format(http.TimeFormat)
 
@@ -575,7 +658,7 @@ func (s *Server) sendFile(w http.ResponseWriter, r *http.Request, path, filename
 				if err != nil {
 					w.Header().Set("Content-Range", fmt.Sprintf("bytes */%d", size))
 					w.WriteHeader(http.StatusRequestedRangeNotSatisfiable)
-					return
+					return http.StatusRequestedRangeNotSatisfiable, 0, nil
 				}
 			}
 			if parts[1] != "" {
@@ -584,7 +667,7 @@ func (s *Server) sendFile(w http.ResponseWriter, r *http.Request, path, filename
 				if err != nil {
 					w.Header().Set("Content-Range", fmt.Sprintf("bytes */%d", size))
 					w.WriteHeader(http.StatusRequestedRangeNotSatisfiable)
-					return
+					return http.StatusRequestedRangeNotSatisfiable, 0, nil
 				}
 			} else {
 				end = size - 1
@@ -595,7 +678,7 @@ func (s *Server) sendFile(w http.ResponseWriter, r *http.Request, path, filename
 			if start > end || start >= size {
 				w.Header().Set("Content-Range", fmt.Sprintf("bytes */%d", size))
 				w.WriteHeader(http.StatusRequestedRangeNotSatisfiable)
-				return
+				return http.StatusRequestedRangeNotSatisfiable, 0, nil
 			}
 			contentLength := end - start + 1
 			w.Header().Set("Content-Type", "application/octet-stream")
@@ -607,10 +690,10 @@ func (s *Server) sendFile(w http.ResponseWriter, r *http.Request, path, filename
 			w.Header().Set("ETag", etag)
 			w.WriteHeader(http.StatusPartialContent)
 			if _, err := f.Seek(start, io.SeekStart); err != nil {
-				return
+				return http.StatusPartialContent, 0, err
 			}
-			streamChunked(w, f, contentLength)
-			return
+			n, err := streamChunked(w, f, contentLength)
+			return http.StatusPartialContent, n, err
 		}
 	}
 
@@ -622,10 +705,20 @@ func (s *Server) sendFile(w http.ResponseWriter, r *http.Request, path, filename
 	w.Header().Set("Last-Modified", lastModified)
 	w.Header().Set("ETag", etag)
 	w.WriteHeader(http.StatusOK)
-	streamChunked(w, f, size)
+	n, err := streamChunked(w, f, size)
+	if err == nil {
+		// Push out what the server still buffers, so a client that went
+		// away shows up as an error here.
+		if fErr := http.NewResponseController(w).Flush(); !errors.Is(fErr, http.ErrNotSupported) {
+			err = fErr
+		}
+	}
+	return http.StatusOK, n, err
 }
 
-func streamChunked(w io.Writer, r io.Reader, length int64) {
+// streamChunked copies length bytes from r to w. It returns the bytes
+// written and an error if w failed or r ended early.
+func streamChunked(w io.Writer, r io.Reader, length int64) (int64, error) {
 	remaining := length
 	buf := make([]byte, fileChunkSize)
 	for remaining > 0 {
@@ -636,14 +729,21 @@ func streamChunked(w io.Writer, r io.Reader, length int64) {
 		n, err := r.Read(buf[:toRead])
 		if n > 0 {
 			if _, wErr := w.Write(buf[:n]); wErr != nil {
-				return
+				return length - remaining, wErr
 			}
 			remaining -= int64(n)
 		}
 		if err != nil {
+			if err == io.EOF && remaining > 0 {
+				err = io.ErrUnexpectedEOF
+			}
+			if remaining > 0 {
+				return length - remaining, err
+			}
 			break
 		}
 	}
+	return length, nil
 }
 
 // ---------- response helpers ----------
@@ -668,6 +768,32 @@ func (s *Server) sendBody(w http.ResponseWriter, r *http.Request, status int, co
 	}
 }
 
+// streamHTML sends a 200 HTML response that render writes in parts; flush
+// pushes what it has written so far to the client, compressed or not.
+func (s *Server) streamHTML(w http.ResponseWriter, r *http.Request, render func(out io.Writer, flush func())) {
+	w.Header().Set("Content-Type", "text/html; charset=utf-8")
+	var (
+		out io.Writer = w
+		gz  *gzip.Writer
+	)
+	if strings.Contains(r.Header.Get("Accept-Encoding"), "gzip") {
+		w.Header().Set("Content-Encoding", "gzip")
+		gz = gzip.NewWriter(w)
+		defer gz.Close()
+		out = gz
+	}
+	w.WriteHeader(http.StatusOK)
+	flusher, _ := w.(http.Flusher)
+	render(out, func() {
+		if gz != nil {
+			_ = gz.Flush()
+		}
+		if flusher != nil {
+			flusher.Flush()
+		}
+	})
+}
+
 func (s *Server) sendHTML(w http.ResponseWriter, r *http.Request, status int, body string) {
 	s.sendBody(w, r, status, "text/html; charset=utf-8", []byte(body))
 }
@@ -718,8 +844,9 @@ func (s *Server) idleShutdownMonitor() {
 
 	for range ticker.C {
 		status := lfSync.GetStatus()
-		if status.State != "idle" && status.State != "" {
-			// Sync active — reset timer
+		busy := status.State != "idle" && status.State != "" && status.State != "error"
+		if busy || (s.jobs != nil && s.jobs.Busy()) {
+			// Sync or background job active — reset timer
 			s.lastActivityLock.Lock()
 			s.lastActivity = time.Now()
 			s.lastActivityLock.Unlock()
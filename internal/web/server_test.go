@@ -1,13 +1,26 @@
 package web
 
 import (
+	"bufio"
+	"bytes"
+	"compress/gzip"
+	"crypto/sha256"
+	"encoding/hex"
 	"encoding/json"
+	"errors"
+	"fmt"
+	"io"
+	"net"
 	"net/http"
 	"net/http/httptest"
 	"os"
 	"path/filepath"
+	"strconv"
+	"strings"
 	"testing"
+	"time"
 
+	"github.com/proeugene/logfalcon/internal/blackbox"
 	"github.com/proeugene/logfalcon/internal/config"
 	"github.com/proeugene/logfalcon/internal/storage"
 	lfSync "github.com/proeugene/logfalcon/internal/sync"
@@ -18,6 +31,7 @@ func newTestServer(t *testing.T) (*Server, string) {
 	dir := t.TempDir()
 	cfg := config.Default()
 	cfg.StoragePath = dir
+	cfg.RuntimeDir = filepath.Join(dir, "run")
 	s := NewServer(dir, cfg)
 	// Ensure idle sync status for deterministic tests.
 	lfSync.SetStatus("idle", 0, "Ready for the next sync.")
@@ -188,6 +202,108 @@ func TestDownloadValidFile(t *testing.T) {
 	}
 }
 
+func TestPinAndDownloadTracking(t *testing.T) {
+	s, dir := newTestServer(t)
+
+	store := storage.NewDirStore(dir)
+	info := &storage.FCInfo{APIMajor: 1, APIMinor: 46, Variant: "BTFL", UID: "abc12345"}
+	id, w, err := store.Create(info)
+	if err != nil {
+		t.Fatal(err)
+	}
+	_, _ = w.Write([]byte("flash"))
+	_ = w.Close()
+	if err := store.PutManifest(id, storage.NewManifest(info, w.SHA256Hex(), 5, true, true, nil)); err != nil {
+		t.Fatal(err)
+	}
+
+	req := httptest.NewRequest(http.MethodPost, "/sessions/"+id+"/pin", nil)
+	rec := httptest.NewRecorder()
+	s.ServeHTTP(rec, req)
+	if rec.Code != http.StatusForbidden {
+		t.Fatalf("pin without CSRF: expected 403, got %d", rec.Code)
+	}
+
+	req = httptest.NewRequest(http.MethodPost, "/sessions/"+id+"/pin", nil)
+	req.Header.Set("X-CSRF-Token", s.csrfToken)
+	rec = httptest.NewRecorder()
+	s.ServeHTTP(rec, req)
+	if rec.Code != http.StatusOK {
+		t.Fatalf("pin: expected 200, got %d", rec.Code)
+	}
+
+	req = httptest.NewRequest(http.MethodGet, "/download/"+id+"/raw_flash.bbl", nil)
+	rec = httptest.NewRecorder()
+	s.ServeHTTP(rec, req)
+	if rec.Code != http.StatusOK {
+		t.Fatalf("download: expected 200, got %d", rec.Code)
+	}
+
+	sessions, err := store.ListSessions()
+	if err != nil || len(sessions) != 1 {
+		t.Fatalf("ListSessions: %d sessions, err=%v", len(sessions), err)
+	}
+	m := sessions[0].Manifest
+	if !m.Pinned {
+		t.Error("session should be pinned")
+	}
+	if m.DownloadedUTC == "" {
+		t.Error("download should be recorded in the manifest")
+	}
+	if !m.EraseCompleted {
+		t.Error("pin/download updates must keep existing manifest fields")
+	}
+}
+
+// brokenClient is a client that drops the connection before the body.
+type brokenClient struct{ *httptest.ResponseRecorder }
+
+func (brokenClient) Write([]byte) (int, error) { return 0, errors.New("connection reset by peer") }
+
+func TestDownloadRecordedOnlyWhenComplete(t *testing.T) {
+	s, dir := newTestServer(t)
+	store := storage.NewDirStore(dir)
+	id, w, err := store.Create(&storage.FCInfo{APIMajor: 1, APIMinor: 46, Variant: "BTFL", UID: "abc12345"})
+	if err != nil {
+		t.Fatal(err)
+	}
+	_, _ = w.Write([]byte("flash"))
+	_ = w.Close()
+	if err := store.PutManifest(id, storage.NewManifest(&storage.FCInfo{Variant: "BTFL", UID: "abc12345"}, w.SHA256Hex(), 5, true, true, nil)); err != nil {
+		t.Fatal(err)
+	}
+	url := "/download/" + id + "/raw_flash.bbl"
+	downloaded := func() bool {
+		sessions, err := store.ListSessions()
+		if err != nil || len(sessions) != 1 {
+			t.Fatalf("ListSessions: %d sessions, err=%v", len(sessions), err)
+		}
+		return sessions[0].Manifest.DownloadedUTC != ""
+	}
+
+	head := httptest.NewRecorder()
+	s.ServeHTTP(head, httptest.NewRequest(http.MethodHead, url, nil))
+	partial := httptest.NewRequest(http.MethodGet, url, nil)
+	partial.Header.Set("Range", "bytes=0-1")
+	s.ServeHTTP(httptest.NewRecorder(), partial)
+	cached := httptest.NewRequest(http.MethodGet, url, nil)
+	cached.Header.Set("If-None-Match", head.Header().Get("ETag"))
+	rec := httptest.NewRecorder()
+	s.ServeHTTP(rec, cached)
+	if rec.Code != http.StatusNotModified {
+		t.Fatalf("If-None-Match: got %d, want 304", rec.Code)
+	}
+	s.ServeHTTP(brokenClient{httptest.NewRecorder()}, httptest.NewRequest(http.MethodGet, url, nil))
+	if downloaded() {
+		t.Fatal("HEAD, range, 304 or a dropped transfer recorded a download")
+	}
+
+	s.ServeHTTP(httptest.NewRecorder(), httptest.NewRequest(http.MethodGet, url, nil))
+	if !downloaded() {
+		t.Error("complete download not recorded")
+	}
+}
+
 func TestIndexPage(t *testing.T) {
 	s, _ := newTestServer(t)
 	req := httptest.NewRequest(http.MethodGet, "/", nil)
@@ -203,6 +319,62 @@ func TestIndexPage(t *testing.T) {
 	}
 }
 
+func TestStaticAssets(t *testing.T) {
+	s, _ := newTestServer(t)
+	w := httptest.NewRecorder()
+	s.ServeHTTP(w, httptest.NewRequest(http.MethodGet, "/", nil))
+	page := w.Body.String()
+	if strings.Contains(page, "<style>") || strings.Contains(page, "function fmtBytes") {
+		t.Error("dashboard still inlines its CSS or JavaScript")
+	}
+
+	for src, hashed := range assetNames {
+		// The build must match the sources; otherwise run go generate.
+		want, err := os.ReadFile(filepath.Join("assets", src))
+		if err != nil {
+			t.Fatal(err)
+		}
+		sum := sha256.Sum256(want)
+		if !strings.Contains(hashed, "."+hex.EncodeToString(sum[:5])+".") {
+			t.Errorf("%s changed since assets were built; run go generate ./internal/web", src)
+		}
+		if src != "settings.css" && !strings.Contains(page, assetURL(src)) {
+			t.Errorf("dashboard does not link %s", assetURL(src))
+		}
+
+		req := httptest.NewRequest(http.MethodGet, assetURL(src), nil)
+		req.Header.Set("Accept-Encoding", "br;q=0, gzip, deflate")
+		w := httptest.NewRecorder()
+		s.ServeHTTP(w, req)
+		if w.Code != http.StatusOK || w.Header().Get("Content-Encoding") != "gzip" ||
+			!strings.Contains(w.Header().Get("Cache-Control"), "immutable") {
+			t.Fatalf("%s: code %d headers %v", src, w.Code, w.Header())
+		}
+		zr, err := gzip.NewReader(w.Body)
+		if err != nil {
+			t.Fatal(err)
+		}
+		got, _ := io.ReadAll(zr)
+		if !bytes.Equal(got, want) {
+			t.Errorf("%s: gzip variant does not match the source", src)
+		}
+
+		w = httptest.NewRecorder()
+		s.ServeHTTP(w, httptest.NewRequest(http.MethodGet, assetURL(src), nil))
+		if w.Header().Get("Content-Encoding") != "" || !bytes.Equal(w.Body.Bytes(), want) {
+			t.Errorf("%s: identity response differs from the source", src)
+		}
+	}
+
+	for _, path := range []string{"/static/dashboard.css", "/static/dashboard.0000000000.css"} {
+		w := httptest.NewRecorder()
+		s.ServeHTTP(w, httptest.NewRequest(http.MethodGet, path, nil))
+		if w.Code != http.StatusNotFound {
+			t.Errorf("GET %s = %d, want 404", path, w.Code)
+		}
+	}
+}
+
 func containsStr(haystack, needle string) bool {
 	return len(haystack) >= len(needle) && (haystack == needle ||
 		len(needle) == 0 ||
@@ -217,3 +389,322 @@ func findSubstring(s, sub string) bool {
 	}
 	return false
 }
+
+func TestEventsPushesDeltas(t *testing.T) {
+	s, dir := newTestServer(t)
+	ts := httptest.NewServer(s)
+	defer ts.Close()
+
+	resp, err := http.Get(ts.URL + "/events")
+	if err != nil {
+		t.Fatal(err)
+	}
+	defer resp.Body.Close()
+	events := make(chan [2]string, 8)
+	go func() {
+		sc := bufio.NewScanner(resp.Body)
+		var name string
+		for sc.Scan() {
+			line := sc.Text()
+			switch {
+			case strings.HasPrefix(line, "event: "):
+				name = strings.TrimPrefix(line, "event: ")
+			case strings.HasPrefix(line, "data: "):
+				events <- [2]string{name, strings.TrimPrefix(line, "data: ")}
+			}
+		}
+		close(events)
+	}()
+	next := func() (string, map[string]any) {
+		t.Helper()
+		select {
+		case ev, ok := <-events:
+			if !ok {
+				t.Fatal("stream closed")
+			}
+			var data map[string]any
+			if err := json.Unmarshal([]byte(ev[1]), &data); err != nil {
+				t.Fatalf("event %s: invalid JSON %q", ev[0], ev[1])
+			}
+			return ev[0], data
+		case <-time.After(5 * time.Second):
+			t.Fatal("timed out waiting for an event")
+		}
+		return "", nil
+	}
+
+	name, data := next()
+	if name != "status" || data["state"] != "idle" || data["message"] == nil {
+		t.Fatalf("first event = %s %v, want full idle snapshot", name, data)
+	}
+
+	lfSync.SetStatus("syncing", 40, "Copying blackbox flash to the Pi SD card.")
+	defer lfSync.SetStatus("idle", 0, "Ready for the next sync.")
+	name, data = next()
+	if name != "status" || data["state"] != "syncing" || data["progress"] != float64(40) {
+		t.Fatalf("delta = %s %v, want syncing at 40%%", name, data)
+	}
+	if _, ok := data["fc_variant"]; ok {
+		t.Error("delta should carry only changed fields")
+	}
+
+	store := storage.NewDirStore(dir)
+	info := &storage.FCInfo{APIMajor: 1, APIMinor: 46, Variant: "BTFL", UID: "abc12345"}
+	id, w, err := store.Create(info)
+	if err != nil {
+		t.Fatal(err)
+	}
+	_ = w.Close()
+	_ = store.PutManifest(id, storage.NewManifest(info, w.SHA256Hex(), 0, true, true, nil))
+	s.invalidateSessionsCache()
+	if name, data = next(); name != "sessions" || data["count"] != float64(1) {
+		t.Fatalf("event = %s %v, want sessions change with count 1", name, data)
+	}
+}
+
+func TestSessionsFragment(t *testing.T) {
+	s, _ := newTestServer(t)
+	req := httptest.NewRequest(http.MethodGet, "/sessions?format=html", nil)
+	w := httptest.NewRecorder()
+	s.ServeHTTP(w, req)
+	if w.Code != http.StatusOK || !strings.Contains(w.Body.String(), "No sessions yet") {
+		t.Fatalf("fragment: code %d body %q", w.Code, w.Body.String())
+	}
+}
+
+func TestSessionListPaging(t *testing.T) {
+	s, dir := newTestServer(t)
+	for day := 1; day <= 25; day++ {
+		sessDir := filepath.Join(dir, "fc_BTFL_uid-abc12345", fmt.Sprintf("2025-06-%02d_120000", day))
+		if err := os.MkdirAll(sessDir, 0o755); err != nil {
+			t.Fatal(err)
+		}
+		mdata, _ := json.Marshal(storage.Manifest{Version: 1, File: storage.ManifestFile{Name: "raw_flash.bbl", Bytes: 1024}})
+		if err := os.WriteFile(filepath.Join(sessDir, "manifest.json"), mdata, 0o644); err != nil {
+			t.Fatal(err)
+		}
+	}
+	get := func(url string) string {
+		t.Helper()
+		w := httptest.NewRecorder()
+		s.ServeHTTP(w, httptest.NewRequest(http.MethodGet, url, nil))
+		if w.Code != http.StatusOK {
+			t.Fatalf("GET %s: %d", url, w.Code)
+		}
+		return w.Body.String()
+	}
+
+	first := get("/")
+	if n := strings.Count(first, `class="session-card"`); n != sessionsPageSize {
+		t.Errorf("first page has %d sessions, want %d", n, sessionsPageSize)
+	}
+	if !strings.Contains(first, "2025-06-25 120000") || strings.Contains(first, "2025-06-05 120000") {
+		t.Error("first page should hold the newest sessions only")
+	}
+	next := "fc_BTFL_uid-abc12345/2025-06-06_120000"
+	if !strings.Contains(first, `data-after="`+next+`"`) || !strings.Contains(first, "Load more (5 older)") {
+		t.Fatalf("first page lacks a load-more cursor: %s", first)
+	}
+
+	more := get("/sessions?format=html&after=" + next)
+	if n := strings.Count(more, `class="session-card"`); n != 5 || strings.Contains(more, "Load more") {
+		t.Errorf("last page has %d sessions (load more: %v), want 5 and none", n, strings.Contains(more, "Load more"))
+	}
+	if !strings.HasPrefix(more, `<div class="group-cont">`) || strings.Contains(more, "<details") {
+		t.Errorf("a page continuing the same FC should not repeat its header: %s", more)
+	}
+
+	// The cursor survives the deletion of the session it names.
+	if err := os.RemoveAll(filepath.Join(dir, next)); err != nil {
+		t.Fatal(err)
+	}
+	s.resetSessionsCache()
+	if more := get("/sessions?format=html&after=" + next); strings.Count(more, `class="session-card"`) != 5 {
+		t.Error("paging after a deleted session lost its place")
+	}
+
+	byDay := get("/sessions?format=html&group=day&after=" + next)
+	if !strings.Contains(byDay, "<summary>2025-06-05</summary>") || strings.Contains(byDay, "group-cont") {
+		t.Errorf("day grouping: %s", byDay)
+	}
+
+	// A refresh keeps every page the dashboard has loaded.
+	refreshed := get("/sessions?format=html&limit=25")
+	if n := strings.Count(refreshed, `class="session-card"`); n != 24 || strings.Contains(refreshed, "Load more") {
+		t.Errorf("refresh of the loaded range has %d sessions, want all 24", n)
+	}
+}
+
+func TestSessionsFragmentSparklines(t *testing.T) {
+	s, dir := newTestServer(t)
+	sessDir := filepath.Join(dir, "fc_BTFL_uid-abc12345", "2025-06-01_120000")
+	if err := os.MkdirAll(sessDir, 0o755); err != nil {
+		t.Fatal(err)
+	}
+	crash := &blackbox.Flight{Samples: []blackbox.Sample{{Throttle: 1400, GyroDPS: 200}, {TimeUS: 90e6, Throttle: 1000, GyroDPS: 1999}}}
+	manifest := storage.Manifest{
+		Version: 1,
+		FC:      storage.ManifestFC{Variant: "BTFL", UID: "abc12345", APIVersion: "1.46"},
+		File:    storage.ManifestFile{Name: "raw_flash.bbl", Bytes: 1024},
+		Flights: []storage.ManifestFlight{
+			{DurationSec: 90, MaxGyroDPS: 1999, Sparkline: crash.Sparkline()},
+			{Sparkline: `<svg onload="alert(1)"></svg>`},
+		},
+	}
+	mdata, _ := json.Marshal(manifest)
+	if err := os.WriteFile(filepath.Join(sessDir, "manifest.json"), mdata, 0o644); err != nil {
+		t.Fatal(err)
+	}
+
+	req := httptest.NewRequest(http.MethodGet, "/sessions?format=html", nil)
+	w := httptest.NewRecorder()
+	s.ServeHTTP(w, req)
+	body := w.Body.String()
+	if !strings.Contains(body, crash.Sparkline()) || !strings.Contains(body, "Flight 1: 1m30s, peak gyro 1999°/s, possible crash") {
+		t.Errorf("sparkline missing from the session list: %s", body)
+	}
+	if strings.Contains(body, "onload") {
+		t.Errorf("untrusted sparkline inlined: %s", body)
+	}
+}
+
+func TestSocketActivationAndIdleExit(t *testing.T) {
+	s, _ := newTestServer(t)
+	s.config.WebIdleExitMinutes = 1
+
+	// Hand the server a listening socket the way systemd does.
+	ln, err := net.Listen("tcp", "127.0.0.1:0")
+	if err != nil {
+		t.Fatal(err)
+	}
+	f, err := ln.(*net.TCPListener).File()
+	if err != nil {
+		t.Fatal(err)
+	}
+	url := "http://" + ln.Addr().String()
+	ln.Close()
+	defer func(fd int, check time.Duration) { listenFDsStart, idleExitCheck = fd, check }(listenFDsStart, idleExitCheck)
+	listenFDsStart = int(f.Fd())
+	idleExitCheck = 10 * time.Millisecond
+	t.Setenv("LISTEN_PID", strconv.Itoa(os.Getpid()))
+	t.Setenv("LISTEN_FDS", "1")
+
+	done := make(chan error, 1)
+	go func() { done <- s.ListenAndServe("127.0.0.1:1") }()
+
+	resp, err := http.Get(url + "/health")
+	if err != nil {
+		t.Fatalf("request on the inherited socket: %v", err)
+	}
+	resp.Body.Close()
+	if resp.StatusCode != http.StatusOK {
+		t.Fatalf("/health status = %d", resp.StatusCode)
+	}
+	select {
+	case err := <-done:
+		t.Fatalf("server exited right after a request: %v", err)
+	case <-time.After(50 * time.Millisecond):
+	}
+
+	s.lastRequest.Store(time.Now().Add(-2 * time.Minute).UnixNano())
+	select {
+	case err := <-done:
+		if err != nil {
+			t.Fatalf("idle exit returned %v, want nil", err)
+		}
+	case <-time.After(5 * time.Second):
+		t.Fatal("server did not exit when idle")
+	}
+	if os.Getenv("LISTEN_FDS") != "" {
+		t.Error("LISTEN_FDS should not leak to child processes")
+	}
+}
+
+func TestFCQueryProxy(t *testing.T) {
+	s, dir := newTestServer(t)
+	get := func() *httptest.ResponseRecorder {
+		w := httptest.NewRecorder()
+		s.ServeHTTP(w, httptest.NewRequest(http.MethodGet, "/fc/analog", nil))
+		return w
+	}
+	if w := get(); w.Code != http.StatusServiceUnavailable {
+		t.Fatalf("without a sync: %d, want 503", w.Code)
+	}
+
+	// A sync answering on its query socket.
+	sock := filepath.Join(dir, "run", lfSync.FCQuerySocketName)
+	if err := os.MkdirAll(filepath.Dir(sock), 0o755); err != nil {
+		t.Fatal(err)
+	}
+	ln, err := net.Listen("unix", sock)
+	if err != nil {
+		t.Fatal(err)
+	}
+	srv := &http.Server{Handler: http.HandlerFunc(func(w http.ResponseWriter, r *http.Request) {
+		if r.URL.Path != "/fc/analog" {
+			http.NotFound(w, r)
+			return
+		}
+		w.Write([]byte(`{"query":"analog","data":{"voltage":16.8}}`))
+	})}
+	go srv.Serve(ln)
+	defer srv.Close()
+
+	w := get()
+	if w.Code != http.StatusOK || !strings.Contains(w.Body.String(), `"voltage":16.8`) {
+		t.Fatalf("proxied query: %d %s", w.Code, w.Body.String())
+	}
+}
+
+func TestCardHealthReporting(t *testing.T) {
+	s, dir := newTestServer(t)
+	slow := &storage.IOProfile{Bytes: 1 << 20, Busy: time.Second}
+	for i := 0; i < 3; i++ {
+		if err := storage.RecordSync(dir, slow); err != nil {
+			t.Fatal(err)
+		}
+	}
+
+	w := httptest.NewRecorder()
+	s.ServeHTTP(w, httptest.NewRequest(http.MethodGet, "/health", nil))
+	var body struct {
+		Card map[string]any `json:"card"`
+	}
+	if err := json.Unmarshal(w.Body.Bytes(), &body); err != nil {
+		t.Fatal(err)
+	}
+	if body.Card["syncs"] != 3.0 || !strings.Contains(body.Card["warning"].(string), "slow") {
+		t.Fatalf("card health = %v", body.Card)
+	}
+	if warning, _ := s.statusPayload()["card_warning"].(string); warning == "" {
+		t.Error("dashboard status has no card warning")
+	}
+	// The status pushed every second reuses the reading until it expires.
+	if err := os.Remove(filepath.Join(dir, storage.CardHealthName)); err != nil {
+		t.Fatal(err)
+	}
+	if warning, _ := s.statusPayload()["card_warning"].(string); warning == "" {
+		t.Error("card warning was re-read before the cache expired")
+	}
+	s.healthCache.ts = time.Time{}
+	if warning, _ := s.statusPayload()["card_warning"].(string); warning != "" {
+		t.Errorf("card warning after expiry = %q, want none", warning)
+	}
+
+	// Without the job scheduler the check cannot be queued.
+	form := strings.NewReader("csrf_token=" + s.csrfToken)
+	req := httptest.NewRequest(http.MethodPost, "/settings/card-check", form)
+	req.Header.Set("Content-Type", "application/x-www-form-urlencoded")
+	w = httptest.NewRecorder()
+	s.ServeHTTP(w, req)
+	if w.Code != http.StatusServiceUnavailable {
+		t.Errorf("card check without jobs: %d, want 503", w.Code)
+	}
+	req = httptest.NewRequest(http.MethodPost, "/settings/card-check", strings.NewReader("csrf_token=wrong"))
+	req.Header.Set("Content-Type", "application/x-www-form-urlencoded")
+	w = httptest.NewRecorder()
+	s.ServeHTTP(w, req)
+	if w.Code != http.StatusForbidden {
+		t.Errorf("card check with a bad token: %d, want 403", w.Code)
+	}
+}
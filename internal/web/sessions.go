@@ -0,0 +1,87 @@
+package web
+
+import (
+	"log/slog"
+	"net/http"
+	"strconv"
+	"strings"
+
+	"github.com/proeugene/logfalcon/internal/storage"
+)
+
+// Session list groupings, selected with ?group=.
+const (
+	GroupByFC  = "fc"
+	GroupByDay = "day"
+)
+
+// sessionsPageSize is how many sessions one page of the list renders; older
+// ones are fetched a page at a time with "Load more". A refresh of the list
+// asks for as many as the dashboard shows, up to sessionsRefreshMax.
+const (
+	sessionsPageSize   = 20
+	sessionsRefreshMax = 500
+)
+
+// SessionPage is one page of the newest-first session list.
+type SessionPage struct {
+	Sessions []*storage.Session
+	Group    string
+	// First is the top of the list, where an empty list explains how to
+	// sync.
+	First bool
+	// Continues is set when the page starts inside the group the previous
+	// page ended in, so its first cards get no group header.
+	Continues bool
+	Next      string // session ID to continue after; "" on the last page
+	Remaining int    // sessions after this page
+}
+
+// sessionGroup returns the grouping a request asks for.
+func sessionGroup(r *http.Request) string {
+	if r.URL.Query().Get("group") == GroupByDay {
+		return GroupByDay
+	}
+	return GroupByFC
+}
+
+// groupKey is the group a session is listed under: its FC directory, or the
+// day it was synced.
+func groupKey(sess *storage.Session, group string) string {
+	if group == GroupByDay && len(sess.SessionDir) >= len("2006-01-02") {
+		return sess.SessionDir[:len("2006-01-02")]
+	}
+	return sess.FCDir
+}
+
+// sessionLimit returns how many sessions a list request asks for: one page,
+// or with ?limit= the number of cards a refreshing dashboard already shows.
+func sessionLimit(r *http.Request) int {
+	n, err := strconv.Atoi(r.URL.Query().Get("limit"))
+	if err != nil || n < sessionsPageSize {
+		return sessionsPageSize
+	}
+	return min(n, sessionsRefreshMax)
+}
+
+// sessionPage reads up to limit sessions after the session ID after straight
+// from the store, so a page costs the same however many sessions are stored.
+// The cursor still works once that session has been deleted.
+func (s *Server) sessionPage(group, after string, limit int) SessionPage {
+	sessions, remaining, err := s.store.ListSessionsAfter(after, limit)
+	if err != nil {
+		slog.Warn("listing sessions", "error", err)
+	}
+	p := SessionPage{Sessions: sessions, Group: group, First: after == ""}
+	if after != "" && len(sessions) > 0 {
+		// The cursor is the last card of the previous page.
+		fcDir, sessDir, _ := strings.Cut(after, "/")
+		prev := &storage.Session{FCDir: fcDir, SessionDir: sessDir}
+		p.Continues = groupKey(prev, group) == groupKey(sessions[0], group)
+	}
+	if remaining > 0 && len(sessions) > 0 {
+		p.Next = sessions[len(sessions)-1].SessionID
+		p.Remaining = remaining
+	}
+	return p
+}
@@ -4,8 +4,11 @@ package web
 import (
 	"fmt"
 	"html"
+	"io"
 	"strings"
+	"time"
 
+	"github.com/proeugene/logfalcon/internal/blackbox"
 	"github.com/proeugene/logfalcon/internal/storage"
 )
 
@@ -13,7 +16,7 @@ import (
 type IndexParams struct {
 	UsedGB, FreeGB     float64
 	Pct                int
-	SessionsHTML       string
+	Group              string // GroupByFC or GroupByDay
 	StatusMessage      string
 	StorageWarningHTML string
 	CSRFToken          string
@@ -26,191 +29,48 @@ type SettingsParams struct {
 	MsgHTML     string
 	WarningHTML string
 	CSRFToken   string
+	CardHTML    string
 }
 
 func esc(s string) string { return html.EscapeString(s) }
 
-// RenderIndex renders the main dashboard page.
-func RenderIndex(params IndexParams) string {
-	return fmt.Sprintf(`<!DOCTYPE html>
+// RenderIndex writes the main dashboard page to w. The session list is
+// written by sessions once everything above it is out, so the page can be
+// streamed while the list is fetched.
+func RenderIndex(w io.Writer, params IndexParams, sessions func(io.Writer)) {
+	fmt.Fprintf(w, indexHead,
+		assetURL("dashboard.css"),
+		esc(params.Group),
+		esc(params.CSRFToken),
+		fmt.Sprintf("%.1f", params.UsedGB),
+		fmt.Sprintf("%.1f", params.FreeGB),
+		params.Pct,
+		esc(params.StatusMessage),
+		params.StorageWarningHTML,
+		groupLink(GroupByFC, "FC", params.Group),
+		groupLink(GroupByDay, "day", params.Group),
+	)
+	sessions(w)
+	fmt.Fprintf(w, indexTail, assetURL("dashboard.js"))
+}
+
+// groupLink is a session list grouping choice; the current one is not a link.
+func groupLink(group, label, current string) string {
+	if group == current {
+		return "<strong>" + label + "</strong>"
+	}
+	return fmt.Sprintf(`<a href="/?group=%s">%s</a>`, group, label)
+}
+
+const indexHead = `<!DOCTYPE html>
 <html lang="en">
 <head>
   <meta charset="UTF-8">
   <meta name="viewport" content="width=device-width, initial-scale=1.0">
   <title>LogFalcon</title>
-  <style>
-    *, *::before, *::after { box-sizing: border-box; }
-    body {
-      font-family: -apple-system, BlinkMacSystemFont, "Segoe UI", Roboto, sans-serif;
-      margin: 0; padding: 0;
-      background: #0f0f12;
-      color: #e0e0e8;
-      min-height: 100vh;
-    }
-    header {
-      background: #1a1a24;
-      border-bottom: 1px solid #2e2e40;
-      padding: 14px 20px;
-      display: flex;
-      align-items: center;
-      justify-content: space-between;
-      position: sticky; top: 0; z-index: 100;
-    }
-    header h1 { margin: 0; font-size: 1.1rem; font-weight: 600; }
-    #status-badge {
-      font-size: 0.75rem;
-      padding: 4px 10px;
-      border-radius: 12px;
-      background: #2e2e40;
-      color: #a0a0b8;
-    }
-    #status-badge.syncing    { background: #1a3a5c; color: #60b0ff; }
-    #status-badge.identifying { background: #1a2a3a; color: #7090b0; animation: pulse 1.8s ease-in-out infinite; }
-    #status-badge.querying   { background: #1a2a3a; color: #7090b0; animation: pulse 1.8s ease-in-out infinite; }
-    #status-badge.erasing    { background: #3a2a10; color: #ffaa40; }
-    #status-badge.verifying  { background: #2a1a4a; color: #c060ff; }
-    #status-badge.error      { background: #3a1a1a; color: #ff6060; }
-    @keyframes pulse { 0%%,100%% { opacity:1; } 50%% { opacity:0.5; } }
-    main { max-width: 700px; margin: 0 auto; padding: 16px; }
-    .disk-info {
-      background: #1a1a24;
-      border: 1px solid #2e2e40;
-      border-radius: 8px;
-      padding: 12px 16px;
-      margin-bottom: 16px;
-      font-size: 0.85rem;
-      color: #a0a0b8;
-    }
-    .disk-bar-track {
-      background: #2e2e40;
-      border-radius: 4px;
-      height: 6px;
-      margin-top: 6px;
-      overflow: hidden;
-    }
-    .disk-bar-fill {
-      background: #4060d0;
-      height: 100%%;
-      border-radius: 4px;
-      transition: width 0.3s;
-    }
-    .help-card {
-      background: #141c2c;
-      border: 1px solid #294263;
-      border-radius: 8px;
-      padding: 12px 16px;
-      margin-bottom: 16px;
-      color: #b7d0f5;
-      font-size: 0.85rem;
-    }
-    .help-card strong { color: #ffffff; }
-    .help-card ol { margin: 10px 0 0 18px; padding: 0; }
-    .help-card li { margin-bottom: 6px; }
-    .warning-card {
-      background: #3a2a10;
-      border: 1px solid #704d15;
-      border-radius: 8px;
-      padding: 12px 16px;
-      margin-bottom: 16px;
-      color: #ffca80;
-      font-size: 0.85rem;
-    }
-    #status-detail {
-      margin-top: 6px;
-      color: #8f90a8;
-      font-size: 0.8rem;
-    }
-    .fc-group { margin-bottom: 20px; }
-    .fc-group summary {
-      cursor: pointer;
-      font-size: 0.9rem;
-      font-weight: 600;
-      color: #c0c0d8;
-      padding: 8px 0;
-      list-style: none;
-      display: flex;
-      align-items: center;
-      gap: 8px;
-      border-bottom: 1px solid #2e2e40;
-      user-select: none;
-    }
-    .fc-group summary::before { content: "\25b6"; font-size: 0.7rem; transition: transform 0.2s; }
-    .fc-group[open] summary::before { transform: rotate(90deg); }
-    .session-card {
-      background: #1a1a24;
-      border: 1px solid #2e2e40;
-      border-radius: 8px;
-      padding: 12px 14px;
-      margin-top: 8px;
-      display: flex;
-      flex-direction: column;
-      gap: 6px;
-    }
-    .session-header {
-      display: flex;
-      align-items: center;
-      justify-content: space-between;
-      gap: 8px;
-      flex-wrap: wrap;
-    }
-    .session-title { font-size: 0.9rem; font-weight: 500; }
-    .session-meta { font-size: 0.75rem; color: #808098; display: flex; gap: 10px; flex-wrap: wrap; }
-    .badge {
-      display: inline-block;
-      padding: 2px 8px;
-      border-radius: 8px;
-      font-size: 0.7rem;
-      background: #2e2e40;
-      color: #909098;
-    }
-    .badge.erased { background: #1a3a1a; color: #60d060; }
-    .badge.no-erase { background: #3a2a10; color: #c08030; }
-    .session-actions { display: flex; gap: 8px; flex-wrap: wrap; }
-    button, a.btn {
-      display: inline-block;
-      padding: 6px 14px;
-      border-radius: 6px;
-      font-size: 0.8rem;
-      cursor: pointer;
-      border: none;
-      text-decoration: none;
-      font-weight: 500;
-      transition: opacity 0.15s;
-    }
-    button:hover, a.btn:hover { opacity: 0.8; }
-    .btn-download { background: #2a4a80; color: #a0c8ff; }
-    .btn-manifest { background: #2e2e40; color: #a0a0b8; }
-    .btn-delete   { background: #4a1a1a; color: #ff8080; }
-    .empty-state {
-      text-align: center;
-      padding: 48px 24px;
-      color: #505068;
-    }
-    .empty-state .icon { font-size: 3rem; margin-bottom: 12px; }
-    .empty-state ol {
-      display: inline-block;
-      margin: 12px auto 0;
-      padding-left: 18px;
-      text-align: left;
-      color: #7f8098;
-    }
-    .progress-bar-track {
-      background: #2e2e40;
-      border-radius: 3px;
-      height: 4px;
-      overflow: hidden;
-      display: none;
-    }
-    .progress-bar-fill {
-      background: #60b0ff;
-      height: 100%%;
-      width: 0%%;
-      border-radius: 3px;
-      transition: width 0.5s;
-    }
-  </style>
+  <link rel="stylesheet" href="%s">
 </head>
-<body>
+<body data-group="%s" data-csrf="%s">
 
 <header>
   <h1>LogFalcon</h1>
@@ -226,6 +86,14 @@ func RenderIndex(params IndexParams) string {
   ⚠ <span id="version-warning-text"></span>
 </div>
 
+<div id="power-warning-banner" style="display:none; background:#2a0a0a; border-bottom:1px solid #6a1a1a; padding:8px 20px; font-size:0.8rem; color:#ff9080; text-align:center;">
+  🌡 <span id="power-warning-text"></span>
+</div>
+
+<div id="card-warning-banner" style="display:none; background:#2a0a0a; border-bottom:1px solid #6a1a1a; padding:8px 20px; font-size:0.8rem; color:#ff9080; text-align:center;">
+  💾 <span id="card-warning-text"></span>
+</div>
+
 <div id="sync-progress-container" style="background:#1a2a3a; padding:0 20px; display:none;">
   <div style="max-width:700px; margin:0 auto; padding:8px 0; font-size:0.8rem; color:#60b0ff;">
     <div style="display:flex; justify-content:space-between; align-items:baseline; margin-bottom:4px;">
@@ -247,6 +115,12 @@ func RenderIndex(params IndexParams) string {
     <div id="status-detail">%s</div>
     <div id="fc-identity" style="display:none; margin-top:8px; padding:6px 8px; background:#0e1a2a; border-radius:6px; font-size:0.75rem; color:#6080a0;">
       <span id="fc-identity-text"></span>
+      <span id="fc-battery"></span>
+    </div>
+    <div id="sync-timeline" style="display:none; margin-top:8px; padding:6px 8px; background:#0e1a2a; border-radius:6px; font-size:0.7rem; color:#6080a0;">
+      <div>Last sync, plug-in to result LED: <strong id="sync-timeline-total"></strong></div>
+      <div id="sync-timeline-bar" style="display:flex; height:6px; margin:4px 0; border-radius:3px; overflow:hidden; background:#1a2a3a;"></div>
+      <div id="sync-timeline-steps"></div>
     </div>
   </div>
 
@@ -262,167 +136,23 @@ func RenderIndex(params IndexParams) string {
 
   %s
 
-  %s
+  <div class="list-controls">Group by %s · %s</div>
+  <div id="sessions-list">`
+
+const indexTail = `</div>
 </main>
 
-<script>
-  function fmtBytes(b) {
-    if (b >= 1048576) return (b / 1048576).toFixed(1) + ' MB';
-    if (b >= 1024) return (b / 1024).toFixed(0) + ' KB';
-    return b + ' B';
-  }
-  function fmtSpeed(bps) {
-    if (bps >= 1048576) return (bps / 1048576).toFixed(1) + ' MB/s';
-    if (bps >= 1024) return (bps / 1024).toFixed(0) + ' KB/s';
-    return Math.round(bps) + ' B/s';
-  }
-  function fmtETA(sec) {
-    if (sec <= 0) return '';
-    if (sec >= 60) return '~' + Math.ceil(sec / 60) + 'm remaining';
-    return '~' + sec + 's remaining';
-  }
-
-  function updateStatus() {
-    fetch('/status')
-      .then(r => r.json())
-      .then(data => {
-        const badge = document.getElementById('status-badge');
-        const detail = document.getElementById('status-detail');
-        const state = data.state || 'idle';
-        const progress = data.progress || 0;
-        const labels = {
-          idle: 'Idle',
-          identifying: 'Finding FC\u2026',
-          querying: 'Reading flash\u2026',
-          syncing: 'Syncing\u2026',
-          verifying: 'Verifying\u2026',
-          erasing: 'Erasing\u2026',
-          error: 'Error'
-        };
-        detail.textContent = data.message || 'Ready for the next sync.';
-        badge.textContent = (labels[state] || state) +
-          (state === 'syncing' && progress > 0 ? ' ' + progress + '%%' : '');
-        badge.className = '';
-        if (state === 'syncing') badge.classList.add('syncing');
-        else if (state === 'identifying') badge.classList.add('identifying');
-        else if (state === 'querying') badge.classList.add('querying');
-        else if (state === 'erasing') badge.classList.add('erasing');
-        else if (state === 'verifying') badge.classList.add('verifying');
-        else if (state === 'error') badge.classList.add('error');
-
-        const progressContainer = document.getElementById('sync-progress-container');
-        const progressFill = document.getElementById('progress-fill');
-        const progressLabel = document.getElementById('sync-progress-label');
-        const progressMeta = document.getElementById('sync-progress-meta');
-        if (state === 'syncing') {
-          progressContainer.style.display = 'block';
-          progressFill.style.width = progress + '%%';
-          const copied = data.bytes_copied || 0;
-          const total = data.total_bytes || 0;
-          const speed = data.speed_bps || 0;
-          const eta = data.eta_sec || 0;
-          progressLabel.textContent = 'Syncing flash\u2026 ' + progress + '%%' +
-            (total > 0 ? '  (' + fmtBytes(copied) + ' / ' + fmtBytes(total) + ')' : '');
-          const parts = [];
-          if (speed > 0) parts.push(fmtSpeed(speed));
-          if (eta > 0) parts.push(fmtETA(eta));
-          progressMeta.textContent = parts.join('  \u00b7  ');
-        } else {
-          progressContainer.style.display = 'none';
-          if (progressMeta) progressMeta.textContent = '';
-        }
-
-        const shutBanner = document.getElementById('idle-shutdown-banner');
-        const shutText = document.getElementById('idle-shutdown-text');
-        const shutMin = data.idle_shutdown_minutes || 0;
-        const shutSec = data.idle_shutdown_remaining_sec;
-        if (shutMin > 0 && shutSec != null) {
-          const m = Math.floor(shutSec / 60);
-          const s = shutSec %% 60;
-          shutText.textContent = '\u23fb Auto-shutdown in ' + m + ' min ' + s + ' sec \u2014 activity resets timer';
-          shutBanner.style.display = 'block';
-          if (shutSec < 60) {
-            shutBanner.style.background = '#2a0a0a';
-            shutBanner.style.borderBottomColor = '#6a1a1a';
-            shutText.style.color = '#e04040';
-          } else {
-            shutBanner.style.background = '#1a1400';
-            shutBanner.style.borderBottomColor = '#4a3a00';
-            shutText.style.color = '#d4a017';
-          }
-        } else {
-          shutBanner.style.display = 'none';
-        }
-
-        // FC identity line — shown once handshake completes.
-        const fcIdentity = document.getElementById('fc-identity');
-        const fcIdentityText = document.getElementById('fc-identity-text');
-        if (data.fc_variant) {
-          let fc = data.fc_variant;
-          if (data.fc_firmware_version) fc += ' ' + data.fc_firmware_version;
-          if (data.fc_api_version) fc += '  (API ' + data.fc_api_version + ')';
-          fcIdentityText.textContent = '\u26a1 FC: ' + fc;
-          fcIdentity.style.display = 'block';
-        } else {
-          fcIdentity.style.display = 'none';
-        }
-
-        // Version warning banner — amber, persists until page reload.
-        const warnBanner = document.getElementById('version-warning-banner');
-        const warnText = document.getElementById('version-warning-text');
-        if (data.warning) {
-          warnText.textContent = data.warning;
-          warnBanner.style.display = 'block';
-        }
-      })
-      .catch(() => {});
-  }
-  updateStatus();
-  setInterval(updateStatus, 3000);
-
-  function deleteSession(sessionId, btn) {
-    if (!confirm('Delete this session from the Pi?\n\nMake sure you have downloaded the .bbl file first.')) return;
-    btn.disabled = true;
-    btn.textContent = 'Deleting\u2026';
-    fetch('/sessions/' + sessionId, {
-      method: 'DELETE',
-      headers: { 'X-CSRF-Token': '%s' }
-    })
-      .then(r => r.json())
-      .then(data => {
-        if (data.deleted) {
-          const card = btn.closest('.session-card');
-          card.style.transition = 'opacity 0.3s';
-          card.style.opacity = '0';
-          setTimeout(() => { card.remove(); location.reload(); }, 300);
-        } else {
-          btn.disabled = false;
-          btn.textContent = 'Delete from Pi';
-          alert('Delete failed.');
-        }
-      })
-      .catch(() => {
-        btn.disabled = false;
-        btn.textContent = 'Delete from Pi';
-        alert('Delete request failed.');
-      });
-  }
-</script>
+<script src="%s"></script>
 </body>
-</html>`,
-		fmt.Sprintf("%.1f", params.UsedGB),
-		fmt.Sprintf("%.1f", params.FreeGB),
-		params.Pct,
-		esc(params.StatusMessage),
-		params.StorageWarningHTML,
-		params.SessionsHTML,
-		esc(params.CSRFToken),
-	)
-}
-
-// RenderSessions renders session cards HTML fragment.
-func RenderSessions(sessions []*storage.Session) string {
-	if len(sessions) == 0 {
+</html>`
+
+// RenderSessions renders one page of session cards as an HTML fragment,
+// grouped by page.Group, with a "Load more" button if older sessions remain.
+func RenderSessions(page SessionPage) string {
+	if len(page.Sessions) == 0 {
+		if !page.First {
+			return ""
+		}
 		return `<div class="empty-state">` +
 			`<div class="icon">📭</div>` +
 			`<p>No sessions yet.</p>` +
@@ -435,14 +165,25 @@ func RenderSessions(sessions []*storage.Session) string {
 	}
 
 	var b strings.Builder
-	currentFC := ""
-	for i, sess := range sessions {
-		if sess.FCDir != currentFC {
-			if currentFC != "" {
-				b.WriteString("</div></details>")
+	currentGroup, closeGroup := "", ""
+	for i, sess := range page.Sessions {
+		if key := groupKey(sess, page.Group); i == 0 || key != currentGroup {
+			b.WriteString(closeGroup)
+			currentGroup = key
+			if i == 0 && page.Continues {
+				// The previous page opened this group; the dashboard moves
+				// these cards into it.
+				b.WriteString(`<div class="group-cont">`)
+				closeGroup = "</div>"
+			} else {
+				fmt.Fprintf(&b, `<details class="fc-group" open><summary>%s</summary><div>`, esc(key))
+				closeGroup = "</div></details>"
 			}
-			currentFC = sess.FCDir
-			fmt.Fprintf(&b, `<details class="fc-group" open><summary>%s</summary><div>`, esc(sess.FCDir))
+		}
+
+		flightsHTML := ""
+		if sess.Manifest != nil {
+			flightsHTML = renderFlights(sess.Manifest.Flights)
 		}
 
 		var (
@@ -450,12 +191,20 @@ func RenderSessions(sessions []*storage.Session) string {
 			fileSize int64
 			erased   bool
 			sha256   string
+			pinned   bool
+			fetched  bool
+			partial  string
 		)
 		if sess.Manifest != nil {
 			fcVer = sess.Manifest.FC.APIVersion
 			fileSize = sess.Manifest.File.Bytes
 			erased = sess.Manifest.EraseCompleted
 			sha256 = sess.Manifest.File.SHA256
+			pinned = sess.Manifest.Pinned
+			fetched = sess.Manifest.DownloadedUTC != ""
+			if sess.Manifest.Partial != nil {
+				partial = sess.Manifest.Partial.Mode
+			}
 		}
 		fileMB := fmt.Sprintf("%.1f", float64(fileSize)/1048576)
 
@@ -487,36 +236,92 @@ func RenderSessions(sessions []*storage.Session) string {
 
 		title := strings.ReplaceAll(sess.SessionDir, "_", " ")
 
+		retentionHTML := ""
+		switch partial {
+		case "":
+		case storage.PartialInterrupted:
+			retentionHTML += `<span class="badge partial" title="The copy was interrupted; only the newest part of the flash was saved.">Incomplete</span>`
+		default:
+			retentionHTML += `<span class="badge partial" title="Quick sync: only the last flight was copied and the FC flash was kept.">Last flight</span>`
+		}
+		if pinned {
+			retentionHTML += `<span class="badge pinned" title="Never deleted automatically.">Pinned</span>`
+		}
+		if fetched {
+			retentionHTML += `<span class="badge downloaded" title="Downloaded from the web UI; cleaned up first when space runs low.">Downloaded</span>`
+		}
+		pinAction, pinLabel := "pin", "Pin"
+		if pinned {
+			pinAction, pinLabel = "unpin", "Unpin"
+		}
+
 		fmt.Fprintf(&b,
 			`<div class="session-card">`+
 				`<div class="session-header">`+
 				`<span class="session-title">%s</span>`+
 				`<span class="badge %s" title="%s">%s</span>`+
+				`%s`+
 				`</div>`+
 				`<div class="session-meta">`+
 				`<span>%s MB</span>`+
 				`<span>API %s</span>`+
 				`%s`+
 				`</div>`+
+				`%s`+
 				`<div class="session-actions">`+
 				`%s`+
 				`<a class="btn btn-manifest" href="/download/%s/manifest.json">Manifest</a>`+
+				`<button class="btn-pin" onclick="pinSession('%s', '%s', this)">%s</button>`+
 				`<button class="btn-delete" onclick="deleteSession('%s', this)">Delete from Pi</button>`+
 				`</div></div>`,
 			esc(title),
 			erasedCls, esc(erasedTitle), erasedTxt,
+			retentionHTML,
 			fileMB,
 			esc(fcVer),
 			shaHTML,
+			flightsHTML,
 			bblHTML,
 			esc(sess.SessionID),
+			esc(sess.SessionID), pinAction, pinLabel,
 			esc(sess.SessionID),
 		)
 
-		if i == len(sessions)-1 {
-			b.WriteString("</div></details>")
+	}
+	b.WriteString(closeGroup)
+	if page.Next != "" {
+		fmt.Fprintf(&b, `<div class="load-more"><button data-after="%s" onclick="loadMoreSessions(this)">Load more (%d older)</button></div>`,
+			esc(page.Next), page.Remaining)
+	}
+	return b.String()
+}
+
+// crashGyroDPS marks a flight whose gyro trace reached near full scale, which
+// in practice means a crash or a hard hit.
+const crashGyroDPS = 1900
+
+// renderFlights inlines the sparklines stored by post-sync indexing, so the
+// list costs no log decoding. Anything that is not a sparkline as generated
+// is left out rather than escaped.
+func renderFlights(flights []storage.ManifestFlight) string {
+	if len(flights) == 0 {
+		return ""
+	}
+	var b strings.Builder
+	b.WriteString(`<div class="session-flights">`)
+	for i, f := range flights {
+		if !blackbox.ValidSparkline(f.Sparkline) {
+			continue
+		}
+		cls, note := "flight", ""
+		if f.MaxGyroDPS >= crashGyroDPS {
+			cls, note = "flight crash", ", possible crash"
 		}
+		dur := time.Duration(f.DurationSec * float64(time.Second)).Round(time.Second)
+		fmt.Fprintf(&b, `<span class="%s" title="Flight %d: %s, peak gyro %.0f°/s%s. Blue: throttle, orange: gyro.">%s</span>`,
+			cls, i+1, dur, f.MaxGyroDPS, note, f.Sparkline)
 	}
+	b.WriteString(`</div>`)
 	return b.String()
 }
 
@@ -528,50 +333,7 @@ func RenderSettings(params SettingsParams) string {
   <meta charset="UTF-8">
   <meta name="viewport" content="width=device-width, initial-scale=1.0">
   <title>Settings — LogFalcon</title>
-  <style>
-    *, *::before, *::after { box-sizing: border-box; }
-    body {
-      font-family: -apple-system, BlinkMacSystemFont, "Segoe UI", Roboto, sans-serif;
-      margin: 0; padding: 0;
-      background: #0f0f12;
-      color: #e0e0e8;
-      min-height: 100vh;
-    }
-    header {
-      background: #1a1a24;
-      border-bottom: 1px solid #2e2e40;
-      padding: 14px 20px;
-      display: flex;
-      align-items: center;
-      justify-content: space-between;
-      position: sticky; top: 0; z-index: 100;
-    }
-    header h1 { margin: 0; font-size: 1.1rem; font-weight: 600; }
-    main { max-width: 700px; margin: 0 auto; padding: 16px; }
-    .form-group { margin-bottom: 16px; }
-    label { display: block; font-size: 0.85rem; color: #a0a0b8; margin-bottom: 4px; }
-    input[type="text"], input[type="password"] {
-      width: 100%%; padding: 8px 12px;
-      background: #1a1a24; border: 1px solid #2e2e40;
-      border-radius: 6px; color: #e0e0e8; font-size: 0.9rem;
-    }
-    .btn-save {
-      display: inline-block; padding: 8px 20px;
-      background: #2a4a80; color: #a0c8ff;
-      border: none; border-radius: 6px;
-      font-size: 0.9rem; cursor: pointer; font-weight: 500;
-    }
-    .btn-save:hover { opacity: 0.8; }
-    .back-link { color: #a0a0b8; text-decoration: none; font-size: 0.85rem; }
-    .back-link:hover { color: #e0e0e8; }
-    .msg-error { background: #3a1a1a; color: #ff6060; padding: 10px 14px;
-      border-radius: 6px; margin-bottom: 16px; font-size: 0.85rem; }
-    .msg-success { background: #1a3a1a; color: #60d060; padding: 10px 14px;
-      border-radius: 6px; margin-bottom: 16px; font-size: 0.85rem; }
-    .current-info { background: #1a1a24; border: 1px solid #2e2e40;
-      border-radius: 8px; padding: 12px 16px; margin-bottom: 16px;
-      font-size: 0.85rem; color: #a0a0b8; }
-  </style>
+  <link rel="stylesheet" href="%s">
 </head>
 <body>
 <header>
@@ -600,14 +362,17 @@ func RenderSettings(params SettingsParams) string {
     </p>
     <button type="submit" class="btn-save">Save</button>
   </form>
+  %s
 </main>
 </body>
 </html>`,
+		assetURL("settings.css"),
 		params.MsgHTML,
 		params.WarningHTML,
 		esc(params.CurrentSSID),
 		esc(params.CurrentPass),
 		esc(params.CSRFToken),
+		params.CardHTML,
 	)
 }
 
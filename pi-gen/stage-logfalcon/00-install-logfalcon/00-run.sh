@@ -26,6 +26,7 @@ rsync -a --exclude='.git' --exclude='pi-gen' \
 # Copy systemd units
 install -m 644 "${REPO_ROOT}/system/logfalcon@.service" "${ROOTFS_DIR}/etc/systemd/system/"
 install -m 644 "${REPO_ROOT}/system/logfalcon-web.service" "${ROOTFS_DIR}/etc/systemd/system/"
+install -m 644 "${REPO_ROOT}/system/logfalcon-web.socket" "${ROOTFS_DIR}/etc/systemd/system/"
 install -m 644 "${REPO_ROOT}/system/logfalcon-firstboot.service" "${ROOTFS_DIR}/etc/systemd/system/"
 install -m 644 "${REPO_ROOT}/system/logfalcon-boot-led.service" "${ROOTFS_DIR}/etc/systemd/system/"
 install -m 644 "${REPO_ROOT}/system/logfalcon-ready-led.service" "${ROOTFS_DIR}/etc/systemd/system/"
@@ -36,6 +37,9 @@ install -m 755 "${REPO_ROOT}/system/logfalcon-boot-led.sh" "${ROOTFS_DIR}/opt/lo
 # Copy ready LED script
 install -m 755 "${REPO_ROOT}/system/logfalcon-ready-led.sh" "${ROOTFS_DIR}/opt/logfalcon/ready-led.sh"
 
+# Copy tmpfiles rule (cpufreq access for the sync service)
+install -m 644 "${REPO_ROOT}/system/logfalcon.tmpfiles" "${ROOTFS_DIR}/etc/tmpfiles.d/logfalcon.conf"
+
 # Copy udev rule
 install -m 644 "${REPO_ROOT}/system/99-betaflight-fc.rules" "${ROOTFS_DIR}/etc/udev/rules.d/"
 
@@ -54,7 +58,7 @@ echo "[logfalcon] Created ${BOOT_DIR}/userconf.txt for headless first boot"
 
 # Enable services in chroot
 on_chroot << CHEOF
-systemctl enable logfalcon-web.service
+systemctl enable logfalcon-web.socket
 systemctl enable logfalcon-firstboot.service
 systemctl enable logfalcon-boot-led.service
 systemctl enable logfalcon-ready-led.service
@@ -188,6 +188,11 @@ LED="/sys/class/leds/led0"
 echo none > "$LED/trigger" 2>/dev/null
 cleanup() { echo 0 > "$LED/brightness" 2>/dev/null; echo mmc0 > "$LED/trigger" 2>/dev/null; exit 0; }
 trap cleanup TERM INT
+if echo timer > "$LED/trigger" 2>/dev/null; then
+    echo 1000 > "$LED/delay_on"; echo 1000 > "$LED/delay_off"
+    sleep infinity & wait
+fi
+echo none > "$LED/trigger" 2>/dev/null
 while true; do echo 1 > "$LED/brightness"; sleep 1; echo 0 > "$LED/brightness"; sleep 1; done
 SCRIPTEOF
 
@@ -211,6 +216,13 @@ SUBSYSTEM=="tty", ATTRS{idVendor}=="0483", ATTRS{idProduct}!="df11", KERNEL=="tt
 EOF
 udevadm control --reload-rules 2>/dev/null || true
 
+# --- Install tmpfiles rule (cpufreq access for the sync service) -------------
+cat > /etc/tmpfiles.d/logfalcon.conf <<'EOF'
+z /sys/devices/system/cpu/cpufreq/policy*/scaling_governor 0664 root bbsyncer -
+z /sys/devices/system/cpu/cpufreq/policy*/scaling_min_freq 0664 root bbsyncer -
+EOF
+systemd-tmpfiles --create /etc/tmpfiles.d/logfalcon.conf 2>/dev/null || true
+
 # --- Install systemd units ---------------------------------------------------
 cat > /etc/systemd/system/logfalcon@.service <<'EOF'
 [Unit]
@@ -223,28 +235,47 @@ Conflicts=logfalcon@*.service
 [Service]
 Type=oneshot
 ExecStartPre=+/usr/bin/systemctl stop logfalcon-ready-led.service
-ExecStartPre=/bin/sleep 3
 User=bbsyncer
 Group=dialout
+AmbientCapabilities=CAP_SYS_NICE
+CapabilityBoundingSet=CAP_SYS_NICE
 WorkingDirectory=/opt/logfalcon
 ExecStart=/opt/logfalcon/logfalcon --port /dev/%I
 StandardOutput=journal
 StandardError=journal
 SyslogIdentifier=logfalcon
+RuntimeDirectory=logfalcon
+RuntimeDirectoryPreserve=yes
 TimeoutStartSec=600
 TimeoutStopSec=10
+ExecStopPost=+/opt/logfalcon/logfalcon --restore-cpu
 ExecStopPost=+/usr/bin/systemctl start logfalcon-ready-led.service
+ExecStopPost=+/usr/bin/systemctl start --no-block logfalcon-web.service
 Restart=no
 
 [Install]
 WantedBy=multi-user.target
 EOF
 
+cat > /etc/systemd/system/logfalcon-web.socket <<'EOF'
+[Unit]
+Description=LogFalcon Web Server Socket
+Documentation=https://github.com/proeugene/logfalcon
+
+[Socket]
+ListenStream=80
+Backlog=64
+
+[Install]
+WantedBy=sockets.target
+EOF
+
 cat > /etc/systemd/system/logfalcon-web.service <<'EOF'
 [Unit]
 Description=LogFalcon Web Server
 Documentation=https://github.com/proeugene/logfalcon
-After=network.target hostapd.service
+After=network.target hostapd.service logfalcon-web.socket
+Requires=logfalcon-web.socket
 
 [Service]
 Type=simple
@@ -255,13 +286,15 @@ ExecStart=/opt/logfalcon/logfalcon --web
 StandardOutput=journal
 StandardError=journal
 SyslogIdentifier=logfalcon-web
-Restart=always
+RuntimeDirectory=logfalcon
+RuntimeDirectoryPreserve=yes
+Restart=on-failure
 RestartSec=5
 AmbientCapabilities=CAP_NET_BIND_SERVICE
 CapabilityBoundingSet=CAP_NET_BIND_SERVICE
 
 [Install]
-WantedBy=multi-user.target
+Also=logfalcon-web.socket
 EOF
 
 cat > /etc/systemd/system/logfalcon-firstboot.service <<'EOF'
@@ -283,8 +316,8 @@ cat > /etc/systemd/system/logfalcon-boot-led.service <<'EOF'
 [Unit]
 Description=LogFalcon Boot LED Heartbeat
 DefaultDependencies=no
-Before=logfalcon-web.service
-Conflicts=logfalcon-web.service
+Before=logfalcon-ready-led.service
+Conflicts=logfalcon-ready-led.service
 
 [Service]
 Type=simple
@@ -298,8 +331,8 @@ EOF
 cat > /etc/systemd/system/logfalcon-ready-led.service <<'EOF'
 [Unit]
 Description=LogFalcon Ready LED
-After=logfalcon-web.service
-Requires=logfalcon-web.service
+After=logfalcon-web.socket
+Requires=logfalcon-web.socket
 Conflicts=logfalcon-boot-led.service
 
 [Service]
@@ -384,7 +417,7 @@ info "Hotspot configured (SSID: LogFalcon, Password: fpvpilot)."
 info "Enabling services..."
 systemctl daemon-reload
 
-systemctl enable logfalcon-web.service
+systemctl enable logfalcon-web.socket
 systemctl enable logfalcon-firstboot.service
 systemctl enable logfalcon-boot-led.service
 systemctl enable logfalcon-ready-led.service
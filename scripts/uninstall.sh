@@ -16,6 +16,8 @@ info "Uninstalling LogFalcon..."
 
 # --- Stop and disable services -----------------------------------------------
 info "Stopping services..."
+systemctl stop logfalcon-web.socket 2>/dev/null || true
+systemctl disable logfalcon-web.socket 2>/dev/null || true
 for svc in logfalcon-web logfalcon-firstboot logfalcon-boot-led logfalcon-ready-led "logfalcon@*"; do
     systemctl stop "$svc".service 2>/dev/null || true
     systemctl disable "$svc".service 2>/dev/null || true
@@ -25,6 +27,7 @@ done
 info "Removing systemd units..."
 rm -f /etc/systemd/system/logfalcon@.service
 rm -f /etc/systemd/system/logfalcon-web.service
+rm -f /etc/systemd/system/logfalcon-web.socket
 rm -f /etc/systemd/system/logfalcon-firstboot.service
 rm -f /etc/systemd/system/logfalcon-boot-led.service
 rm -f /etc/systemd/system/logfalcon-ready-led.service
@@ -33,6 +36,7 @@ systemctl daemon-reload
 # --- Remove udev rule ---------------------------------------------------------
 info "Removing udev rule..."
 rm -f /etc/udev/rules.d/99-betaflight-fc.rules
+rm -f /etc/tmpfiles.d/logfalcon.conf
 udevadm control --reload-rules 2>/dev/null || true
 
 # --- Remove files -------------------------------------------------------------
@@ -16,7 +16,16 @@ cleanup() {
 }
 trap cleanup TERM INT
 
-# Slow heartbeat: 1s on / 1s off
+# Slow heartbeat: 1s on / 1s off. Let the kernel timer trigger blink it so
+# boot is not slowed by a shell loop; fall back to toggling by hand.
+if echo timer > "$TRIGGER" 2>/dev/null; then
+    echo 1000 > "$LED/delay_on"
+    echo 1000 > "$LED/delay_off"
+    sleep infinity &
+    wait
+fi
+
+echo none > "$TRIGGER" 2>/dev/null
 while true; do
     echo 1 > "$BRIGHTNESS"
     sleep 1